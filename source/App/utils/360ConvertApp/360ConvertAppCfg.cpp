@@ -47,6 +47,9 @@
 #include "CommonLib/Buffer.h"
 #include "Lib360/TGeometry.h"
 #include "Lib360/TViewPort.h"
+#if SVIDEO_FUSED_PACKED_CONVERSION
+#include "Lib360/TPackedConverter.h"
+#endif
 #include "360ConvertAppCfg.h"
 #include "Utilities/program_options_lite.h"
 #include "Utilities/VideoIOYuv.h"
@@ -63,6 +66,9 @@
 #if SVIDEO_CPPPSNR
 #include "Lib360/TCPPPSNRMetricCalc.h"
 #endif
+#if SVIDEO_SHARED_FRAME_CONTEXT
+#include "Lib360/TSphereFrameContext.h"
+#endif
 
 #ifdef WIN32
 #define strdup _strdup
@@ -108,6 +114,15 @@ TApp360ConvertCfg::TApp360ConvertCfg()
   , m_outputInternalColourSpace(false)
   , m_temporalSubsampleRatio(1)
   , m_faceSizeAlignment(8)
+#if SVIDEO_VIEWPORT_LUT_CACHE
+  , m_iViewPortLutCacheSize(0)
+#endif
+#if SVIDEO_FUSED_PACKED_CONVERSION
+  , m_bFusedPackedConversion(false)
+#endif
+#if SVIDEO_FAST_TRIGONOMETRY
+  , m_bValidateFastTrigonometry(false)
+#endif
 {
 }
 
@@ -535,6 +550,19 @@ Bool TApp360ConvertCfg::parseCfg( Int argc, TChar* argv[] )
     ("ViewPortFile,v",                                  cfg_ViewFile,                                string(""), "Viewport paramete file name for dynamic viewport generation")
 #if SVIDEO_DYNAMIC_VIEWPORT_PSNR
     ("DynamicViewPortFile,-dynvp",                      cfg_Dynamic_ViewFile,                        string(""), "Viewport parameter file name for sequential dynamic viewport generation")
+#endif
+#if SVIDEO_VIEWPORT_LUT_CACHE
+    ("ViewPortLUTCacheSize",                            m_iViewPortLutCacheSize,                              0, "Memory budget in MB of the viewport mapping tables cached for the orientations already used, 0: disabled")
+#endif
+#if SVIDEO_FUSED_PACKED_CONVERSION
+    ("FusedPackedConversion",                           m_bFusedPackedConversion,                         false, "Convert the frame packed pictures in one pass without the face buffers (ERP, CMP, ACP and EAC of the same chroma format as the internal one)")
+#endif
+#if SVIDEO_FAST_TRIGONOMETRY
+    ("ValidateFastTrigonometry",                        m_bValidateFastTrigonometry,                      false, "Report the errors of the polynomial approximations of the trigonometric functions this build maps with")
+#endif
+#if SVIDEO_MAPPING_ACCURACY_CHECK
+    ("MappingCheckFile",                                m_mappingCheckFile,                            string(""), "File the mapping table from the input to the coding geometry is written to, with the source positions")
+    ("MappingCheckRefFile",                             m_mappingCheckRefFile,                         string(""), "Mapping check file of another build (e.g. with double positions) the mapping table is compared with")
 #endif
     ("SpherePointsFile,p",                              cfg_SpherePointsFile,                        string(""), "File name for point coordinates on the sphere of the converted projction")
     ("SourceWidth,-wdt",                                m_iInputWidth,                                        0, "Source picture width")
@@ -3031,6 +3059,9 @@ Void  TApp360ConvertCfg::convert()
   PelStorage *pcPicYuvReadFromFile = nullptr;  ///< for file reading;
   PelStorage *pcPicYuvRot = nullptr;  ///< adjust to frame packed video to normal sphere video;
   TGeometry  *pcInputGeometry = nullptr, *pcCodingGeometry = nullptr;
+#if SVIDEO_FUSED_PACKED_CONVERSION
+  TPackedConverter *pcPackedConverter = nullptr;
+#endif
   PelStorage *pcPicYuvReadFromRefFile = nullptr;
 #if SVIDEO_SPSNR_NN
   TPSNRMetric  cPSNRCalc;
@@ -3044,6 +3075,9 @@ Void  TApp360ConvertCfg::convert()
 #endif
 #if SVIDEO_CPPPSNR
   TCPPPSNRMetric cCPPPSNRCalc;
+#endif
+#if SVIDEO_SHARED_FRAME_CONTEXT
+  TSphereFrameContext cFrameContext;
 #endif
   pcPicYuvReadFromFile = new PelStorage;
   pcPicYuvReadFromFile->create(m_InputChromaFormatIDC, Area(Position(), Size(m_iInputWidth, m_iInputHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
@@ -3131,8 +3165,56 @@ Void  TApp360ConvertCfg::convert()
     }
   }
 
+#if SVIDEO_FAST_TRIGONOMETRY
+  if(m_bValidateFastTrigonometry)
+  {
+    TFastTrig::validate();
+  }
+#endif
+#if SVIDEO_FUSED_PACKED_CONVERSION
+  //the face buffers are only allocated if the fused conversion turns out not to be supported;
+  Bool bFaceBuffers = !m_bFusedPackedConversion || bGeoConvertSkip;
+  pcInputGeometry = TGeometry::create(m_sourceSVideoInfo, &m_inputGeoParam, bFaceBuffers);
+  pcCodingGeometry = TGeometry::create(m_codingSVideoInfo, &m_inputGeoParam, bFaceBuffers);
+#else
   pcInputGeometry = TGeometry::create(m_sourceSVideoInfo, &m_inputGeoParam); 
   pcCodingGeometry = TGeometry::create(m_codingSVideoInfo, &m_inputGeoParam);
+#endif
+#if SVIDEO_DEMAND_SPHERE_PADDING
+  pcInputGeometry->setDemandPadding(!bDirectFPConvert);
+#endif
+#if SVIDEO_VIEWPORT_LUT_CACHE
+  if(m_codingSVideoInfo.geoType == SVIDEO_VIEWPORT && m_iViewPortLutCacheSize > 0)
+  {
+    ((TViewPort*)pcCodingGeometry)->setLutCacheSize(m_iViewPortLutCacheSize);
+  }
+#endif
+#if SVIDEO_MAPPING_ACCURACY_CHECK
+  if(!bGeoConvertSkip && !m_mappingCheckFile.empty())
+  {
+    pcCodingGeometry->writeMappingCheck(pcInputGeometry, m_mappingCheckFile);
+  }
+  if(!bGeoConvertSkip && !m_mappingCheckRefFile.empty())
+  {
+    pcCodingGeometry->compareMappingCheck(pcInputGeometry, m_mappingCheckRefFile);
+  }
+#endif
+#if SVIDEO_FUSED_PACKED_CONVERSION
+  if(m_bFusedPackedConversion && !bGeoConvertSkip)
+  {
+    if(!bDirectFPConvert && !pcPicYuvRot && TPackedConverter::isSupported(pcInputGeometry, pcCodingGeometry))
+    {
+      pcPackedConverter = new TPackedConverter;
+      pcPackedConverter->init(pcInputGeometry, pcCodingGeometry);
+    }
+    else
+    {
+      printf("Warning: the fused conversion is not supported for the given geometries, the faces are converted separately!\n");
+      pcInputGeometry->allocFaceBuffers();
+      pcCodingGeometry->allocFaceBuffers();
+    }
+  }
+#endif
 #if SVIDEO_CPPPSNR
   //pcReferenceGeometry = TGeometry::create(m_referenceSVideoInfo, &m_inputGeoParam);
 #endif
@@ -3186,12 +3268,18 @@ Void  TApp360ConvertCfg::convert()
     cSPSNRICalc.init(m_inputGeoParam, m_codingSVideoInfo, m_referenceSVideoInfo, m_iSourceWidth, m_iSourceHeight, m_iReferenceSourceWidth, m_iReferenceSourceHeight);
     cSPSNRICalc.sphSampoints(m_pchSphData);
     cSPSNRICalc.createTable(pcPicYuvReadFromRefFile, pcCodingGeometry);
+#if SVIDEO_SHARED_FRAME_CONTEXT
+    cSPSNRICalc.setFrameContext(&cFrameContext);
+#endif
   }
 #endif
 #if SVIDEO_CPPPSNR
   if( m_psnrEnabled[METRIC_CPPPSNR])
   {
     cCPPPSNRCalc.initCPPPSNR(m_inputGeoParam, m_cppPsnrWidth, m_cppPsnrHeight, m_codingSVideoInfo, m_referenceSVideoInfo);
+#if SVIDEO_SHARED_FRAME_CONTEXT
+    cCPPPSNRCalc.setFrameContext(&cFrameContext);
+#endif
   }
 #endif
   //dump all points on the sphere;
@@ -3247,6 +3335,14 @@ Void  TApp360ConvertCfg::convert()
     if (cTVideoIOYuvInputFile.isEof())
       break;
 
+#if SVIDEO_FUSED_PACKED_CONVERSION
+    if(pcPackedConverter)
+    {
+      pcPackedConverter->convert(pcPicYuvReadFromFile, &cPicYuvTrueOrg);
+      cTVideoIOYuvInputFile.ColourSpaceConvert(cPicYuvTrueOrg, *pcPicYuvOrg, ipCSC, true);
+    }
+    else
+#endif
     if(!bGeoConvertSkip)
     {
       if(pcPicYuvRot)
@@ -3354,6 +3450,9 @@ Void  TApp360ConvertCfg::convert()
       cTVideoIOYuvRefFile.read(*pcPicYuvReadFromRefFile, *pcPicYuvReadFromRefFile, IPCOLOURSPACE_UNCHANGED, aiPad, m_OutputChromaFormatIDC, m_bClipInputVideoToRec709Range);
       if (!cTVideoIOYuvRefFile.isEof())
       {
+#if SVIDEO_SHARED_FRAME_CONTEXT
+        cFrameContext.newFrame();
+#endif
 #if SVIDEO_FIX_TICKET51
         if(m_psnrEnabled[METRIC_PSNR])
         {
@@ -3511,6 +3610,13 @@ Void  TApp360ConvertCfg::convert()
     delete pcPicYuvReadFromRefFile;
     pcPicYuvReadFromRefFile = nullptr;
   }
+#if SVIDEO_FUSED_PACKED_CONVERSION
+  if(pcPackedConverter)
+  {
+    delete pcPackedConverter;
+    pcPackedConverter = nullptr;
+  }
+#endif
   if(pcInputGeometry)
   {
     delete pcInputGeometry;
@@ -130,6 +130,19 @@ protected:
 
   UInt  m_temporalSubsampleRatio;                         ///< temporal subsample ratio, 2 means code every two frames
   Int   m_faceSizeAlignment;
+#if SVIDEO_VIEWPORT_LUT_CACHE
+  Int   m_iViewPortLutCacheSize;                          ///< memory budget in MB of the cached viewport mapping tables, 0: disabled
+#endif
+#if SVIDEO_FUSED_PACKED_CONVERSION
+  Bool  m_bFusedPackedConversion;                         ///< convert the frame packed pictures directly, without the face buffers
+#endif
+#if SVIDEO_FAST_TRIGONOMETRY
+  Bool  m_bValidateFastTrigonometry;                      ///< report the errors of the approximations
+#endif
+#if SVIDEO_MAPPING_ACCURACY_CHECK
+  std::string m_mappingCheckFile;                         ///< mapping table dump with the source positions
+  std::string m_mappingCheckRefFile;                      ///< mapping table dump of another build to compare with
+#endif
 
   //snr flags
   Bool m_psnrEnabled[METRIC_NUM];                                     //0-psnr;1-spsnr;2-wspsnr;
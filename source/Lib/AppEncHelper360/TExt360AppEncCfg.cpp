@@ -556,6 +556,36 @@ Void TExt360AppEncCfg::addOptions(df::program_options_lite::Options &opts, TExt3
 #if SVIDEO_CF_CPPPSNR
   ("CF_CPP_PSNR,-cf_cpppsnr",               m_bCFCPPPSNREnabled,                           true, "Flag to enable cross format cpp-psnr calculation")
 #endif
+#if SVIDEO_CONCURRENT_METRICS
+  ("MetricThreads",                              m_iMetricThreads,                              0,     "Number of worker threads to calculate the 360 video metrics, 0: calculate them serially")
+#endif
+#if SVIDEO_E2E_METRICS && SVIDEO_ORIG_FRAME_CACHE
+  ("OrigFrameCacheSize",                         m_iOrigFrameCacheSize,                         0,     "Number of original pictures cached for the end to end metrics, 0: reordering distance of the GOP")
+#endif
+#if SVIDEO_INPUT_PREFETCH
+  ("InputPrefetchDepth",                         m_iInputPrefetchDepth,                         0,     "Number of input pictures read and converted to the coding geometry ahead of the encoder on a separate thread, 0: disabled")
+#endif
+#if SVIDEO_INPUT_CACHE
+  ("InputCacheDir",                              m_inputCacheDir,                               std::string(""), "Directory of the cache of the input pictures converted to the coding geometry, shared by the encoder runs; empty: disabled")
+#endif
+#if SVIDEO_VIEWPORT_LUT_CACHE
+  ("ViewPortLUTCacheSize",                       m_iViewPortLutCacheSize,                       0,     "Memory budget in MB of the mapping tables cached by each dynamic viewport, reused when the viewport returns to an orientation, 0: disabled")
+#endif
+#if SVIDEO_VIEWPORT_DIRECT_SAMPLING
+  ("DynamicViewPortDirectSampling",              m_bDynViewPortDirectSampling,                  false, "Flag to sample the dynamic viewports directly from the source geometry without building the mapping tables")
+  ("DynamicViewPortThreads",                     m_iDynViewPortThreads,                         1,     "Number of threads sampling each dynamic viewport in the direct sampling mode")
+#endif
+#if SVIDEO_VIEWPORT_BATCH_PSNR
+  ("ViewPortPSNRThreads",                        m_iViewPortPSNRThreads,                        0,     "Number of threads evaluating all the static viewports in one pass without frame packing them, 0: evaluate the viewports one by one")
+#endif
+#if SVIDEO_TRACE_VIEWPORT_PSNR
+  ("TraceViewPortFile",                          m_traceViewPortFile,                           std::string(""), "Binary file of the head motion traces of the users for the trace viewport PSNR calculation; empty: disabled")
+  ("TraceViewPortWidth",                         m_iTraceViewPortWidth,                         1920,  "Viewport width for trace viewport PSNR calculation")
+  ("TraceViewPortHeight",                        m_iTraceViewPortHeight,                        1080,  "Viewport height for trace viewport PSNR calculation")
+  ("TraceViewPortStep",                          m_dTraceViewPortStep,                          0.0,   "Orientations of the users within the same step in degrees are evaluated as one viewport, 0: only identical orientations are merged")
+  ("TraceViewPortThreads",                       m_iTraceViewPortThreads,                       1,     "Number of threads evaluating the distinct viewports of each picture for trace viewport PSNR calculation")
+  ("TraceViewPortSummaryFile",                   m_traceViewPortSummaryFile,                    std::string(""), "File of the per-user averages of the trace viewport PSNR; empty: not written")
+#endif
 #if SVIDEO_HEMI_PROJECTIONS
   ("CodingPCMP",                            m_codingSVideoInfo.bPCMP,                      false,  "Enable padded hemisphere-based projection format coding")
 #endif
@@ -2062,6 +2092,28 @@ Bool TExt360AppEncCfg::verifyParameters()
   if(m_bSVideo)
   {
     xConfirmPara(m_faceSizeAlignment<0, "FaceSizeAlignment must be no less than 0");
+#if SVIDEO_CONCURRENT_METRICS
+    xConfirmPara(m_iMetricThreads<0, "MetricThreads must be no less than 0");
+#endif
+#if SVIDEO_E2E_METRICS && SVIDEO_ORIG_FRAME_CACHE
+    xConfirmPara(m_iOrigFrameCacheSize<0, "OrigFrameCacheSize must be no less than 0");
+#endif
+#if SVIDEO_INPUT_PREFETCH
+    xConfirmPara(m_iInputPrefetchDepth<0, "InputPrefetchDepth must be no less than 0");
+#endif
+#if SVIDEO_VIEWPORT_LUT_CACHE
+    xConfirmPara(m_iViewPortLutCacheSize<0, "ViewPortLUTCacheSize must be no less than 0");
+#endif
+#if SVIDEO_VIEWPORT_DIRECT_SAMPLING
+    xConfirmPara(m_iDynViewPortThreads<1, "DynamicViewPortThreads must be greater than 0");
+#endif
+#if SVIDEO_VIEWPORT_BATCH_PSNR
+    xConfirmPara(m_iViewPortPSNRThreads<0, "ViewPortPSNRThreads must be no less than 0");
+#endif
+#if SVIDEO_TRACE_VIEWPORT_PSNR
+    xConfirmPara(m_iTraceViewPortThreads<1, "TraceViewPortThreads must be greater than 0");
+    xConfirmPara(m_dTraceViewPortStep<0, "TraceViewPortStep must be no less than 0");
+#endif
     //check source;
     if(   m_sourceSVideoInfo.geoType == SVIDEO_EQUIRECT 
 #if SVIDEO_ADJUSTED_EQUALAREA
@@ -2626,6 +2678,22 @@ Void TExt360AppEncCfg::outputConfigurationSummary()
 #endif
 #if SVIDEO_ROT_FIX
     printf("Rotation in 1/100 degrees: (yaw:%d  pitch:%d  roll:%d)\n", m_codingSVideoInfo.sVideoRotation.degree[2], m_codingSVideoInfo.sVideoRotation.degree[1], m_codingSVideoInfo.sVideoRotation.degree[0]); 
+#endif
+#if SVIDEO_CONCURRENT_METRICS
+    if(m_iMetricThreads)
+      printf("Metrics are calculated by %d worker threads\n", m_iMetricThreads);
+#endif
+#if SVIDEO_INPUT_PREFETCH
+    if(m_iInputPrefetchDepth)
+      printf("Input pictures are converted up to %d pictures ahead\n", m_iInputPrefetchDepth);
+#endif
+#if SVIDEO_INPUT_CACHE
+    if(!m_inputCacheDir.empty())
+      printf("Converted input pictures are cached in: %s\n", m_inputCacheDir.c_str());
+#endif
+#if SVIDEO_TRACE_VIEWPORT_PSNR
+    if(!m_traceViewPortFile.empty())
+      printf("Trace viewport PSNR: %s %dx%d, step %.2f degrees\n", m_traceViewPortFile.c_str(), m_iTraceViewPortWidth, m_iTraceViewPortHeight, m_dTraceViewPortStep);
 #endif
   }
   printf("-----360 video parameters----\n");
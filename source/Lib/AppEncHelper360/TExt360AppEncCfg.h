@@ -99,6 +99,36 @@ protected:
 #if SVIDEO_CF_CPPPSNR
   Bool     m_bCFCPPPSNREnabled;
 #endif
+#if SVIDEO_CONCURRENT_METRICS
+  Int       m_iMetricThreads;                                 ///< number of worker threads for the 360 video metrics, 0: calculate them serially;
+#endif
+#if SVIDEO_E2E_METRICS && SVIDEO_ORIG_FRAME_CACHE
+  Int       m_iOrigFrameCacheSize;                            ///< number of original pictures cached for the end to end metrics, 0: reordering distance of the GOP;
+#endif
+#if SVIDEO_INPUT_PREFETCH
+  Int       m_iInputPrefetchDepth;                            ///< number of input pictures converted ahead of the encoder, 0: disabled;
+#endif
+#if SVIDEO_INPUT_CACHE
+  std::string m_inputCacheDir;                                ///< directory of the converted input picture cache, empty: disabled;
+#endif
+#if SVIDEO_VIEWPORT_LUT_CACHE
+  Int       m_iViewPortLutCacheSize;                          ///< memory budget in MB of the mapping tables cached by each dynamic viewport, 0: disabled;
+#endif
+#if SVIDEO_VIEWPORT_DIRECT_SAMPLING
+  Bool      m_bDynViewPortDirectSampling;                     ///< sample the dynamic viewports without building the mapping tables;
+  Int       m_iDynViewPortThreads;                            ///< number of threads sampling each dynamic viewport;
+#endif
+#if SVIDEO_VIEWPORT_BATCH_PSNR
+  Int       m_iViewPortPSNRThreads;                           ///< number of threads evaluating the static viewports in one pass, 0: one by one;
+#endif
+#if SVIDEO_TRACE_VIEWPORT_PSNR
+  std::string m_traceViewPortFile;                            ///< binary file of the head motion traces, empty: disabled;
+  Int       m_iTraceViewPortWidth;
+  Int       m_iTraceViewPortHeight;
+  Double    m_dTraceViewPortStep;                             ///< orientations within the step (degrees) share one viewport, 0: only identical orientations;
+  Int       m_iTraceViewPortThreads;                          ///< number of threads evaluating the distinct viewports;
+  std::string m_traceViewPortSummaryFile;                     ///< per-user summary file, empty: not written;
+#endif
 
   EncAppCfg &m_cfg;
   friend class TExt360AppEncTop;
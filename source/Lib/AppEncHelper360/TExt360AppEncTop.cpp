@@ -46,6 +46,12 @@ TExt360AppEncTop::TExt360AppEncTop(EncAppCfg &cfg, TExt360EncGop &ext360Gop, Enc
   , m_picYuvRot()
   , m_pcInputGeomtry(nullptr)
   , m_pcCodingGeomtry(nullptr)
+#if SVIDEO_INPUT_PREFETCH
+  , m_iPrefetchDepth(m_cfg.m_ext360.m_iInputPrefetchDepth)
+  , m_iPrefetchRead(0)
+  , m_iPrefetchWritten(0)
+  , m_bPrefetchStop(false)
+#endif
 {
   if(m_bDirectFPConvert)
   {
@@ -61,6 +67,19 @@ TExt360AppEncTop::~TExt360AppEncTop()
 
 Void TExt360AppEncTop::xDestroy()
 {
+#if SVIDEO_INPUT_CACHE
+  m_cInputCache.close();
+#endif
+#if SVIDEO_INPUT_PREFETCH
+  xStopPrefetch();
+  m_cPrefetchInputFile.close();
+  for(Int i=0; i<(Int)m_prefetchPics.size(); i++)
+  {
+    m_prefetchPics[i]->destroy();
+    delete m_prefetchPics[i];
+  }
+  m_prefetchPics.clear();
+#endif
 #if SVIDEO_E2E_METRICS
   m_cTVideoIOYuvInputFile4E2EMetrics.close();
 #else
@@ -100,6 +119,29 @@ Void TExt360AppEncTop::xCreate(EncGOP &encGop, PelStorage &yuvOrig)
   m_cTVideoIOYuvInputFile4E2EWSPSNR.open( m_cfg.m_inputFileName,     false, m_cfg.m_inputBitDepth, m_cfg.m_MSBExtendedBitDepth, m_cfg.m_internalBitDepth );
   m_cTVideoIOYuvInputFile4E2EWSPSNR.skipFrames(m_cfg.m_FrameSkip, m_cfg.m_inputFileWidth, m_cfg.m_inputFileHeight, m_cfg.m_InputChromaFormatIDC);
 #endif
+#endif
+#if SVIDEO_INPUT_CACHE
+  if(!m_cfg.m_ext360.m_inputCacheDir.empty() && isEnabled() && !m_bGeoConvertSkip)
+  {
+    xOpenInputCache();
+  }
+#endif
+#if SVIDEO_INPUT_PREFETCH
+#if SVIDEO_INPUT_CACHE
+  if(m_cInputCache.isReading())
+  {
+    m_iPrefetchDepth = 0;
+  }
+#endif
+  if(m_iPrefetchDepth && isEnabled() && !m_bGeoConvertSkip)
+  {
+    m_cPrefetchInputFile.open( m_cfg.m_inputFileName,     false, m_cfg.m_inputBitDepth, m_cfg.m_MSBExtendedBitDepth, m_cfg.m_internalBitDepth );
+    m_cPrefetchInputFile.skipFrames(m_cfg.m_FrameSkip, m_cfg.m_inputFileWidth, m_cfg.m_inputFileHeight, m_cfg.m_InputChromaFormatIDC);
+  }
+  else
+  {
+    m_iPrefetchDepth = 0;
+  }
 #endif
   //if(m_bSVideo)
   if (isEnabled())
@@ -139,9 +181,32 @@ Void TExt360AppEncTop::xCreate(EncGOP &encGop, PelStorage &yuvOrig)
     m_pcInputGeomtry  = TGeometry::create(extCfg.m_sourceSVideoInfo, &extCfg.m_inputGeoParam);
     m_pcCodingGeomtry = TGeometry::create(extCfg.m_codingSVideoInfo, &extCfg.m_inputGeoParam);
 #endif
+#if SVIDEO_DEMAND_SPHERE_PADDING
+    m_pcInputGeomtry->setDemandPadding(!m_bDirectFPConvert);
+#endif
+#if SVIDEO_CONCURRENT_METRICS
+    m_ext360EncGop.initMetricPool(extCfg.m_iMetricThreads);
+#endif
 #if SVIDEO_E2E_METRICS
+#if SVIDEO_ORIG_FRAME_CACHE
+    //by default the ring only spans the reordering distance of the GOP structure,
+    //i.e. from the furthest picture read ahead back to the picture requested in coding order;
+    Int iOrigCacheSize = extCfg.m_iOrigFrameCacheSize;
+    if(!iOrigCacheSize)
+    {
+      Int iMaxPOC = 0;
+      iOrigCacheSize = 1;
+      for(Int i=0; i<cfg.m_iGOPSize; i++)
+      {
+        iMaxPOC = std::max(iMaxPOC, cfg.m_GOPList[i].m_POC);
+        iOrigCacheSize = std::max(iOrigCacheSize, iMaxPOC - cfg.m_GOPList[i].m_POC + 1);
+      }
+    }
+    m_ext360EncGop.initE2EMetricsCalc(extCfg.m_sourceSVideoInfo, extCfg.m_codingSVideoInfo, &extCfg.m_inputGeoParam, m_cTVideoIOYuvInputFile4E2EMetrics, cfg.m_InputChromaFormatIDC, cfg.m_inputFileWidth, cfg.m_inputFileHeight, cfg.m_temporalSubsampleRatio, iOrigCacheSize);
+#else
     m_ext360EncGop.initE2EMetricsCalc(extCfg.m_sourceSVideoInfo, extCfg.m_codingSVideoInfo, &extCfg.m_inputGeoParam, m_cTVideoIOYuvInputFile4E2EMetrics, cfg.m_InputChromaFormatIDC, cfg.m_inputFileWidth, cfg.m_inputFileHeight, cfg.m_temporalSubsampleRatio);
 #endif
+#endif
 #if SVIDEO_VIEWPORT_PSNR
     if(extCfg.m_viewPortPSNRParam.bViewPortPSNREnabled)
     {
@@ -156,6 +221,12 @@ Void TExt360AppEncTop::xCreate(EncGOP &encGop, PelStorage &yuvOrig)
                                                    m_cTVideoIOYuvInputFile4VPPSNR,
                                                    cfg.m_inputFileWidth, cfg.m_inputFileHeight,
                                                    cfg.m_temporalSubsampleRatio);
+#endif
+#if SVIDEO_SHARED_FRAME_CONTEXT
+      m_ext360EncGop.getViewPortPSNRMetric()->setFrameContext(m_ext360EncGop.getFrameContext());
+#endif
+#if SVIDEO_VIEWPORT_BATCH_PSNR
+      m_ext360EncGop.getViewPortPSNRMetric()->setBatchThreads(extCfg.m_iViewPortPSNRThreads);
 #endif
     }
 #endif
@@ -164,6 +235,27 @@ Void TExt360AppEncTop::xCreate(EncGOP &encGop, PelStorage &yuvOrig)
     {
       m_ext360EncGop.initDynamicViewPortPSNR(encGop, (Int)extCfg.m_dynamicViewPortPSNRParam.viewPortSettingsList.size());
       m_ext360EncGop.getDynamicViewPortPSNRMetric()->initDynamicViewPort(extCfg.m_sourceSVideoInfo, extCfg.m_codingSVideoInfo, &extCfg.m_inputGeoParam, extCfg.m_dynamicViewPortPSNRParam, cfg.m_FrameSkip, cfg.m_temporalSubsampleRatio);
+#if SVIDEO_SHARED_FRAME_CONTEXT
+      m_ext360EncGop.getDynamicViewPortPSNRMetric()->setFrameContext(m_ext360EncGop.getFrameContext());
+#endif
+#if SVIDEO_VIEWPORT_LUT_CACHE
+      m_ext360EncGop.getDynamicViewPortPSNRMetric()->setLutCacheSize(extCfg.m_iViewPortLutCacheSize);
+#endif
+#if SVIDEO_VIEWPORT_DIRECT_SAMPLING
+      m_ext360EncGop.getDynamicViewPortPSNRMetric()->setDirectSampling(extCfg.m_bDynViewPortDirectSampling, extCfg.m_iDynViewPortThreads);
+#endif
+    }
+#endif
+#if SVIDEO_TRACE_VIEWPORT_PSNR
+    if(!extCfg.m_traceViewPortFile.empty())
+    {
+      m_ext360EncGop.getTraceViewPortPSNRMetric()->init(extCfg.m_sourceSVideoInfo, extCfg.m_codingSVideoInfo, &extCfg.m_inputGeoParam, extCfg.m_traceViewPortFile,
+                                                        extCfg.m_iTraceViewPortWidth, extCfg.m_iTraceViewPortHeight, (Float)extCfg.m_dTraceViewPortStep,
+                                                        extCfg.m_iTraceViewPortThreads, cfg.m_FrameSkip, cfg.m_temporalSubsampleRatio);
+      m_ext360EncGop.getTraceViewPortPSNRMetric()->setUserSummaryFile(extCfg.m_traceViewPortSummaryFile);
+#if SVIDEO_SHARED_FRAME_CONTEXT
+      m_ext360EncGop.getTraceViewPortPSNRMetric()->setFrameContext(m_ext360EncGop.getFrameContext());
+#endif
     }
 #endif
 #if SVIDEO_SPSNR_NN
@@ -235,6 +327,9 @@ Void TExt360AppEncTop::xCreate(EncGOP &encGop, PelStorage &yuvOrig)
 #endif
       m_ext360EncGop.getSPSNRIMetric()->sphSampoints(extCfg.m_sphFilename);
       m_ext360EncGop.getSPSNRIMetric()->createTable(&yuvOrig, m_pcCodingGeomtry);
+#if SVIDEO_SHARED_FRAME_CONTEXT
+      m_ext360EncGop.getSPSNRIMetric()->setFrameContext(m_ext360EncGop.getFrameContext());
+#endif
     }
 #endif
 #if SVIDEO_CPPPSNR
@@ -247,6 +342,9 @@ Void TExt360AppEncTop::xCreate(EncGOP &encGop, PelStorage &yuvOrig)
       m_ext360EncGop.getCPPPSNRMetric()->initCPPPSNR(extCfg.m_inputGeoParam, cfg.m_inputFileWidth, cfg.m_inputFileHeight, extCfg.m_sourceSVideoInfo, extCfg.m_sourceSVideoInfo);
 #else
       m_ext360EncGop.getCPPPSNRMetric()->initCPPPSNR(extCfg.m_inputGeoParam, cfg.m_sourceWidth, cfg.m_sourceHeight, extCfg.m_codingSVideoInfo, extCfg.m_codingSVideoInfo);
+#endif
+#if SVIDEO_SHARED_FRAME_CONTEXT
+      m_ext360EncGop.getCPPPSNRMetric()->setFrameContext(m_ext360EncGop.getFrameContext());
 #endif
     }
 #endif
@@ -270,6 +368,9 @@ Void TExt360AppEncTop::xCreate(EncGOP &encGop, PelStorage &yuvOrig)
       m_ext360EncGop.getCFSPSNRIMetric()->init(extCfg.m_inputGeoParam, extCfg.m_codingSVideoInfo, extCfg.m_sourceSVideoInfo, cfg.m_sourceWidth, cfg.m_sourceHeight, cfg.m_inputFileWidth, cfg.m_inputFileHeight);
       m_ext360EncGop.getCFSPSNRIMetric()->sphSampoints(extCfg.m_sphFilename);
       m_ext360EncGop.getCFSPSNRIMetric()->createTable(&yuvOrig, m_pcCodingGeomtry);
+#if SVIDEO_SHARED_FRAME_CONTEXT
+      m_ext360EncGop.getCFSPSNRIMetric()->setFrameContext(m_ext360EncGop.getFrameContext());
+#endif
     }
 #endif
 #if SVIDEO_CF_CPPPSNR
@@ -279,6 +380,9 @@ Void TExt360AppEncTop::xCreate(EncGOP &encGop, PelStorage &yuvOrig)
       m_ext360EncGop.getCFCPPPSNRMetric()->setOutputBitDepth(cfg.m_internalBitDepth);
       m_ext360EncGop.getCFCPPPSNRMetric()->setReferenceBitDepth(cfg.m_internalBitDepth);
       m_ext360EncGop.getCFCPPPSNRMetric()->initCPPPSNR(extCfg.m_inputGeoParam, cfg.m_sourceWidth, cfg.m_sourceHeight, extCfg.m_codingSVideoInfo, extCfg.m_sourceSVideoInfo);
+#if SVIDEO_SHARED_FRAME_CONTEXT
+      m_ext360EncGop.getCFCPPPSNRMetric()->setFrameContext(m_ext360EncGop.getFrameContext());
+#endif
     }
 #endif
   }
@@ -290,64 +394,238 @@ TExt360AppEncTop::read(VideoIOYuv &inputVideoFile, PelStorage &picYuvOrg, PelSto
 {
   if (!m_bGeoConvertSkip)
   {
-    Int aiPad[2]={0,0};
-    //PelUnitBuf tmp;
-    inputVideoFile.read(m_picYuvReadFromFile, m_picYuvReadFromFile, IPCOLOURSPACE_UNCHANGED, aiPad, m_cfg.m_InputChromaFormatIDC, m_cfg.m_bClipInputVideoToRec709Range);
-    if(m_picYuvRot.chromaFormat != NUM_CHROMA_FORMAT)
+#if SVIDEO_INPUT_CACHE
+    if(m_cInputCache.isReading() && m_cInputCache.read(picYuvTrueOrg))
     {
-      m_pcInputGeomtry->rotYuv(&m_picYuvReadFromFile, &m_picYuvRot, (360-m_cfg.m_ext360.m_sourceSVideoInfo.framePackStruct.faces[0][0].rot)%360);
-      m_pcInputGeomtry->convertYuv(&m_picYuvRot);
+      //keep the encoder's input file in step with the cache;
+      inputVideoFile.skipFrames(1, m_cfg.m_inputFileWidth, m_cfg.m_inputFileHeight, m_cfg.m_InputChromaFormatIDC);
     }
     else
+#endif
+#if SVIDEO_INPUT_PREFETCH
+    if(m_iPrefetchDepth)
     {
-      if((m_pcInputGeomtry->getSVideoInfo()->geoType == SVIDEO_OCTAHEDRON || m_pcInputGeomtry->getSVideoInfo()->geoType == SVIDEO_ICOSAHEDRON) && m_pcInputGeomtry->getSVideoInfo()->iCompactFPStructure)
-      {
-        m_pcInputGeomtry->compactFramePackConvertYuv(&m_picYuvReadFromFile);
-      }
-      else
-      {
-        m_pcInputGeomtry->convertYuv(&m_picYuvReadFromFile);
-      }
+      xGetPrefetchedPicture(inputVideoFile, picYuvTrueOrg);
     }
-    if(!m_bDirectFPConvert)
+    else
+#endif
+    xReadAndConvert(inputVideoFile, picYuvTrueOrg);
+#if SVIDEO_INPUT_CACHE
+    if(m_cInputCache.isWriting() && !inputVideoFile.isEof())
+    {
+      m_cInputCache.write(picYuvTrueOrg);
+    }
+#endif
+    inputVideoFile.ColourSpaceConvert(picYuvTrueOrg, picYuvOrg, ipCSC, true);
+    m_pcInputGeomtry->framePadding(&picYuvOrg, m_cfg.m_sourcePadding);
+  }
+  else
+  {
+    inputVideoFile.read( picYuvOrg, picYuvTrueOrg, ipCSC, m_cfg.m_sourcePadding, m_cfg.m_InputChromaFormatIDC, m_cfg.m_bClipInputVideoToRec709Range );
+  }
+}
+
+//read one picture and convert it to the coding geometry;
+Void TExt360AppEncTop::xReadAndConvert(VideoIOYuv &inputVideoFile, PelStorage &picYuvTrueOrg)
+{
+  Int aiPad[2]={0,0};
+  //PelUnitBuf tmp;
+  inputVideoFile.read(m_picYuvReadFromFile, m_picYuvReadFromFile, IPCOLOURSPACE_UNCHANGED, aiPad, m_cfg.m_InputChromaFormatIDC, m_cfg.m_bClipInputVideoToRec709Range);
+  if(m_picYuvRot.chromaFormat != NUM_CHROMA_FORMAT)
+  {
+    m_pcInputGeomtry->rotYuv(&m_picYuvReadFromFile, &m_picYuvRot, (360-m_cfg.m_ext360.m_sourceSVideoInfo.framePackStruct.faces[0][0].rot)%360);
+    m_pcInputGeomtry->convertYuv(&m_picYuvRot);
+  }
+  else
+  {
+    if((m_pcInputGeomtry->getSVideoInfo()->geoType == SVIDEO_OCTAHEDRON || m_pcInputGeomtry->getSVideoInfo()->geoType == SVIDEO_ICOSAHEDRON) && m_pcInputGeomtry->getSVideoInfo()->iCompactFPStructure)
     {
-      m_pcInputGeomtry->geoConvert(m_pcCodingGeomtry);
+      m_pcInputGeomtry->compactFramePackConvertYuv(&m_picYuvReadFromFile);
     }
     else
     {
-      m_pcInputGeomtry->setPaddingFlag(true);
+      m_pcInputGeomtry->convertYuv(&m_picYuvReadFromFile);
     }
+  }
+  if(!m_bDirectFPConvert)
+  {
+    m_pcInputGeomtry->geoConvert(m_pcCodingGeomtry);
+  }
+  else
+  {
+    m_pcInputGeomtry->setPaddingFlag(true);
+  }
 
-    if((m_pcCodingGeomtry->getSVideoInfo()->geoType == SVIDEO_OCTAHEDRON || m_pcCodingGeomtry->getSVideoInfo()->geoType == SVIDEO_ICOSAHEDRON) && m_pcCodingGeomtry->getSVideoInfo()->iCompactFPStructure)
+  if((m_pcCodingGeomtry->getSVideoInfo()->geoType == SVIDEO_OCTAHEDRON || m_pcCodingGeomtry->getSVideoInfo()->geoType == SVIDEO_ICOSAHEDRON) && m_pcCodingGeomtry->getSVideoInfo()->iCompactFPStructure)
+  {
+    if(!m_bDirectFPConvert)
     {
-      if(!m_bDirectFPConvert)
-      {
-        m_pcCodingGeomtry->compactFramePack(&picYuvTrueOrg);
-      }
-      else
-      {
-        m_pcInputGeomtry->compactFramePack(&picYuvTrueOrg);
-      }
+      m_pcCodingGeomtry->compactFramePack(&picYuvTrueOrg);
     }
     else
     {
-      if(!m_bDirectFPConvert)
-      {
-        m_pcCodingGeomtry->framePack(&picYuvTrueOrg);
-      }
-      else
-      {
-        m_pcInputGeomtry->framePack(&picYuvTrueOrg);
-      }
+      m_pcInputGeomtry->compactFramePack(&picYuvTrueOrg);
     }
-    inputVideoFile.ColourSpaceConvert(picYuvTrueOrg, picYuvOrg, ipCSC, true);
-    m_pcInputGeomtry->framePadding(&picYuvOrg, m_cfg.m_sourcePadding);
   }
   else
   {
-    inputVideoFile.read( picYuvOrg, picYuvTrueOrg, ipCSC, m_cfg.m_sourcePadding, m_cfg.m_InputChromaFormatIDC, m_cfg.m_bClipInputVideoToRec709Range );
+    if(!m_bDirectFPConvert)
+    {
+      m_pcCodingGeomtry->framePack(&picYuvTrueOrg);
+    }
+    else
+    {
+      m_pcInputGeomtry->framePack(&picYuvTrueOrg);
+    }
+  }
+}
+
+#if SVIDEO_INPUT_PREFETCH
+Void TExt360AppEncTop::xStartPrefetch(const PelStorage &picYuvTrueOrg)
+{
+  const Area a = Area(Position(), Size(picYuvTrueOrg.get(COMPONENT_Y).width, picYuvTrueOrg.get(COMPONENT_Y).height));
+  m_prefetchPics.resize(m_iPrefetchDepth);
+  m_prefetchEof.resize(m_iPrefetchDepth, false);
+  for(Int i=0; i<m_iPrefetchDepth; i++)
+  {
+    m_prefetchPics[i] = new PelStorage;
+    m_prefetchPics[i]->create(picYuvTrueOrg.chromaFormat, a, 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+  }
+  m_bPrefetchStop = false;
+  m_prefetchThread = std::thread(&TExt360AppEncTop::xPrefetchLoop, this);
+}
+
+Void TExt360AppEncTop::xStopPrefetch()
+{
+  if(!m_prefetchThread.joinable())
+    return;
+  {
+    std::unique_lock<std::mutex> lock(m_prefetchMutex);
+    m_bPrefetchStop = true;
+  }
+  m_prefetchCond.notify_all();
+  m_prefetchThread.join();
+}
+
+/*********************************************************
+//the prefetch thread reads the input pictures with its own file handle,
+//including the temporal subsampling done by the encoder, and stops at the end of file;
+**********************************************************/
+Void TExt360AppEncTop::xPrefetchLoop()
+{
+  for(Int iPicIdx=0; ; iPicIdx++)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_prefetchMutex);
+      m_prefetchCond.wait(lock, [&]{ return m_bPrefetchStop || m_iPrefetchWritten - m_iPrefetchRead < m_iPrefetchDepth; });
+      if(m_bPrefetchStop)
+        return;
+    }
+    Int iSlot = iPicIdx % m_iPrefetchDepth;
+    xReadAndConvert(m_cPrefetchInputFile, *m_prefetchPics[iSlot]);
+    Bool bEof = m_cPrefetchInputFile.isEof();
+    if(!bEof && m_cfg.m_temporalSubsampleRatio > 1)
+    {
+      m_cPrefetchInputFile.skipFrames(m_cfg.m_temporalSubsampleRatio-1, m_cfg.m_inputFileWidth, m_cfg.m_inputFileHeight, m_cfg.m_InputChromaFormatIDC);
+    }
+    {
+      std::unique_lock<std::mutex> lock(m_prefetchMutex);
+      m_prefetchEof[iSlot] = bEof;
+      m_iPrefetchWritten++;
+    }
+    m_prefetchCond.notify_all();
+    if(bEof)
+      return;
+  }
+}
+
+Void TExt360AppEncTop::xGetPrefetchedPicture(VideoIOYuv &inputVideoFile, PelStorage &picYuvTrueOrg)
+{
+  if(!m_prefetchThread.joinable() && !m_iPrefetchWritten)
+  {
+    xStartPrefetch(picYuvTrueOrg);
+  }
+  Int  iSlot = m_iPrefetchRead % m_iPrefetchDepth;
+  Bool bEof;
+  {
+    std::unique_lock<std::mutex> lock(m_prefetchMutex);
+    m_prefetchCond.wait(lock, [&]{ return m_iPrefetchWritten > m_iPrefetchRead; });
+    bEof = m_prefetchEof[iSlot];
+  }
+  if(bEof)
+  {
+    //reproduce the failing read on the encoder's input file so that it detects the end of file;
+    xStopPrefetch();
+    Int aiPad[2]={0,0};
+    inputVideoFile.read(m_picYuvReadFromFile, m_picYuvReadFromFile, IPCOLOURSPACE_UNCHANGED, aiPad, m_cfg.m_InputChromaFormatIDC, m_cfg.m_bClipInputVideoToRec709Range);
+  }
+  else
+  {
+    //keep the encoder's input file in step with the prefetch thread;
+    inputVideoFile.skipFrames(1, m_cfg.m_inputFileWidth, m_cfg.m_inputFileHeight, m_cfg.m_InputChromaFormatIDC);
+    picYuvTrueOrg.copyFrom(*m_prefetchPics[iSlot]);
+  }
+  {
+    std::unique_lock<std::mutex> lock(m_prefetchMutex);
+    m_iPrefetchRead++;
   }
+  m_prefetchCond.notify_all();
 }
+#endif
+
+#if SVIDEO_INPUT_CACHE
+/*********************************************************
+//the cache is keyed by the source file fingerprint, the first picture and the temporal subsampling,
+//and all the parameters of the conversion; a cache written by a shorter run is used as far as it goes;
+**********************************************************/
+Void TExt360AppEncTop::xOpenInputCache()
+{
+  TExt360AppEncCfg &extCfg = m_cfg.m_ext360;
+  m_cInputCache.resetKey();
+  if(!m_cInputCache.addFileFingerprint(m_cfg.m_inputFileName))
+  {
+    printf("Warning: the input cache is disabled, cannot read %s\n", m_cfg.m_inputFileName.c_str());
+    return;
+  }
+  m_cInputCache.addKey(m_cfg.m_inputFileWidth);
+  m_cInputCache.addKey(m_cfg.m_inputFileHeight);
+  m_cInputCache.addKey((Int)m_cfg.m_InputChromaFormatIDC);
+  m_cInputCache.addKey(m_cfg.m_sourceWidth);
+  m_cInputCache.addKey(m_cfg.m_sourceHeight);
+  for(Int ch=0; ch<MAX_NUM_CHANNEL_TYPE; ch++)
+  {
+    m_cInputCache.addKey(m_cfg.m_inputBitDepth[ch]);
+    m_cInputCache.addKey(m_cfg.m_MSBExtendedBitDepth[ch]);
+    m_cInputCache.addKey(m_cfg.m_internalBitDepth[ch]);
+  }
+  m_cInputCache.addKey(m_cfg.m_FrameSkip);
+  m_cInputCache.addKey(m_cfg.m_temporalSubsampleRatio);
+  m_cInputCache.addKey(m_cfg.m_bClipInputVideoToRec709Range);
+  m_cInputCache.addKey(m_bDirectFPConvert);
+  m_cInputCache.addKey(extCfg.m_sourceSVideoInfo);
+  m_cInputCache.addKey(extCfg.m_codingSVideoInfo);
+  m_cInputCache.addKey((Int)extCfg.m_inputGeoParam.chromaFormat);
+#if !SVIDEO_CHROMA_TYPES_SUPPORT
+  m_cInputCache.addKey(extCfg.m_inputGeoParam.bResampleChroma);
+  m_cInputCache.addKey(extCfg.m_inputGeoParam.iChromaSampleLocType);
+#endif
+  m_cInputCache.addKey(extCfg.m_inputGeoParam.nBitDepth);
+  m_cInputCache.addKey(extCfg.m_inputGeoParam.nOutputBitDepth);
+  for(Int ch=0; ch<MAX_NUM_CHANNEL_TYPE; ch++)
+  {
+    m_cInputCache.addKey(extCfg.m_inputGeoParam.iInterp[ch]);
+  }
+
+  if(!m_cInputCache.open(extCfg.m_inputCacheDir))
+  {
+    printf("Warning: the input cache is disabled, cannot write to %s\n", extCfg.m_inputCacheDir.c_str());
+  }
+  else
+  {
+    printf("%s converted input pictures cache\n", m_cInputCache.isReading() ? "Reading from" : "Writing to");
+  }
+}
+#endif
 
 Bool TExt360AppEncTop::isEnabled() const
 {
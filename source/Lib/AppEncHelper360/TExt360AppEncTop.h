@@ -39,6 +39,14 @@
 #include "Lib360/TGeometry.h"
 #include "AppEncHelper360/TExt360AppEncCfg.h"
 #include "Utilities/VideoIOYuv.h"
+#if SVIDEO_INPUT_CACHE
+#include "AppEncHelper360/TExt360InputCache.h"
+#endif
+#if SVIDEO_INPUT_PREFETCH
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
 
 class EncAppCfg;
 class TExt360EncGop;
@@ -65,10 +73,33 @@ class TExt360AppEncTop
 #if SVIDEO_WSPSNR_E2E
   TVideoIOYuv                m_cTVideoIOYuvInputFile4E2EWSPSNR;       ///< input YUV file for viewport PSNR calculation;
 #endif
+#endif
+#if SVIDEO_INPUT_PREFETCH
+  Int                       m_iPrefetchDepth;                   ///< number of pictures converted ahead, 0: disabled;
+  VideoIOYuv                m_cPrefetchInputFile;               ///< input YUV file read by the prefetch thread;
+  std::vector<PelStorage*>  m_prefetchPics;                     ///< ring buffer of converted pictures in the coding geometry;
+  std::vector<Bool>         m_prefetchEof;                      ///< the read of the picture hit the end of file;
+  Int                       m_iPrefetchRead;                    ///< number of pictures taken by the encoder;
+  Int                       m_iPrefetchWritten;                 ///< number of pictures converted;
+  Bool                      m_bPrefetchStop;
+  std::thread               m_prefetchThread;
+  std::mutex                m_prefetchMutex;
+  std::condition_variable   m_prefetchCond;
+
+  Void xStartPrefetch(const PelStorage &picYuvTrueOrg);
+  Void xStopPrefetch();
+  Void xPrefetchLoop();
+  Void xGetPrefetchedPicture(VideoIOYuv &inputVideoFile, PelStorage &picYuvTrueOrg);
+#endif
+#if SVIDEO_INPUT_CACHE
+  TExt360InputCache         m_cInputCache;                      ///< converted input pictures shared by the encoder runs;
+
+  Void xOpenInputCache();
 #endif
 
   Void xDestroy();
   Void xCreate(EncGOP &encGop, PelStorage &yuvOrig);
+  Void xReadAndConvert(VideoIOYuv &inputVideoFile, PelStorage &picYuvTrueOrg);
 
 public:
   TExt360AppEncTop(EncAppCfg &cfg, TExt360EncGop &ext360Gop, EncGOP &encGop, PelStorage &yuvOrig);
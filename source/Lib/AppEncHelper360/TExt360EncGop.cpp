@@ -49,11 +49,20 @@ TExt360EncGop::TExt360EncGop()
   m_temporalSubsampleRatio = 1;
   m_pRefGeometry = nullptr;
   m_pRecGeometry = nullptr;
+#if SVIDEO_ORIG_FRAME_CACHE
+  m_iNextCachePOC = 0;
+#endif
 #endif
 }
 
 TExt360EncGop::~TExt360EncGop()
 {
+#if SVIDEO_CONCURRENT_METRICS
+  m_cMetricPool.destroy();
+#endif
+#if SVIDEO_TRACE_VIEWPORT_PSNR
+  m_cTraceViewPortPSNR.printSummary();
+#endif
 #if SVIDEO_E2E_METRICS
   if(m_pRefGeometry)
   {
@@ -65,11 +74,21 @@ TExt360EncGop::~TExt360EncGop()
     delete m_pRecGeometry;
     m_pRecGeometry = nullptr;
   }
+#if SVIDEO_ORIG_FRAME_CACHE
+  for(Int i=0; i<(Int)m_origFrameCache.size(); i++)
+  {
+    m_origFrameCache[i]->destroy();
+    delete m_origFrameCache[i];
+  }
+  m_origFrameCache.clear();
+  m_pcOrgPicYuv = nullptr;
+#else
   if(m_pcOrgPicYuv)
   {
     m_pcOrgPicYuv->destroy();
     delete m_pcOrgPicYuv;
   }
+#endif
   if(m_pcRecPicYuv)
   {
     m_pcRecPicYuv->destroy();
@@ -80,26 +99,59 @@ TExt360EncGop::~TExt360EncGop()
 }
 
 Void TExt360EncGop::calculatePSNRs(Picture *pcPic)
+{
+#if SVIDEO_CONCURRENT_METRICS
+  //the results are stored in the metric calculators and reported by EncGOP right after, so all the tasks are done here;
+  xCalculatePSNRs(pcPic);
+  m_cMetricPool.wait();
+#else
+  xCalculatePSNRs(pcPic);
+#endif
+}
+
+#if SVIDEO_CONCURRENT_METRICS
+Void TExt360EncGop::initMetricPool(Int iNumThreads)
+{
+  m_cMetricPool.create(iNumThreads);
+}
+#endif
+
+Void TExt360EncGop::xRunMetricTask(std::function<Void()> task)
+{
+#if SVIDEO_CONCURRENT_METRICS
+  m_cMetricPool.addTask(task);
+#else
+  task();
+#endif
+}
+
+Void TExt360EncGop::xCalculatePSNRs(Picture *pcPic)
 {
   PelUnitBuf recPicYuv = pcPic->getRecoBuf();
   PelUnitBuf orgPicYuv = pcPic->getOrigBuf();
+#if SVIDEO_SHARED_FRAME_CONTEXT
+  m_cFrameContext.newFrame();
+#endif
 #if SVIDEO_E2E_METRICS
   readOrigPicYuv(pcPic->getPOC());
   reconstructPicYuv(recPicYuv);
 #endif
+  //the metrics below are independent of each other;
 #if SVIDEO_SPSNR_NN
   if(getSPSNRMetric()->getSPSNREnabled())
   {
+    xRunMetricTask([=]() mutable {
 #if SVIDEO_E2E_METRICS
-    getSPSNRMetric()->xCalculateSPSNR(*getOrigPicYuv(), *getRecPicYuv());
+      getSPSNRMetric()->xCalculateSPSNR(*getOrigPicYuv(), *getRecPicYuv());
 #else
-    getSPSNRMetric()->xCalculateSPSNR(orgPicYuv, recPicYuv);
+      getSPSNRMetric()->xCalculateSPSNR(orgPicYuv, recPicYuv);
 #endif
+    });
   }
 #if SVIDEO_CODEC_SPSNR_NN
   if(getCodecSPSNRMetric()->getSPSNREnabled())
   {
-    getCodecSPSNRMetric()->xCalculateSPSNR(orgPicYuv, recPicYuv);
+    xRunMetricTask([=]() mutable { getCodecSPSNRMetric()->xCalculateSPSNR(orgPicYuv, recPicYuv); });
   }
 #endif
 #endif
@@ -109,75 +161,89 @@ Void TExt360EncGop::calculatePSNRs(Picture *pcPic)
 #if SVIDEO_HEMI_PROJECTIONS
     if (!((Int)(m_pRecGeometry->getType()) == SVIDEO_HCMP || (Int)(m_pRecGeometry->getType()) == SVIDEO_HEAC))
 #endif
-    getWSPSNRMetric()->xCalculateWSPSNR(&orgPicYuv, &recPicYuv);
+    xRunMetricTask([=]() mutable { getWSPSNRMetric()->xCalculateWSPSNR(&orgPicYuv, &recPicYuv); });
   }
 #if SVIDEO_WSPSNR_E2E
   if(getE2EWSPSNRMetric()->getWSPSNREnabled())
   {
+    xRunMetricTask([=]() mutable {
 #if SVIDEO_ERP_PADDING
-    getE2EWSPSNRMetric()->setPERPFlag(false);
+      getE2EWSPSNRMetric()->setPERPFlag(false);
 #endif
 
 #if SVIDEO_E2E_METRICS
-    getE2EWSPSNRMetric()->xCalculateE2EWSPSNR(getRecPicYuv(),  getOrigPicYuv());
+      getE2EWSPSNRMetric()->xCalculateE2EWSPSNR(getRecPicYuv(),  getOrigPicYuv());
 #else
-    getE2EWSPSNRMetric()->xCalculateE2EWSPSNR(&recPicYuv, pcPic->getPOC());
+      getE2EWSPSNRMetric()->xCalculateE2EWSPSNR(&recPicYuv, pcPic->getPOC());
 #endif
+    });
   }
 #endif
 #endif
 #if SVIDEO_SPSNR_I
   if(getSPSNRIMetric()->getSPSNRIEnabled())
   {
+    xRunMetricTask([=]() mutable {
 #if SVIDEO_E2E_METRICS
-    getSPSNRIMetric()->xCalculateSPSNRI(getOrigPicYuv(), getRecPicYuv());
+      getSPSNRIMetric()->xCalculateSPSNRI(getOrigPicYuv(), getRecPicYuv());
 #else
-    getSPSNRIMetric()->xCalculateSPSNRI(&orgPicYuv, &recPicYuv);
+      getSPSNRIMetric()->xCalculateSPSNRI(&orgPicYuv, &recPicYuv);
 #endif
+    });
   }
 #endif
 #if SVIDEO_CPPPSNR
   if(getCPPPSNRMetric()->getCPPPSNREnabled())
   {
+    xRunMetricTask([=]() mutable {
 #if SVIDEO_E2E_METRICS
-    getCPPPSNRMetric()->xCalculateCPPPSNR(getOrigPicYuv(), getRecPicYuv());
+      getCPPPSNRMetric()->xCalculateCPPPSNR(getOrigPicYuv(), getRecPicYuv());
 #else
-    getCPPPSNRMetric()->xCalculateCPPPSNR(&orgPicYuv, &recPicYuv);
+      getCPPPSNRMetric()->xCalculateCPPPSNR(&orgPicYuv, &recPicYuv);
 #endif
+    });
   }
 #endif
 #if SVIDEO_VIEWPORT_PSNR
   if(getViewPortPSNRMetric()->isEnabled())
   {
+    xRunMetricTask([=]() {
 #if SVIDEO_E2E_METRICS
-    getViewPortPSNRMetric()->xCalculatePSNR(pcPic, getOrigPicYuv());
+      getViewPortPSNRMetric()->xCalculatePSNR(pcPic, getOrigPicYuv());
 #else
-    getViewPortPSNRMetric()->xCalculatePSNR(pcPic);
+      getViewPortPSNRMetric()->xCalculatePSNR(pcPic);
 #endif
+    });
   }
 #endif
 #if SVIDEO_DYNAMIC_VIEWPORT_PSNR
   if(getDynamicViewPortPSNRMetric()->isEnabled())
   {
-    getDynamicViewPortPSNRMetric()->xCalculateDynamicViewPSNR(pcPic, getOrigPicYuv());
+    xRunMetricTask([=]() { getDynamicViewPortPSNRMetric()->xCalculateDynamicViewPSNR(pcPic, getOrigPicYuv()); });
+  }
+#endif
+#if SVIDEO_TRACE_VIEWPORT_PSNR
+  if(getTraceViewPortPSNRMetric()->isEnabled())
+  {
+    xRunMetricTask([=]() { getTraceViewPortPSNRMetric()->xCalculatePSNR(pcPic, getOrigPicYuv()); });
   }
 #endif
 #if SVIDEO_CF_SPSNR_NN
   if(getCFSPSNRMetric()->getSPSNREnabled())
   { 
-    getCFSPSNRMetric()->xCalculateCFSPSNR(getOrigPicYuv(), &recPicYuv);
+    xRunMetricTask([=]() mutable { getCFSPSNRMetric()->xCalculateCFSPSNR(getOrigPicYuv(), &recPicYuv); });
   }
 #endif
 #if SVIDEO_CF_SPSNR_I
   if(getCFSPSNRIMetric()->getSPSNRIEnabled())
   { 
-    getCFSPSNRIMetric()->xCalculateSPSNRI(getOrigPicYuv(), &recPicYuv);
+    xRunMetricTask([=]() mutable { getCFSPSNRIMetric()->xCalculateSPSNRI(getOrigPicYuv(), &recPicYuv); });
   }
 #endif
 #if SVIDEO_CF_CPPPSNR
   if(getCFCPPPSNRMetric()->getCPPPSNREnabled())
   { 
-    getCFCPPPSNRMetric()->xCalculateCPPPSNR(getOrigPicYuv(), &recPicYuv);
+    xRunMetricTask([=]() mutable { getCFCPPPSNRMetric()->xCalculateCPPPSNR(getOrigPicYuv(), &recPicYuv); });
   }
 #endif
 }
@@ -389,6 +455,12 @@ Void TExt360EncGop::printPerPOCInfo(MsgLevel level, bool printHexPsnr)
     }
   }
 #endif
+#if SVIDEO_TRACE_VIEWPORT_PSNR
+  if (getTraceViewPortPSNRMetric()->isEnabled())
+  {
+    printPsnr(level, printHexPsnr, "PSNR_TRACE_VP", getTraceViewPortPSNRMetric()->getPSNR());
+  }
+#endif
 #if SVIDEO_CF_SPSNR_NN && SVIDEO_CF_SPSNR_NN_REPORT_PER_FRAME
   if (getCFSPSNRMetric()->getSPSNREnabled())
   {
@@ -483,6 +555,12 @@ Void TExt360EncGop::printPerPOCInfo(MsgLevel level)
       msg(level, " [Y-PSNR_DYN_VP%d %6.4lf dB   U-PSNR_DYN_VP%d %6.4lf dB   V-PSNR_DYN_VP%d %6.4lf dB]", i, getDynamicViewPortPSNRMetric()->getPSNR(i)[COMPONENT_Y], i, getDynamicViewPortPSNRMetric()->getPSNR(i)[COMPONENT_Cb], i, getDynamicViewPortPSNRMetric()->getPSNR(i)[COMPONENT_Cr] );
   }
 #endif
+#if SVIDEO_TRACE_VIEWPORT_PSNR
+  if(getTraceViewPortPSNRMetric()->isEnabled())
+  {
+    msg(level, " [Y-PSNR_TRACE_VP %6.4lf dB   U-PSNR_TRACE_VP %6.4lf dB   V-PSNR_TRACE_VP %6.4lf dB   VPs %d]", getTraceViewPortPSNRMetric()->getPSNR()[COMPONENT_Y], getTraceViewPortPSNRMetric()->getPSNR()[COMPONENT_Cb], getTraceViewPortPSNRMetric()->getPSNR()[COMPONENT_Cr], getTraceViewPortPSNRMetric()->getNumDistinctViewPorts() );
+  }
+#endif
 #if SVIDEO_CF_SPSNR_NN && SVIDEO_CF_SPSNR_NN_REPORT_PER_FRAME
   if(getCFSPSNRMetric()->getSPSNREnabled())
   {
@@ -524,6 +602,46 @@ Void TExt360EncGop::initDynamicViewPortPSNR(EncGOP &encGop, Int iNumVPs)
 }
 #endif
 #if SVIDEO_E2E_METRICS
+#if SVIDEO_ORIG_FRAME_CACHE
+/*********************************************************
+//the original pictures are read in display order into a ring buffer;
+//a picture requested in coding order is then read from the file only once;
+**********************************************************/
+Void TExt360EncGop::readOrigPicYuv(Int iPOC)
+{
+  Int iCacheSize = (Int)m_origFrameCache.size();
+  Int iSlot = iPOC % iCacheSize;
+  if(m_origFrameCachePOC[iSlot] != iPOC)
+  {
+    if(iPOC >= m_iNextCachePOC)
+    {
+      //read ahead in display order; the skipped pictures are kept for the following coding order;
+      for(Int iCurPOC = std::max(m_iNextCachePOC, iPOC-iCacheSize+1); iCurPOC <= iPOC; iCurPOC++)
+      {
+        xReadOrigFrame(iCurPOC, m_origFrameCache[iCurPOC % iCacheSize]);
+        m_origFrameCachePOC[iCurPOC % iCacheSize] = iCurPOC;
+      }
+      m_iNextCachePOC = iPOC+1;
+    }
+    else
+    {
+      //already evicted (the cache is smaller than the reordering depth);
+      xReadOrigFrame(iPOC, m_origFrameCache[iSlot]);
+      m_origFrameCachePOC[iSlot] = iPOC;
+    }
+  }
+  m_pcOrgPicYuv = m_origFrameCache[iSlot];
+}
+
+Void TExt360EncGop::xReadOrigFrame(Int iPOC, PelStorage *pcPicYuv)
+{
+  Int iDeltaFrames = iPOC*m_temporalSubsampleRatio - m_iLastFrmPOC;
+  Int aiPad[2]={0,0};
+  m_pcTVideoIOYuvInputFile->skipFrames(iDeltaFrames, m_iInputWidth, m_iInputHeight, m_inputChromaFomat);
+  m_pcTVideoIOYuvInputFile->read(*pcPicYuv, *pcPicYuv, IPCOLOURSPACE_UNCHANGED, aiPad, m_inputChromaFomat, false );
+  m_iLastFrmPOC = iPOC*m_temporalSubsampleRatio+1;
+}
+#else
 Void TExt360EncGop::readOrigPicYuv(Int iPOC)
 {
   Int iDeltaFrames = iPOC*m_temporalSubsampleRatio - m_iLastFrmPOC;
@@ -533,24 +651,34 @@ Void TExt360EncGop::readOrigPicYuv(Int iPOC)
   m_pcTVideoIOYuvInputFile->read(*m_pcOrgPicYuv, *m_pcOrgPicYuv, IPCOLOURSPACE_UNCHANGED, aiPad, m_inputChromaFomat, false );
   m_iLastFrmPOC = iPOC*m_temporalSubsampleRatio+1;
 }
+#endif
 Void TExt360EncGop::reconstructPicYuv(PelUnitBuf& InPicYuv)
 {
   //generate the reconstructed picture in source gemoetry domain;
+#if SVIDEO_SHARED_FRAME_CONTEXT
+  TGeometry *pRecGeometry = m_cFrameContext.getGeometry(m_recVideoInfo, &m_geoParam, &InPicYuv);
+#else
+  TGeometry *pRecGeometry = m_pRecGeometry;
   if((m_pRecGeometry->getType() == SVIDEO_OCTAHEDRON || m_pRecGeometry->getType() == SVIDEO_ICOSAHEDRON) && m_pRecGeometry->getSVideoInfo()->iCompactFPStructure) 
     m_pRecGeometry->compactFramePackConvertYuv(&InPicYuv);
   else
     m_pRecGeometry->convertYuv(&InPicYuv);
+#endif
 #if SVIDEO_ROT_FIX
-  m_pRecGeometry->geoConvert(m_pRefGeometry, true);
+  pRecGeometry->geoConvert(m_pRefGeometry, true);
 #else
-  m_pRecGeometry->geoConvert(m_pRefGeometry);
+  pRecGeometry->geoConvert(m_pRefGeometry);
 #endif
   if((m_pRefGeometry->getType() == SVIDEO_OCTAHEDRON || m_pRefGeometry->getType() == SVIDEO_ICOSAHEDRON) && m_pRefGeometry->getSVideoInfo()->iCompactFPStructure)
     m_pRefGeometry->compactFramePack(m_pcRecPicYuv);
   else
     m_pRefGeometry->framePack(m_pcRecPicYuv);
 }
+#if SVIDEO_ORIG_FRAME_CACHE
+Void TExt360EncGop::initE2EMetricsCalc(SVideoInfo& sRefVideoInfo, SVideoInfo& sRecVideoInfo, InputGeoParam *pInGeoParam, VideoIOYuv& yuvInputFile, ChromaFormat inputChromaFomat, Int iInputWidth, Int iInputHeight, UInt tempSubsampleRatio, Int iOrigCacheSize)
+#else
 Void TExt360EncGop::initE2EMetricsCalc(SVideoInfo& sRefVideoInfo, SVideoInfo& sRecVideoInfo, InputGeoParam *pInGeoParam, VideoIOYuv& yuvInputFile, ChromaFormat inputChromaFomat, Int iInputWidth, Int iInputHeight, UInt tempSubsampleRatio)
+#endif
 {
 #if SVIDEO_HEMI_PROJECTIONS 
   if (sRecVideoInfo.geoType == SVIDEO_HCMP || sRecVideoInfo.geoType == SVIDEO_HEAC )
@@ -559,15 +687,27 @@ Void TExt360EncGop::initE2EMetricsCalc(SVideoInfo& sRefVideoInfo, SVideoInfo& sR
     sRecVideoInfo_.iFaceWidth /= 2;
     m_pRefGeometry = TGeometry::create(sRefVideoInfo, pInGeoParam);
     m_pRecGeometry = TGeometry::create(sRecVideoInfo_, pInGeoParam);
+#if SVIDEO_SHARED_FRAME_CONTEXT
+    m_recVideoInfo = sRecVideoInfo_;
+#endif
   }
   else
   {
     m_pRefGeometry = TGeometry::create(sRefVideoInfo, pInGeoParam);
     m_pRecGeometry = TGeometry::create(sRecVideoInfo, pInGeoParam);
+#if SVIDEO_SHARED_FRAME_CONTEXT
+    m_recVideoInfo = sRecVideoInfo;
+#endif
   }
 #else
     m_pRefGeometry = TGeometry::create(sRefVideoInfo, pInGeoParam);
     m_pRecGeometry = TGeometry::create(sRecVideoInfo, pInGeoParam);
+#if SVIDEO_SHARED_FRAME_CONTEXT
+    m_recVideoInfo = sRecVideoInfo;
+#endif
+#endif
+#if SVIDEO_SHARED_FRAME_CONTEXT
+    m_geoParam = *pInGeoParam;
 #endif
 
     m_pcTVideoIOYuvInputFile = &yuvInputFile;
@@ -576,9 +716,20 @@ Void TExt360EncGop::initE2EMetricsCalc(SVideoInfo& sRefVideoInfo, SVideoInfo& sR
     m_inputChromaFomat = inputChromaFomat;
     m_temporalSubsampleRatio = tempSubsampleRatio;
 
-    m_pcOrgPicYuv = new PelStorage;
     const Area a = Area(Position(), Size(iInputWidth, iInputHeight));
+#if SVIDEO_ORIG_FRAME_CACHE
+    m_origFrameCache.resize(std::max(iOrigCacheSize, 1));
+    m_origFrameCachePOC.resize(m_origFrameCache.size(), -1);
+    for(Int i=0; i<(Int)m_origFrameCache.size(); i++)
+    {
+      m_origFrameCache[i] = new PelStorage;
+      m_origFrameCache[i]->create(m_inputChromaFomat, a, 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+    }
+    m_pcOrgPicYuv = m_origFrameCache[0];
+#else
+    m_pcOrgPicYuv = new PelStorage;
     m_pcOrgPicYuv->create(m_inputChromaFomat, a, 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+#endif
     m_pcRecPicYuv = new PelStorage;
     m_pcRecPicYuv->create(m_inputChromaFomat, a, 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
 }
@@ -56,6 +56,16 @@ class EncGOP;
 #if SVIDEO_VIEWPORT_PSNR
 #include "Lib360/TViewPortPSNR.h"
 #endif
+#if SVIDEO_TRACE_VIEWPORT_PSNR
+#include "Lib360/TTraceViewPortPSNR.h"
+#endif
+#if SVIDEO_SHARED_FRAME_CONTEXT
+#include "Lib360/TSphereFrameContext.h"
+#endif
+#if SVIDEO_CONCURRENT_METRICS
+#include "Lib360/TWorkerPool.h"
+#endif
+#include <functional>
 
 
 class TExt360EncGop
@@ -86,6 +96,19 @@ private:
   UInt         m_temporalSubsampleRatio;
   TGeometry   *m_pRefGeometry;
   TGeometry   *m_pRecGeometry;
+#if SVIDEO_SHARED_FRAME_CONTEXT
+  SVideoInfo    m_recVideoInfo;
+  InputGeoParam m_geoParam;
+#endif
+#if SVIDEO_ORIG_FRAME_CACHE
+  std::vector<PelStorage*> m_origFrameCache;       //ring buffer of the original pictures, slot = POC % size;
+  std::vector<Int>         m_origFrameCachePOC;    //POC held by each slot, -1: empty;
+  Int                      m_iNextCachePOC;        //next POC to be read in display order;
+  Void xReadOrigFrame(Int iPOC, PelStorage *pcPicYuv);
+#endif
+#endif
+#if SVIDEO_SHARED_FRAME_CONTEXT
+  TSphereFrameContext     m_cFrameContext;
 #endif
 #if SVIDEO_SPSNR_NN
   TSPSNRMetric            m_cSPSNRMetric;
@@ -120,6 +143,15 @@ private:
 #if SVIDEO_DYNAMIC_VIEWPORT_PSNR
   TViewPortPSNR           m_cDynamicViewPortPSNR;
 #endif
+#if SVIDEO_TRACE_VIEWPORT_PSNR
+  TTraceViewPortPSNR      m_cTraceViewPortPSNR;
+#endif
+#if SVIDEO_CONCURRENT_METRICS
+  TWorkerPool             m_cMetricPool;
+#endif
+
+  Void xCalculatePSNRs(Picture *pcPic);
+  Void xRunMetricTask(std::function<Void()> task);
 
 public:
 
@@ -128,8 +160,12 @@ public:
   PelStorage* getRecPicYuv() {return m_pcRecPicYuv;};
   Void readOrigPicYuv(Int iPOC);
   Void reconstructPicYuv(PelUnitBuf& InPicYuv);
+#if SVIDEO_ORIG_FRAME_CACHE
+  Void initE2EMetricsCalc(SVideoInfo& sRefVideoInfo, SVideoInfo& sRecVideoInfo, InputGeoParam *pInGeoParam, VideoIOYuv& yuvInputFile, ChromaFormat inputChromaFomat, Int iInputWidth, Int iInputHeight, UInt tempSubsampleRatio, Int iOrigCacheSize);
+#else
   Void initE2EMetricsCalc(SVideoInfo& sRefVideoInfo, SVideoInfo& sRecVideoInfo, InputGeoParam *pInGeoParam, VideoIOYuv& yuvInputFile, ChromaFormat inputChromaFomat, Int iInputWidth, Int iInputHeight, UInt tempSubsampleRatio);  
 #endif
+#endif
 #if SVIDEO_SPSNR_NN
   TSPSNRMetric* getSPSNRMetric()  {return &m_cSPSNRMetric;}
 #if SVIDEO_CODEC_SPSNR_NN
@@ -165,6 +201,15 @@ public:
   TViewPortPSNR* getDynamicViewPortPSNRMetric() { return &m_cDynamicViewPortPSNR; }
   static Void initDynamicViewPortPSNR(EncGOP &encGop, Int iNumVPs);
 #endif
+#if SVIDEO_TRACE_VIEWPORT_PSNR
+  TTraceViewPortPSNR* getTraceViewPortPSNRMetric() { return &m_cTraceViewPortPSNR; }
+#endif
+#if SVIDEO_SHARED_FRAME_CONTEXT
+  TSphereFrameContext* getFrameContext() { return &m_cFrameContext; }
+#endif
+#if SVIDEO_CONCURRENT_METRICS
+  Void initMetricPool(Int iNumThreads);
+#endif
 
 };
 
@@ -0,0 +1,320 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "AppEncHelper360/TExt360InputCache.h"
+#include <cstdio>
+#include <sstream>
+#include <iomanip>
+#include <random>
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+#if SVIDEO_INPUT_CACHE
+static const uint64_t s_uiFNVOffsetBasis = 14695981039346656037ULL;
+static const uint64_t s_uiFNVPrime       = 1099511628211ULL;
+static const TChar    s_cacheVersion[]   = "360Lib-InputCache-1";
+static const Int      s_iFingerprintSize = 1<<20;     //bytes hashed at the beginning and the end of the source file;
+static const Int      s_iTmpFileAttempts = 16;
+
+TExt360InputCache::TExt360InputCache()
+  : m_bReading(false)
+  , m_bWriting(false)
+  , m_iNumPics(0)
+  , m_uiKey(s_uiFNVOffsetBasis)
+{
+}
+
+TExt360InputCache::~TExt360InputCache()
+{
+  close();
+}
+
+Void TExt360InputCache::resetKey()
+{
+  m_uiKey = s_uiFNVOffsetBasis;
+  addKey(s_cacheVersion, sizeof(s_cacheVersion));
+  addKey((Int)sizeof(Pel));
+  //the build modes that change the mapped samples;
+  addKey((Int)sizeof(POSType));
+  addKey((Int)sizeof(FacePel));
+  addKey((Int)SVIDEO_FAST_TRIGONOMETRY);
+}
+
+//FNV-1a;
+Void TExt360InputCache::addKey(const Void *pData, size_t iSize)
+{
+  const UChar *p = (const UChar *)pData;
+  for(size_t i=0; i<iSize; i++)
+  {
+    m_uiKey ^= p[i];
+    m_uiKey *= s_uiFNVPrime;
+  }
+}
+
+//field by field, the padding bytes of the structures are not hashed;
+Void TExt360InputCache::addKey(const SVideoInfo &sVideoInfo)
+{
+  addKey(sVideoInfo.geoType);
+#if SVIDEO_HEMI_PROJECTIONS
+  addKey(sVideoInfo.hemiFlag);
+#endif
+  const SVideoFPStruct &fp = sVideoInfo.framePackStruct;
+  addKey((Int)fp.chromaFormatIDC);
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+  addKey(fp.chromaSampleLocType);
+#endif
+  addKey(fp.rows);
+  addKey(fp.cols);
+  for(Int j=0; j<fp.rows; j++)
+  {
+    for(Int i=0; i<fp.cols; i++)
+    {
+      addKey(fp.faces[j][i].id);
+      addKey(fp.faces[j][i].rot);
+      addKey(fp.faces[j][i].width);
+      addKey(fp.faces[j][i].height);
+    }
+  }
+  for(Int i=0; i<3; i++)
+  {
+    addKey(sVideoInfo.sVideoRotation.degree[i]);
+  }
+  addKey(sVideoInfo.iFaceWidth);
+  addKey(sVideoInfo.iFaceHeight);
+  addKey(sVideoInfo.iNumFaces);
+  addKey(sVideoInfo.viewPort.hFOV);
+  addKey(sVideoInfo.viewPort.vFOV);
+  addKey(sVideoInfo.viewPort.fYaw);
+  addKey(sVideoInfo.viewPort.fPitch);
+  addKey(sVideoInfo.iCompactFPStructure);
+#if SVIDEO_SUB_SPHERE
+  addKey(sVideoInfo.subSphere.iCenterYaw);
+  addKey(sVideoInfo.subSphere.iCenterPitch);
+  addKey(sVideoInfo.subSphere.iYawRange);
+  addKey(sVideoInfo.subSphere.iPitchRange);
+  addKey((Int)sVideoInfo.subSphere.bPresent);
+#endif
+#if SVIDEO_ERP_PADDING
+  addKey((Int)sVideoInfo.bPERP);
+#endif
+#if SVIDEO_HEMI_PROJECTIONS
+  addKey((Int)sVideoInfo.bPCMP);
+#endif
+#if SVIDEO_FISHEYE
+  const FisheyeInfo &fisheye = sVideoInfo.sFisheyeInfo;
+  addKey(fisheye.fCentreAzimuth);
+  addKey(fisheye.fCentreElevation);
+  addKey(fisheye.fCentreTilt);
+  addKey(fisheye.fCircularRegionCentre_x);
+  addKey(fisheye.fCircularRegionCentre_y);
+  addKey(fisheye.fCircularRegionRadius);
+  addKey(fisheye.fFOV);
+  addKey(fisheye.iRectTop);
+  addKey(fisheye.iRectLeft);
+  addKey(fisheye.iRectWidth);
+  addKey(fisheye.iRectHeight);
+#endif
+#if SVIDEO_GENERALIZED_CUBEMAP
+  addKey(sVideoInfo.iGCMPPackingType);
+  addKey(sVideoInfo.iGCMPMappingType);
+  for(Int i=0; i<6; i++)
+  {
+    addKey(sVideoInfo.GCMPSettings.fCoeffU[i]);
+    addKey((Int)sVideoInfo.GCMPSettings.bUAffectedByV[i]);
+    addKey(sVideoInfo.GCMPSettings.fCoeffV[i]);
+    addKey((Int)sVideoInfo.GCMPSettings.bVAffectedByU[i]);
+  }
+  addKey((Int)sVideoInfo.bPGCMP);
+#if SVIDEO_GCMP_PADDING_TYPE
+  addKey(sVideoInfo.iPGCMPPaddingType);
+#endif
+  addKey((Int)sVideoInfo.bPGCMPBoundary);
+  addKey(sVideoInfo.iPGCMPSize);
+#endif
+}
+
+//the size of the file and its first and last bytes;
+Bool TExt360InputCache::addFileFingerprint(const std::string &fileName)
+{
+  std::ifstream cFile(fileName.c_str(), std::ios::in | std::ios::binary);
+  if(!cFile.is_open())
+  {
+    return false;
+  }
+  cFile.seekg(0, std::ios::end);
+  int64_t iFileSize = (int64_t)cFile.tellg();
+  addKey(iFileSize);
+
+  std::vector<TChar> buf(s_iFingerprintSize);
+  Int iSize = (Int)std::min<int64_t>(iFileSize, s_iFingerprintSize);
+  cFile.seekg(0, std::ios::beg);
+  cFile.read(&buf[0], iSize);
+  addKey(&buf[0], iSize);
+  cFile.seekg(iFileSize-iSize, std::ios::beg);
+  cFile.read(&buf[0], iSize);
+  addKey(&buf[0], iSize);
+  return !cFile.fail();
+}
+
+Bool TExt360InputCache::open(const std::string &cacheDir)
+{
+  close();
+  std::ostringstream oss;
+  oss << cacheDir;
+  if(!cacheDir.empty() && cacheDir.back() != '/' && cacheDir.back() != '\\')
+  {
+    oss << '/';
+  }
+  oss << "360input_" << std::hex << std::setw(16) << std::setfill('0') << m_uiKey << ".bin";
+  m_fileName = oss.str();
+  m_iNumPics = 0;
+
+  m_cFile.open(m_fileName.c_str(), std::ios::in | std::ios::binary);
+  if(m_cFile.is_open())
+  {
+    m_bReading = true;
+    return true;
+  }
+  m_cFile.clear();
+  if(xCreateTmpFile())
+  {
+    m_cFile.open(m_tmpFileName.c_str(), std::ios::out | std::ios::binary);
+    if(m_cFile.is_open())
+    {
+      m_bWriting = true;
+      return true;
+    }
+    m_cFile.clear();
+    std::remove(m_tmpFileName.c_str());
+  }
+  return false;
+}
+
+//the temporary file is named after the process id and a random suffix, and created only if it does not exist,
+//so that the encoder runs sharing the cache directory never write to the same file;
+Bool TExt360InputCache::xCreateTmpFile()
+{
+  std::random_device rd;
+  for(Int i=0; i<s_iTmpFileAttempts; i++)
+  {
+    std::ostringstream oss;
+    oss << m_fileName << '.' << std::dec << (Int)getpid() << '.' << std::hex << std::setw(8) << std::setfill('0') << (UInt)rd() << ".tmp";
+    FILE *pFile = std::fopen(oss.str().c_str(), "wbx");
+    if(pFile)
+    {
+      std::fclose(pFile);
+      m_tmpFileName = oss.str();
+      return true;
+    }
+  }
+  return false;
+}
+
+Void TExt360InputCache::close()
+{
+  Bool bComplete = true;
+  if(m_cFile.is_open())
+  {
+    m_cFile.flush();
+    bComplete = !m_cFile.fail();
+    m_cFile.close();
+    bComplete = bComplete && !m_cFile.fail();
+  }
+  m_cFile.clear();
+  if(m_bWriting)
+  {
+    //publish the cache file by a rename, the readers see either no file or a complete one;
+    //another run may have published it in the meantime, then the temporary file is only removed;
+    if(bComplete && m_iNumPics && !std::ifstream(m_fileName.c_str()).is_open())
+    {
+      std::rename(m_tmpFileName.c_str(), m_fileName.c_str());
+    }
+    std::remove(m_tmpFileName.c_str());
+  }
+  m_bReading = false;
+  m_bWriting = false;
+}
+
+Bool TExt360InputCache::xReadPlane(PelBuf &buf)
+{
+  for(Int j=0; j<(Int)buf.height; j++)
+  {
+    m_cFile.read((TChar *)buf.bufAt(0, j), sizeof(Pel)*buf.width);
+  }
+  return !m_cFile.fail();
+}
+
+Void TExt360InputCache::xWritePlane(const PelBuf &buf)
+{
+  for(Int j=0; j<(Int)buf.height; j++)
+  {
+    m_cFile.write((const TChar *)buf.bufAt(0, j), sizeof(Pel)*buf.width);
+  }
+}
+
+//returns false once all the cached pictures are read;
+Bool TExt360InputCache::read(PelStorage &picYuv)
+{
+  if(!m_bReading || m_cFile.fail())
+  {
+    return false;
+  }
+  for(UInt ch=0; ch<getNumberValidComponents(picYuv.chromaFormat); ch++)
+  {
+    if(!xReadPlane(picYuv.get(ComponentID(ch))))
+    {
+      return false;
+    }
+  }
+  m_iNumPics++;
+  return true;
+}
+
+Void TExt360InputCache::write(const PelStorage &picYuv)
+{
+  if(!m_bWriting)
+  {
+    return;
+  }
+  for(UInt ch=0; ch<getNumberValidComponents(picYuv.chromaFormat); ch++)
+  {
+    xWritePlane(picYuv.get(ComponentID(ch)));
+  }
+  m_iNumPics++;
+}
+#endif
@@ -0,0 +1,84 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __TEXT360INPUTCACHE__
+#define __TEXT360INPUTCACHE__
+
+#include "CommonLib/CommonDef.h"
+#include "Lib360/TGeometry.h"
+#include <fstream>
+
+#if SVIDEO_INPUT_CACHE
+/*********************************************************
+//cache of the input pictures converted to the coding geometry, shared by the encoder runs;
+//the cache file is named after a hash of the source file fingerprint and all the parameters used by the conversion;
+//it is written to a temporary file, unique to the encoder run and created exclusively, and only published
+//by an atomic rename once the encoder run is completed and the file is flushed and closed successfully;
+**********************************************************/
+class TExt360InputCache
+{
+private:
+  std::fstream m_cFile;
+  std::string  m_fileName;
+  std::string  m_tmpFileName;
+  Bool         m_bReading;
+  Bool         m_bWriting;
+  Int          m_iNumPics;      //number of pictures read from or written to the cache file;
+  uint64_t     m_uiKey;
+
+  Bool xReadPlane(PelBuf &buf);
+  Void xWritePlane(const PelBuf &buf);
+  Bool xCreateTmpFile();
+
+public:
+  TExt360InputCache();
+  virtual ~TExt360InputCache();
+
+  Void resetKey();
+  Void addKey(const Void *pData, size_t iSize);
+  template<typename T>
+  Void addKey(const T &value) { addKey(&value, sizeof(T)); }
+  Void addKey(const SVideoInfo &sVideoInfo);
+  Bool addFileFingerprint(const std::string &fileName);
+  uint64_t getKey() const { return m_uiKey; }
+
+  Bool open(const std::string &cacheDir);
+  Void close();
+  Bool isReading() const { return m_bReading; }
+  Bool isWriting() const { return m_bWriting; }
+  Bool read(PelStorage &picYuv);
+  Void write(const PelStorage &picYuv);
+  Int  getNumPics() const { return m_iNumPics; }
+};
+#endif
+#endif // __TEXT360INPUTCACHE__
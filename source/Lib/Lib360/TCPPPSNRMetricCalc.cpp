@@ -49,6 +49,9 @@ TCPPPSNRMetric::TCPPPSNRMetric()
   m_pcReferenceGeomtry = nullptr;
   m_pcOutputCPPGeomtry = nullptr;
   m_pcRefCPPGeomtry    = nullptr;
+#if SVIDEO_SHARED_FRAME_CONTEXT
+  m_pcFrameContext     = nullptr;
+#endif
 }
 
 TCPPPSNRMetric::~TCPPPSNRMetric()
@@ -454,6 +457,22 @@ Void TCPPPSNRMetric::xCalculateCPPPSNR( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcP
   TPicYUVOutCPP = new PelStorage;
   TPicYUVOutCPP->create(m_chromaFormatIDC, Area(Position(), Size(m_cppWidth, m_cppHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
 
+  TGeometry *pcReferenceGeomtry = m_pcReferenceGeomtry;
+  TGeometry *pcOutputGeomtry    = m_pcOutputGeomtry;
+#if SVIDEO_SHARED_FRAME_CONTEXT
+  if(m_pcFrameContext)
+  {
+#if SVIDEO_CPP_FIX
+    pcReferenceGeomtry = m_pcFrameContext->getGeometry(m_cppRefVideoInfo, &m_refGeoParam, pcOrgPicYuv);
+    pcOutputGeomtry    = m_pcFrameContext->getGeometry(m_cppCodingVideoInfo, &m_outGeoParam, pcPicD);
+#else
+    pcReferenceGeomtry = m_pcFrameContext->getGeometry(m_cppRefVideoInfo, &m_cppGeoParam, pcOrgPicYuv);
+    pcOutputGeomtry    = m_pcFrameContext->getGeometry(m_cppCodingVideoInfo, &m_cppGeoParam, pcPicD);
+#endif
+  }
+  else
+  {
+#endif
   // Converting Reference to CPP
   if ((m_pcReferenceGeomtry->getSVideoInfo()->geoType == SVIDEO_OCTAHEDRON || m_pcReferenceGeomtry->getSVideoInfo()->geoType == SVIDEO_ICOSAHEDRON) && m_pcReferenceGeomtry->getSVideoInfo()->iCompactFPStructure)
   {
@@ -463,8 +482,6 @@ Void TCPPPSNRMetric::xCalculateCPPPSNR( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcP
   {
     m_pcReferenceGeomtry->convertYuv(pcOrgPicYuv);
   }
-  m_pcReferenceGeomtry->geoConvert(m_pcRefCPPGeomtry);
-  m_pcRefCPPGeomtry->framePack(TPicYUVRefCPP);
 
   // Converting Output to CPP
   if ((m_pcOutputGeomtry->getSVideoInfo()->geoType == SVIDEO_OCTAHEDRON || m_pcOutputGeomtry->getSVideoInfo()->geoType == SVIDEO_ICOSAHEDRON) && m_pcOutputGeomtry->getSVideoInfo()->iCompactFPStructure)
@@ -475,10 +492,16 @@ Void TCPPPSNRMetric::xCalculateCPPPSNR( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcP
   {
     m_pcOutputGeomtry->convertYuv(pcPicD);
   }
+#if SVIDEO_SHARED_FRAME_CONTEXT
+  }
+#endif
+  pcReferenceGeomtry->geoConvert(m_pcRefCPPGeomtry);
+  m_pcRefCPPGeomtry->framePack(TPicYUVRefCPP);
+
 #if SVIDEO_ROT_FIX
-  m_pcOutputGeomtry->geoConvert(m_pcOutputCPPGeomtry, true);
+  pcOutputGeomtry->geoConvert(m_pcOutputCPPGeomtry, true);
 #else
-  m_pcOutputGeomtry->geoConvert(m_pcOutputCPPGeomtry);
+  pcOutputGeomtry->geoConvert(m_pcOutputCPPGeomtry);
 #endif
   m_pcOutputCPPGeomtry->framePack(TPicYUVOutCPP);
 
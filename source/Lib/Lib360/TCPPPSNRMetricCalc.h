@@ -38,6 +38,9 @@
 #ifndef __TCPPPSNRCALC__
 #define __TCPPPSNRCALC__
 #include "TGeometry.h"
+#if SVIDEO_SHARED_FRAME_CONTEXT
+#include "TSphereFrameContext.h"
+#endif
 
 // ====================================================================================================================
 // Class definition
@@ -77,6 +80,9 @@ private:
   TGeometry     *m_pcReferenceGeomtry;
   TGeometry     *m_pcOutputCPPGeomtry;
   TGeometry     *m_pcRefCPPGeomtry;
+#if SVIDEO_SHARED_FRAME_CONTEXT
+  TSphereFrameContext *m_pcFrameContext;   //note: reference;
+#endif
 
 public:
   TCPPPSNRMetric();
@@ -99,6 +105,9 @@ public:
   Void    sphToCart(CPos2D*, CPos3D*);
   Void    xCalculateCPPPSNR( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcPicD );
   Void    initCPPPSNR(InputGeoParam inputGeoParam, Int cppWidth, Int cppHeight, SVideoInfo codingvideoInfo, SVideoInfo referenceVideoInfo);
+#if SVIDEO_SHARED_FRAME_CONTEXT
+  Void    setFrameContext(TSphereFrameContext *pcFrameContext) { m_pcFrameContext = pcFrameContext; }
+#endif
 };
 
 #endif // SVIDEO_CPPPSNR
@@ -186,17 +186,17 @@ Void TCubeMap::map3DTo2D(SPos *pSPosIn, SPos *pSPosOut)
   pSPosOut->y = (POSType)((pv+1.0)*(m_sVideoInfo.iFaceHeight>>1)+ (-0.5));
 }
 
-Void TCubeMap::sPad(Pel *pSrc0, Int iHStep0, Int iStrideSrc0, Pel* pSrc1, Int iHStep1, Int iStrideSrc1, Int iNumSamples, Int hCnt, Int vCnt)
+Void TCubeMap::sPad(FacePel *pSrc0, Int iHStep0, Int iStrideSrc0, FacePel* pSrc1, Int iHStep1, Int iStrideSrc1, Int iNumSamples, Int hCnt, Int vCnt)
 {
-  Pel *pSrc0Start = pSrc0 + iHStep0;
-  Pel *pSrc1Start = pSrc1 - iHStep1;
+  FacePel *pSrc0Start = pSrc0 + iHStep0;
+  FacePel *pSrc1Start = pSrc1 - iHStep1;
 
   for(Int j=0; j<vCnt; j++)
   {
     for(Int i=0; i<hCnt; i++)
     {
-      memcpy(pSrc0Start+i*iHStep0, pSrc1+i*iHStep1, iNumSamples*sizeof(Pel));
-      memcpy(pSrc1Start-i*iHStep1, pSrc0-i*iHStep0, iNumSamples*sizeof(Pel));
+      memcpy(pSrc0Start+i*iHStep0, pSrc1+i*iHStep1, iNumSamples*sizeof(FacePel));
+      memcpy(pSrc1Start-i*iHStep1, pSrc0-i*iHStep0, iNumSamples*sizeof(FacePel));
     }
     pSrc0 += iStrideSrc0;
     pSrc0Start += iStrideSrc0;
@@ -206,15 +206,15 @@ Void TCubeMap::sPad(Pel *pSrc0, Int iHStep0, Int iStrideSrc0, Pel* pSrc1, Int iH
 }
 
 //90 anti clockwise: source -> destination;
-Void TCubeMap::rot90(Pel *pSrcBuf, Int iStrideSrc, Int iWidth, Int iHeight, Int iNumSamples, Pel *pDst, Int iStrideDst)
+Void TCubeMap::rot90(FacePel *pSrcBuf, Int iStrideSrc, Int iWidth, Int iHeight, Int iNumSamples, FacePel *pDst, Int iStrideDst)
 {
-    Pel *pSrcCol = pSrcBuf + (iWidth-1)*iNumSamples;
+    FacePel *pSrcCol = pSrcBuf + (iWidth-1)*iNumSamples;
     for(Int j=0; j<iWidth; j++)
     {
-      Pel *pSrc = pSrcCol;
+      FacePel *pSrc = pSrcCol;
       for(Int i=0; i<iHeight; i++, pSrc+= iStrideSrc)
       {
-        memcpy(pDst+i*iNumSamples,  pSrc, iNumSamples*sizeof(Pel));
+        memcpy(pDst+i*iNumSamples,  pSrc, iNumSamples*sizeof(FacePel));
       }
       pDst += iStrideDst;
       pSrcCol -= iNumSamples;
@@ -222,7 +222,7 @@ Void TCubeMap::rot90(Pel *pSrcBuf, Int iStrideSrc, Int iWidth, Int iHeight, Int
 } 
 
 //corner;
-Void TCubeMap::cPad(Pel *pSrc, Int iWidth, Int iHeight, Int iStrideSrc, Int iNumSamples, Int hCnt, Int vCnt)
+Void TCubeMap::cPad(FacePel *pSrc, Int iWidth, Int iHeight, Int iStrideSrc, Int iNumSamples, Int hCnt, Int vCnt)
 {
   //top-left;
   rot90(pSrc-hCnt*iStrideSrc, iStrideSrc, vCnt, hCnt, iNumSamples, pSrc-vCnt*iStrideSrc-hCnt*iNumSamples, iStrideSrc); 
@@ -261,13 +261,17 @@ Void TCubeMap::convertYuv(PelUnitBuf *pSrcYuv)
       {
         for(Int faceIdx=0; faceIdx<nFaces; faceIdx++)
         {
+#if SVIDEO_VIEWPORT_RENDERER
+          if(!((m_uiConvertFaceMask>>faceIdx)&1))
+            continue;
+#endif
           Int faceX = m_facePos[faceIdx][1]*nWidth;
           Int faceY = m_facePos[faceIdx][0]*nHeight;
           CHECK(faceIdx != m_sVideoInfo.framePackStruct.faces[m_facePos[faceIdx][0]][m_facePos[faceIdx][1]].id, "");
           Int iRot = m_sVideoInfo.framePackStruct.faces[m_facePos[faceIdx][0]][m_facePos[faceIdx][1]].rot;
           Int iStrideSrc = pSrcYuv->get((ComponentID)(ch)).stride;
           Pel *pSrc = pSrcYuv->get((ComponentID)ch).bufAt(0, 0) + faceY*iStrideSrc + faceX;
-          Pel *pDst = m_pFacesOrig[faceIdx][ch];
+          FacePel *pDst = m_pFacesOrig[faceIdx][ch];
           rotFaceChannelGeneral(pSrc, nWidth, nHeight, pSrcYuv->get((ComponentID)ch).stride, 1, iRot, pDst, getStride((ComponentID)ch), 1, true);
         }
         continue;
@@ -279,14 +283,14 @@ Void TCubeMap::convertYuv(PelUnitBuf *pSrcYuv)
         CHECK(m_pFacesBufTempOrig,"");
         m_nMarginSizeBufTemp = std::max(m_filterUps[2].nTaps, m_filterUps[3].nTaps)>>1;;  //depends on the vertical upsampling filter;
         m_nStrideBufTemp = nWidth + (m_nMarginSizeBufTemp<<1);
-        m_pFacesBufTemp = new Pel*[nFaces];
-        memset(m_pFacesBufTemp, 0, sizeof(Pel*)*nFaces);
-        m_pFacesBufTempOrig = new Pel*[nFaces];
-        memset(m_pFacesBufTempOrig, 0, sizeof(Pel*)*nFaces);
+        m_pFacesBufTemp = new FacePel*[nFaces];
+        memset(m_pFacesBufTemp, 0, sizeof(FacePel*)*nFaces);
+        m_pFacesBufTempOrig = new FacePel*[nFaces];
+        memset(m_pFacesBufTempOrig, 0, sizeof(FacePel*)*nFaces);
         Int iTotalHeight = (nHeight +(m_nMarginSizeBufTemp<<1));
         for(Int i=0; i<nFaces; i++)
         {
-          m_pFacesBufTemp[i] = (Pel *)xMalloc(Pel,  m_nStrideBufTemp*iTotalHeight);
+          m_pFacesBufTemp[i] = (FacePel *)xMalloc(FacePel,  m_nStrideBufTemp*iTotalHeight);
           m_pFacesBufTempOrig[i] = m_pFacesBufTemp[i] +  m_nStrideBufTemp * m_nMarginSizeBufTemp + m_nMarginSizeBufTemp;
         }
       }
@@ -300,7 +304,7 @@ Void TCubeMap::convertYuv(PelUnitBuf *pSrcYuv)
 
         Int iStrideSrc = pSrcYuv->get((ComponentID)(ch)).stride;
         Pel *pSrc = pSrcYuv->get((ComponentID)ch).bufAt(0, 0) + faceY*iStrideSrc + faceX;
-        Pel *pDst = m_pFacesBufTempOrig[faceIdx];
+        FacePel *pDst = m_pFacesBufTempOrig[faceIdx];
         rotFaceChannelGeneral(pSrc, nWidth, nHeight, pSrcYuv->get((ComponentID)ch).stride, 1, iRot, pDst, m_nStrideBufTemp, 1, true);
       }
 
@@ -354,6 +358,10 @@ Void TCubeMap::convertYuv(PelUnitBuf *pSrcYuv)
      {
       for(Int faceIdx=0; faceIdx<m_sVideoInfo.iNumFaces; faceIdx++)
       {
+#if SVIDEO_VIEWPORT_RENDERER
+        if(!((m_uiConvertFaceMask>>faceIdx)&1))
+          continue;
+#endif
         Int faceX = m_facePos[faceIdx][1]*nWidth;
         Int faceY = m_facePos[faceIdx][0]*nHeight;
         CHECK(faceIdx != m_sVideoInfo.framePackStruct.faces[m_facePos[faceIdx][0]][m_facePos[faceIdx][1]].id, "");
@@ -363,7 +371,7 @@ Void TCubeMap::convertYuv(PelUnitBuf *pSrcYuv)
         {
           Int iStrideSrc = pSrcYuv->get((ComponentID)(ch)).stride;
           Pel *pSrc = pSrcYuv->get((ComponentID)(ch)).bufAt(0, 0) + faceY*iStrideSrc + faceX;
-          Pel *pDst = m_pFacesOrig[faceIdx][ch];
+          FacePel *pDst = m_pFacesOrig[faceIdx][ch];
           rotFaceChannelGeneral(pSrc, nWidth, nHeight, pSrcYuv->get((ComponentID)ch).stride, 1, iRot, pDst, getStride((ComponentID)ch), 1, true);
         }
       }
@@ -49,9 +49,9 @@ class TCubeMap : public TGeometry
 {
 private:
 
-  Void sPad(Pel *pSrc0, Int iHStep0, Int iStrideSrc0, Pel* pSrc1, Int iHStep1, Int iStrideSrc1, Int iNumSamples, Int hCnt, Int vCnt);
-  Void cPad(Pel *pSrc0, Int iWidth, Int iHeight, Int iStrideSrc0, Int iNumSamples, Int hCnt, Int vCnt);
-  Void rot90(Pel *pSrc, Int iStrideSrc, Int iWidth, Int iHeight, Int iNumSamples, Pel *pDst, Int iStrideDst);
+  Void sPad(FacePel *pSrc0, Int iHStep0, Int iStrideSrc0, FacePel* pSrc1, Int iHStep1, Int iStrideSrc1, Int iNumSamples, Int hCnt, Int vCnt);
+  Void cPad(FacePel *pSrc0, Int iWidth, Int iHeight, Int iStrideSrc0, Int iNumSamples, Int hCnt, Int vCnt);
+  Void rot90(FacePel *pSrc, Int iStrideSrc, Int iWidth, Int iHeight, Int iNumSamples, FacePel *pDst, Int iStrideDst);
   
   //
 public:
@@ -61,6 +61,9 @@ public:
   virtual Void map2DTo3D(SPos& IPosIn, SPos *pSPosOut); 
   virtual Void map3DTo2D(SPos *pSPosIn, SPos *pSPosOut); 
   virtual Void convertYuv(PelUnitBuf *pSrcYuv);
+#if SVIDEO_VIEWPORT_RENDERER
+  virtual Bool isFaceMaskSupported() { return true; }
+#endif
 };
 
 #endif
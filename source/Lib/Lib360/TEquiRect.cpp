@@ -167,7 +167,6 @@ Void TEquiRect::convertYuv(PelUnitBuf *pSrcYuv)
 
       //fill;
       Pel *pSrc = pSrcYuv->get(chId).bufAt(0, 0);
-      Pel *pDst;
 #if SVIDEO_ERP_PADDING
       Int iPadWidth_L = SVIDEO_ERP_PAD_L >> getComponentScaleX(chId);
       if (m_sVideoInfo.bPERP)
@@ -179,7 +178,7 @@ Void TEquiRect::convertYuv(PelUnitBuf *pSrcYuv)
       if(!ch || (m_chromaFormatIDC==CHROMA_420 && !m_bResampleChroma))
 #endif
       {
-        pDst = m_pFacesOrig[0][ch];
+        FacePel *pDst = m_pFacesOrig[0][ch];
 #if SVIDEO_BLENDING
         if (m_sVideoInfo.bPERP)
         {
@@ -187,11 +186,11 @@ Void TEquiRect::convertYuv(PelUnitBuf *pSrcYuv)
 
             Pel *pSrcPadL = pSrcYuv->get(chId).bufAt(0, 0);
             Pel *pSrcPadR = pSrcYuv->get(chId).bufAt(0, 0) + nWidth;
-            Pel *pDstR = pDst + nWidth - iPadWidth_L;
+            FacePel *pDstR = pDst + nWidth - iPadWidth_L;
 
             for (Int j = 0; j<nHeight; j++)
             {
-                memcpy(pDst, pSrc, nWidth*sizeof(Pel));
+                copySamples(pDst, pSrc, nWidth);
 
                 for (Int i = 0; i < iPadWidth_L; i ++)
                     pDstR[i] = ((i * pSrcPadL[i] + (iPadWidth - i) * pSrcPadR[i]) + (iPadWidth >> 1)) / iPadWidth;
@@ -211,7 +210,7 @@ Void TEquiRect::convertYuv(PelUnitBuf *pSrcYuv)
         {
           for(Int j=0; j<nHeight; j++)
           {
-            memcpy(pDst, pSrc, nWidth*sizeof(Pel));
+            copySamples(pDst, pSrc, nWidth);
             pDst +=  getStride(chId);
             pSrc += pSrcYuv->get(chId).stride;
           }
@@ -226,7 +225,7 @@ Void TEquiRect::convertYuv(PelUnitBuf *pSrcYuv)
       if (m_sVideoInfo.bPERP)
           pSrc += iPadWidth_L;
 #endif
-      pDst = pSrc + nWidth;
+      Pel *pDst = pSrc + nWidth;
       for(Int i=0; i<nHeight; i++)
       {
         sPadH(pSrc, pDst, nMarginSizeTmpBuf);
@@ -286,10 +285,10 @@ Void TEquiRect::convertYuv(PelUnitBuf *pSrcYuv)
         if (m_sVideoInfo.bPERP)
             pSrc += iPadWidth_L;
 #endif
-        Pel *pDst = m_pFacesOrig[0][ch];
+        FacePel *pDst = m_pFacesOrig[0][ch];
         for(Int j=0; j<nHeight; j++)
         {
-          memcpy(pDst, pSrc, nWidth*sizeof(Pel));
+          copySamples(pDst, pSrc, nWidth);
           pDst +=  getStride(chId);
           pSrc += pSrcYuv->get(chId).stride;
         }
@@ -305,7 +304,8 @@ Void TEquiRect::convertYuv(PelUnitBuf *pSrcYuv)
   setPaddingFlag(false);
 }
 
-Void TEquiRect::sPadH(Pel *pSrc, Pel *pDst, Int iCount)
+template<typename T>
+Void TEquiRect::sPadH(T *pSrc, T *pDst, Int iCount)
 {
   for(Int i=1; i<=iCount; i++)
   {
@@ -314,7 +314,8 @@ Void TEquiRect::sPadH(Pel *pSrc, Pel *pDst, Int iCount)
   }
 }
 
-Void TEquiRect::sPadV(Pel *pSrc, Pel *pDst, Int iStride, Int iCount)
+template<typename T>
+Void TEquiRect::sPadV(T *pSrc, T *pDst, Int iStride, Int iCount)
 {
   for(Int i=1; i<=iCount; i++)
   {
@@ -347,8 +348,8 @@ Void TEquiRect::spherePadding(Bool bEnforced)
     Int nMarginY = m_iMarginY >> getComponentScaleY(chId);
 
     //left and right;
-    Pel *pSrc = m_pFacesOrig[0][ch];
-    Pel *pDst = pSrc + nWidth;
+    FacePel *pSrc = m_pFacesOrig[0][ch];
+    FacePel *pDst = pSrc + nWidth;
     for(Int i=0; i<nHeight; i++)
     {
       sPadH(pSrc, pDst, nMarginX);
@@ -385,6 +386,33 @@ Void TEquiRect::spherePadding(Bool bEnforced)
 
 }
 
+#if SVIDEO_VIEWPORT_DEPENDENCY_MAP
+//the margins are wrapped horizontally, and mirrored at the poles with a shift of half the width;
+Bool TEquiRect::getPaddingCopySource(Int fIdx, Int x, Int y, ComponentID chId, Int &fIdxSrc, Int &xSrc, Int &ySrc)
+{
+  Int nWidth  = m_sVideoInfo.iFaceWidth >> getComponentScaleX(chId);
+  Int nHeight = m_sVideoInfo.iFaceHeight >> getComponentScaleY(chId);
+  if(x >= 0 && x < nWidth && y >= 0 && y < nHeight)
+  {
+    return false;
+  }
+  if(y < 0)
+  {
+    y  = -1 - y;
+    x += (nWidth >> 1);
+  }
+  else if(y >= nHeight)
+  {
+    y  = (nHeight << 1) - 1 - y;
+    x += (nWidth >> 1);
+  }
+  fIdxSrc = fIdx;
+  xSrc    = ((x % nWidth) + nWidth) % nWidth;
+  ySrc    = y;
+  return true;
+}
+#endif
+
 Void TEquiRect::framePack(PelUnitBuf *pDstYuv)
 {
   if(pDstYuv->chromaFormat==CHROMA_420)
@@ -413,13 +441,17 @@ Void TEquiRect::framePack(PelUnitBuf *pDstYuv)
       }
       if(!m_pDS420Buf)
       {
-        m_pDS420Buf = (Pel*)xMalloc(Pel, nHeightC*iStride420);
+        m_pDS420Buf = (FacePel*)xMalloc(FacePel, nHeightC*iStride420);
       }
       //1: 444->422;
       for(Int ch=1; ch<getNumChannels(); ch++)
       {
+#if SVIDEO_FUSED_CHROMA_RESAMPLING
+        chromaDonwsampleHV(m_pFacesOrig[0][ch], m_sVideoInfo.iFaceWidth, m_sVideoInfo.iFaceHeight, getStride((ComponentID)ch), m_pDS422Buf, iStride422, m_pDS420Buf, iStride420);
+#else
         chromaDonwsampleH(m_pFacesOrig[0][ch]-nMarginSize*getStride((ComponentID)ch), m_sVideoInfo.iFaceWidth, nHeightC422, getStride((ComponentID)ch), 1, m_pDS422Buf, iStride422);
         chromaDonwsampleV(m_pDS422Buf + nMarginSize*iStride422, nWidthC, m_sVideoInfo.iFaceHeight, iStride422, 1, m_pDS420Buf, iStride420);
+#endif
         rotOneFaceChannel(m_pDS420Buf, nWidthC, nHeightC, iStride420, 1, ch, m_sVideoInfo.framePackStruct.faces[0][0].rot, pDstYuv, 0, 0, 0, 0);
       }
       //luma;
@@ -435,7 +467,7 @@ Void TEquiRect::framePack(PelUnitBuf *pDstYuv)
       //chroma resample
       if(!m_pDS420Buf && (m_chromaFormatIDC == CHROMA_420 && m_bResampleChroma))
       {
-        m_pDS420Buf = (Pel*)xMalloc(Pel, nHeightC*nWidthC);
+        m_pDS420Buf = (FacePel*)xMalloc(FacePel, nHeightC*nWidthC);
       }
 #endif
       for(Int ch=1; ch<getNumChannels(); ch++)
@@ -51,8 +51,8 @@ class TEquiRect : public TGeometry
 private:
 
 private:
-  Void sPadH(Pel *pSrc, Pel *pDst, Int iCount);
-  Void sPadV(Pel *pSrc, Pel *pDst, Int iStride, Int iCount); 
+  template<typename T> Void sPadH(T *pSrc, T *pDst, Int iCount);
+  template<typename T> Void sPadV(T *pSrc, T *pDst, Int iStride, Int iCount); 
 
 public:
   TEquiRect(SVideoInfo& sVideoInfo, InputGeoParam *pInGeoParam);
@@ -65,6 +65,13 @@ public:
   virtual Void convertYuv(PelUnitBuf *pSrcYuv);
   virtual Void framePack(PelUnitBuf *pDstYuv);
   virtual Void spherePadding(Bool bEnforced=false);
+#if SVIDEO_DEMAND_SPHERE_PADDING
+  virtual Bool isDemandPaddingSupported() { return false; }
+#endif
+#if SVIDEO_VIEWPORT_DEPENDENCY_MAP
+  virtual Bool isPaddingTableUsed() { return false; }
+  virtual Bool getPaddingCopySource(Int fIdx, Int x, Int y, ComponentID chId, Int &fIdxSrc, Int &xSrc, Int &ySrc);
+#endif
 #if SVIDEO_ERP_PADDING
   virtual Void geoToFramePack(IPos* posIn, IPos2D* posOut);
 #endif
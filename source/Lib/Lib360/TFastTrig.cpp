@@ -0,0 +1,69 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TFastTrig.cpp
+    \brief    Polynomial approximations of the trigonometric functions used by the geometry mappings
+*/
+
+#include "TGeometry.h"
+#include <algorithm>
+
+#if SVIDEO_FAST_TRIGONOMETRY
+
+/***************************************************
+//report the maximum errors of the approximations; the mapping tables are compared with the ones of an exact build
+//by the mapping check files (SVIDEO_MAPPING_ACCURACY_CHECK);
+****************************************************/
+Void TFastTrig::validate()
+{
+  Int    iNumSteps = 1 << 20;
+  Double dErr[7]   = { 0, 0, 0, 0, 0, 0, 0 };
+  for (Int k = 0; k <= iNumSteps; k++)
+  {
+    Double t = (Double) k / iNumSteps;
+    Double a = (2 * t - 1) * 4 * S_PI;               //[-4pi, 4pi];
+    Double b = (2 * t - 1) * (S_PI_2 - 1e-3);        //tan() over (-pi/2, pi/2);
+    Double x = 2 * t - 1;                            //[-1, 1];
+    dErr[0]  = std::max(dErr[0], fabs(fastSin(a) - sin(a)));
+    dErr[1]  = std::max(dErr[1], fabs(fastCos(a) - cos(a)));
+    dErr[2]  = std::max(dErr[2], fabs(fastTan(b) - tan(b)) / (1 + tan(b) * tan(b)));   //error of the angle;
+    dErr[3]  = std::max(dErr[3], fabs(fastAtan2(sin(a), cos(a)) - atan2(sin(a), cos(a))));
+    dErr[4]  = std::max(dErr[4], fabs(fastAtan(tan(b)) - atan(tan(b))));
+    dErr[5]  = std::max(dErr[5], fabs(fastAsin(x) - asin(x)));
+    dErr[6]  = std::max(dErr[6], fabs(fastAcos(x) - acos(x)));
+  }
+  printf("Fast trigonometry, maximum absolute error: sin %.3e, cos %.3e, tan %.3e, atan2 %.3e, atan %.3e, asin %.3e, acos %.3e\n",
+         dErr[0], dErr[1], dErr[2], dErr[3], dErr[4], dErr[5], dErr[6]);
+}
+#endif
@@ -8,11 +8,148 @@ TFisheye::TFisheye(SVideoInfo& sVideoInfo, InputGeoParam *pInGeoParam) : TGeomet
   CHECK(!bGeoTypeChecking, "error in projection format");
   geoInit(sVideoInfo, pInGeoParam);
   m_FisheyeInfo = sVideoInfo.sFisheyeInfo;
+#if SVIDEO_FISHEYE_PRECOMPUTATION
+  m_pCircularRegionSpan = nullptr;
+  xInitPrecomputation();
+#endif
 }
 
 TFisheye::~TFisheye()
 {
+#if SVIDEO_FISHEYE_PRECOMPUTATION
+  delete[] m_pCircularRegionSpan;
+  m_pCircularRegionSpan = nullptr;
+#endif
+}
+
+#if SVIDEO_FISHEYE_PRECOMPUTATION
+/***************************************************
+//the constants of the mapping are derived with the same expressions as rotate3D(), invRotate3D() and geoConvert() use,
+//so the results are not changed;
+****************************************************/
+Void TFisheye::xInitPrecomputation()
+{
+  m_dFOVrad = m_FisheyeInfo.fFOV / SVIDEO_ROT_PRECISION * S_PI / 180.0;
+
+#if SVIDEO_ROT_FIX
+  Int iTilt      = (Int)round(m_FisheyeInfo.fCentreTilt);
+  Int iElevation = (Int)round(m_FisheyeInfo.fCentreElevation);
+  Int iAzimuth   = (Int)round(m_FisheyeInfo.fCentreAzimuth);
+  //rotate3D(iTilt, iElevation, iAzimuth) and invRotate3D(-iTilt, -iElevation, -iAzimuth);
+  Int iAngle[2][3] = { { iTilt, -iElevation, iAzimuth }, { -iTilt, iElevation, -iAzimuth } };
+  for(Int k=0; k<3; k++)
+  {
+    m_bRotation[k] = (iAngle[0][k] != 0);
+    for(Int i=0; i<2; i++)
+    {
+      m_rotCos[i][k] = scos((POSType)(iAngle[i][k] * S_PI / (180.0 * SVIDEO_ROT_PRECISION)));
+      m_rotSin[i][k] = ssin((POSType)(iAngle[i][k] * S_PI / (180.0 * SVIDEO_ROT_PRECISION)));
+    }
+  }
+#endif
+
+  //the samples inside the circular region form one run in each row;
+  Int iWidth  = m_sVideoInfo.iFaceWidth + (m_iMarginX<<1);
+  Int iHeight = m_sVideoInfo.iFaceHeight + (m_iMarginY<<1);
+  Double cnt_x = m_FisheyeInfo.fCircularRegionCentre_x;
+  Double cnt_y = m_FisheyeInfo.fCircularRegionCentre_y;
+  m_pCircularRegionSpan = new Int[iHeight<<1];
+  for(Int j=0; j<iHeight; j++)
+  {
+    Int yy = j - m_iMarginY;
+    Int *pSpan = m_pCircularRegionSpan + (j<<1);
+    pSpan[0] = 0;
+    pSpan[1] = -1;
+    Bool bFound = false;
+    for(Int i=0; i<iWidth; i++)
+    {
+      Int    xx   = i - m_iMarginX;
+      Double dist = ssqrt((xx + 0.5 - cnt_x) * (xx + 0.5 - cnt_x) + (yy + 0.5 - cnt_y) * (yy + 0.5 - cnt_y));
+      if(dist < (Double)(m_FisheyeInfo.fCircularRegionRadius) - 0.5)
+      {
+        if(!bFound)
+          pSpan[0] = xx;
+        pSpan[1] = xx;
+        bFound = true;
+      }
+    }
+  }
+}
+
+//the rotations of rotate3D() and invRotate3D() with the precomputed sines and cosines; without SVIDEO_ROT_FIX those of rotate3D();
+Void TFisheye::xRotate(SPos& sPos)
+{
+#if SVIDEO_ROT_FIX
+  POSType x = sPos.x;
+  POSType y = sPos.y;
+  POSType z = sPos.z;
+  if(m_bRotation[0])
+  {
+    POSType t1 = m_rotCos[0][0] * y - m_rotSin[0][0] * z;
+    POSType t2 = m_rotSin[0][0] * y + m_rotCos[0][0] * z;
+    y = t1;
+    z = t2;
+  }
+  if(m_bRotation[1])
+  {
+    POSType t1 = m_rotCos[0][1] * x - m_rotSin[0][1] * y;
+    POSType t2 = m_rotSin[0][1] * x + m_rotCos[0][1] * y;
+    x = t1;
+    y = t2;
+  }
+  if(m_bRotation[2])
+  {
+    POSType t1 = m_rotCos[0][2] * x + m_rotSin[0][2] * z;
+    POSType t2 = -m_rotSin[0][2] * x + m_rotCos[0][2] * z;
+    x = t1;
+    z = t2;
+  }
+  sPos.x = x;
+  sPos.y = y;
+  sPos.z = z;
+#else
+  rotate3D(sPos, (Int)round(m_FisheyeInfo.fCentreTilt), (Int)round(m_FisheyeInfo.fCentreElevation), (Int)round(m_FisheyeInfo.fCentreAzimuth));
+#endif
+}
+
+Void TFisheye::xInvRotate(SPos& sPos)
+{
+#if SVIDEO_ROT_FIX
+  POSType x = sPos.x;
+  POSType y = sPos.y;
+  POSType z = sPos.z;
+  if(m_bRotation[2])
+  {
+    POSType t1 = m_rotCos[1][2] * x + m_rotSin[1][2] * z;
+    POSType t2 = -m_rotSin[1][2] * x + m_rotCos[1][2] * z;
+    x = t1;
+    z = t2;
+  }
+  if(m_bRotation[1])
+  {
+    POSType t1 = m_rotCos[1][1] * x - m_rotSin[1][1] * y;
+    POSType t2 = m_rotSin[1][1] * x + m_rotCos[1][1] * y;
+    x = t1;
+    y = t2;
+  }
+  if(m_bRotation[0])
+  {
+    POSType t1 = m_rotCos[1][0] * y - m_rotSin[1][0] * z;
+    POSType t2 = m_rotSin[1][0] * y + m_rotCos[1][0] * z;
+    y = t1;
+    z = t2;
+  }
+  sPos.x = x;
+  sPos.y = y;
+  sPos.z = z;
+#else
+  //there is no invRotate3D() for the rotation of rotate3D(), its axes are undone in the reverse order;
+  rotate3D(sPos, 0, 0, -1 * (Int)round(m_FisheyeInfo.fCentreAzimuth));
+  rotate3D(sPos, 0, -1 * (Int)round(m_FisheyeInfo.fCentreElevation), 0);
+  rotate3D(sPos, -1 * (Int)round(m_FisheyeInfo.fCentreTilt), 0, 0);
+#endif
 }
+#endif
 
 
 Void TFisheye::map2DTo3D(SPos& IPosIn, SPos *pSPosOut)
@@ -21,17 +158,31 @@ Void TFisheye::map2DTo3D(SPos& IPosIn, SPos *pSPosOut)
   cx = ((IPosIn.x) - m_FisheyeInfo.fCircularRegionCentre_x) / (m_FisheyeInfo.fCircularRegionRadius);
   cy = (m_FisheyeInfo.fCircularRegionCentre_y - (IPosIn.y)) / (m_FisheyeInfo.fCircularRegionRadius);
 
+#if SVIDEO_FISHEYE_PRECOMPUTATION
+  Double r_dist = ssqrt(cx*cx + cy*cy);
+
+  Double phi = r_dist * m_dFOVrad / 2;
+  Double theta = satan2(cy, cx);
+  Double sinPhi = ssin(phi);
+
+  pSPosOut->x = (POSType)(scos(phi));
+  pSPosOut->y = (POSType)(sinPhi*ssin(theta));
+  pSPosOut->z = -(POSType)(sinPhi*scos(theta));
+
+  xRotate(*pSPosOut);
+#else
   Double FOVrad = m_FisheyeInfo.fFOV / SVIDEO_ROT_PRECISION *  S_PI / 180.0;
   Double r_dist = ssqrt(cx*cx + cy*cy);
 
   Double phi = r_dist * FOVrad / 2;
-  Double theta = atan2(cy, cx);
+  Double theta = satan2(cy, cx);
   
   pSPosOut->x = (POSType)(scos(phi));
   pSPosOut->y = (POSType)(ssin(phi)*ssin(theta));
   pSPosOut->z = -(POSType)(ssin(phi)*scos(theta));
 
   rotate3D(*pSPosOut, (Int)round(m_FisheyeInfo.fCentreTilt), (Int)round(m_FisheyeInfo.fCentreElevation), (Int)round(m_FisheyeInfo.fCentreAzimuth));  
+#endif
 }
 
 Void TFisheye::map3DTo2D(SPos *pSPosIn, SPos *pSPosOut)
@@ -45,8 +196,13 @@ Void TFisheye::map3DTo2D(SPos *pSPosIn, SPos *pSPosOut)
   pSPosOut->y = 0;
   pSPosOut->z = 0;
 
+#if SVIDEO_FISHEYE_PRECOMPUTATION
+  xInvRotate(sPos);
+  Double FOVrad = m_dFOVrad;
+#else
   invRotate3D(sPos, -1 * (Int)round(m_FisheyeInfo.fCentreTilt), -1 * (Int)round(m_FisheyeInfo.fCentreElevation), -1 * (Int)round(m_FisheyeInfo.fCentreAzimuth));
   Double FOVrad = m_FisheyeInfo.fFOV / SVIDEO_ROT_PRECISION * S_PI / 180.0;
+#endif
   Double theta = satan2(sPos.y, -sPos.z);
   Double r_dist = 2.0 * satan2(ssqrt(sPos.y*sPos.y + sPos.z*sPos.z), sPos.x) / FOVrad;
 
@@ -80,18 +236,17 @@ Void TFisheye::convertYuv(PelUnitBuf *pSrcYuv)
 
       //fill;
       Pel *pSrc = pSrcYuv->get(chId).bufAt(0, 0);
-      Pel *pDst;
 #if SVIDEO_CHROMA_TYPES_SUPPORT
       if (!ch || (m_chromaFormatIDC == CHROMA_420))
 #else
       if (!ch || (m_chromaFormatIDC == CHROMA_420 && !m_bResampleChroma))
 #endif    
       {
-        pDst = m_pFacesOrig[0][ch];
+        FacePel *pDst = m_pFacesOrig[0][ch];
         {
           for (Int j = 0; j<nHeight; j++)
           {
-            memcpy(pDst, pSrc, nWidth * sizeof(Pel));
+            copySamples(pDst, pSrc, nWidth);
             pDst += getStride(chId);
             pSrc += pSrcYuv->get(chId).stride + m_FisheyeInfo.iRectLeft;
           }
@@ -101,7 +256,7 @@ Void TFisheye::convertYuv(PelUnitBuf *pSrcYuv)
       //padding;
       //left and right; 
       pSrc = pSrcYuv->get(chId).bufAt(0, 0);
-      pDst = pSrc + nWidth;
+      Pel *pDst = pSrc + nWidth;
       for (Int i = 0; i<nHeight; i++)
       {
         sPadH(pSrc, pDst, nMarginSizeTmpBuf);
@@ -148,10 +303,10 @@ Void TFisheye::convertYuv(PelUnitBuf *pSrcYuv)
       {
         ComponentID chId = ComponentID(ch);
         Pel *pSrc = pSrcYuv->get(chId).bufAt(0, 0) + (m_FisheyeInfo.iRectTop * pSrcYuv->get(chId).stride + m_FisheyeInfo.iRectLeft);
-        Pel *pDst = m_pFacesOrig[0][ch];
+        FacePel *pDst = m_pFacesOrig[0][ch];
         for (Int j = 0; j<nHeight; j++)
         {
-          memcpy(pDst, pSrc, nWidth * sizeof(Pel));
+          copySamples(pDst, pSrc, nWidth);
           pDst += getStride(chId);
           pSrc += pSrcYuv->get(chId).stride + m_FisheyeInfo.iRectLeft;
         }
@@ -168,7 +323,8 @@ Void TFisheye::convertYuv(PelUnitBuf *pSrcYuv)
 }
 
 
-Void TFisheye::sPadH(Pel *pSrc, Pel *pDst, Int iCount)
+template<typename T>
+Void TFisheye::sPadH(T *pSrc, T *pDst, Int iCount)
 {
   for (Int i = 1; i <= iCount; i++)
   {
@@ -177,7 +333,8 @@ Void TFisheye::sPadH(Pel *pSrc, Pel *pDst, Int iCount)
   }
 }
 
-Void TFisheye::sPadV(Pel *pSrc, Pel *pDst, Int iStride, Int iCount)
+template<typename T>
+Void TFisheye::sPadV(T *pSrc, T *pDst, Int iStride, Int iCount)
 {
   for (Int i = 1; i <= iCount; i++)
   {
@@ -210,8 +367,8 @@ Void TFisheye::spherePadding(Bool bEnforced)
     Int nMarginY = m_iMarginY >> getComponentScaleY(chId);
 
     //left and right;
-    Pel *pSrc = m_pFacesOrig[0][ch];
-    Pel *pDst = pSrc + nWidth;
+    FacePel *pSrc = m_pFacesOrig[0][ch];
+    FacePel *pDst = pSrc + nWidth;
     for (Int i = 0; i < nHeight; i++)
     {
       sPadH(pSrc, pDst, nMarginX);
@@ -245,4 +402,31 @@ Void TFisheye::spherePadding(Bool bEnforced)
   dumpAllFacesToFile("equirect_after_padding", true, !bFirstDumpAfterPading);
   bFirstDumpAfterPading = false;
 #endif
-}
\ No newline at end of file
+}
+
+#if SVIDEO_VIEWPORT_DEPENDENCY_MAP
+//the margins are wrapped horizontally, and mirrored at the poles with a shift of half the width;
+Bool TFisheye::getPaddingCopySource(Int fIdx, Int x, Int y, ComponentID chId, Int &fIdxSrc, Int &xSrc, Int &ySrc)
+{
+  Int nWidth  = m_sVideoInfo.iFaceWidth >> getComponentScaleX(chId);
+  Int nHeight = m_sVideoInfo.iFaceHeight >> getComponentScaleY(chId);
+  if(x >= 0 && x < nWidth && y >= 0 && y < nHeight)
+  {
+    return false;
+  }
+  if(y < 0)
+  {
+    y  = -1 - y;
+    x += (nWidth >> 1);
+  }
+  else if(y >= nHeight)
+  {
+    y  = (nHeight << 1) - 1 - y;
+    x += (nWidth >> 1);
+  }
+  fIdxSrc = fIdx;
+  xSrc    = ((x % nWidth) + nWidth) % nWidth;
+  ySrc    = y;
+  return true;
+}
+#endif
\ No newline at end of file
@@ -9,9 +9,22 @@ class TFisheye : public TGeometry
 private:
 
 private:
-  Void sPadH(Pel *pSrc, Pel *pDst, Int iCount);
-  Void sPadV(Pel *pSrc, Pel *pDst, Int iStride, Int iCount);
+  template<typename T> Void sPadH(T *pSrc, T *pDst, Int iCount);
+  template<typename T> Void sPadV(T *pSrc, T *pDst, Int iStride, Int iCount);
   FisheyeInfo m_FisheyeInfo;
+#if SVIDEO_FISHEYE_PRECOMPUTATION
+  Double   m_dFOVrad;
+#if SVIDEO_ROT_FIX
+  Bool     m_bRotation[3];                //[roll, pitch, yaw]; the centre tilt, elevation and azimuth are not 0;
+  POSType  m_rotCos[2][3];                //[0: rotate3D(); 1: invRotate3D()][roll, pitch, yaw];
+  POSType  m_rotSin[2][3];
+#endif
+  Int     *m_pCircularRegionSpan;         //[2*(y+marginY)]: first and last luma column inside the circular region, margins included;
+
+  Void xInitPrecomputation();
+  Void xRotate(SPos& sPos);
+  Void xInvRotate(SPos& sPos);
+#endif
 
 public:
   TFisheye(SVideoInfo& sVideoInfo, InputGeoParam *pInGeoParam);
@@ -23,6 +36,17 @@ public:
   //own methods;
   virtual Void convertYuv(PelUnitBuf *pSrcYuv);
   virtual Void spherePadding(Bool bEnforced = false);
+#if SVIDEO_DEMAND_SPHERE_PADDING
+  virtual Bool isDemandPaddingSupported() { return false; }
+#endif
+#if SVIDEO_VIEWPORT_DEPENDENCY_MAP
+  virtual Bool isPaddingTableUsed() { return false; }
+  virtual Bool getPaddingCopySource(Int fIdx, Int x, Int y, ComponentID chId, Int &fIdxSrc, Int &xSrc, Int &ySrc);
+#endif
+#if SVIDEO_FISHEYE_PRECOMPUTATION
+  //same test as geoConvert() does on the distance to the centre, for the luma position (x, y) of the face including the margins;
+  Bool insideCircularRegion(Int x, Int y) { const Int *pSpan = m_pCircularRegionSpan + ((y + m_iMarginY)<<1); return (x >= pSpan[0] && x <= pSpan[1]); }
+#endif
 };
 #endif
 #endif // __TFISHEYE__
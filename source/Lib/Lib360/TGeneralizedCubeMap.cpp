@@ -438,19 +438,19 @@ Void TGeneralizedCubeMap::framePack(PelUnitBuf *pDstYuv)
       if (!m_pDS420FacesBuf)
       {
         Int nChroma      = getNumChannels() - 1;
-        m_pDS420FacesBuf = new Pel **[iTotalNumOfFaces];
+        m_pDS420FacesBuf = new FacePel **[iTotalNumOfFaces];
         for (Int i = 0; i < iTotalNumOfFaces; i++)
         {
-          m_pDS420FacesBuf[i] = new Pel *[nChroma];
-          memset(m_pDS420FacesBuf[i], 0, sizeof(Pel *) * (nChroma));
+          m_pDS420FacesBuf[i] = new FacePel *[nChroma];
+          memset(m_pDS420FacesBuf[i], 0, sizeof(FacePel *) * (nChroma));
           for (Int j = 0; j < nChroma; j++)
-            m_pDS420FacesBuf[i][j] = (Pel *) xMalloc(Pel, nHeightC420 * iStride420);
+            m_pDS420FacesBuf[i][j] = (FacePel *) xMalloc(FacePel, nHeightC420 * iStride420);
         }
       }
       if (!m_pDS422Buf)
         m_pDS422Buf = (Pel *) xMalloc(Pel, nHeightC422 * iStride422);
       if (!m_pDS420Buf)
-        m_pDS420Buf = (Pel *) xMalloc(Pel, nHeightC420 * iStride420);
+        m_pDS420Buf = (FacePel *) xMalloc(FacePel, nHeightC420 * iStride420);
 
       for (Int face = 0; face < iTotalNumOfFaces; face++)
       {
@@ -477,12 +477,16 @@ Void TGeneralizedCubeMap::framePack(PelUnitBuf *pDstYuv)
             }
             else
             {
+#if SVIDEO_FUSED_CHROMA_RESAMPLING
+              chromaDonwsampleHV(m_pFacesOrig[face][ch], m_sVideoInfo.iFaceWidth, m_sVideoInfo.iFaceHeight, getStride(chId), m_pDS422Buf, iStride422, m_pDS420Buf, iStride420);
+#else
               chromaDonwsampleH(m_pFacesOrig[face][ch] - nMarginSize * getStride((ComponentID) ch),
                                 m_sVideoInfo.iFaceWidth, nHeightC422, getStride(chId), 1, m_pDS422Buf, iStride422);
               chromaDonwsampleV(m_pDS422Buf + nMarginSize * iStride422, nWidthC, m_sVideoInfo.iFaceHeight, iStride422,
                                 1, m_pDS420Buf, iStride420);
+#endif
             }
-            memcpy(m_pDS420FacesBuf[face][ch - 1], m_pDS420Buf, nHeightC420 * iStride420 * sizeof(Pel));
+            memcpy(m_pDS420FacesBuf[face][ch - 1], m_pDS420Buf, nHeightC420 * iStride420 * sizeof(FacePel));
           }
         }
       }
@@ -522,7 +526,7 @@ Void TGeneralizedCubeMap::framePack(PelUnitBuf *pDstYuv)
             Int         yc           = y >> ::getComponentScaleY(chId, pDstYuv->chromaFormat);
             Int         nFaceWidthC  = nFaceWidth >> ::getComponentScaleX(chId, pDstYuv->chromaFormat);
             Int         nFaceHeightC = nFaceHeight >> ::getComponentScaleY(chId, pDstYuv->chromaFormat);
-            Pel *       pDS420BufOrig;
+            FacePel *   pDS420BufOrig;
             if (m_sVideoInfo.bPGCMP && m_sVideoInfo.iPGCMPPaddingType == 3)
               pDS420BufOrig = m_pDS420FacesBuf[face][ch - 1] + nPaddingC * iStride420 + nPaddingC;
             else
@@ -564,7 +568,7 @@ Void TGeneralizedCubeMap::framePack(PelUnitBuf *pDstYuv)
             {
               Int  faceOffsetX = m_iFaceOffset[face][0] >> ::getComponentScaleX(chId, pDstYuv->chromaFormat);
               Int  faceOffsetY = m_iFaceOffset[face][1] >> ::getComponentScaleY(chId, pDstYuv->chromaFormat);
-              Pel *pBufOffset  = m_pFacesOrig[face][ch] + faceOffsetY * getStride(chId) + faceOffsetX;
+              FacePel *pBufOffset = m_pFacesOrig[face][ch] + faceOffsetY * getStride(chId) + faceOffsetX;
               rotOneFaceChannel(pBufOffset, nFaceWidthC, nFaceHeightC, getStride(chId), 1, ch, rot, pDstYuv, xc, yc,
                                 face, (m_nBitDepth - m_nOutputBitDepth));
             }
@@ -590,7 +594,7 @@ Void TGeneralizedCubeMap::framePack(PelUnitBuf *pDstYuv)
         {
           Int  faceOffsetX = m_iFaceOffset[face][0];
           Int  faceOffsetY = m_iFaceOffset[face][1];
-          Pel *pBufOffset  = m_pFacesOrig[face][0] + faceOffsetY * getStride((ComponentID) 0) + faceOffsetX;
+          FacePel *pBufOffset = m_pFacesOrig[face][0] + faceOffsetY * getStride((ComponentID) 0) + faceOffsetX;
           rotOneFaceChannel(pBufOffset, nFaceWidth, nFaceHeight, getStride((ComponentID) 0), 1, 0, rot, pDstYuv, x, y,
                             face, (m_nBitDepth - m_nOutputBitDepth));
         }
@@ -652,7 +656,7 @@ Void TGeneralizedCubeMap::framePack(PelUnitBuf *pDstYuv)
             {
               Int  faceOffsetX = m_iFaceOffset[face][0];
               Int  faceOffsetY = m_iFaceOffset[face][1];
-              Pel *pBufOffset  = m_pFacesOrig[face][ch] + faceOffsetY * getStride(chId) + faceOffsetX;
+              FacePel *pBufOffset = m_pFacesOrig[face][ch] + faceOffsetY * getStride(chId) + faceOffsetX;
               rotOneFaceChannel(pBufOffset, nFaceWidth, nFaceHeight, getStride(chId), 1, ch, rot, pDstYuv, x, y, face,
                                 (m_nBitDepth - m_nOutputBitDepth));
             }
@@ -737,7 +741,7 @@ Void TGeneralizedCubeMap::framePack(PelUnitBuf *pDstYuv)
     if (!m_pDS420Buf && ((m_chromaFormatIDC == CHROMA_444) || (m_chromaFormatIDC == CHROMA_420 && m_bResampleChroma)))
 #endif
     {
-      m_pDS420Buf = (Pel *) xMalloc(Pel, nHeightC * iStride420);
+      m_pDS420Buf = (FacePel *) xMalloc(FacePel, nHeightC * iStride420);
     }
     for (Int face = 0; face < iTotalNumOfFaces; face++)
     {
@@ -832,10 +836,14 @@ Void TGeneralizedCubeMap::framePack(PelUnitBuf *pDstYuv)
             ComponentID chId = (ComponentID) ch;
             Int xc = x >> ::getComponentScaleX(chId, pDstYuv->chromaFormat);
             Int yc = y >> ::getComponentScaleY(chId, pDstYuv->chromaFormat);
+#if SVIDEO_FUSED_CHROMA_RESAMPLING
+            chromaDonwsampleHV(m_pFacesOrig[face][ch], m_sVideoInfo.iFaceWidth, m_sVideoInfo.iFaceHeight, getStride(chId), m_pDS422Buf, iStride422, m_pDS420Buf, iStride420);
+#else
             chromaDonwsampleH(m_pFacesOrig[face][ch] - nMarginSize * getStride((ComponentID) ch),
                               m_sVideoInfo.iFaceWidth, nHeightC422, getStride(chId), 1, m_pDS422Buf, iStride422);
             chromaDonwsampleV(m_pDS422Buf + nMarginSize * iStride422, nWidthC, m_sVideoInfo.iFaceHeight, iStride422, 1,
                               m_pDS420Buf, iStride420);
+#endif
             if ((m_sVideoInfo.iGCMPPackingType == 4 || m_sVideoInfo.iGCMPPackingType == 5))
             {
               Int faceOffsetX = m_iFaceOffset[face][0] >> ::getComponentScaleX(chId, pDstYuv->chromaFormat);
@@ -853,7 +861,7 @@ Void TGeneralizedCubeMap::framePack(PelUnitBuf *pDstYuv)
                 if (m_sVideoInfo.iGCMPPackingType == 5 && facePosIdx == 0)
                   yc = 0;
               }
-              Pel *pDS420BufOffset = m_pDS420Buf + faceOffsetY * iStride420 + faceOffsetX;
+              FacePel *pDS420BufOffset = m_pDS420Buf + faceOffsetY * iStride420 + faceOffsetX;
               rotOneFaceChannel(pDS420BufOffset, nFaceWidthC, nFaceHeightC, iStride420, 1, ch, rot, pDstYuv, xc, yc,
                                 face, 0);
             }
@@ -900,7 +908,7 @@ Void TGeneralizedCubeMap::framePack(PelUnitBuf *pDstYuv)
                   if (m_sVideoInfo.iGCMPPackingType == 5 && facePosIdx == 0)
                     yc = 0;
                 }
-                Pel *pBufOffset = m_pFacesOrig[face][ch] + faceOffsetY * getStride(chId) + faceOffsetX;
+                FacePel *pBufOffset = m_pFacesOrig[face][ch] + faceOffsetY * getStride(chId) + faceOffsetX;
                 rotOneFaceChannel(pBufOffset, nFaceWidthC, nFaceHeightC, getStride(chId), 1, ch, rot, pDstYuv, xc, yc,
                                   face, (m_nBitDepth - m_nOutputBitDepth));
               }
@@ -981,7 +989,7 @@ Void TGeneralizedCubeMap::framePack(PelUnitBuf *pDstYuv)
             if (m_sVideoInfo.iGCMPPackingType == 5 && facePosIdx == 0)
               yl = 0;
           }
-          Pel *pBufOffset = m_pFacesOrig[face][0] + faceOffsetY * getStride((ComponentID) 0) + faceOffsetX;
+          FacePel *pBufOffset = m_pFacesOrig[face][0] + faceOffsetY * getStride((ComponentID) 0) + faceOffsetX;
           rotOneFaceChannel(pBufOffset, nFaceWidth, nFaceHeight, getStride((ComponentID) 0), 1, 0, rot, pDstYuv, xl, yl,
                             face, (m_nBitDepth - m_nOutputBitDepth));
         }
@@ -1114,7 +1122,7 @@ Void TGeneralizedCubeMap::framePack(PelUnitBuf *pDstYuv)
                 if (m_sVideoInfo.iGCMPPackingType == 5 && facePosIdx == 0)
                   yl = 0;
               }
-              Pel *pBufOffset = m_pFacesOrig[face][ch] + faceOffsetY * getStride(chId) + faceOffsetX;
+              FacePel *pBufOffset = m_pFacesOrig[face][ch] + faceOffsetY * getStride(chId) + faceOffsetX;
               rotOneFaceChannel(pBufOffset, nFaceWidth, nFaceHeight, getStride(chId), 1, ch, rot, pDstYuv, xl, yl, face,
                                 (m_nBitDepth - m_nOutputBitDepth));
             }
@@ -1274,7 +1282,7 @@ Void TGeneralizedCubeMap::convertYuv(PelUnitBuf *pSrcYuv)
           Pel *pSrc        = pSrcYuv->get((ComponentID) ch).bufAt(0, 0) + faceY * iStrideSrc + faceX;
           Int  faceOffsetX = m_iFaceOffset[faceIdx][0] >> ::getComponentScaleX(chId, pSrcYuv->chromaFormat);
           Int  faceOffsetY = m_iFaceOffset[faceIdx][1] >> ::getComponentScaleY(chId, pSrcYuv->chromaFormat);
-          Pel *pDst        = m_pFacesOrig[faceIdx][ch] + faceOffsetY * getStride((ComponentID) ch) + faceOffsetX;
+          FacePel *pDst    = m_pFacesOrig[faceIdx][ch] + faceOffsetY * getStride((ComponentID) ch) + faceOffsetX;
           rotFaceChannelGeneral(pSrc, nFaceWidth, nFaceHeight, pSrcYuv->get((ComponentID) ch).stride, 1, iRot, pDst,
                                 getStride((ComponentID) ch), 1, true);
         }
@@ -1329,14 +1337,14 @@ Void TGeneralizedCubeMap::convertYuv(PelUnitBuf *pSrcYuv)
         m_nMarginSizeBufTemp = std::max(m_filterUps[2].nTaps, m_filterUps[3].nTaps) >> 1;
         ;   // depends on the vertical upsampling filter;
         m_nStrideBufTemp = nWidth + (m_nMarginSizeBufTemp << 1);
-        m_pFacesBufTemp  = new Pel *[nFaces];
-        memset(m_pFacesBufTemp, 0, sizeof(Pel *) * nFaces);
-        m_pFacesBufTempOrig = new Pel *[nFaces];
-        memset(m_pFacesBufTempOrig, 0, sizeof(Pel *) * nFaces);
+        m_pFacesBufTemp  = new FacePel *[nFaces];
+        memset(m_pFacesBufTemp, 0, sizeof(FacePel *) * nFaces);
+        m_pFacesBufTempOrig = new FacePel *[nFaces];
+        memset(m_pFacesBufTempOrig, 0, sizeof(FacePel *) * nFaces);
         Int iTotalHeight = (nHeight + (m_nMarginSizeBufTemp << 1));
         for (Int i = 0; i < nFaces; i++)
         {
-          m_pFacesBufTemp[i]     = (Pel *) xMalloc(Pel, m_nStrideBufTemp * iTotalHeight);
+          m_pFacesBufTemp[i]     = (FacePel *) xMalloc(FacePel, m_nStrideBufTemp * iTotalHeight);
           m_pFacesBufTempOrig[i] = m_pFacesBufTemp[i] + m_nStrideBufTemp * m_nMarginSizeBufTemp + m_nMarginSizeBufTemp;
         }
       }
@@ -1410,7 +1418,7 @@ Void TGeneralizedCubeMap::convertYuv(PelUnitBuf *pSrcYuv)
         Pel *pSrc        = pSrcYuv->get((ComponentID) ch).bufAt(0, 0) + faceY * iStrideSrc + faceX;
         Int  faceOffsetX = m_iFaceOffset[faceIdx][0] >> ::getComponentScaleX(chId, pSrcYuv->chromaFormat);
         Int  faceOffsetY = m_iFaceOffset[faceIdx][1] >> ::getComponentScaleY(chId, pSrcYuv->chromaFormat);
-        Pel *pDst        = m_pFacesBufTempOrig[faceIdx] + faceOffsetY * m_nStrideBufTemp + faceOffsetX;
+        FacePel *pDst    = m_pFacesBufTempOrig[faceIdx] + faceOffsetY * m_nStrideBufTemp + faceOffsetX;
         rotFaceChannelGeneral(pSrc, nFaceWidth, nFaceHeight, pSrcYuv->get((ComponentID) ch).stride, 1, iRot, pDst,
                               m_nStrideBufTemp, 1, true);
       }
@@ -1593,7 +1601,7 @@ Void TGeneralizedCubeMap::convertYuv(PelUnitBuf *pSrcYuv)
           Pel *pSrc        = pSrcYuv->get((ComponentID)(ch)).bufAt(0, 0) + faceY * iStrideSrc + faceX;
           Int  faceOffsetX = m_iFaceOffset[faceIdx][0] >> ::getComponentScaleX((ComponentID) ch, pSrcYuv->chromaFormat);
           Int  faceOffsetY = m_iFaceOffset[faceIdx][1] >> ::getComponentScaleY((ComponentID) ch, pSrcYuv->chromaFormat);
-          Pel *pDst        = m_pFacesOrig[faceIdx][ch] + faceOffsetY * getStride((ComponentID) ch) + faceOffsetX;
+          FacePel *pDst    = m_pFacesOrig[faceIdx][ch] + faceOffsetY * getStride((ComponentID) ch) + faceOffsetX;
           rotFaceChannelGeneral(pSrc, nFaceWidth, nFaceHeight, pSrcYuv->get((ComponentID) ch).stride, 1, iRot, pDst,
                                 getStride((ComponentID) ch), 1, true);
         }
@@ -1757,7 +1765,7 @@ Void TGeneralizedCubeMap::checkFaceRotation(SVideoInfo &sVideoInfo, Int middleFa
   }
 }
 
-Void TGeneralizedCubeMap::clearFaceBuffer(Pel *pDst, Int iWidth, Int iHeight, Int iStrideDst)
+Void TGeneralizedCubeMap::clearFaceBuffer(FacePel *pDst, Int iWidth, Int iHeight, Int iStrideDst)
 {
   for (Int j = 0; j < iHeight; j++)
   {
@@ -1767,18 +1775,18 @@ Void TGeneralizedCubeMap::clearFaceBuffer(Pel *pDst, Int iWidth, Int iHeight, In
   }
 }
 
-Void TGeneralizedCubeMap::sPad(Pel *pSrc0, Int iHStep0, Int iStrideSrc0, Pel *pSrc1, Int iHStep1, Int iStrideSrc1,
-                               Int iNumSamples, Int hCnt, Int vCnt)
+Void TGeneralizedCubeMap::sPad(FacePel *pSrc0, Int iHStep0, Int iStrideSrc0, FacePel *pSrc1, Int iHStep1,
+                               Int iStrideSrc1, Int iNumSamples, Int hCnt, Int vCnt)
 {
-  Pel *pSrc0Start = pSrc0 + iHStep0;
-  Pel *pSrc1Start = pSrc1 - iHStep1;
+  FacePel *pSrc0Start = pSrc0 + iHStep0;
+  FacePel *pSrc1Start = pSrc1 - iHStep1;
 
   for (Int j = 0; j < vCnt; j++)
   {
     for (Int i = 0; i < hCnt; i++)
     {
-      memcpy(pSrc0Start + i * iHStep0, pSrc1 + i * iHStep1, iNumSamples * sizeof(Pel));
-      memcpy(pSrc1Start - i * iHStep1, pSrc0 - i * iHStep0, iNumSamples * sizeof(Pel));
+      memcpy(pSrc0Start + i * iHStep0, pSrc1 + i * iHStep1, iNumSamples * sizeof(FacePel));
+      memcpy(pSrc1Start - i * iHStep1, pSrc0 - i * iHStep0, iNumSamples * sizeof(FacePel));
     }
     pSrc0 += iStrideSrc0;
     pSrc0Start += iStrideSrc0;
@@ -1788,16 +1796,16 @@ Void TGeneralizedCubeMap::sPad(Pel *pSrc0, Int iHStep0, Int iStrideSrc0, Pel *pS
 }
 
 // 90 anti clockwise: source -> destination;
-Void TGeneralizedCubeMap::rot90(Pel *pSrcBuf, Int iStrideSrc, Int iWidth, Int iHeight, Int iNumSamples, Pel *pDst,
-                                Int iStrideDst)
+Void TGeneralizedCubeMap::rot90(FacePel *pSrcBuf, Int iStrideSrc, Int iWidth, Int iHeight, Int iNumSamples,
+                                FacePel *pDst, Int iStrideDst)
 {
-  Pel *pSrcCol = pSrcBuf + (iWidth - 1) * iNumSamples;
+  FacePel *pSrcCol = pSrcBuf + (iWidth - 1) * iNumSamples;
   for (Int j = 0; j < iWidth; j++)
   {
-    Pel *pSrc = pSrcCol;
+    FacePel *pSrc = pSrcCol;
     for (Int i = 0; i < iHeight; i++, pSrc += iStrideSrc)
     {
-      memcpy(pDst + i * iNumSamples, pSrc, iNumSamples * sizeof(Pel));
+      memcpy(pDst + i * iNumSamples, pSrc, iNumSamples * sizeof(FacePel));
     }
     pDst += iStrideDst;
     pSrcCol -= iNumSamples;
@@ -1805,7 +1813,8 @@ Void TGeneralizedCubeMap::rot90(Pel *pSrcBuf, Int iStrideSrc, Int iWidth, Int iH
 }
 
 // corner;
-Void TGeneralizedCubeMap::cPad(Pel *pSrc, Int iWidth, Int iHeight, Int iStrideSrc, Int iNumSamples, Int hCnt, Int vCnt)
+Void TGeneralizedCubeMap::cPad(FacePel *pSrc, Int iWidth, Int iHeight, Int iStrideSrc, Int iNumSamples, Int hCnt,
+                               Int vCnt)
 {
   // top-left;
   rot90(pSrc - hCnt * iStrideSrc, iStrideSrc, vCnt, hCnt, iNumSamples, pSrc - vCnt * iStrideSrc - hCnt * iNumSamples,
@@ -2012,6 +2021,26 @@ Void TGeneralizedCubeMap::generatePadding(PelUnitBuf *pcPicYuvDst, Int ch, Int f
   }
 }
 
+// copies the padding lines; the source is a face buffer, or the frame itself for the replicated padding;
+template<typename T>
+static Void copyPaddingLines(const T *pSrcBuf, Int iHorSrc, Int iVerSrc, Pel *pDstBuf, Int iHorDst, Int iVerDst,
+                             Int nWidth, Int nLines, Int iOffset, Int iBDAdjust, Int iBitDepth)
+{
+  const T *pSrcLine = pSrcBuf;
+  Pel     *pDstLine = pDstBuf;
+  for (Int j = 0; j < nLines; j++)
+  {
+    const T *pSrc = pSrcLine;
+    Pel     *pDst = pDstLine;
+    for (Int i = 0; i < nWidth; i++, pSrc += iHorSrc, pDst += iHorDst)
+    {
+      *pDst = ClipBD(((*pSrc) + iOffset) >> iBDAdjust, iBitDepth);
+    }
+    pSrcLine += iVerSrc;
+    pDstLine += iVerDst;
+  }
+}
+
 Void TGeneralizedCubeMap::fillPadding(PelUnitBuf *pcPicYuvDst, Int ch, Int faceIdx, Int rot, Int padLocIdx, Int offsetX,
                                       Int offsetY, Int iBDAdjust, Bool bHalfPadding)
 {
@@ -2067,20 +2096,21 @@ Void TGeneralizedCubeMap::fillPadding(PelUnitBuf *pcPicYuvDst, Int ch, Int faceI
   default: CHECK(true, "Error TGeneralizedCubeMap::fillPadding()"); break;
   }
 
-  Pel *pSrcBuf = nullptr;
-  Int  iHorSrc = 0, iVerSrc = 0;
+  const Pel *pEdgeBuf = nullptr;   // replicated padding: the face boundary already written to the frame;
+  FacePel   *pSrcBuf  = nullptr;
+  Int        iHorSrc = 0, iVerSrc = 0;
   if (m_sVideoInfo.iPGCMPPaddingType <= 1)
   {
     iHorSrc = iHorDst;
     iVerSrc = 0;
     if (padLocIdx == 0)
-      pSrcBuf = pDstBuf + iStrideDst;
+      pEdgeBuf = pDstBuf + iStrideDst;
     else if (padLocIdx == 1)
-      pSrcBuf = pDstBuf - 1;
+      pEdgeBuf = pDstBuf - 1;
     else if (padLocIdx == 2)
-      pSrcBuf = pDstBuf - iStrideDst;
+      pEdgeBuf = pDstBuf - iStrideDst;
     else if (padLocIdx == 3)
-      pSrcBuf = pDstBuf + 1;
+      pEdgeBuf = pDstBuf + 1;
   }
   else if (m_sVideoInfo.iPGCMPPaddingType == 2)
   {
@@ -2248,19 +2278,12 @@ Void TGeneralizedCubeMap::fillPadding(PelUnitBuf *pcPicYuvDst, Int ch, Int faceI
     CHECK(true, "Not supported");
   }
 
-  Pel *pSrcLine = pSrcBuf;
-  Pel *pDstLine = pDstBuf;
-  for (Int j = 0; j < nPadding; j++)
-  {
-    Pel *pSrc = pSrcLine;
-    Pel *pDst = pDstLine;
-    for (Int i = 0; i < nPaddingWidth; i++, pSrc += iHorSrc, pDst += iHorDst)
-    {
-      *pDst = ClipBD(((*pSrc) + iOffset) >> iBDAdjust, m_nOutputBitDepth);
-    }
-    pSrcLine += iVerSrc;
-    pDstLine += iVerDst;
-  }
+  if (pEdgeBuf)
+    copyPaddingLines(pEdgeBuf, iHorSrc, iVerSrc, pDstBuf, iHorDst, iVerDst, nPaddingWidth, nPadding, iOffset, iBDAdjust,
+                     m_nOutputBitDepth);
+  else
+    copyPaddingLines(pSrcBuf, iHorSrc, iVerSrc, pDstBuf, iHorDst, iVerDst, nPaddingWidth, nPadding, iOffset, iBDAdjust,
+                     m_nOutputBitDepth);
 }
 
 Void TGeneralizedCubeMap::fillCornerPadding(PelUnitBuf *pcPicYuvDst, Int ch, Int faceIdx, Int rot, Int padLocIdx,
@@ -2360,9 +2383,9 @@ Void TGeneralizedCubeMap::fillCornerPadding(PelUnitBuf *pcPicYuvDst, Int ch, Int
     Int srcBufOffsetX = copyFromMiddleX ? (nWidth >> 1) : 0;
     Int srcBufOffsetY = copyFromMiddleY ? (nHeight >> 1) : 0;
 
-    Pel *pSrcBuf;
-    Int  iHorSrc, iVerSrc;
-    Int  iStrideSrc = bDS420 ? nWidth + (nPadding << 1) : getStride(chId);
+    FacePel *pSrcBuf;
+    Int      iHorSrc, iVerSrc;
+    Int      iStrideSrc = bDS420 ? nWidth + (nPadding << 1) : getStride(chId);
     switch ((padLocIdx + rot / 90) % 4)
     {
     case 0:
@@ -2396,11 +2419,11 @@ Void TGeneralizedCubeMap::fillCornerPadding(PelUnitBuf *pcPicYuvDst, Int ch, Int
     default: CHECK(true, "Error TGeneralizedCubeMap::fillCornerPadding()"); break;
     }
 
-    Pel *pSrcLine = pSrcBuf;
+    FacePel *pSrcLine = pSrcBuf;
     Pel *pDstLine = pDstBuf;
     for (Int j = 0; j < nPadding; j++)
     {
-      Pel *pSrc = pSrcLine;
+      FacePel *pSrc = pSrcLine;
       Pel *pDst = pDstLine;
       for (Int i = 0; i < nPadding; i++, pSrc += iHorSrc, pDst += iHorDst)
       {
@@ -2676,7 +2699,7 @@ Void TGeneralizedCubeMap::fillPadding(PelUnitBuf *pcPicYuvDst, Int ch, Int faceI
   Int iStrideDst = pcPicYuvDst->get(chId).stride;
   Int iOffset = iBDAdjust > 0 ? (1 << (iBDAdjust - 1)) : 0;
 
-  Pel *pSrcBuf;
+  FacePel *pSrcBuf;
   Int iHorSrc, iVerSrc;
   switch (copyBoundaryIdx)
   {
@@ -2734,11 +2757,11 @@ Void TGeneralizedCubeMap::fillPadding(PelUnitBuf *pcPicYuvDst, Int ch, Int faceI
   default: CHECK(true, "Error TGeneralizedCubeMap::fillPadding()"); break;
   }
 
-  Pel *pSrcLine = pSrcBuf;
+  FacePel *pSrcLine = pSrcBuf;
   Pel *pDstLine = pDstBuf;
   for (Int j = 0; j < nPadding; j++)
   {
-    Pel *pSrc = pSrcLine;
+    FacePel *pSrc = pSrcLine;
     Pel *pDst = pDstLine;
     for (Int i = 0; i < nPaddingWidth; i++, pDst += iHorDst, pSrc += iHorSrc)
     {
@@ -2910,9 +2933,10 @@ Void TGeneralizedCubeMap::blendingPaddingType2(PelUnitBuf *pcPicYuvSrc, Int ch,
   
   Bool        bUS420 = ch != 0 && pcPicYuvSrc->chromaFormat == CHROMA_420 && m_chromaFormatIDC != CHROMA_420 ? true : false;
 
-  Pel *pSrcBuf, *pDstBuf;
-  Int  iStrideSrc = pcPicYuvSrc->get(chId).stride;
-  Int  iHorSrc, iVerSrc;
+  Pel     *pSrcBuf;
+  FacePel *pDstBuf;
+  Int      iStrideSrc = pcPicYuvSrc->get(chId).stride;
+  Int      iHorSrc, iVerSrc;
   switch (padLocIdx)
   {
   case 0:
@@ -3011,12 +3035,12 @@ Void TGeneralizedCubeMap::blendingPaddingType2(PelUnitBuf *pcPicYuvSrc, Int ch,
   }
 
   Pel *pSrcLine = pSrcBuf;
-  Pel *pDstLine = pDstBuf;
+  FacePel *pDstLine = pDstBuf;
   Int nDoublePadding = nPadding << 1;
   for (Int j = 0; j < nPadding; j++)
   {
     Pel *pSrc = pSrcLine;
-    Pel *pDst = pDstLine;
+    FacePel *pDst = pDstLine;
     Double w = j + nPadding + 0.5;
     for (Int i = 0; i < nWidth; i++, pSrc += iHorSrc, pDst += iHorDst)
     {
@@ -57,14 +57,14 @@ private:
 #endif
   Int m_iFaceOffset[6][2];
 #if SVIDEO_GCMP_PADDING_TYPE
-  Pel ***m_pDS420FacesBuf; 
+  FacePel ***m_pDS420FacesBuf; 
 #endif
   Void faceOffset4Hemisphere(Int middleFaceIdx);
   Void checkFaceRotation(SVideoInfo& sVideoInfo, Int middleFaceIdx);
-  Void clearFaceBuffer(Pel *pDst, Int iWidth, Int iHeight, Int iStrideDst);
-  Void sPad(Pel *pSrc0, Int iHStep0, Int iStrideSrc0, Pel* pSrc1, Int iHStep1, Int iStrideSrc1, Int iNumSamples, Int hCnt, Int vCnt);
-  Void cPad(Pel *pSrc0, Int iWidth, Int iHeight, Int iStrideSrc0, Int iNumSamples, Int hCnt, Int vCnt);
-  Void rot90(Pel *pSrc, Int iStrideSrc, Int iWidth, Int iHeight, Int iNumSamples, Pel *pDst, Int iStrideDst);
+  Void clearFaceBuffer(FacePel *pDst, Int iWidth, Int iHeight, Int iStrideDst);
+  Void sPad(FacePel *pSrc0, Int iHStep0, Int iStrideSrc0, FacePel* pSrc1, Int iHStep1, Int iStrideSrc1, Int iNumSamples, Int hCnt, Int vCnt);
+  Void cPad(FacePel *pSrc0, Int iWidth, Int iHeight, Int iStrideSrc0, Int iNumSamples, Int hCnt, Int vCnt);
+  Void rot90(FacePel *pSrc, Int iStrideSrc, Int iWidth, Int iHeight, Int iNumSamples, FacePel *pDst, Int iStrideDst);
   Void generatePadding(PelUnitBuf *pcPicYuvDst, Int ch, Int faceIdx, Int rot, Int offsetX, Int offsetY, Int iBDAdjust);
   Void fillPadding(PelUnitBuf *pcPicYuvDst, Int ch, Int faceIdx, Int rot, Int padLocIdx, Int offsetX, Int offsetY, Int iBDAdjust, Bool bHalfPadding = false);
 #if SVIDEO_GCMP_PADDING_TYPE
@@ -88,6 +88,9 @@ public:
   virtual Void framePack(PelUnitBuf *pDstYuv);
   virtual Bool insideFace(Int fId, Int x, Int y, ComponentID chId, ComponentID origchId);
   virtual Void convertYuv(PelUnitBuf *pSrcYuv);
+#if SVIDEO_VIEWPORT_RENDERER
+  virtual Bool isFaceMaskSupported() { return false; }
+#endif
 };
 #endif
 #endif
@@ -48,6 +48,9 @@
 #include "TOctahedron.h"
 #include "TIcosahedron.h"
 #include "TViewPort.h"
+#if SVIDEO_VIEWPORT_DIRECT_SAMPLING
+#include "TWorkerPool.h"
+#endif
 #if SVIDEO_CPPPSNR
 #include "TCrastersParabolic.h"
 #endif
@@ -97,6 +100,40 @@ template<typename T> static inline Int filter1D(T *pSrc, Int iStride, Filter1DIn
   return ret;
 }
 
+#if SVIDEO_FUSED_CHROMA_RESAMPLING
+//filter1D() for a row of outputs: the input advances by S and the output by D samples per output; N taps (0: pFilter->nTaps);
+template<Int N, Int S, Int D, Bool bClip, typename T, typename TD>
+static Void filterRowN(const T *pSrc, Int iStride, const Filter1DInfo *pFilter, TD *pDst, Int iWidth, Int iOffset, Int iShift, Int iBitDepth)
+{
+  const Int  nTaps        = N ? N : pFilter->nTaps;
+  const Int *pFilterCoeff = pFilter->iFilterCoeff;
+  const T   *pSrcL        = pSrc - ((nTaps - 1) >> 1) * iStride;
+  for (Int i = 0; i < iWidth; i++)
+  {
+    Int ret = 0;
+    for (Int k = 0; k < nTaps; k++)
+    {
+      ret += pSrcL[i * S + k * iStride] * pFilterCoeff[k];
+    }
+    pDst[i * D] = (TD) (bClip ? ClipBD<Int>((ret + iOffset) >> iShift, iBitDepth) : ret);
+  }
+}
+
+template<Int S, Int D, Bool bClip, typename T, typename TD>
+static Void filterRow(const T *pSrc, Int iStride, const Filter1DInfo *pFilter, TD *pDst, Int iWidth, Int iOffset = 0, Int iShift = 0, Int iBitDepth = 0)
+{
+  switch (pFilter->nTaps)
+  {
+  case 1: filterRowN<1, S, D, bClip>(pSrc, iStride, pFilter, pDst, iWidth, iOffset, iShift, iBitDepth); break;
+  case 2: filterRowN<2, S, D, bClip>(pSrc, iStride, pFilter, pDst, iWidth, iOffset, iShift, iBitDepth); break;
+  case 3: filterRowN<3, S, D, bClip>(pSrc, iStride, pFilter, pDst, iWidth, iOffset, iShift, iBitDepth); break;
+  case 4: filterRowN<4, S, D, bClip>(pSrc, iStride, pFilter, pDst, iWidth, iOffset, iShift, iBitDepth); break;
+  case 8: filterRowN<8, S, D, bClip>(pSrc, iStride, pFilter, pDst, iWidth, iOffset, iShift, iBitDepth); break;
+  default: filterRowN<0, S, D, bClip>(pSrc, iStride, pFilter, pDst, iWidth, iOffset, iShift, iBitDepth); break;
+  }
+}
+#endif
+
 TChar TGeometry::m_strGeoName[SVIDEO_TYPE_NUM][256] = { { "Equirectangular" },
                                                         { "Cubemap" },
 #if SVIDEO_ADJUSTED_EQUALAREA
@@ -180,6 +217,9 @@ TGeometry::TGeometry()
   m_pUpsTempBuf           = nullptr;
   m_iUpsTempBufMarginSize = 0;
   m_iStrideUpsTempBuf     = 0;
+#if SVIDEO_VIEWPORT_DEPENDENCY_MAP
+  m_pUpsProbe             = nullptr;
+#endif
   m_InterpolationType[0] = m_InterpolationType[1] = SI_UNDEFINED;
   memset(m_filterDs, 0, sizeof(m_filterDs));
   memset(m_filterUps, 0, sizeof(m_filterUps));
@@ -191,6 +231,18 @@ TGeometry::TGeometry()
   m_bGeometryMapping          = false;
   m_WeightMap_NumOfBits4Faces = 0;
   memset(m_pPixelWeight, 0, sizeof(m_pPixelWeight));
+#if SVIDEO_SEPARABLE_CUBE_MAPPING
+  memset(m_bSeparableMapping, 0, sizeof(m_bSeparableMapping));
+  memset(m_pPixelWeightSep, 0, sizeof(m_pPixelWeightSep));
+#if SVIDEO_YAW_ROTATION_SHIFT
+  memset(m_iSepColumnShift, -1, sizeof(m_iSepColumnShift));
+  m_bHorWeightLut[0] = m_bHorWeightLut[1] = false;
+  m_bIdentityWeight[0] = m_bIdentityWeight[1] = false;
+#endif
+#if SVIDEO_SEPARABLE_TWO_PASS_FILTER
+  memset(m_bSepTwoPass, 0, sizeof(m_bSepTwoPass));
+#endif
+#endif
   m_interpolateWeight[0] = m_interpolateWeight[1] = nullptr;
   m_iLanczosParamA[0] = m_iLanczosParamA[1] = 0;
   m_pfLanczosFltCoefLut[0] = m_pfLanczosFltCoefLut[1] = nullptr;
@@ -200,6 +252,17 @@ TGeometry::TGeometry()
   memset(m_pWeightLut, 0, sizeof(m_pWeightLut));
   memset(m_iInterpFilterTaps, 0, sizeof(m_iInterpFilterTaps));
   m_bConvOutputPaddingNeeded = false;
+#if SVIDEO_VIEWPORT_RENDERER
+  m_uiConvertFaceMask = m_uiPadFaceMask = 0xFFFFFFFF;
+#endif
+#if SVIDEO_DEMAND_SPHERE_PADDING
+  m_bDemandPadding = m_bPaddingDemandUpdated = false;
+  memset(m_pPaddingDemand, 0, sizeof(m_pPaddingDemand));
+  memset(m_pPaddingDemandRow, 0, sizeof(m_pPaddingDemandRow));
+#endif
+#if SVIDEO_BLOCKED_FACE_ROTATION
+  memset(m_iInsideFaceMaskSize, -1, sizeof(m_iInsideFaceMaskSize));
+#endif
 }
 
 Void TGeometry::geoInit(SVideoInfo &sVideoInfo, InputGeoParam *pInGeoParam)
@@ -207,6 +270,9 @@ Void TGeometry::geoInit(SVideoInfo &sVideoInfo, InputGeoParam *pInGeoParam)
   m_sVideoInfo      = sVideoInfo;
   m_nBitDepth       = pInGeoParam->nBitDepth;
   m_nOutputBitDepth = pInGeoParam->nOutputBitDepth;
+#if SVIDEO_8BIT_FACE_STORAGE
+  CHECK(m_nBitDepth > 8, "The 8-bit face storage requires an internal bit depth of 8");
+#endif
   m_chromaFormatIDC = pInGeoParam->chromaFormat;
 #if !SVIDEO_CHROMA_TYPES_SUPPORT
   m_bResampleChroma = pInGeoParam->bResampleChroma;
@@ -223,28 +289,38 @@ Void TGeometry::geoInit(SVideoInfo &sVideoInfo, InputGeoParam *pInGeoParam)
   setChromaResamplingFilter(pInGeoParam->iChromaSampleLocType);
 #endif
   m_iMarginX = m_iMarginY = S_PAD_MAX;
+#if !SVIDEO_FUSED_PACKED_CONVERSION
+  allocFaceBuffers();
+#endif
+
+  // optional; map faceId to (row, col) in frame packing structure;
+  parseFacePos(m_facePos[0]);
+}
+
+//the faces with their margins, for convertYuv(), geoConvert(), spherePadding() and framePack();
+Void TGeometry::allocFaceBuffers()
+{
+  if (m_pFacesBuf)
+    return;
   Int nFaces              = m_sVideoInfo.iNumFaces;
-  m_pFacesBuf             = new Pel **[nFaces];
-  m_pFacesOrig            = new Pel **[nFaces];
+  m_pFacesBuf             = new FacePel **[nFaces];
+  m_pFacesOrig            = new FacePel **[nFaces];
   Int nChannels           = getNumChannels();
   for (Int i = 0; i < nFaces; i++)
   {
-    m_pFacesBuf[i] = new Pel *[nChannels];
-    memset(m_pFacesBuf[i], 0, sizeof(Pel *) * nChannels);
-    m_pFacesOrig[i] = new Pel *[nChannels];
-    memset(m_pFacesOrig[i], 0, sizeof(Pel *) * nChannels);
+    m_pFacesBuf[i] = new FacePel *[nChannels];
+    memset(m_pFacesBuf[i], 0, sizeof(FacePel *) * nChannels);
+    m_pFacesOrig[i] = new FacePel *[nChannels];
+    memset(m_pFacesOrig[i], 0, sizeof(FacePel *) * nChannels);
     for (Int j = 0; j < (nChannels); j++)
     {
       Int iTotalHeight  = (m_sVideoInfo.iFaceHeight + (m_iMarginY << 1)) >> getComponentScaleY(ComponentID(j));
-      m_pFacesBuf[i][j] = (Pel *) xMalloc(Pel, getStride(ComponentID(j)) * iTotalHeight);
+      m_pFacesBuf[i][j] = (FacePel *) xMalloc(FacePel, getStride(ComponentID(j)) * iTotalHeight);
     }
     for (Int j = 0; j < nChannels; j++)
       m_pFacesOrig[i][j] =
         m_pFacesBuf[i][j] + getStride(ComponentID(j)) * getMarginY(ComponentID(j)) + getMarginX(ComponentID(j));
   }
-
-  // optional; map faceId to (row, col) in frame packing structure;
-  parseFacePos(m_facePos[0]);
 }
 
 TGeometry::~TGeometry()
@@ -333,8 +409,22 @@ TGeometry::~TGeometry()
         }
       }
     }
+#if SVIDEO_SEPARABLE_CUBE_MAPPING
+    for (Int j = 0; j < 2; j++)
+    {
+      for (Int k = 0; k < 2; k++)
+      {
+        delete[] m_pPixelWeightSep[i][j][k];
+        m_pPixelWeightSep[i][j][k] = nullptr;
+      }
+    }
+#endif
   }
 
+#if SVIDEO_DEMAND_SPHERE_PADDING
+  xFreePaddingDemand();
+#endif
+
   for (Int j = 0; j < 2; j++)
   {
     if (m_pWeightLut[j])
@@ -375,7 +465,11 @@ TGeometry::~TGeometry()
   }
 }
 
+#if SVIDEO_FUSED_PACKED_CONVERSION
+TGeometry *TGeometry::create(SVideoInfo &sVideoInfo, InputGeoParam *pInGeoParam, Bool bFaceBuffers)
+#else
 TGeometry *TGeometry::create(SVideoInfo &sVideoInfo, InputGeoParam *pInGeoParam)
+#endif
 {
   TGeometry *pRet = nullptr;
   if (sVideoInfo.geoType == SVIDEO_EQUIRECT)
@@ -440,6 +534,11 @@ TGeometry *TGeometry::create(SVideoInfo &sVideoInfo, InputGeoParam *pInGeoParam)
 #if SVIDEO_GENERALIZED_CUBEMAP
   else if (sVideoInfo.geoType == SVIDEO_GENERALIZEDCUBEMAP)
     pRet = new TGeneralizedCubeMap(sVideoInfo, pInGeoParam);
+#endif
+#if SVIDEO_FUSED_PACKED_CONVERSION
+  //not needed by TPackedConverter, which reads and writes the frame packed pictures only;
+  if (pRet && bFaceBuffers)
+    pRet->allocFaceBuffers();
 #endif
   return pRet;
 }
@@ -450,16 +549,76 @@ Void TGeometry::clamp(IPos *pIPos)
   pIPos->v = Clip3(0, m_sVideoInfo.iFaceHeight - 1, (Int) pIPos->v);
 }
 
-// 1->2 upsampling;
-Void TGeometry::chromaUpsample(Pel *pSrcBuf, Int nWidthC, Int nHeightC, Int iStrideSrc, Int iFaceId, ComponentID chId)
+// 1->2 upsampling; the source is either a frame buffer or a face buffer;
+template<typename T>
+Void TGeometry::chromaUpsample(T *pSrcBuf, Int nWidthC, Int nHeightC, Int iStrideSrc, Int iFaceId, ComponentID chId)
 {
   Int nWidth  = nWidthC << 1;
   Int nHeight = nHeightC << 1;
   CHECK(m_sVideoInfo.iFaceWidth != nWidth, "");
   CHECK(m_sVideoInfo.iFaceHeight != nHeight, "");
+#if SVIDEO_VIEWPORT_DEPENDENCY_MAP
+  if (m_pUpsProbe)
+  {
+    //the window read by the vertical filters below, with the margins of TViewPortDependencyMap; -1: not read;
+    if (chId == COMPONENT_Cb)
+    {
+      Int iMarginX = std::max(m_filterUps[0].nTaps, m_filterUps[1].nTaps) >> 1;
+      Int iMarginY = std::max(m_filterUps[2].nTaps, m_filterUps[3].nTaps) >> 1;
+      Int iRow2    = (m_filterUps[2].nTaps > 1 ? -1 : 0) - ((m_filterUps[2].nTaps - 1) >> 1);
+      Int iRow3    = -((m_filterUps[3].nTaps - 1) >> 1);
+      Int iRow0    = std::min(iRow2, iRow3);
+      Int iRow1    = nHeightC - 1 + std::max(iRow2 + m_filterUps[2].nTaps, iRow3 + m_filterUps[3].nTaps) - 1;
+      Int iWidthP  = nWidthC + (iMarginX << 1);
+      std::vector<Int> &probe = m_pUpsProbe[iFaceId];
+      probe.assign(iWidthP * (nHeightC + (iMarginY << 1)), -1);
+      for (Int j = std::max(iRow0, -iMarginY); j <= std::min(iRow1, nHeightC + iMarginY - 1); j++)
+      {
+        for (Int i = 1 - iMarginX; i < nWidthC + iMarginX; i++)
+        {
+          probe[(j + iMarginY) * iWidthP + i + iMarginX] = pSrcBuf[j * iStrideSrc + i];
+        }
+      }
+    }
+    return;
+  }
+#endif
   // vertical upsampling;  [-2, 16, 54, -4]; [-4, 54, 16, -2];
   Int iStrideDst = getStride(chId);
 
+#if SVIDEO_FUSED_CHROMA_RESAMPLING
+  // both directions row by row; one temporal row per vertical phase;
+  if (!m_pUpsTempBuf)
+  {
+    m_iUpsTempBufMarginSize = std::max(m_filterUps[0].nTaps, m_filterUps[1].nTaps) >> 1;   // 2: 4 tap filter;
+    m_iStrideUpsTempBuf     = nWidthC + m_iUpsTempBufMarginSize * 2;
+    m_pUpsTempBuf           = (Int *) xMalloc(Int, m_iStrideUpsTempBuf * 2);
+    memset(m_pUpsTempBuf, 0, m_iStrideUpsTempBuf * 2 * sizeof(Int));   // the first entry of a row is not written by the vertical filter;
+  }
+  Int     *pTmp0      = m_pUpsTempBuf;
+  Int     *pTmp1      = m_pUpsTempBuf + m_iStrideUpsTempBuf;
+  T       *pSrc0      = pSrcBuf - m_iUpsTempBufMarginSize + 1 + (m_filterUps[2].nTaps > 1 ? -iStrideSrc : 0);
+  T       *pSrc1      = pSrcBuf - m_iUpsTempBufMarginSize + 1;
+  Int      iHorStart0 = m_iUpsTempBufMarginSize + (m_filterUps[0].nTaps > 1 ? -1 : 0);
+  Int      iHorStart1 = m_iUpsTempBufMarginSize;
+  Int      nWidthTmp  = nWidthC + 2 * m_iUpsTempBufMarginSize - 1;
+  FacePel *pOut       = m_pFacesOrig[iFaceId][chId];
+  Int      iBitShift  = m_filterUps[0].nlog2Norm + m_filterUps[2].nlog2Norm;
+  Int      iOffset    = iBitShift ? (1 << (iBitShift - 1)) : 0;
+  for (Int j = 0; j < nHeightC; j++)
+  {
+    filterRow<1, 1, false>(pSrc0, iStrideSrc, m_filterUps + 2, pTmp0 + 1, nWidthTmp);
+    filterRow<1, 1, false>(pSrc1, iStrideSrc, m_filterUps + 3, pTmp1 + 1, nWidthTmp);
+    filterRow<1, 2, true>(pTmp0 + iHorStart0, 1, m_filterUps, pOut, nWidthC, iOffset, iBitShift, m_nBitDepth);
+    filterRow<1, 2, true>(pTmp0 + iHorStart1, 1, m_filterUps + 1, pOut + 1, nWidthC, iOffset, iBitShift, m_nBitDepth);
+    pOut += iStrideDst;
+    filterRow<1, 2, true>(pTmp1 + iHorStart0, 1, m_filterUps, pOut, nWidthC, iOffset, iBitShift, m_nBitDepth);
+    filterRow<1, 2, true>(pTmp1 + iHorStart1, 1, m_filterUps + 1, pOut + 1, nWidthC, iOffset, iBitShift, m_nBitDepth);
+    pOut += iStrideDst;
+    pSrc0 += iStrideSrc;
+    pSrc1 += iStrideSrc;
+  }
+#else
   if (!m_pUpsTempBuf)
   {
     m_iUpsTempBufMarginSize = std::max(m_filterUps[0].nTaps, m_filterUps[1].nTaps) >> 1;   // 2: 4 tap filter;
@@ -468,8 +627,8 @@ Void TGeometry::chromaUpsample(Pel *pSrcBuf, Int nWidthC, Int nHeightC, Int iStr
   }
   Int *pDst0 = m_pUpsTempBuf + 1;
   Int *pDst1 = pDst0 + m_iStrideUpsTempBuf;
-  Pel *pSrc0 = pSrcBuf - m_iUpsTempBufMarginSize + 1 + (m_filterUps[2].nTaps > 1 ? -iStrideSrc : 0);
-  Pel *pSrc1 = pSrcBuf - m_iUpsTempBufMarginSize + 1;
+  T   *pSrc0 = pSrcBuf - m_iUpsTempBufMarginSize + 1 + (m_filterUps[2].nTaps > 1 ? -iStrideSrc : 0);
+  T   *pSrc1 = pSrcBuf - m_iUpsTempBufMarginSize + 1;
   for (Int j = 0; j < nHeightC; j++)
   {
     for (Int i = 0; i < nWidthC + 2 * m_iUpsTempBufMarginSize - 1; i++)
@@ -484,11 +643,11 @@ Void TGeometry::chromaUpsample(Pel *pSrcBuf, Int nWidthC, Int nHeightC, Int iStr
     pDst1 += (m_iStrideUpsTempBuf << 1);
   }
   // horizontal filtering; [-4, 36, 36, -4]
-  pDst0          = m_pUpsTempBuf + m_iUpsTempBufMarginSize + (m_filterUps[0].nTaps > 1 ? -1 : 0);
-  pDst1          = m_pUpsTempBuf + m_iUpsTempBufMarginSize;
-  Pel *pOut      = m_pFacesOrig[iFaceId][chId];
-  Int  iBitShift = m_filterUps[0].nlog2Norm + m_filterUps[2].nlog2Norm;
-  Int  iOffset   = iBitShift ? (1 << (iBitShift - 1)) : 0;
+  pDst0              = m_pUpsTempBuf + m_iUpsTempBufMarginSize + (m_filterUps[0].nTaps > 1 ? -1 : 0);
+  pDst1              = m_pUpsTempBuf + m_iUpsTempBufMarginSize;
+  FacePel *pOut      = m_pFacesOrig[iFaceId][chId];
+  Int      iBitShift = m_filterUps[0].nlog2Norm + m_filterUps[2].nlog2Norm;
+  Int      iOffset   = iBitShift ? (1 << (iBitShift - 1)) : 0;
   for (Int j = 0; j < nHeight; j++)
   {
     for (Int i = 0; i < nWidthC; i++)
@@ -502,14 +661,31 @@ Void TGeometry::chromaUpsample(Pel *pSrcBuf, Int nWidthC, Int nHeightC, Int iStr
     pDst0 += m_iStrideUpsTempBuf;
     pDst1 += m_iStrideUpsTempBuf;
   }
+#endif
 }
+template Void TGeometry::chromaUpsample<Pel>(Pel *pSrcBuf, Int nWidthC, Int nHeightC, Int iStrideSrc, Int iFaceId, ComponentID chId);
+#if SVIDEO_8BIT_FACE_STORAGE
+template Void TGeometry::chromaUpsample<FacePel>(FacePel *pSrcBuf, Int nWidthC, Int nHeightC, Int iStrideSrc, Int iFaceId, ComponentID chId);
+#endif
 
 // horizontal 2:1 downsampling; //[1,6,1]
-Void TGeometry::chromaDonwsampleH(Pel *pSrcBuf, Int iWidth, Int iHeight, Int iStrideSrc, Int iNumPels, Pel *pDstBuf,
+Void TGeometry::chromaDonwsampleH(FacePel *pSrcBuf, Int iWidth, Int iHeight, Int iStrideSrc, Int iNumPels, Pel *pDstBuf,
                                   Int iStrideDst)
 {
-  Pel *pSrc = pSrcBuf;
-  Pel *pDst = pDstBuf;
+  FacePel *pSrc = pSrcBuf;
+  Pel     *pDst = pDstBuf;
+#if SVIDEO_FUSED_CHROMA_RESAMPLING
+  if (iNumPels == 1)
+  {
+    for (Int j = 0; j < iHeight; j++)
+    {
+      filterRow<2, 1, false>(pSrc, 1, m_filterDs, pDst, iWidth >> 1);
+      pSrc += iStrideSrc;
+      pDst += iStrideDst;
+    }
+    return;
+  }
+#endif
   for (Int j = 0; j < iHeight; j++)
   {
     for (Int i = 0; i < (iWidth >> 1); i++)
@@ -523,16 +699,28 @@ Void TGeometry::chromaDonwsampleH(Pel *pSrcBuf, Int iWidth, Int iHeight, Int iSt
 }
 
 // vertical 2:1 downsampling; //[1, 1]
-Void TGeometry::chromaDonwsampleV(Pel *pSrcBuf, Int iWidth, Int iHeight, Int iStrideSrc, Int iNumPels, Pel *pDstBuf,
+Void TGeometry::chromaDonwsampleV(Pel *pSrcBuf, Int iWidth, Int iHeight, Int iStrideSrc, Int iNumPels, FacePel *pDstBuf,
                                   Int iStrideDst)
 {
   Int  iBitShift = m_filterDs[0].nlog2Norm + m_filterDs[1].nlog2Norm + (m_nBitDepth - m_nOutputBitDepth);   // 3+1;
   Int  iOffset   = iBitShift ? (1 << (iBitShift - 1)) : 0;
   Pel *pSrc      = pSrcBuf;
   // Pel *pSrc1 = pSrcBuf+iStrideSrc;
-  Pel *pDst        = pDstBuf;
+  FacePel *pDst    = pDstBuf;
   Int  iStrideSrc2 = iStrideSrc << 1;
 
+#if SVIDEO_FUSED_CHROMA_RESAMPLING
+  if (iNumPels == 1)
+  {
+    for (Int j = 0; j < (iHeight >> 1); j++)
+    {
+      filterRow<1, 1, true>(pSrc, iStrideSrc, m_filterDs + 1, pDst, iWidth, iOffset, iBitShift, m_nOutputBitDepth);
+      pSrc += iStrideSrc2;
+      pDst += iStrideDst;
+    }
+    return;
+  }
+#endif
   for (Int j = 0; j < (iHeight >> 1); j++)
   {
     for (Int i = 0; i < iWidth; i++)
@@ -546,6 +734,31 @@ Void TGeometry::chromaDonwsampleV(Pel *pSrcBuf, Int iWidth, Int iHeight, Int iSt
   }
 }
 
+#if SVIDEO_FUSED_CHROMA_RESAMPLING
+// 444->420; the rows of the horizontally downsampled strip (pBuf422, including the margin of the vertical filter) are
+// still in the cache when the strip is downsampled vertically;
+Void TGeometry::chromaDonwsampleHV(FacePel *pSrcBuf, Int iWidth, Int iHeight, Int iStrideSrc, Pel *pBuf422, Int iStride422,
+                                   FacePel *pDstBuf, Int iStrideDst)
+{
+  Int nMarginSize = (m_filterDs[1].nTaps - 1) >> 1;
+  Int nHeight422  = iHeight + nMarginSize * 2;
+  Int nRows422    = 0;   // rows of pBuf422 filtered so far;
+  for (Int j0 = 0; j0 < (iHeight >> 1); j0 += S_CHROMA_DS_STRIP)
+  {
+    Int j1      = std::min(j0 + S_CHROMA_DS_STRIP, iHeight >> 1);
+    Int nRowEnd = std::min(2 * (j1 - 1) + m_filterDs[1].nTaps, nHeight422);
+    if (nRowEnd > nRows422)
+    {
+      chromaDonwsampleH(pSrcBuf + (nRows422 - nMarginSize) * iStrideSrc, iWidth, nRowEnd - nRows422, iStrideSrc, 1,
+                        pBuf422 + nRows422 * iStride422, iStride422);
+      nRows422 = nRowEnd;
+    }
+    chromaDonwsampleV(pBuf422 + (nMarginSize + 2 * j0) * iStride422, iWidth >> 1, (j1 - j0) << 1, iStride422, 1,
+                      pDstBuf + j0 * iStrideDst, iStrideDst);
+  }
+}
+#endif
+
 #if !SVIDEO_CHROMA_TYPES_SUPPORT
 // forward resampling;
 Void TGeometry::chromaResampleType0toType2(Pel *pSrcBuf, Int nWidthC, Int nHeightC, Int iStrideSrc, Pel *pDstBuf,
@@ -736,6 +949,63 @@ Void TGeometry::initFilterWeightLut()
           }
         }
       }
+#if SVIDEO_YAW_ROTATION_SHIFT
+      //the kernels of the integer rows are the first S_LANCZOS_LUT_SCALE+1 ones;
+      Int iTapsX   = m_iInterpFilterTaps[i][0];
+      Int iMidTap  = ((m_iInterpFilterTaps[i][1] - 1) >> 1) * iTapsX + ((iTapsX - 1) >> 1);
+      m_bHorWeightLut[i] = m_bIdentityWeight[i] = true;
+      for (Int n = 0; n < (S_LANCZOS_LUT_SCALE + 1); n++)
+      {
+        for (Int k = 0; k < iFilterSize; k++)
+        {
+          if (k / iTapsX != iMidTap / iTapsX && m_pWeightLut[i][n][k])
+            m_bHorWeightLut[i] = false;
+          if (!n && m_pWeightLut[i][n][k] != (k == iMidTap ? (1 << S_INTERPOLATE_PrecisionBD) : 0))
+            m_bIdentityWeight[i] = false;
+        }
+      }
+#endif
+#if SVIDEO_SEPARABLE_TWO_PASS_FILTER
+      //1-D kernels of the same phases, normalized and completed by the last tap as the 2-D ones;
+      Int iTaps = m_iInterpFilterTaps[i][0];
+      Int mul   = 1 << (S_INTERPOLATE_PrecisionBD);
+      m_weightLut1D[i].assign((S_LANCZOS_LUT_SCALE + 1) * iTaps, 0);
+      for (Int m = 0; m < (S_LANCZOS_LUT_SCALE + 1); m++)
+      {
+        Double t = m * (1.0 / S_LANCZOS_LUT_SCALE);
+        Double w[6], dSum = 0;
+        if (m_InterpolationType[i] == SI_NN)
+          w[0] = 1;
+        else if (m_InterpolationType[i] == SI_BILINEAR)
+        {
+          w[0] = 1 - t;
+          w[1] = t;
+        }
+        else if (m_InterpolationType[i] == SI_BICUBIC)
+        {
+          w[0] = (POSType)(0.5 * (-t * t * t + 2 * t * t - t));
+          w[1] = (POSType)(0.5 * (3 * t * t * t - 5 * t * t + 2));
+          w[2] = (POSType)(0.5 * (-3 * t * t * t + 4 * t * t + t));
+          w[3] = (POSType)(0.5 * (t * t * t - t * t));
+        }
+        else
+        {
+          for (Int k = -m_iLanczosParamA[i]; k < m_iLanczosParamA[i]; k++)
+            w[k + m_iLanczosParamA[i]] =
+              m_pfLanczosFltCoefLut[i][(Int)((sfabs(t - k - 1) + m_iLanczosParamA[i]) * S_LANCZOS_LUT_SCALE + 0.5)];
+        }
+        for (Int k = 0; k < iTaps; k++)
+          dSum += w[k];
+        Int *pW  = &m_weightLut1D[i][m * iTaps];
+        Int  sum = 0;
+        for (Int k = 0; k < iTaps - 1; k++)
+        {
+          pW[k] = (Int)round(w[k] * mul / dSum);
+          sum += pW[k];
+        }
+        pW[iTaps - 1] = mul - sum;
+      }
+#endif
     }
   }
 }
@@ -910,6 +1180,11 @@ Void TGeometry::geometryMapping(TGeometry *pGeoSrc)
       && ((m_chromaFormatIDC == CHROMA_444) || (m_chromaFormatIDC == CHROMA_420 && m_bResampleChroma)))
 #endif
     m_bConvOutputPaddingNeeded = true;
+#if SVIDEO_ROTATED_SPHERE && SVIDEO_RSP_420_OUTPUT_PADDING
+  //the arcs packed by framePack() reach beyond the samples inside the faces;
+  if (m_sVideoInfo.geoType == SVIDEO_ROTATEDSPHERE && m_sVideoInfo.framePackStruct.chromaFormatIDC == CHROMA_420)
+    m_bConvOutputPaddingNeeded = true;
+#endif
 
 #if SVIDEO_GCMP_PADDING_TYPE
   if (m_sVideoInfo.geoType == SVIDEO_GENERALIZEDCUBEMAP && m_sVideoInfo.bPGCMP && m_sVideoInfo.iPGCMPPaddingType == 3)
@@ -924,7 +1199,7 @@ Void TGeometry::geometryMapping(TGeometry *pGeoSrc)
       {
         Int iTotalHeight = (m_sVideoInfo.iFaceHeight + (m_iMarginY << 1)) >> getComponentScaleY(ComponentID(j));
         xFree(m_pFacesBuf[i][j]);
-        m_pFacesBuf[i][j] = (Pel *) xMalloc(Pel, getStride(ComponentID(j)) * iTotalHeight);
+        m_pFacesBuf[i][j] = (FacePel *) xMalloc(FacePel, getStride(ComponentID(j)) * iTotalHeight);
         m_pFacesOrig[i][j] =
           m_pFacesBuf[i][j] + getStride(ComponentID(j)) * getMarginY(ComponentID(j)) + getMarginX(ComponentID(j));
       }
@@ -932,6 +1207,27 @@ Void TGeometry::geometryMapping(TGeometry *pGeoSrc)
   }
 #endif
 
+#if SVIDEO_SEPARABLE_CUBE_MAPPING
+  //between cube based geometries without rotation, the source column of a sample only depends on its column and the
+  //source row on its row; only the samples inside the faces are mapped;
+  Bool bSeparable = xIsSeparableCube(m_sVideoInfo) && xIsSeparableCube(pGeoSrc->m_sVideoInfo) && !pRot[0] && !pRot[1] && !pRot[2];
+#if SVIDEO_SEPARABLE_CYLINDER_MAPPING
+  //so is it between the cylindrical projections, the rows of which are the parallels; the longitude the per sample
+  //table gets from satan2() in each row is taken from the middle row, so the result is equal up to its rounding only;
+#if SVIDEO_YAW_ROTATION_SHIFT
+  //a rotation around the polar axis only shifts the meridians;
+#if SVIDEO_ROT_FIX
+  Bool bPolarRot = !pRot[0] && !pRot[1];
+#else
+  Bool bPolarRot = !pRot[0] && !pRot[2];
+#endif
+#else
+  Bool bPolarRot = !pRot[0] && !pRot[1] && !pRot[2];
+#endif
+  bSeparable = bSeparable || (xIsSeparableCylinder(m_sVideoInfo) && xIsSeparableCylinder(pGeoSrc->m_sVideoInfo) && bPolarRot);
+#endif
+  bSeparable = bSeparable && !m_bConvOutputPaddingNeeded;
+#endif
   for (Int fIdx = 0; fIdx < m_sVideoInfo.iNumFaces; fIdx++)
   {
 #if SVIDEO_GENERALIZED_CUBEMAP
@@ -943,6 +1239,19 @@ Void TGeometry::geometryMapping(TGeometry *pGeoSrc)
       if (fIdx == virtualFaceIdx)
         continue;
     }
+#endif
+#if SVIDEO_SEPARABLE_CUBE_MAPPING
+#if SVIDEO_YAW_ROTATION_SHIFT
+#if SVIDEO_ROT_FIX
+    m_bSeparableMapping[fIdx] = bSeparable && xBuildSeparableMapping(pGeoSrc, fIdx, iNumMaps, pRot, bRec);
+#else
+    m_bSeparableMapping[fIdx] = bSeparable && xBuildSeparableMapping(pGeoSrc, fIdx, iNumMaps, pRot, false);
+#endif
+#else
+    m_bSeparableMapping[fIdx] = bSeparable && xBuildSeparableMapping(pGeoSrc, fIdx, iNumMaps);
+#endif
+    if (m_bSeparableMapping[fIdx])
+      continue;
 #endif
     for (Int ch = 0; ch < iNumMaps; ch++)
     {
@@ -975,6 +1284,10 @@ Void TGeometry::geometryMapping(TGeometry *pGeoSrc)
       if (fIdx == virtualFaceIdx)
         continue;
     }
+#endif
+#if SVIDEO_SEPARABLE_CUBE_MAPPING
+    if (m_bSeparableMapping[fIdx])
+      continue;
 #endif
     for (Int ch = 0; ch < iNumMaps; ch++)
     {
@@ -1055,6 +1368,14 @@ Void TGeometry::geometryMapping(TGeometry *pGeoSrc)
               pos3D.y       = 0;
               (pGeoSrc->*pGeoSrc->m_interpolateWeight[toChannelType(chId)])(chId, &pos3D, wList);
             }
+#endif
+#if SVIDEO_DEMAND_SPHERE_PADDING
+            if (pGeoSrc->m_bDemandPadding)
+            {
+              pGeoSrc->xAddPaddingDemand(ch, wList);
+              if (iNumMaps == 1 && pGeoSrc->getNumChannels() > 1)
+                pGeoSrc->xAddPaddingDemand(1, wList);
+            }
 #endif
           }
         }
@@ -1063,124 +1384,1065 @@ Void TGeometry::geometryMapping(TGeometry *pGeoSrc)
   m_bGeometryMapping = true;
 }
 
-/***************************************************
-//convert source geometry to destination geometry;
-****************************************************/
-Void TGeometry::geoConvert(TGeometry *pGeoDst
+#if SVIDEO_SEPARABLE_CUBE_MAPPING || SVIDEO_MAPPING_ACCURACY_CHECK
+//the source position of one sample as derived by geometryMapping();
+Void TGeometry::xMapSamplePos(TGeometry *pGeoSrc, Int fIdx, ComponentID chId, Int i, Int j, Int *pRot, Bool bInvRot, SPos &pos)
+{
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+  Double chromaOffsetSrc[2] = { 0.0, 0.0 };   //[0: X; 1: Y];
+  Double chromaOffsetDst[2] = { 0.0, 0.0 };   //[0: X; 1: Y];
+  getFaceChromaOffset(chromaOffsetDst, fIdx, chId);
+  POSType x = i * (1 << getComponentScaleX(chId)) + chromaOffsetDst[0];
+  POSType y = j * (1 << getComponentScaleY(chId)) + chromaOffsetDst[1];
+#else
+  POSType x = i * (1 << getComponentScaleX(chId));
+  POSType y = j * (1 << getComponentScaleY(chId));
+#endif
+  SPos in(fIdx, x, y, 0);
+
+  map2DTo3D(in, &pos);
 #if SVIDEO_ROT_FIX
-                           ,
-                           Bool bRec
+  if (bInvRot)
+    invRotate3D(pos, pRot[0], pRot[1], pRot[2]);
+  else
+    rotate3D(pos, pRot[0], pRot[1], pRot[2]);
+#else
+  rotate3D(pos, pRot[0], pRot[1], pRot[2]);
 #endif
-)
+  pGeoSrc->map3DTo2D(&pos, &pos);
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+  pGeoSrc->getFaceChromaOffset(chromaOffsetSrc, pos.faceIdx, chId);
+  pos.x = (pos.x - chromaOffsetSrc[0]) / POSType(1 << getComponentScaleX(chId));
+  pos.y = (pos.y - chromaOffsetSrc[1]) / POSType(1 << getComponentScaleY(chId));
+#else
+  pos.x = pos.x / POSType(1 << getComponentScaleX(chId));
+  pos.y = pos.y / POSType(1 << getComponentScaleY(chId));
+#endif
+}
+#endif
+
+#if SVIDEO_SEPARABLE_CUBE_MAPPING
+Bool TGeometry::xIsSeparableCube(SVideoInfo &sVideoInfo)
 {
-  // padding;
-  spherePadding();
+  switch (sVideoInfo.geoType)
+  {
+  case SVIDEO_CUBEMAP:
+#if SVIDEO_ADJUSTED_CUBEMAP
+  case SVIDEO_ADJUSTEDCUBEMAP:
+#endif
+#if SVIDEO_EQUIANGULAR_CUBEMAP
+  case SVIDEO_EQUIANGULARCUBEMAP:
+#endif
+    return true;
+#if SVIDEO_GENERALIZED_CUBEMAP
+  case SVIDEO_GENERALIZEDCUBEMAP:
+    //the parameterized mapping is separable unless a coordinate is adjusted by the other one;
+    if (sVideoInfo.iGCMPMappingType == 2)
+    {
+      for (Int i = 0; i < 6; i++)
+      {
+        if (sVideoInfo.GCMPSettings.bUAffectedByV[i] || sVideoInfo.GCMPSettings.bVAffectedByU[i])
+          return false;
+      }
+    }
+    return true;
+#endif
+  default:
+    return false;
+  }
+}
 
-  if (!pGeoDst->m_bGeometryMapping)
-#if SVIDEO_ROT_FIX
-    pGeoDst->geometryMapping(this, bRec);
+#if SVIDEO_SEPARABLE_CYLINDER_MAPPING
+//the latitude only depends on the row and the longitude is linear in the column;
+Bool TGeometry::xIsSeparableCylinder(SVideoInfo &sVideoInfo)
+{
+#if SVIDEO_ADJUSTED_EQUALAREA
+  return sVideoInfo.geoType == SVIDEO_EQUIRECT || sVideoInfo.geoType == SVIDEO_ADJUSTEDEQUALAREA;
 #else
-    pGeoDst->geometryMapping(this);
+  return sVideoInfo.geoType == SVIDEO_EQUIRECT || sVideoInfo.geoType == SVIDEO_EQUALAREA;
+#endif
+}
 #endif
 
-  Int nFaces             = pGeoDst->m_sVideoInfo.iNumFaces;
-  Int iBDPrecision       = S_INTERPOLATE_PrecisionBD;
-  Int iWeightMapFaceMask = (1 << m_WeightMap_NumOfBits4Faces) - 1;
-  Int iOffset            = 1 << (iBDPrecision - 1);
+//the mapping of one sample as done by geometryMapping();
+#if SVIDEO_YAW_ROTATION_SHIFT
+Void TGeometry::xMapSampleWeight(TGeometry *pGeoSrc, Int fIdx, ComponentID chId, Int i, Int j, Int *pRot, Bool bInvRot, PxlFltLut &wList)
+#else
+Void TGeometry::xMapSampleWeight(TGeometry *pGeoSrc, Int fIdx, ComponentID chId, Int i, Int j, PxlFltLut &wList)
+#endif
+{
+  SPos pos;
+#if SVIDEO_YAW_ROTATION_SHIFT
+  xMapSamplePos(pGeoSrc, fIdx, chId, i, j, pRot, bInvRot, pos);
+#else
+  Int iRot[3] = { 0, 0, 0 };
+  xMapSamplePos(pGeoSrc, fIdx, chId, i, j, iRot, false, pos);
+#endif
+  (pGeoSrc->*pGeoSrc->m_interpolateWeight[toChannelType(chId)])(chId, &pos, wList);
+}
 
-  for (Int fIdx = 0; fIdx < nFaces; fIdx++)
+/***************************************************
+//the columns are mapped along the middle row and the rows along the middle column;
+//a column entry holds the horizontal offset from the middle column and the horizontal weight index,
+//a row entry the source face, the position of the middle column and the vertical weight index;
+//false if a sample is not mapped to the same source face, the per sample table is used then;
+****************************************************/
+#if SVIDEO_YAW_ROTATION_SHIFT
+Bool TGeometry::xBuildSeparableMapping(TGeometry *pGeoSrc, Int fIdx, Int iNumMaps, Int *pRot, Bool bInvRot)
+#else
+Bool TGeometry::xBuildSeparableMapping(TGeometry *pGeoSrc, Int fIdx, Int iNumMaps)
+#endif
+{
+  Int iFaceMask = (1 << pGeoSrc->m_WeightMap_NumOfBits4Faces) - 1;
+  Int iWeightsX = S_LANCZOS_LUT_SCALE + 1;
+
+  for (Int ch = 0; ch < iNumMaps; ch++)
   {
-#if SVIDEO_GENERALIZED_CUBEMAP
-    if (pGeoDst->m_sVideoInfo.geoType == SVIDEO_GENERALIZEDCUBEMAP
-        && (pGeoDst->m_sVideoInfo.iGCMPPackingType == 4 || pGeoDst->m_sVideoInfo.iGCMPPackingType == 5))
+    ComponentID chId      = (ComponentID) ch;
+    Int         iWidth    = m_sVideoInfo.iFaceWidth >> getComponentScaleX(chId);
+    Int         iHeight   = m_sVideoInfo.iFaceHeight >> getComponentScaleY(chId);
+    Int         iHeightPW = (m_sVideoInfo.iFaceHeight + (m_iMarginY << 1)) >> getComponentScaleY(chId);
+
+    if (!m_pPixelWeightSep[fIdx][ch][0])
     {
-      Int virtualFaceIdx = pGeoDst->m_sVideoInfo.iGCMPPackingType == 4
-                             ? pGeoDst->m_sVideoInfo.framePackStruct.faces[0][5].id
-                             : pGeoDst->m_sVideoInfo.framePackStruct.faces[5][0].id;
-      if (fIdx == virtualFaceIdx)
-        continue;
+      m_pPixelWeightSep[fIdx][ch][0] = new PxlFltLut[getStride(chId)];
+      m_pPixelWeightSep[fIdx][ch][1] = new PxlFltLut[iHeightPW];
+    }
+    PxlFltLut *pColWeight = m_pPixelWeightSep[fIdx][ch][0] + getMarginX(chId);
+    PxlFltLut *pRowWeight = m_pPixelWeightSep[fIdx][ch][1] + getMarginY(chId);
+    PxlFltLut  wCenter, wList;
+
+#if SVIDEO_YAW_ROTATION_SHIFT
+    xMapSampleWeight(pGeoSrc, fIdx, chId, iWidth >> 1, iHeight >> 1, pRot, bInvRot, wCenter);
+#else
+    xMapSampleWeight(pGeoSrc, fIdx, chId, iWidth >> 1, iHeight >> 1, wCenter);
+#endif
+    Int face = wCenter.facePos & iFaceMask;
+    for (Int i = 0; i < iWidth; i++)
+    {
+#if SVIDEO_YAW_ROTATION_SHIFT
+      xMapSampleWeight(pGeoSrc, fIdx, chId, i, iHeight >> 1, pRot, bInvRot, wList);
+#else
+      xMapSampleWeight(pGeoSrc, fIdx, chId, i, iHeight >> 1, wList);
+#endif
+      if ((wList.facePos & iFaceMask) != face)
+        return false;
+      pColWeight[i].facePos   = (wList.facePos & ~iFaceMask) - (wCenter.facePos & ~iFaceMask);
+      pColWeight[i].weightIdx = wList.weightIdx % iWeightsX;
+    }
+    for (Int j = 0; j < iHeight; j++)
+    {
+#if SVIDEO_YAW_ROTATION_SHIFT
+      xMapSampleWeight(pGeoSrc, fIdx, chId, iWidth >> 1, j, pRot, bInvRot, wList);
+#else
+      xMapSampleWeight(pGeoSrc, fIdx, chId, iWidth >> 1, j, wList);
+#endif
+      if ((wList.facePos & iFaceMask) != face)
+        return false;
+      pRowWeight[j].facePos   = wList.facePos;
+      pRowWeight[j].weightIdx = wList.weightIdx - wList.weightIdx % iWeightsX;
+    }
+#if SVIDEO_SEPARABLE_TWO_PASS_FILTER
+    //the source rows are filtered once for all the rows of the face if they are read at the same columns;
+    {
+      Int iStride = pGeoSrc->getStride(chId);
+      Int iOrg    = pGeoSrc->getMarginY(chId) * iStride + pGeoSrc->getMarginX(chId);
+      Int iCol    = ((pRowWeight[0].facePos >> pGeoSrc->m_WeightMap_NumOfBits4Faces) + iOrg) % iStride;
+      m_bSepTwoPass[fIdx][ch] = true;
+      for (Int j = 1; j < iHeight && m_bSepTwoPass[fIdx][ch]; j++)
+        m_bSepTwoPass[fIdx][ch] = (((pRowWeight[j].facePos >> pGeoSrc->m_WeightMap_NumOfBits4Faces) + iOrg) % iStride == iCol);
+    }
+#endif
+#if SVIDEO_YAW_ROTATION_SHIFT
+    //the columns are a circular shift of the source columns if they are all at integer positions;
+    Int iSrcWidth  = pGeoSrc->m_sVideoInfo.iFaceWidth >> pGeoSrc->getComponentScaleX(chId);
+    Int iSrcStride = pGeoSrc->getStride(chId);
+    Int iSrcOrg    = pGeoSrc->getMarginY(chId) * iSrcStride + pGeoSrc->getMarginX(chId);
+    Int iShift     = -1;
+    for (Int i = 0; i < iWidth && iWidth == iSrcWidth; i++)
+    {
+      Int iPos = ((pRowWeight[iHeight >> 1].facePos + pColWeight[i].facePos) >> pGeoSrc->m_WeightMap_NumOfBits4Faces) + iSrcOrg;
+      Int x    = iPos % iSrcStride - pGeoSrc->getMarginX(chId);
+      if (!i)
+        iShift = x;
+      if (pColWeight[i].weightIdx || iShift < 0 || iShift >= iWidth || x != (i + iShift) % iWidth)
+      {
+        iShift = -1;
+        break;
+      }
+    }
+    for (Int j = 0; j < iHeight && iShift >= 0; j++)
+    {
+      Int iPos = (pRowWeight[j].facePos >> pGeoSrc->m_WeightMap_NumOfBits4Faces) + iSrcOrg;
+      Int iMid = (pRowWeight[iHeight >> 1].facePos >> pGeoSrc->m_WeightMap_NumOfBits4Faces) + iSrcOrg;
+      if (iPos % iSrcStride != iMid % iSrcStride)
+        iShift = -1;
+    }
+    m_iSepColumnShift[fIdx][ch] = iShift;
+#endif
+  }
+
+#if SVIDEO_DEMAND_SPHERE_PADDING
+  //only the windows of the columns or the rows reaching the margins of the source face read margin samples;
+  if (pGeoSrc->m_bDemandPadding)
+  {
+    for (Int ch = 0; ch < iNumMaps; ch++)
+    {
+      ComponentID      chId       = (ComponentID) ch;
+      ChannelType      chType     = toChannelType(chId);
+      Int              iWidth     = m_sVideoInfo.iFaceWidth >> getComponentScaleX(chId);
+      Int              iHeight    = m_sVideoInfo.iFaceHeight >> getComponentScaleY(chId);
+      Int              iSrcWidth  = pGeoSrc->m_sVideoInfo.iFaceWidth >> pGeoSrc->getComponentScaleX(chId);
+      Int              iSrcHeight = pGeoSrc->m_sVideoInfo.iFaceHeight >> pGeoSrc->getComponentScaleY(chId);
+      Int              iSrcStride = pGeoSrc->getStride(chId);
+      Int              iSrcOrg    = pGeoSrc->getMarginY(chId) * iSrcStride + pGeoSrc->getMarginX(chId);
+      Int              iTapsX     = pGeoSrc->m_iInterpFilterTaps[chType][0];
+      Int              iTapsY     = pGeoSrc->m_iInterpFilterTaps[chType][1];
+      PxlFltLut       *pColWeight = m_pPixelWeightSep[fIdx][ch][0] + getMarginX(chId);
+      PxlFltLut       *pRowWeight = m_pPixelWeightSep[fIdx][ch][1] + getMarginY(chId);
+      std::vector<Int> bColPad(iWidth), bRowPad(iHeight);
+      PxlFltLut        wList;
+
+      for (Int i = 0; i < iWidth; i++)
+      {
+        Int iPos = ((pRowWeight[iHeight >> 1].facePos + pColWeight[i].facePos) >> pGeoSrc->m_WeightMap_NumOfBits4Faces) + iSrcOrg;
+        Int x0   = iPos % iSrcStride - pGeoSrc->getMarginX(chId) - ((iTapsX - 1) >> 1);
+        bColPad[i] = (x0 < 0 || x0 + iTapsX > iSrcWidth);
+      }
+      for (Int j = 0; j < iHeight; j++)
+      {
+        Int iPos = ((pRowWeight[j].facePos + pColWeight[iWidth >> 1].facePos) >> pGeoSrc->m_WeightMap_NumOfBits4Faces) + iSrcOrg;
+        Int y0   = iPos / iSrcStride - pGeoSrc->getMarginY(chId) - ((iTapsY - 1) >> 1);
+        bRowPad[j] = (y0 < 0 || y0 + iTapsY > iSrcHeight);
+      }
+      for (Int j = 0; j < iHeight; j++)
+      {
+        for (Int i = 0; i < iWidth; i++)
+        {
+          if (!bRowPad[j] && !bColPad[i])
+            continue;
+          wList.facePos   = pRowWeight[j].facePos + pColWeight[i].facePos;
+          wList.weightIdx = pRowWeight[j].weightIdx + pColWeight[i].weightIdx;
+          pGeoSrc->xAddPaddingDemand(ch, wList);
+          if (iNumMaps == 1 && pGeoSrc->getNumChannels() > 1)
+            pGeoSrc->xAddPaddingDemand(1, wList);
+        }
+      }
     }
+  }
+#endif
+  return true;
+}
+
+//x, y: position in the table, the margins included;
+PxlFltLut TGeometry::getPixelWeight(Int fIdx, Int mapIdx, Int x, Int y)
+{
+  if (!m_bSeparableMapping[fIdx])
+    return m_pPixelWeight[fIdx][mapIdx][y * getStride((ComponentID) mapIdx) + x];
+
+  PxlFltLut wList;
+  wList.facePos   = m_pPixelWeightSep[fIdx][mapIdx][1][y].facePos + m_pPixelWeightSep[fIdx][mapIdx][0][x].facePos;
+  wList.weightIdx = m_pPixelWeightSep[fIdx][mapIdx][1][y].weightIdx + m_pPixelWeightSep[fIdx][mapIdx][0][x].weightIdx;
+  return wList;
+}
+
+//geoConvert() of one channel of a face mapped by the column and row tables;
+Void TGeometry::xGeoConvertSeparable(TGeometry *pGeoDst, Int fIdx, Int ch)
+{
+  ComponentID chId    = (ComponentID) ch;
+  ChannelType chType  = toChannelType(chId);
+  Int         nWidth  = pGeoDst->m_sVideoInfo.iFaceWidth >> pGeoDst->getComponentScaleX(chId);
+  Int         nHeight = pGeoDst->m_sVideoInfo.iFaceHeight >> pGeoDst->getComponentScaleY(chId);
+  Int         mapIdx =
+    (pGeoDst->m_chromaFormatIDC == CHROMA_444
+     && pGeoDst->m_InterpolationType[CHANNEL_TYPE_LUMA] == pGeoDst->m_InterpolationType[CHANNEL_TYPE_CHROMA])
+      ? 0
+      : (ch > 0 ? 1 : 0);
+  Int iWLutIdx = (m_chromaFormatIDC == CHROMA_400 || (m_InterpolationType[0] == m_InterpolationType[1])) ? 0 : chType;
+  Int iBDPrecision       = S_INTERPOLATE_PrecisionBD;
+  Int iOffset            = 1 << (iBDPrecision - 1);
+  Int iWeightMapFaceMask = (1 << m_WeightMap_NumOfBits4Faces) - 1;
+  Int iTapsX             = m_iInterpFilterTaps[chType][0];
+  Int iTapsY             = m_iInterpFilterTaps[chType][1];
+  Int iStride            = getStride(chId);
+  Int iStrideDst         = pGeoDst->getStride(chId);
+
+  PxlFltLut *pColWeight = pGeoDst->m_pPixelWeightSep[fIdx][mapIdx][0] + pGeoDst->getMarginX(chId);
+  PxlFltLut *pRowWeight = pGeoDst->m_pPixelWeightSep[fIdx][mapIdx][1] + pGeoDst->getMarginY(chId);
+  FacePel   *pSrc       = m_pFacesOrig[pRowWeight[0].facePos & iWeightMapFaceMask][ch]
+                   - ((iTapsY - 1) >> 1) * iStride - ((iTapsX - 1) >> 1);
+  FacePel   *pDst       = pGeoDst->m_pFacesOrig[fIdx][ch];
+
+#if SVIDEO_YAW_ROTATION_SHIFT
+  Int iMidRow = (iTapsY - 1) >> 1;
+  Int iShift  = pGeoDst->m_iSepColumnShift[fIdx][mapIdx];
+#endif
+#if SVIDEO_SEPARABLE_TWO_PASS_FILTER
+#if SVIDEO_YAW_ROTATION_SHIFT
+  if (pGeoDst->m_bSepTwoPass[fIdx][mapIdx] && iShift < 0)
+#else
+  if (pGeoDst->m_bSepTwoPass[fIdx][mapIdx])
+#endif
+  {
+    xGeoConvertTwoPass(pGeoDst, fIdx, ch);
+    return;
+  }
+#endif
+  for (Int j = 0; j < nHeight; j++)
+  {
+    FacePel *pSrcRow = pSrc + (pRowWeight[j].facePos >> m_WeightMap_NumOfBits4Faces);
+    Int **ppWLutRow = m_pWeightLut[iWLutIdx] + pRowWeight[j].weightIdx;
+#if SVIDEO_YAW_ROTATION_SHIFT
+    //the kernels of the integer rows have a single nonzero row, the sum is the same;
+    if (!pRowWeight[j].weightIdx && m_bHorWeightLut[iWLutIdx])
+    {
+      FacePel *pSrcLine = pSrcRow + iMidRow * iStride;
+      if (iShift >= 0 && m_bIdentityWeight[iWLutIdx])
+      {
+        FacePel *pLine = pSrcLine + ((iTapsX - 1) >> 1) + (pColWeight[0].facePos >> m_WeightMap_NumOfBits4Faces) - iShift;
+        memcpy(pDst, pLine + iShift, (nWidth - iShift) * sizeof(FacePel));
+        memcpy(pDst + nWidth - iShift, pLine, iShift * sizeof(FacePel));
+      }
+      else
+      {
+        for (Int i = 0; i < nWidth; i++)
+        {
+          Int *pWLut    = ppWLutRow[pColWeight[i].weightIdx] + iMidRow * iTapsX;
+          FacePel *pPelLine = pSrcLine + (pColWeight[i].facePos >> m_WeightMap_NumOfBits4Faces);
+          Int  sum      = 0;
+          for (Int n = 0; n < iTapsX; n++)
+            sum += pPelLine[n] * pWLut[n];
+#if SVIDEO_GEOCONVERT_CLIP
+          pDst[i] = ClipBD((sum + iOffset) >> iBDPrecision, m_nBitDepth);
+#else
+          pDst[i] = (sum + iOffset) >> iBDPrecision;
+#endif
+        }
+      }
+      pDst += iStrideDst;
+      continue;
+    }
+#endif
+    for (Int i = 0; i < nWidth; i++)
+    {
+      Int *pWLut    = ppWLutRow[pColWeight[i].weightIdx];
+      FacePel *pPelLine = pSrcRow + (pColWeight[i].facePos >> m_WeightMap_NumOfBits4Faces);
+      Int  sum      = 0;
+      for (Int m = 0; m < iTapsY; m++)
+      {
+        for (Int n = 0; n < iTapsX; n++)
+          sum += pPelLine[n] * pWLut[n];
+        pPelLine += iStride;
+        pWLut += iTapsX;
+      }
+#if SVIDEO_GEOCONVERT_CLIP
+      pDst[i] = ClipBD((sum + iOffset) >> iBDPrecision, m_nBitDepth);
+#else
+      pDst[i] = (sum + iOffset) >> iBDPrecision;
+#endif
+    }
+    pDst += iStrideDst;
+  }
+}
+
+#if SVIDEO_SEPARABLE_TWO_PASS_FILTER
+//geoConvert() of one channel of a face whose rows read the same source columns;
+//the source rows read by the face are filtered horizontally into a temporary buffer at full precision,
+//the rows of the face are then filtered vertically from it and rounded once;
+Void TGeometry::xGeoConvertTwoPass(TGeometry *pGeoDst, Int fIdx, Int ch)
+{
+  ComponentID chId    = (ComponentID) ch;
+  ChannelType chType  = toChannelType(chId);
+  Int         nWidth  = pGeoDst->m_sVideoInfo.iFaceWidth >> pGeoDst->getComponentScaleX(chId);
+  Int         nHeight = pGeoDst->m_sVideoInfo.iFaceHeight >> pGeoDst->getComponentScaleY(chId);
+  Int         mapIdx =
+    (pGeoDst->m_chromaFormatIDC == CHROMA_444
+     && pGeoDst->m_InterpolationType[CHANNEL_TYPE_LUMA] == pGeoDst->m_InterpolationType[CHANNEL_TYPE_CHROMA])
+      ? 0
+      : (ch > 0 ? 1 : 0);
+  Int iWLutIdx = (m_chromaFormatIDC == CHROMA_400 || (m_InterpolationType[0] == m_InterpolationType[1])) ? 0 : chType;
+  Int     iBDPrecision = S_INTERPOLATE_PrecisionBD << 1;
+  int64_t iOffset      = (int64_t) 1 << (iBDPrecision - 1);
+  Int     iFaceMask    = (1 << m_WeightMap_NumOfBits4Faces) - 1;
+  Int     iTapsX       = m_iInterpFilterTaps[chType][0];
+  Int     iTapsY       = m_iInterpFilterTaps[chType][1];
+  Int     iStride      = getStride(chId);
+  Int     iStrideDst   = pGeoDst->getStride(chId);
+  Int     iOrg         = getMarginY(chId) * iStride + getMarginX(chId);
+
+  PxlFltLut *pColWeight = pGeoDst->m_pPixelWeightSep[fIdx][mapIdx][0] + pGeoDst->getMarginX(chId);
+  PxlFltLut *pRowWeight = pGeoDst->m_pPixelWeightSep[fIdx][mapIdx][1] + pGeoDst->getMarginY(chId);
+  const Int *pWLut      = &m_weightLut1D[iWLutIdx][0];
+  FacePel   *pSrc       = m_pFacesOrig[pRowWeight[0].facePos & iFaceMask][ch];
+  FacePel   *pDst       = pGeoDst->m_pFacesOrig[fIdx][ch];
+
+  //first source row of the window of each row, first source column of the window of each column;
+  std::vector<Int> rowTop(nHeight), colLeft(nWidth);
+  Int iMidCol = ((pRowWeight[0].facePos >> m_WeightMap_NumOfBits4Faces) + iOrg) % iStride - getMarginX(chId);
+  Int iRowMin = MAX_INT, iRowMax = -MAX_INT;
+  for (Int j = 0; j < nHeight; j++)
+  {
+    rowTop[j] = ((pRowWeight[j].facePos >> m_WeightMap_NumOfBits4Faces) + iOrg) / iStride - getMarginY(chId) - ((iTapsY - 1) >> 1);
+    iRowMin   = std::min(iRowMin, rowTop[j]);
+    iRowMax   = std::max(iRowMax, rowTop[j]);
+  }
+  for (Int i = 0; i < nWidth; i++)
+    colLeft[i] = iMidCol + (pColWeight[i].facePos >> m_WeightMap_NumOfBits4Faces) - ((iTapsX - 1) >> 1);
+
+  Int                  iNumRows = iRowMax - iRowMin + iTapsY;
+  std::vector<UChar>   bRowRead(iNumRows, 0);
+  std::vector<Int>     tmp((size_t) iNumRows * nWidth);
+  std::vector<int64_t> acc(nWidth);
+  for (Int j = 0; j < nHeight; j++)
+    memset(&bRowRead[rowTop[j] - iRowMin], 1, iTapsY);
+
+  //horizontal pass;
+  for (Int r = 0; r < iNumRows; r++)
+  {
+    if (!bRowRead[r])
+      continue;
+    const FacePel *pSrcRow = pSrc + (iRowMin + r) * iStride;
+    Int           *pTmp    = &tmp[(size_t) r * nWidth];
+    for (Int i = 0; i < nWidth; i++)
+    {
+      const FacePel *pPel = pSrcRow + colLeft[i];
+      const Int     *pW   = pWLut + pColWeight[i].weightIdx * iTapsX;
+      Int            sum  = 0;
+      for (Int n = 0; n < iTapsX; n++)
+        sum += pPel[n] * pW[n];
+      pTmp[i] = sum;
+    }
+  }
+  //vertical pass;
+  for (Int j = 0; j < nHeight; j++)
+  {
+    const Int *pW   = pWLut + pRowWeight[j].weightIdx / (S_LANCZOS_LUT_SCALE + 1) * iTapsY;
+    const Int *pTmp = &tmp[(size_t) (rowTop[j] - iRowMin) * nWidth];
+    std::fill(acc.begin(), acc.end(), iOffset);
+    for (Int m = 0; m < iTapsY; m++, pTmp += nWidth)
+    {
+      for (Int i = 0; i < nWidth; i++)
+        acc[i] += (int64_t) pTmp[i] * pW[m];
+    }
+    for (Int i = 0; i < nWidth; i++)
+    {
+#if SVIDEO_GEOCONVERT_CLIP
+      pDst[i] = ClipBD((Int)(acc[i] >> iBDPrecision), m_nBitDepth);
+#else
+      pDst[i] = (FacePel)(acc[i] >> iBDPrecision);
+#endif
+    }
+    pDst += iStrideDst;
+  }
+}
+#endif
+#endif
+
+#if SVIDEO_MAPPING_ACCURACY_CHECK
+/***************************************************
+//the entries of the tables from pGeoSrc for the face samples, face by face and table by table in raster scan order,
+//with the source positions they are derived from;
+****************************************************/
+Void TGeometry::xGetMappingCheckEntries(TGeometry *pGeoSrc, std::vector<MappingCheckEntry> &entries)
+{
+  if (!m_bGeometryMapping)
+    geometryMapping(pGeoSrc);
+
+  Int *pRot     = m_sVideoInfo.sVideoRotation.degree;
+  Int  iNumMaps = (m_chromaFormatIDC == CHROMA_400
+                  || (m_chromaFormatIDC == CHROMA_444 && m_InterpolationType[0] == m_InterpolationType[1]))
+                   ? 1
+                   : 2;
+  entries.clear();
+  for (Int fIdx = 0; fIdx < m_sVideoInfo.iNumFaces; fIdx++)
+  {
+#if SVIDEO_SEPARABLE_CUBE_MAPPING
+    if (!m_bSeparableMapping[fIdx] && !m_pPixelWeight[fIdx][0])
+#else
+    if (!m_pPixelWeight[fIdx][0])
+#endif
+      continue;
+    for (Int ch = 0; ch < iNumMaps; ch++)
+    {
+      ComponentID chId    = (ComponentID) ch;
+      Int         iWidth  = m_sVideoInfo.iFaceWidth >> getComponentScaleX(chId);
+      Int         iHeight = m_sVideoInfo.iFaceHeight >> getComponentScaleY(chId);
+      for (Int j = 0; j < iHeight; j++)
+      {
+        for (Int i = 0; i < iWidth; i++)
+        {
+#if SVIDEO_SEPARABLE_CUBE_MAPPING
+          PxlFltLut w = getPixelWeight(fIdx, ch, i + getMarginX(chId), j + getMarginY(chId));
+#else
+          PxlFltLut w = m_pPixelWeight[fIdx][ch][(j + getMarginY(chId)) * getStride(chId) + i + getMarginX(chId)];
+#endif
+          SPos      pos;
+          xMapSamplePos(pGeoSrc, fIdx, chId, i, j, pRot, false, pos);
+
+          MappingCheckEntry entry;
+          entry.ch        = ch;
+          entry.facePos   = w.facePos;
+          entry.weightIdx = w.weightIdx;
+          entry.faceIdx   = pos.faceIdx;
+          entry.x         = pos.x;
+          entry.y         = pos.y;
+          entries.push_back(entry);
+        }
+      }
+    }
+  }
+}
+
+Void TGeometry::writeMappingCheck(TGeometry *pGeoSrc, const std::string &fileName)
+{
+  std::vector<MappingCheckEntry> entries;
+  xGetMappingCheckEntries(pGeoSrc, entries);
+
+  FILE *fp = fopen(fileName.c_str(), "wb");
+  CHECK(!fp, "Failed to open the mapping check file");
+  Int iNumEntries = (Int) entries.size();
+  fwrite(&iNumEntries, sizeof(Int), 1, fp);
+  fwrite(entries.data(), sizeof(MappingCheckEntry), entries.size(), fp);
+  fclose(fp);
+  printf("Mapping check: %d entries written to %s\n", iNumEntries, fileName.c_str());
+}
+
+//the maximum position delta is measured for the samples mapped to the same source face, across the horizontal wrap of ERP;
+Void TGeometry::compareMappingCheck(TGeometry *pGeoSrc, const std::string &refFileName)
+{
+  std::vector<MappingCheckEntry> entries, refEntries;
+  xGetMappingCheckEntries(pGeoSrc, entries);
+
+  FILE *fp = fopen(refFileName.c_str(), "rb");
+  CHECK(!fp, "Failed to open the mapping check reference file");
+  Int iNumEntries = 0;
+  if (fread(&iNumEntries, sizeof(Int), 1, fp) == 1 && iNumEntries == (Int) entries.size())
+  {
+    refEntries.resize(iNumEntries);
+    if (fread(refEntries.data(), sizeof(MappingCheckEntry), iNumEntries, fp) != (size_t) iNumEntries)
+      refEntries.clear();
+  }
+  fclose(fp);
+  CHECK(refEntries.size() != entries.size(), "The mapping check reference file does not match the geometries");
+
+  Int    iFacePosChanged = 0, iWeightIdxChanged = 0, iFaceChanged = 0;
+  Double dMaxDelta = 0;
+  for (Int k = 0; k < iNumEntries; k++)
+  {
+    iFacePosChanged += (entries[k].facePos != refEntries[k].facePos);
+    iWeightIdxChanged += (entries[k].weightIdx != refEntries[k].weightIdx);
+    if (entries[k].faceIdx != refEntries[k].faceIdx)
+    {
+      iFaceChanged++;
+      continue;
+    }
+    Int    iSrcWidth = pGeoSrc->m_sVideoInfo.iFaceWidth >> pGeoSrc->getComponentScaleX((ComponentID) entries[k].ch);
+    Double dx        = fabs(entries[k].x - refEntries[k].x);
+    dMaxDelta = std::max(dMaxDelta, std::max(std::min(dx, fabs(dx - iSrcWidth)), fabs(entries[k].y - refEntries[k].y)));
+  }
+  printf("Mapping check against %s: %d entries, facePos changed: %d, weightIdx changed: %d, source face changed: %d, maximum position delta: %.6e samples\n",
+         refFileName.c_str(), iNumEntries, iFacePosChanged, iWeightIdxChanged, iFaceChanged, dMaxDelta);
+}
+#endif
+
+/***************************************************
+//convert source geometry to destination geometry;
+****************************************************/
+Void TGeometry::geoConvert(TGeometry *pGeoDst
+#if SVIDEO_ROT_FIX
+                           ,
+                           Bool bRec
+#endif
+)
+{
+#if SVIDEO_DEMAND_SPHERE_PADDING
+  //the mapping does not depend on the samples, it is built first to record the margin samples the padding has to fill;
+  if (!pGeoDst->m_bGeometryMapping)
+#if SVIDEO_ROT_FIX
+    pGeoDst->geometryMapping(this, bRec);
+#else
+    pGeoDst->geometryMapping(this);
+#endif
+
+  // padding;
+  spherePadding();
+#else
+  // padding;
+  spherePadding();
+
+  if (!pGeoDst->m_bGeometryMapping)
+#if SVIDEO_ROT_FIX
+    pGeoDst->geometryMapping(this, bRec);
+#else
+    pGeoDst->geometryMapping(this);
+#endif
+#endif
+
+  Int nFaces             = pGeoDst->m_sVideoInfo.iNumFaces;
+  Int iBDPrecision       = S_INTERPOLATE_PrecisionBD;
+  Int iWeightMapFaceMask = (1 << m_WeightMap_NumOfBits4Faces) - 1;
+  Int iOffset            = 1 << (iBDPrecision - 1);
+
+  for (Int fIdx = 0; fIdx < nFaces; fIdx++)
+  {
+#if SVIDEO_GENERALIZED_CUBEMAP
+    if (pGeoDst->m_sVideoInfo.geoType == SVIDEO_GENERALIZEDCUBEMAP
+        && (pGeoDst->m_sVideoInfo.iGCMPPackingType == 4 || pGeoDst->m_sVideoInfo.iGCMPPackingType == 5))
+    {
+      Int virtualFaceIdx = pGeoDst->m_sVideoInfo.iGCMPPackingType == 4
+                             ? pGeoDst->m_sVideoInfo.framePackStruct.faces[0][5].id
+                             : pGeoDst->m_sVideoInfo.framePackStruct.faces[5][0].id;
+      if (fIdx == virtualFaceIdx)
+        continue;
+    }
+#endif
+    for (Int ch = 0; ch < pGeoDst->getNumChannels(); ch++)
+    {
+#if SVIDEO_SEPARABLE_CUBE_MAPPING
+      if (pGeoDst->m_bSeparableMapping[fIdx])
+      {
+        xGeoConvertSeparable(pGeoDst, fIdx, ch);
+        continue;
+      }
+#endif
+      ComponentID chId    = (ComponentID) ch;
+      Int         nWidth  = pGeoDst->m_sVideoInfo.iFaceWidth >> pGeoDst->getComponentScaleX(chId);
+      Int         nHeight = pGeoDst->m_sVideoInfo.iFaceHeight >> pGeoDst->getComponentScaleY(chId);
+
+      Int nMarginX = pGeoDst->m_iMarginX >> pGeoDst->getComponentScaleX(chId);
+      Int nMarginY = pGeoDst->m_iMarginY >> pGeoDst->getComponentScaleY(chId);
+      Int iWidthPW = pGeoDst->getStride(chId);
+      Int mapIdx =
+        (pGeoDst->m_chromaFormatIDC == CHROMA_444
+         && pGeoDst->m_InterpolationType[CHANNEL_TYPE_LUMA] == pGeoDst->m_InterpolationType[CHANNEL_TYPE_CHROMA])
+          ? 0
+          : (ch > 0 ? 1 : 0);
+      ChannelType chType = toChannelType(chId);
+
+      for (Int j = -nMarginY; j < nHeight + nMarginY; j++)
+        for (Int i = -nMarginX; i < nWidth + nMarginX; i++)
+        {
+          if (!pGeoDst->m_bConvOutputPaddingNeeded
+              && !pGeoDst->insideFace(fIdx, (i << pGeoDst->getComponentScaleX(chId)),
+                                      (j << pGeoDst->getComponentScaleY(chId)), COMPONENT_Y, chId))
+            continue;
+
+          Int x   = i + nMarginX;
+          Int y   = j + nMarginY;
+          Int sum = 0;
+
+#if SVIDEO_FISHEYE
+          {
+#if SVIDEO_FISHEYE_PRECOMPUTATION
+            if (pGeoDst->m_sVideoInfo.geoType != SVIDEO_FISHEYE_CIRCULAR
+                || ((TFisheye *) pGeoDst)
+                     ->insideCircularRegion(i << pGeoDst->getComponentScaleX(chId), j << pGeoDst->getComponentScaleY(chId)))
+#else
+            Int    xx    = i << pGeoDst->getComponentScaleX(chId);
+            Int    yy    = j << pGeoDst->getComponentScaleY(chId);
+            Double cnt_x = pGeoDst->m_sVideoInfo.sFisheyeInfo.fCircularRegionCentre_x;
+            Double cnt_y = pGeoDst->m_sVideoInfo.sFisheyeInfo.fCircularRegionCentre_y;
+            Double dist  = ssqrt((xx + 0.5 - cnt_x) * (xx + 0.5 - cnt_x) + (yy + 0.5 - cnt_y) * (yy + 0.5 - cnt_y));
+
+            if (pGeoDst->m_sVideoInfo.geoType != SVIDEO_FISHEYE_CIRCULAR
+                || (/*pGeoDst->m_sVideoInfo.geoType == SVIDEO_FISHEYE_CIRCULAR &&*/ dist
+                    < (Double)(pGeoDst->m_sVideoInfo.sFisheyeInfo.fCircularRegionRadius) - 0.5))
+#endif
+            {
+#endif
+
+              PxlFltLut *pPelWeight = pGeoDst->m_pPixelWeight[fIdx][mapIdx] + y * iWidthPW + x;
+              Int        face       = (pPelWeight->facePos) & iWeightMapFaceMask;
+              Int        iTLPos     = (pPelWeight->facePos) >> m_WeightMap_NumOfBits4Faces;
+              Int        iWLutIdx =
+                (m_chromaFormatIDC == CHROMA_400 || (m_InterpolationType[0] == m_InterpolationType[1])) ? 0 : chType;
+              Int *pWLut    = m_pWeightLut[iWLutIdx][pPelWeight->weightIdx];
+              FacePel *pPelLine = m_pFacesOrig[face][ch] + iTLPos
+                              - ((m_iInterpFilterTaps[chType][1] - 1) >> 1) * getStride(chId)
+                              - ((m_iInterpFilterTaps[chType][0] - 1) >> 1);
+              for (Int m = 0; m < m_iInterpFilterTaps[chType][1]; m++)
+              {
+                for (Int n = 0; n < m_iInterpFilterTaps[chType][0]; n++)
+                  sum += pPelLine[n] * pWLut[n];
+                pPelLine += getStride(chId);
+                pWLut += m_iInterpFilterTaps[chType][0];
+              }
+
+              Int iPos = j * pGeoDst->getStride(chId) + i;
+#if SVIDEO_GEOCONVERT_CLIP
+              pGeoDst->m_pFacesOrig[fIdx][ch][iPos] = ClipBD((sum + iOffset) >> iBDPrecision, m_nBitDepth);
+#else
+          pGeoDst->m_pFacesOrig[fIdx][ch][iPos] = (sum + iOffset) >> iBDPrecision;
+#endif
+#if SVIDEO_FISHEYE
+            }
+            else if (pGeoDst->m_sVideoInfo.geoType == SVIDEO_FISHEYE_CIRCULAR)
+            {
+              Int iPos                              = j * pGeoDst->getStride(chId) + i;
+              pGeoDst->m_pFacesOrig[fIdx][ch][iPos] = 1 << (m_nBitDepth - 1);
+            }
+          }
+#endif
+        }
+    }
+  }
+
+  pGeoDst->setPaddingFlag(pGeoDst->m_bConvOutputPaddingNeeded ? true : false);
+}
+
+#if SVIDEO_VIEWPORT_DIRECT_SAMPLING
+/***************************************************
+//convert source geometry to a viewport without the mapping table;
+//the source position and the weights of each sample are derived on the fly, exactly as geometryMapping() does,
+//which suits the viewports whose orientation is changed for every picture;
+****************************************************/
+Void TGeometry::geoConvertDirect(TGeometry *pGeoDst, Bool bRec, TWorkerPool *pPool)
+{
+  CHECK(pGeoDst->m_sVideoInfo.geoType != SVIDEO_VIEWPORT, "Direct sampling is only supported for viewports");
+#if SVIDEO_DEMAND_SPHERE_PADDING
+  CHECK(m_bDemandPadding, "Direct sampling is not supported with the demand driven padding");
+#endif
+  // padding;
+  spherePadding();
+
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+  if ((pGeoDst->m_sVideoInfo.framePackStruct.chromaFormatIDC == CHROMA_420) && (pGeoDst->m_chromaFormatIDC == CHROMA_444))
+#else
+  if ((pGeoDst->m_sVideoInfo.framePackStruct.chromaFormatIDC == CHROMA_420)
+      && ((pGeoDst->m_chromaFormatIDC == CHROMA_444) || (pGeoDst->m_chromaFormatIDC == CHROMA_420 && pGeoDst->m_bResampleChroma)))
+#endif
+    pGeoDst->m_bConvOutputPaddingNeeded = true;
+  ((TViewPort *) pGeoDst)->setRotMat();
+  ((TViewPort *) pGeoDst)->setInvK();
+
+  Int iNumMaps = (pGeoDst->m_chromaFormatIDC == CHROMA_400
+                  || (pGeoDst->m_chromaFormatIDC == CHROMA_444 && pGeoDst->m_InterpolationType[0] == pGeoDst->m_InterpolationType[1]))
+                   ? 1
+                   : 2;
+  for (Int iMap = 0; iMap < iNumMaps; iMap++)
+  {
+    ComponentID chId     = (ComponentID) iMap;
+    Int         nMarginY = pGeoDst->m_iMarginY >> pGeoDst->getComponentScaleY(chId);
+    Int         iStart   = -nMarginY;
+    Int         iEnd     = (pGeoDst->m_sVideoInfo.iFaceHeight >> pGeoDst->getComponentScaleY(chId)) + nMarginY;
+    Int         iBands   = std::max(1, std::min(pPool ? pPool->getNumThreads() : 1, iEnd - iStart));
+    if (iBands == 1)
+    {
+      xGeoConvertDirectRows(pGeoDst, bRec, iMap, iStart, iEnd);
+      continue;
+    }
+    //the bands write to disjoint rows of the viewport and only read the source geometry;
+    for (Int b = 0; b < iBands; b++)
+    {
+      Int iBandStart = iStart + (iEnd - iStart) * b / iBands;
+      Int iBandEnd   = iStart + (iEnd - iStart) * (b + 1) / iBands;
+      pPool->addTask([=]() { xGeoConvertDirectRows(pGeoDst, bRec, iMap, iBandStart, iBandEnd); });
+    }
+    pPool->wait();
+  }
+  pGeoDst->setPaddingFlag(pGeoDst->m_bConvOutputPaddingNeeded ? true : false);
+}
+
+//the samples of all the channels using the same map share the derived position and weights;
+Void TGeometry::xGeoConvertDirectRows(TGeometry *pGeoDst, Bool bRec, Int iMap, Int iStartRow, Int iEndRow)
+{
+  Int pRot[3];
+  Void (TGeometry::*pfuncRotation)(SPos & sPos, Int iRoll, Int iPitch, Int iYaw) = nullptr;
+  if (bRec)
+  {
+    pfuncRotation = &TGeometry::invRotate3D;
+    pRot[0]       = -m_sVideoInfo.sVideoRotation.degree[0];
+    pRot[1]       = -m_sVideoInfo.sVideoRotation.degree[1];
+    pRot[2]       = -m_sVideoInfo.sVideoRotation.degree[2];
+  }
+  else
+  {
+    pfuncRotation = &TGeometry::rotate3D;
+    pRot[0]       = pGeoDst->m_sVideoInfo.sVideoRotation.degree[0];
+    pRot[1]       = pGeoDst->m_sVideoInfo.sVideoRotation.degree[1];
+    pRot[2]       = pGeoDst->m_sVideoInfo.sVideoRotation.degree[2];
+  }
+
+  Int fIdx               = 0;
+  Int iBDPrecision       = S_INTERPOLATE_PrecisionBD;
+  Int iWeightMapFaceMask = (1 << m_WeightMap_NumOfBits4Faces) - 1;
+  Int iOffset            = 1 << (iBDPrecision - 1);
+  Int iNumMaps           = (pGeoDst->m_chromaFormatIDC == CHROMA_400
+                            || (pGeoDst->m_chromaFormatIDC == CHROMA_444 && pGeoDst->m_InterpolationType[0] == pGeoDst->m_InterpolationType[1]))
+                             ? 1
+                             : 2;
+  ComponentID chId     = (ComponentID) iMap;
+  ChannelType chType   = toChannelType(chId);
+  Int         iWidth   = pGeoDst->m_sVideoInfo.iFaceWidth >> pGeoDst->getComponentScaleX(chId);
+  Int         nMarginX = pGeoDst->m_iMarginX >> pGeoDst->getComponentScaleX(chId);
+  Int         iFirstCh = iMap;
+  Int         iLastCh  = (iNumMaps == 1 || iMap == 1) ? pGeoDst->getNumChannels() - 1 : 0;
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+  Double chromaOffsetSrc[2] = { 0.0, 0.0 };   //[0: X; 1: Y];
+  Double chromaOffsetDst[2] = { 0.0, 0.0 };   //[0: X; 1: Y];
+  pGeoDst->getFaceChromaOffset(chromaOffsetDst, fIdx, chId);
+#endif
+
+  for (Int j = iStartRow; j < iEndRow; j++)
+    for (Int i = -nMarginX; i < iWidth + nMarginX; i++)
+    {
+      if (!pGeoDst->m_bConvOutputPaddingNeeded
+          && !pGeoDst->insideFace(fIdx, (i << pGeoDst->getComponentScaleX(chId)), (j << pGeoDst->getComponentScaleY(chId)), COMPONENT_Y, chId))
+        continue;
+
+      PxlFltLut wList;
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+      POSType x = (i) * (1 << pGeoDst->getComponentScaleX(chId)) + chromaOffsetDst[0];
+      POSType y = (j) * (1 << pGeoDst->getComponentScaleY(chId)) + chromaOffsetDst[1];
+#else
+      POSType x = (i) * (1 << pGeoDst->getComponentScaleX(chId));
+      POSType y = (j) * (1 << pGeoDst->getComponentScaleY(chId));
+#endif
+      SPos in(fIdx, x, y, 0), pos3D;
+      pGeoDst->map2DTo3D(in, &pos3D);
+      (pGeoDst->*pfuncRotation)(pos3D, pRot[0], pRot[1], pRot[2]);
+      map3DTo2D(&pos3D, &pos3D);
+#if SVIDEO_HEMI_PROJECTIONS
+      if (((Int)getType() == SVIDEO_HCMP || (Int)getType() == SVIDEO_HEAC) && pos3D.faceIdx == 7)
+      {
+        pos3D.faceIdx = 0;
+        pos3D.x       = 0;
+        pos3D.y       = 0;
+      }
+#endif
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+      getFaceChromaOffset(chromaOffsetSrc, pos3D.faceIdx, chId);
+      pos3D.x = (pos3D.x - chromaOffsetSrc[0]) / POSType(1 << pGeoDst->getComponentScaleX(chId));
+      pos3D.y = (pos3D.y - chromaOffsetSrc[1]) / POSType(1 << pGeoDst->getComponentScaleY(chId));
+#else
+      pos3D.x = pos3D.x / POSType(1 << pGeoDst->getComponentScaleX(chId));
+      pos3D.y = pos3D.y / POSType(1 << pGeoDst->getComponentScaleY(chId));
+#endif
+      (this->*m_interpolateWeight[chType])(chId, &pos3D, wList);
+
+      Int face   = (wList.facePos) & iWeightMapFaceMask;
+      Int iTLPos = (wList.facePos) >> m_WeightMap_NumOfBits4Faces;
+      for (Int ch = iFirstCh; ch <= iLastCh; ch++)
+      {
+        ComponentID chIdCur     = (ComponentID) ch;
+        ChannelType chTypeCur   = toChannelType(chIdCur);
+        Int         iWLutIdxCur = (m_chromaFormatIDC == CHROMA_400 || (m_InterpolationType[0] == m_InterpolationType[1])) ? 0 : chTypeCur;
+        Int        *pWLut       = m_pWeightLut[iWLutIdxCur][wList.weightIdx];
+        FacePel    *pPelLine    = m_pFacesOrig[face][ch] + iTLPos
+                            - ((m_iInterpFilterTaps[chTypeCur][1] - 1) >> 1) * getStride(chIdCur)
+                            - ((m_iInterpFilterTaps[chTypeCur][0] - 1) >> 1);
+        Int         sum         = 0;
+        for (Int m = 0; m < m_iInterpFilterTaps[chTypeCur][1]; m++)
+        {
+          for (Int n = 0; n < m_iInterpFilterTaps[chTypeCur][0]; n++)
+            sum += pPelLine[n] * pWLut[n];
+          pPelLine += getStride(chIdCur);
+          pWLut += m_iInterpFilterTaps[chTypeCur][0];
+        }
+
+        Int iPos = j * pGeoDst->getStride(chIdCur) + i;
+#if SVIDEO_GEOCONVERT_CLIP
+        pGeoDst->m_pFacesOrig[fIdx][ch][iPos] = ClipBD((sum + iOffset) >> iBDPrecision, m_nBitDepth);
+#else
+        pGeoDst->m_pFacesOrig[fIdx][ch][iPos] = (sum + iOffset) >> iBDPrecision;
+#endif
+      }
+    }
+}
+#endif
+
+#if SVIDEO_VIEWPORT_BATCH_PSNR
+/***************************************************
+//the frame packing of a single face without rotation and chroma resampling is a plain copy with the output bit depth adjustment;
+****************************************************/
+Bool TGeometry::isFramePackCopy(ChromaFormat dstChromaFormat)
+{
+  if (m_sVideoInfo.iNumFaces != 1 || m_sVideoInfo.framePackStruct.rows != 1 || m_sVideoInfo.framePackStruct.cols != 1
+      || m_sVideoInfo.framePackStruct.faces[0][0].rot)
+    return false;
+  if (dstChromaFormat == CHROMA_420)
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+    return m_chromaFormatIDC == CHROMA_420;
+#else
+    return m_chromaFormatIDC == CHROMA_420 && !m_bResampleChroma;
+#endif
+  return (dstChromaFormat == CHROMA_444 || dstChromaFormat == CHROMA_400) && m_chromaFormatIDC == dstChromaFormat;
+}
+
+//sum of squared differences of the frame packed pictures of two geometries, computed from the faces;
+Void TGeometry::calcFramePackSSD(TGeometry *pGeoRec, ChromaFormat dstChromaFormat, Int iBitDepthForPSNRCalc, Double dSSD[MAX_NUM_COMPONENT])
+{
+  CHECK(!isFramePackCopy(dstChromaFormat) || !pGeoRec->isFramePackCopy(dstChromaFormat), "Frame packing is not a plain copy");
+  Int iRefBDAdjust = m_nBitDepth - m_nOutputBitDepth;
+  Int iRecBDAdjust = pGeoRec->m_nBitDepth - pGeoRec->m_nOutputBitDepth;
+  Int iRefOffset   = iRefBDAdjust > 0 ? (1 << (iRefBDAdjust - 1)) : 0;
+  Int iRecOffset   = iRecBDAdjust > 0 ? (1 << (iRecBDAdjust - 1)) : 0;
+  Int iRefShift    = iBitDepthForPSNRCalc - m_nOutputBitDepth;
+  Int iRecShift    = iBitDepthForPSNRCalc - pGeoRec->m_nOutputBitDepth;
+  Pel refEmptyVal  = 1 << (m_nOutputBitDepth - 1);
+  Pel recEmptyVal  = 1 << (pGeoRec->m_nOutputBitDepth - 1);
+  CHECK(iRefBDAdjust < 0 || iRecBDAdjust < 0, "");
+
+  for (Int ch = 0; ch < MAX_NUM_COMPONENT; ch++)
+  {
+    dSSD[ch] = 0;
+  }
+  for (Int ch = 0; ch < (Int)getNumberValidComponents(dstChromaFormat); ch++)
+  {
+    ComponentID chId    = (ComponentID) ch;
+    Int         iScaleX = ::getComponentScaleX(chId, dstChromaFormat);
+    Int         iScaleY = ::getComponentScaleY(chId, dstChromaFormat);
+    Int         iWidth  = m_sVideoInfo.iFaceWidth >> iScaleX;
+    Int         iHeight = m_sVideoInfo.iFaceHeight >> iScaleY;
+    const FacePel *pRef = m_pFacesOrig[0][ch];
+    const FacePel *pRec = pGeoRec->m_pFacesOrig[0][ch];
+    Double      SSD     = 0;
+    for (Int j = 0; j < iHeight; j++)
+    {
+      for (Int i = 0; i < iWidth; i++)
+      {
+        Pel refVal = insideFace(0, i << iScaleX, j << iScaleY, COMPONENT_Y, chId)
+                       ? ClipBD((pRef[i] + iRefOffset) >> iRefBDAdjust, m_nOutputBitDepth)
+                       : refEmptyVal;
+        Pel recVal = pGeoRec->insideFace(0, i << iScaleX, j << iScaleY, COMPONENT_Y, chId)
+                       ? ClipBD((pRec[i] + iRecOffset) >> iRecBDAdjust, pGeoRec->m_nOutputBitDepth)
+                       : recEmptyVal;
+        Intermediate_Int iDiff = (Intermediate_Int)((refVal << iRefShift) - (recVal << iRecShift));
+        SSD += iDiff * iDiff;
+      }
+      pRef += getStride(chId);
+      pRec += pGeoRec->getStride(chId);
+    }
+    dSSD[ch] = SSD;
+  }
+}
+#endif
+
+#if SVIDEO_VIEWPORT_RENDERER
+/***************************************************
+//a viewport only samples the faces given by getViewPortFaceMask(), and the padding of these faces only reads
+//the faces given by getPaddingSourceMask(); the other faces may be skipped by convertYuv() and spherePadding();
+****************************************************/
+Void TGeometry::setFaceMask(UInt uiConvertFaceMask, UInt uiPadFaceMask)
+{
+  m_uiConvertFaceMask = uiConvertFaceMask;
+  if (m_uiPadFaceMask != uiPadFaceMask)
+  {
+    m_uiPadFaceMask = uiPadFaceMask;
+    m_bPadded       = false;
+  }
+}
+
+UInt TGeometry::getViewPortFaceMask(TGeometry *pGeoDst, Bool bRec)
+{
+  CHECK(pGeoDst->m_sVideoInfo.geoType != SVIDEO_VIEWPORT, "Face masks are only derived for viewports");
+  if (m_sVideoInfo.iNumFaces == 1)
+    return 1;
+
+  Int pRot[3];
+  Void (TGeometry::*pfuncRotation)(SPos & sPos, Int iRoll, Int iPitch, Int iYaw) = nullptr;
+  if (bRec)
+  {
+    pfuncRotation = &TGeometry::invRotate3D;
+    pRot[0]       = -m_sVideoInfo.sVideoRotation.degree[0];
+    pRot[1]       = -m_sVideoInfo.sVideoRotation.degree[1];
+    pRot[2]       = -m_sVideoInfo.sVideoRotation.degree[2];
+  }
+  else
+  {
+    pfuncRotation = &TGeometry::rotate3D;
+    pRot[0]       = pGeoDst->m_sVideoInfo.sVideoRotation.degree[0];
+    pRot[1]       = pGeoDst->m_sVideoInfo.sVideoRotation.degree[1];
+    pRot[2]       = pGeoDst->m_sVideoInfo.sVideoRotation.degree[2];
+  }
+  Bool bOutputPadding = pGeoDst->m_bConvOutputPaddingNeeded;
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+  if ((pGeoDst->m_sVideoInfo.framePackStruct.chromaFormatIDC == CHROMA_420) && (pGeoDst->m_chromaFormatIDC == CHROMA_444))
+#else
+  if ((pGeoDst->m_sVideoInfo.framePackStruct.chromaFormatIDC == CHROMA_420)
+      && ((pGeoDst->m_chromaFormatIDC == CHROMA_444) || (pGeoDst->m_chromaFormatIDC == CHROMA_420 && pGeoDst->m_bResampleChroma)))
+#endif
+    bOutputPadding = true;
+  ((TViewPort *) pGeoDst)->setRotMat();
+  ((TViewPort *) pGeoDst)->setInvK();
+
+  UInt uiMask   = 0;
+  Int  iNumMaps = (pGeoDst->m_chromaFormatIDC == CHROMA_400
+                  || (pGeoDst->m_chromaFormatIDC == CHROMA_444 && pGeoDst->m_InterpolationType[0] == pGeoDst->m_InterpolationType[1]))
+                   ? 1
+                   : 2;
+  for (Int iMap = 0; iMap < iNumMaps; iMap++)
+  {
+    ComponentID chId     = (ComponentID) iMap;
+    Int         iWidth   = pGeoDst->m_sVideoInfo.iFaceWidth >> pGeoDst->getComponentScaleX(chId);
+    Int         iHeight  = pGeoDst->m_sVideoInfo.iFaceHeight >> pGeoDst->getComponentScaleY(chId);
+    Int         nMarginX = pGeoDst->m_iMarginX >> pGeoDst->getComponentScaleX(chId);
+    Int         nMarginY = pGeoDst->m_iMarginY >> pGeoDst->getComponentScaleY(chId);
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+    Double chromaOffsetDst[2] = { 0.0, 0.0 };   //[0: X; 1: Y];
+    pGeoDst->getFaceChromaOffset(chromaOffsetDst, 0, chId);
+#endif
+    for (Int j = -nMarginY; j < iHeight + nMarginY; j++)
+      for (Int i = -nMarginX; i < iWidth + nMarginX; i++)
+      {
+        if (!bOutputPadding
+            && !pGeoDst->insideFace(0, (i << pGeoDst->getComponentScaleX(chId)), (j << pGeoDst->getComponentScaleY(chId)), COMPONENT_Y, chId))
+          continue;
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+        POSType x = (i) * (1 << pGeoDst->getComponentScaleX(chId)) + chromaOffsetDst[0];
+        POSType y = (j) * (1 << pGeoDst->getComponentScaleY(chId)) + chromaOffsetDst[1];
+#else
+        POSType x = (i) * (1 << pGeoDst->getComponentScaleX(chId));
+        POSType y = (j) * (1 << pGeoDst->getComponentScaleY(chId));
 #endif
-    for (Int ch = 0; ch < pGeoDst->getNumChannels(); ch++)
-    {
-      ComponentID chId    = (ComponentID) ch;
-      Int         nWidth  = pGeoDst->m_sVideoInfo.iFaceWidth >> pGeoDst->getComponentScaleX(chId);
-      Int         nHeight = pGeoDst->m_sVideoInfo.iFaceHeight >> pGeoDst->getComponentScaleY(chId);
+        SPos in(0, x, y, 0), pos3D;
+        pGeoDst->map2DTo3D(in, &pos3D);
+        (pGeoDst->*pfuncRotation)(pos3D, pRot[0], pRot[1], pRot[2]);
+        map3DTo2D(&pos3D, &pos3D);
+        uiMask |= 1 << pos3D.faceIdx;
+      }
+  }
+  return uiMask;
+}
 
-      Int nMarginX = pGeoDst->m_iMarginX >> pGeoDst->getComponentScaleX(chId);
-      Int nMarginY = pGeoDst->m_iMarginY >> pGeoDst->getComponentScaleY(chId);
-      Int iWidthPW = pGeoDst->getStride(chId);
-      Int mapIdx =
-        (pGeoDst->m_chromaFormatIDC == CHROMA_444
-         && pGeoDst->m_InterpolationType[CHANNEL_TYPE_LUMA] == pGeoDst->m_InterpolationType[CHANNEL_TYPE_CHROMA])
-          ? 0
-          : (ch > 0 ? 1 : 0);
-      ChannelType chType = toChannelType(chId);
+UInt TGeometry::getPaddingSourceMask(UInt uiFaceMask)
+{
+  if (!m_bGeometryMapping4SpherePadding)
+    geometryMapping4SpherePadding();
 
+  Int  iWeightMapFaceMask = (1 << m_WeightMap_NumOfBits4Faces) - 1;
+  UInt uiMask             = 0;
+  for (Int fIdx = 0; fIdx < m_sVideoInfo.iNumFaces; fIdx++)
+  {
+    if (!((uiFaceMask >> fIdx) & 1))
+      continue;
+    for (Int ch = 0; ch < getNumChannels(); ch++)
+    {
+      ComponentID chId     = (ComponentID) ch;
+      Int         nWidth   = m_sVideoInfo.iFaceWidth >> getComponentScaleX(chId);
+      Int         nHeight  = m_sVideoInfo.iFaceHeight >> getComponentScaleY(chId);
+      Int         nMarginX = m_iMarginX >> getComponentScaleX(chId);
+      Int         nMarginY = m_iMarginY >> getComponentScaleY(chId);
+      Int         mapIdx   = (m_chromaFormatIDC == CHROMA_444
+                    && m_InterpolationType[CHANNEL_TYPE_LUMA] == m_InterpolationType[CHANNEL_TYPE_CHROMA])
+                     ? 0
+                     : (ch > 0 ? 1 : 0);
       for (Int j = -nMarginY; j < nHeight + nMarginY; j++)
+      {
         for (Int i = -nMarginX; i < nWidth + nMarginX; i++)
         {
-          if (!pGeoDst->m_bConvOutputPaddingNeeded
-              && !pGeoDst->insideFace(fIdx, (i << pGeoDst->getComponentScaleX(chId)),
-                                      (j << pGeoDst->getComponentScaleY(chId)), COMPONENT_Y, chId))
+          if (insideFace(fIdx, (i << getComponentScaleX(chId)), (j << getComponentScaleY(chId)), COMPONENT_Y, chId))
             continue;
-
-          Int x   = i + nMarginX;
-          Int y   = j + nMarginY;
-          Int sum = 0;
-
-#if SVIDEO_FISHEYE
-          {
-            Int    xx    = i << pGeoDst->getComponentScaleX(chId);
-            Int    yy    = j << pGeoDst->getComponentScaleY(chId);
-            Double cnt_x = pGeoDst->m_sVideoInfo.sFisheyeInfo.fCircularRegionCentre_x;
-            Double cnt_y = pGeoDst->m_sVideoInfo.sFisheyeInfo.fCircularRegionCentre_y;
-            Double dist  = ssqrt((xx + 0.5 - cnt_x) * (xx + 0.5 - cnt_x) + (yy + 0.5 - cnt_y) * (yy + 0.5 - cnt_y));
-
-            if (pGeoDst->m_sVideoInfo.geoType != SVIDEO_FISHEYE_CIRCULAR
-                || (/*pGeoDst->m_sVideoInfo.geoType == SVIDEO_FISHEYE_CIRCULAR &&*/ dist
-                    < (Double)(pGeoDst->m_sVideoInfo.sFisheyeInfo.fCircularRegionRadius) - 0.5))
-            {
-#endif
-
-              PxlFltLut *pPelWeight = pGeoDst->m_pPixelWeight[fIdx][mapIdx] + y * iWidthPW + x;
-              Int        face       = (pPelWeight->facePos) & iWeightMapFaceMask;
-              Int        iTLPos     = (pPelWeight->facePos) >> m_WeightMap_NumOfBits4Faces;
-              Int        iWLutIdx =
-                (m_chromaFormatIDC == CHROMA_400 || (m_InterpolationType[0] == m_InterpolationType[1])) ? 0 : chType;
-              Int *pWLut    = m_pWeightLut[iWLutIdx][pPelWeight->weightIdx];
-              Pel *pPelLine = m_pFacesOrig[face][ch] + iTLPos
-                              - ((m_iInterpFilterTaps[chType][1] - 1) >> 1) * getStride(chId)
-                              - ((m_iInterpFilterTaps[chType][0] - 1) >> 1);
-              for (Int m = 0; m < m_iInterpFilterTaps[chType][1]; m++)
-              {
-                for (Int n = 0; n < m_iInterpFilterTaps[chType][0]; n++)
-                  sum += pPelLine[n] * pWLut[n];
-                pPelLine += getStride(chId);
-                pWLut += m_iInterpFilterTaps[chType][0];
-              }
-
-              Int iPos = j * pGeoDst->getStride(chId) + i;
-#if SVIDEO_GEOCONVERT_CLIP
-              pGeoDst->m_pFacesOrig[fIdx][ch][iPos] = ClipBD((sum + iOffset) >> iBDPrecision, m_nBitDepth);
-#else
-          pGeoDst->m_pFacesOrig[fIdx][ch][iPos] = (sum + iOffset) >> iBDPrecision;
-#endif
-#if SVIDEO_FISHEYE
-            }
-            else if (pGeoDst->m_sVideoInfo.geoType == SVIDEO_FISHEYE_CIRCULAR)
-            {
-              Int iPos                              = j * pGeoDst->getStride(chId) + i;
-              pGeoDst->m_pFacesOrig[fIdx][ch][iPos] = 1 << (m_nBitDepth - 1);
-            }
-          }
-#endif
+          Int iLutIdx;
+          getSPLutIdx(ch, i, j, iLutIdx);
+          uiMask |= 1 << ((m_pPixelWeight4SherePadding[fIdx][mapIdx] + iLutIdx)->facePos & iWeightMapFaceMask);
         }
+      }
     }
   }
-
-  pGeoDst->setPaddingFlag(pGeoDst->m_bConvOutputPaddingNeeded ? true : false);
+  return uiMask;
 }
+#endif
 
 Void TGeometry::geoToFramePack(IPos *posIn, IPos2D *posOut)
 {
@@ -1275,7 +2537,7 @@ Void TGeometry::framePack(PelUnitBuf *pDstYuv)
     if (!m_pDS420Buf && ((m_chromaFormatIDC == CHROMA_444) || (m_chromaFormatIDC == CHROMA_420 && m_bResampleChroma)))
 #endif
     {
-      m_pDS420Buf = (Pel *) xMalloc(Pel, nHeightC * iStride420);
+      m_pDS420Buf = (FacePel *) xMalloc(FacePel, nHeightC * iStride420);
     }
     for (Int face = 0; face < iTotalNumOfFaces; face++)
     {
@@ -1308,10 +2570,14 @@ Void TGeometry::framePack(PelUnitBuf *pDstYuv)
             ComponentID chId = (ComponentID) ch;
             Int         xc   = x >> ::getComponentScaleX(chId, pDstYuv->chromaFormat);
             Int         yc   = y >> ::getComponentScaleY(chId, pDstYuv->chromaFormat);
+#if SVIDEO_FUSED_CHROMA_RESAMPLING
+            chromaDonwsampleHV(m_pFacesOrig[face][ch], m_sVideoInfo.iFaceWidth, m_sVideoInfo.iFaceHeight, getStride(chId), m_pDS422Buf, iStride422, m_pDS420Buf, iStride420);
+#else
             chromaDonwsampleH(m_pFacesOrig[face][ch] - nMarginSize * getStride((ComponentID) ch),
                               m_sVideoInfo.iFaceWidth, nHeightC422, getStride(chId), 1, m_pDS422Buf, iStride422);
             chromaDonwsampleV(m_pDS422Buf + nMarginSize * iStride422, nWidthC, m_sVideoInfo.iFaceHeight, iStride422, 1,
                               m_pDS420Buf, iStride420);
+#endif
             rotOneFaceChannel(m_pDS420Buf, nWidthC, nHeightC, iStride420, 1, ch, rot, pDstYuv, xc, yc, face, 0);
           }
         }
@@ -1441,6 +2707,10 @@ Void TGeometry::spherePadding(Bool bEnforced)
 
   if (!m_bGeometryMapping4SpherePadding)
     geometryMapping4SpherePadding();
+#if SVIDEO_DEMAND_SPHERE_PADDING
+  if (m_bDemandPadding && m_bPaddingDemandUpdated)
+    xPropagatePaddingDemand();
+#endif
 
   Int iBDPrecision       = S_INTERPOLATE_PrecisionBD;
   Int iWeightMapFaceMask = (1 << m_WeightMap_NumOfBits4Faces) - 1;
@@ -1457,6 +2727,10 @@ Void TGeometry::spherePadding(Bool bEnforced)
       if (fIdx == virtualFaceIdx)
         continue;
     }
+#endif
+#if SVIDEO_VIEWPORT_RENDERER
+    if (!((m_uiPadFaceMask >> fIdx) & 1))
+      continue;
 #endif
     for (Int ch = 0; ch < getNumChannels(); ch++)
     {
@@ -1470,9 +2744,18 @@ Void TGeometry::spherePadding(Bool bEnforced)
                      ? 0
                      : (ch > 0 ? 1 : 0);
       ChannelType chType = toChannelType(chId);
+#if SVIDEO_DEMAND_SPHERE_PADDING
+      //without any recorded demand all the margins are padded;
+      UChar *pDemand    = m_bDemandPadding ? m_pPaddingDemand[fIdx][ch > 0 ? 1 : 0] : nullptr;
+      UChar *pDemandRow = m_bDemandPadding ? m_pPaddingDemandRow[fIdx][ch > 0 ? 1 : 0] : nullptr;
+#endif
 
       for (Int j = -nMarginY; j < nHeight + nMarginY; j++)
       {
+#if SVIDEO_DEMAND_SPHERE_PADDING
+        if (pDemandRow && !pDemandRow[j + nMarginY])
+          continue;
+#endif
         for (Int i = -nMarginX; i < nWidth + nMarginX; i++)
         {
 #if SVIDEO_HEMI_PROJECTIONS
@@ -1488,6 +2771,10 @@ Void TGeometry::spherePadding(Bool bEnforced)
             if (insideFace(fIdx, (i << getComponentScaleX(chId)), (j << getComponentScaleY(chId)), COMPONENT_Y, chId))
               continue;
           }
+#if SVIDEO_DEMAND_SPHERE_PADDING
+          if (pDemand && !pDemand[(j + nMarginY) * getStride(chId) + (i + nMarginX)])
+            continue;
+#endif
 
           Int iLutIdx;
           getSPLutIdx(ch, i, j, iLutIdx);
@@ -1499,7 +2786,7 @@ Void TGeometry::spherePadding(Bool bEnforced)
           Int        iWLutIdx =
             (m_chromaFormatIDC == CHROMA_400 || (m_InterpolationType[0] == m_InterpolationType[1])) ? 0 : chType;
           Int *pWLut    = m_pWeightLut[iWLutIdx][pPelWeight->weightIdx];
-          Pel *pPelLine = m_pFacesOrig[face][ch] + iTLPos
+          FacePel *pPelLine = m_pFacesOrig[face][ch] + iTLPos
                           - ((m_iInterpFilterTaps[chType][1] - 1) >> 1) * getStride(chId)
                           - ((m_iInterpFilterTaps[chType][0] - 1) >> 1);
           for (Int m = 0; m < m_iInterpFilterTaps[chType][1]; m++)
@@ -1525,6 +2812,138 @@ Void TGeometry::spherePadding(Bool bEnforced)
 #endif
 }
 
+#if SVIDEO_DEMAND_SPHERE_PADDING
+/***************************************************
+//the padding only fills the margin samples read by the mapping tables built from this geometry by geoConvert(),
+//and the margin samples these are interpolated from; it must not be enabled if the margins are read otherwise;
+//the geometries padding their margins without the padding table never record any demand;
+****************************************************/
+Void TGeometry::setDemandPadding(Bool bEnabled)
+{
+  bEnabled = bEnabled && isDemandPaddingSupported();
+  if (m_bDemandPadding != bEnabled)
+  {
+    m_bDemandPadding = bEnabled;
+    m_bPadded        = false;
+  }
+}
+
+Void TGeometry::xFreePaddingDemand()
+{
+  for (Int fIdx = 0; fIdx < SV_MAX_NUM_FACES; fIdx++)
+  {
+    for (Int i = 0; i < 2; i++)
+    {
+      delete[] m_pPaddingDemand[fIdx][i];
+      delete[] m_pPaddingDemandRow[fIdx][i];
+      m_pPaddingDemand[fIdx][i] = m_pPaddingDemandRow[fIdx][i] = nullptr;
+    }
+  }
+}
+
+//mark the samples of the interpolation window given by wList; iDemandIdx: 0: luma; 1: chroma;
+Void TGeometry::xAddPaddingDemand(Int iDemandIdx, PxlFltLut &wList)
+{
+  ComponentID chId      = (ComponentID) iDemandIdx;
+  ChannelType chType    = toChannelType(chId);
+  Int         iStride   = getStride(chId);
+  Int         iHeightPW = (m_sVideoInfo.iFaceHeight + (m_iMarginY << 1)) >> getComponentScaleY(chId);
+
+  if (!m_pPaddingDemand[0][iDemandIdx])
+  {
+    //the demand of all the faces is recorded once one is; the faces never read are not padded;
+    for (Int fIdx = 0; fIdx < m_sVideoInfo.iNumFaces; fIdx++)
+    {
+      m_pPaddingDemand[fIdx][iDemandIdx]    = new UChar[iStride * iHeightPW];
+      m_pPaddingDemandRow[fIdx][iDemandIdx] = new UChar[iHeightPW];
+      memset(m_pPaddingDemand[fIdx][iDemandIdx], 0, iStride * iHeightPW);
+      memset(m_pPaddingDemandRow[fIdx][iDemandIdx], 0, iHeightPW);
+    }
+  }
+
+  Int iWeightMapFaceMask = (1 << m_WeightMap_NumOfBits4Faces) - 1;
+  Int face               = wList.facePos & iWeightMapFaceMask;
+  Int iTLPos             = wList.facePos >> m_WeightMap_NumOfBits4Faces;
+  Int iTapsX             = m_iInterpFilterTaps[chType][0];
+  Int iTapsY             = m_iInterpFilterTaps[chType][1];
+  Int iPos = iTLPos + getMarginY(chId) * iStride + getMarginX(chId) - ((iTapsY - 1) >> 1) * iStride - ((iTapsX - 1) >> 1);
+  Int y0   = iPos >= 0 ? iPos / iStride : -((iStride - 1 - iPos) / iStride);
+  Int x0   = iPos - y0 * iStride;
+
+  UChar *pDemand    = m_pPaddingDemand[face][iDemandIdx];
+  UChar *pDemandRow = m_pPaddingDemandRow[face][iDemandIdx];
+  for (Int y = std::max(y0, 0); y < std::min(y0 + iTapsY, iHeightPW); y++)
+  {
+    for (Int x = std::max(x0, 0); x < std::min(x0 + iTapsX, iStride); x++)
+    {
+      if (!pDemand[y * iStride + x])
+      {
+        pDemand[y * iStride + x] = 1;
+        pDemandRow[y]            = 1;
+        m_bPaddingDemandUpdated  = true;
+        m_bPadded                = false;
+      }
+    }
+  }
+}
+
+//the padded samples are interpolated from the samples of the neighboring faces, which may lie in their margins;
+Void TGeometry::xPropagatePaddingDemand()
+{
+  while (m_bPaddingDemandUpdated)
+  {
+    m_bPaddingDemandUpdated = false;
+    for (Int fIdx = 0; fIdx < m_sVideoInfo.iNumFaces; fIdx++)
+    {
+      for (Int iDemandIdx = 0; iDemandIdx < 2; iDemandIdx++)
+      {
+        if (!m_pPaddingDemand[fIdx][iDemandIdx])
+          continue;
+        ComponentID chId     = (ComponentID) iDemandIdx;
+        Int         nWidth   = m_sVideoInfo.iFaceWidth >> getComponentScaleX(chId);
+        Int         nHeight  = m_sVideoInfo.iFaceHeight >> getComponentScaleY(chId);
+        Int         nMarginX = m_iMarginX >> getComponentScaleX(chId);
+        Int         nMarginY = m_iMarginY >> getComponentScaleY(chId);
+        Int         mapIdx   = (m_chromaFormatIDC == CHROMA_444
+                      && m_InterpolationType[CHANNEL_TYPE_LUMA] == m_InterpolationType[CHANNEL_TYPE_CHROMA])
+                       ? 0
+                       : iDemandIdx;
+        UChar *pDemand    = m_pPaddingDemand[fIdx][iDemandIdx];
+        UChar *pDemandRow = m_pPaddingDemandRow[fIdx][iDemandIdx];
+
+        for (Int j = -nMarginY; j < nHeight + nMarginY; j++)
+        {
+          if (!pDemandRow[j + nMarginY])
+            continue;
+          for (Int i = -nMarginX; i < nWidth + nMarginX; i++)
+          {
+            if (!pDemand[(j + nMarginY) * getStride(chId) + (i + nMarginX)])
+              continue;
+#if SVIDEO_HEMI_PROJECTIONS
+            if ((m_sVideoInfo.geoType == SVIDEO_HCMP) || (m_sVideoInfo.geoType == SVIDEO_HEAC))
+            {
+              if (TGeometry::insideFace(fIdx, (i << getComponentScaleX(chId)), (j << getComponentScaleY(chId)),
+                                        COMPONENT_Y, chId))
+                continue;
+            }
+            else
+#endif
+            {
+              if (insideFace(fIdx, (i << getComponentScaleX(chId)), (j << getComponentScaleY(chId)), COMPONENT_Y, chId))
+                continue;
+            }
+
+            Int iLutIdx;
+            getSPLutIdx(iDemandIdx, i, j, iLutIdx);
+            xAddPaddingDemand(iDemandIdx, m_pPixelWeight4SherePadding[fIdx][mapIdx][iLutIdx]);
+          }
+        }
+      }
+    }
+  }
+}
+#endif
+
 Void TGeometry::geometryMapping4SpherePadding()
 {
   CHECK(m_bGeometryMapping4SpherePadding, "");
@@ -1767,7 +3186,7 @@ Void TGeometry::getSPLutIdx(Int ch, Int x, Int y, Int &iIdx)
 }
 
 // for frame packing;
-Void TGeometry::rotOneFaceChannel(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSrc, Int iStrideSrc, Int iNumSamplesPerPixel,
+Void TGeometry::rotOneFaceChannel(FacePel *pSrcBuf, Int iWidthSrc, Int iHeightSrc, Int iStrideSrc, Int iNumSamplesPerPixel,
                                   Int ch, Int rot, PelUnitBuf *pcPicYuvDst, Int offsetX, Int offsetY, Int face,
                                   Int iBDAdjust)
 {
@@ -1780,16 +3199,42 @@ Void TGeometry::rotOneFaceChannel(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSrc, I
   Int         iScaleY    = ::getComponentScaleY(chId, pcPicYuvDst->chromaFormat);
   Int         iOffset    = iBDAdjust > 0 ? (1 << (iBDAdjust - 1)) : 0;
 
+#if SVIDEO_BLOCKED_FACE_ROTATION
+  Int iSrcOffset, iStepI, iStepJ;
+  if (
+#if SVIDEO_TSP_IMP
+      m_sVideoInfo.geoType != SVIDEO_TSP &&
+#endif
+      face >= 0 && face < SV_MAX_NUM_FACES
+      && xGetRotScan(rot, iWidthSrc, iHeightSrc, iNumSamplesPerPixel, iStrideSrc, iSrcOffset, iStepI, iStepJ))
+  {
+    Bool bTranspose = ((rot / 90) & 1);
+    Int  iWidthDst  = bTranspose ? iHeightSrc : iWidthSrc;
+    Int  iHeightDst = bTranspose ? iWidthSrc : iHeightSrc;
+    CHECK(pcPicYuvDst->get(chId).width < offsetX + iWidthDst, "");
+    CHECK(pcPicYuvDst->get(chId).height < offsetY + iHeightDst, "");
+
+    const UChar *pMask = xGetInsideFaceMask(face, chId, iWidthSrc, iHeightSrc, iScaleX, iScaleY);
+    Int iMaskOffset = 0, iMaskStepI = 0, iMaskStepJ = 0;
+    if (pMask)
+    {
+      xGetRotScan(rot, iWidthSrc, iHeightSrc, 1, iWidthSrc, iMaskOffset, iMaskStepI, iMaskStepJ);
+      pMask += iMaskOffset;
+    }
+    xPackRotScan(pSrcBuf + iSrcOffset, iStepI, iStepJ, pMask, iMaskStepI, iMaskStepJ, pDstBuf, iStrideDst, iWidthDst, iHeightDst, iOffset, iBDAdjust, emptyVal);
+    return;
+  }
+#endif
   if (!rot)
   {
     Int  iWidthDst  = iWidthSrc;
     Int  iHeightDst = iHeightSrc;
-    Pel *pSrcLine   = pSrcBuf;
+    FacePel *pSrcLine = pSrcBuf;
     CHECK(pcPicYuvDst->get(chId).width < offsetX + iWidthDst, "");
     CHECK(pcPicYuvDst->get(chId).height < offsetY + iHeightDst, "");
     for (Int j = 0; j < iHeightDst; j++)
     {
-      Pel *pSrc = pSrcLine;
+      FacePel *pSrc = pSrcLine;
       for (Int i = 0; i < iWidthDst; i++, pSrc += iNumSamplesPerPixel)
       {
 #if SVIDEO_TSP_IMP
@@ -1820,13 +3265,13 @@ Void TGeometry::rotOneFaceChannel(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSrc, I
   {
     Int  iWidthDst  = iHeightSrc;
     Int  iHeightDst = iWidthSrc;
-    Pel *pSrcLine   = pSrcBuf + (iWidthSrc - 1) * iNumSamplesPerPixel;
+    FacePel *pSrcLine = pSrcBuf + (iWidthSrc - 1) * iNumSamplesPerPixel;
 
     CHECK(pcPicYuvDst->get(chId).width < offsetX + iWidthDst, "");
     CHECK(pcPicYuvDst->get(chId).height < offsetY + iHeightDst, "");
     for (Int j = 0; j < iHeightDst; j++)
     {
-      Pel *pSrc = pSrcLine;
+      FacePel *pSrc = pSrcLine;
       for (Int i = 0; i < iWidthDst; i++, pSrc += iStrideSrc)
       {
         if (insideFace(face, (iHeightDst - 1 - j) << iScaleX, i << iScaleY, COMPONENT_Y, chId))
@@ -1842,13 +3287,13 @@ Void TGeometry::rotOneFaceChannel(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSrc, I
   {
     Int  iWidthDst  = iWidthSrc;
     Int  iHeightDst = iHeightSrc;
-    Pel *pSrcLine   = pSrcBuf + (iHeightSrc - 1) * iStrideSrc + (iWidthSrc - 1) * iNumSamplesPerPixel;
+    FacePel *pSrcLine = pSrcBuf + (iHeightSrc - 1) * iStrideSrc + (iWidthSrc - 1) * iNumSamplesPerPixel;
 
     CHECK(pcPicYuvDst->get(chId).width < offsetX + iWidthDst, "");
     CHECK(pcPicYuvDst->get(chId).height < offsetY + iHeightDst, "");
     for (Int j = 0; j < iHeightDst; j++)
     {
-      Pel *pSrc = pSrcLine;
+      FacePel *pSrc = pSrcLine;
       for (Int i = 0; i < iWidthDst; i++, pSrc -= iNumSamplesPerPixel)
       {
         if (insideFace(face, (iWidthDst - 1 - i) << iScaleX, (iHeightDst - 1 - j) << iScaleY, COMPONENT_Y, chId))
@@ -1864,13 +3309,13 @@ Void TGeometry::rotOneFaceChannel(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSrc, I
   {
     Int  iWidthDst  = iHeightSrc;
     Int  iHeightDst = iWidthSrc;
-    Pel *pSrcLine   = pSrcBuf + (iHeightSrc - 1) * iStrideSrc;
+    FacePel *pSrcLine = pSrcBuf + (iHeightSrc - 1) * iStrideSrc;
 
     CHECK(pcPicYuvDst->get(chId).width < offsetX + iWidthDst, "");
     CHECK(pcPicYuvDst->get(chId).height < offsetY + iHeightDst, "");
     for (Int j = 0; j < iHeightDst; j++)
     {
-      Pel *pSrc = pSrcLine;
+      FacePel *pSrc = pSrcLine;
       for (Int i = 0; i < iWidthDst; i++, pSrc -= iStrideSrc)
       {
         if (insideFace(face, j << iScaleX, (iWidthDst - 1 - i) << iScaleY, COMPONENT_Y, chId))
@@ -1887,12 +3332,12 @@ Void TGeometry::rotOneFaceChannel(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSrc, I
   {
     Int  iWidthDst  = iWidthSrc;
     Int  iHeightDst = iHeightSrc;
-    Pel *pSrcLine   = pSrcBuf;
+    FacePel *pSrcLine = pSrcBuf;
     CHECK(pcPicYuvDst->get(chId).width < offsetX + iWidthDst, "");
     CHECK(pcPicYuvDst->get(chId).height < offsetY + iHeightDst, "");
     for (Int j = 0; j < iHeightDst; j++)
     {
-      Pel *pSrc = pSrcLine + (iWidthSrc - 1) * iNumSamplesPerPixel;
+      FacePel *pSrc = pSrcLine + (iWidthSrc - 1) * iNumSamplesPerPixel;
       for (Int i = 0; i < iWidthDst; i++, pSrc -= iNumSamplesPerPixel)
       {
         if (insideFace(face, (iWidthDst -1 - i) << iScaleX, j << iScaleY, COMPONENT_Y, chId))
@@ -1908,13 +3353,13 @@ Void TGeometry::rotOneFaceChannel(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSrc, I
   {
     Int  iWidthDst  = iHeightSrc;
     Int  iHeightDst = iWidthSrc;
-    Pel *pSrcLine   = pSrcBuf;
+    FacePel *pSrcLine = pSrcBuf;
 
     CHECK(pcPicYuvDst->get(chId).width < offsetX + iWidthDst, "");
     CHECK(pcPicYuvDst->get(chId).height < offsetY + iHeightDst, "");
     for (Int j = 0; j < iHeightDst; j++)
     {
-      Pel *pSrc = pSrcLine;
+      FacePel *pSrc = pSrcLine;
       for (Int i = 0; i < iWidthDst; i++, pSrc += iStrideSrc)
       {
         if (insideFace(face, j << iScaleX, i << iScaleY, COMPONENT_Y, chId))
@@ -1930,13 +3375,13 @@ Void TGeometry::rotOneFaceChannel(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSrc, I
   {
     Int  iWidthDst  = iWidthSrc;
     Int  iHeightDst = iHeightSrc;
-    Pel *pSrcLine   = pSrcBuf + (iHeightSrc - 1) * iStrideSrc;
+    FacePel *pSrcLine = pSrcBuf + (iHeightSrc - 1) * iStrideSrc;
 
     CHECK(pcPicYuvDst->get(chId).width < offsetX + iWidthDst, "");
     CHECK(pcPicYuvDst->get(chId).height < offsetY + iHeightDst, "");
     for (Int j = 0; j < iHeightDst; j++)
     {
-      Pel *pSrc = pSrcLine;
+      FacePel *pSrc = pSrcLine;
       for (Int i = 0; i < iWidthDst; i++, pSrc += iNumSamplesPerPixel)
       {
         if (insideFace(face, i << iScaleX, (iHeightDst - 1 - j) << iScaleY, COMPONENT_Y, chId))
@@ -1952,13 +3397,13 @@ Void TGeometry::rotOneFaceChannel(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSrc, I
   {
     Int  iWidthDst  = iHeightSrc;
     Int  iHeightDst = iWidthSrc;
-    Pel *pSrcLine   = pSrcBuf + (iHeightSrc - 1) * iStrideSrc + (iWidthSrc - 1) * iNumSamplesPerPixel;
+    FacePel *pSrcLine = pSrcBuf + (iHeightSrc - 1) * iStrideSrc + (iWidthSrc - 1) * iNumSamplesPerPixel;
 
     CHECK(pcPicYuvDst->get(chId).width < offsetX + iWidthDst, "");
     CHECK(pcPicYuvDst->get(chId).height < offsetY + iHeightDst, "");
     for (Int j = 0; j < iHeightDst; j++)
     {
-      Pel *pSrc = pSrcLine;
+      FacePel *pSrc = pSrcLine;
       for (Int i = 0; i < iWidthDst; i++, pSrc -= iStrideSrc)
       {
         if (insideFace(face, (iHeightDst - 1 - j) << iScaleX, (iWidthDst - 1 - i) << iScaleY, COMPONENT_Y, chId))
@@ -1979,7 +3424,7 @@ Void TGeometry::rotOneFaceChannel(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSrc, I
 for convertYuv and framePack in general;
 *********************************************/
 Void TGeometry::rotFaceChannelGeneral(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSrc, Int iStrideSrc, Int nSPPSrc, Int rot,
-                                      Pel *pDstBuf, Int iStrideDst, Int nSPPDst, Bool bInverse)
+                                      FacePel *pDstBuf, Int iStrideDst, Int nSPPDst, Bool bInverse)
 {
 #if SVIDEO_HFLIP
   Bool bFlip = (rot >= 360);
@@ -1992,16 +3437,35 @@ Void TGeometry::rotFaceChannelGeneral(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSr
   {
     rot = (360 - rot) % 360;
   }
+#if SVIDEO_BLOCKED_FACE_ROTATION
+  {
+    //the flip is applied before the rotation here, and after it in rotOneFaceChannel();
+    Int iScanRot = rot;
+#if SVIDEO_HFLIP
+    if (bFlip)
+    {
+      iScanRot = SVIDEO_HFLIP_DEGREE + ((360 - rot) % 360);
+    }
+#endif
+    Int iSrcOffset, iStepI, iStepJ;
+    if (xGetRotScan(iScanRot, iWidthSrc, iHeightSrc, nSPPSrc, iStrideSrc, iSrcOffset, iStepI, iStepJ))
+    {
+      Bool bTranspose = ((rot / 90) & 1);
+      xCopyRotScan(pSrcBuf + iSrcOffset, iStepI, iStepJ, pDstBuf, nSPPDst, iStrideDst, bTranspose ? iHeightSrc : iWidthSrc, bTranspose ? iWidthSrc : iHeightSrc);
+      return;
+    }
+  }
+#endif
   if (!rot 
 #if SVIDEO_HFLIP
      && !bFlip
 #endif
     )
   {
-    Int  iWidthDst  = iWidthSrc;
-    Int  iHeightDst = iHeightSrc;
-    Pel *pSrcLine   = pSrcBuf;
-    Pel *pDstLine   = pDstBuf;
+    Int      iWidthDst  = iWidthSrc;
+    Int      iHeightDst = iHeightSrc;
+    Pel     *pSrcLine   = pSrcBuf;
+    FacePel *pDstLine   = pDstBuf;
     for (Int j = 0; j < iHeightDst; j++)
     {
       for (Int i = 0; i < iWidthDst; i++)
@@ -2018,10 +3482,10 @@ Void TGeometry::rotFaceChannelGeneral(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSr
 #endif
     )
   {
-    Int  iWidthDst  = iHeightSrc;
-    Int  iHeightDst = iWidthSrc;
-    Pel *pSrcLine   = pSrcBuf + (iWidthSrc - 1) * nSPPSrc;
-    Pel *pDstLine   = pDstBuf;
+    Int      iWidthDst  = iHeightSrc;
+    Int      iHeightDst = iWidthSrc;
+    Pel     *pSrcLine   = pSrcBuf + (iWidthSrc - 1) * nSPPSrc;
+    FacePel *pDstLine   = pDstBuf;
     for (Int j = 0; j < iHeightDst; j++)
     {
       Pel *pSrc = pSrcLine;
@@ -2039,10 +3503,10 @@ Void TGeometry::rotFaceChannelGeneral(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSr
 #endif
     )
   {
-    Int  iWidthDst  = iWidthSrc;
-    Int  iHeightDst = iHeightSrc;
-    Pel *pSrcLine   = pSrcBuf + (iHeightSrc - 1) * iStrideSrc + (iWidthSrc - 1) * nSPPSrc;
-    Pel *pDstLine   = pDstBuf;
+    Int      iWidthDst  = iWidthSrc;
+    Int      iHeightDst = iHeightSrc;
+    Pel     *pSrcLine   = pSrcBuf + (iHeightSrc - 1) * iStrideSrc + (iWidthSrc - 1) * nSPPSrc;
+    FacePel *pDstLine   = pDstBuf;
     for (Int j = 0; j < iHeightDst; j++)
     {
       Pel *pSrc = pSrcLine;
@@ -2060,10 +3524,10 @@ Void TGeometry::rotFaceChannelGeneral(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSr
 #endif
     )
   {
-    Int  iWidthDst  = iHeightSrc;
-    Int  iHeightDst = iWidthSrc;
-    Pel *pSrcLine   = pSrcBuf + (iHeightSrc - 1) * iStrideSrc;
-    Pel *pDstLine   = pDstBuf;
+    Int      iWidthDst  = iHeightSrc;
+    Int      iHeightDst = iWidthSrc;
+    Pel     *pSrcLine   = pSrcBuf + (iHeightSrc - 1) * iStrideSrc;
+    FacePel *pDstLine   = pDstBuf;
     for (Int j = 0; j < iHeightDst; j++)
     {
       Pel *pSrc = pSrcLine;
@@ -2078,10 +3542,10 @@ Void TGeometry::rotFaceChannelGeneral(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSr
 #if SVIDEO_HFLIP
   else if (!rot && bFlip)
   {
-    Int  iWidthDst  = iWidthSrc;
-    Int  iHeightDst = iHeightSrc;
-    Pel *pSrcLine   = pSrcBuf + (iWidthSrc - 1) * nSPPSrc;
-    Pel *pDstLine   = pDstBuf;
+    Int      iWidthDst  = iWidthSrc;
+    Int      iHeightDst = iHeightSrc;
+    Pel     *pSrcLine   = pSrcBuf + (iWidthSrc - 1) * nSPPSrc;
+    FacePel *pDstLine   = pDstBuf;
     for (Int j = 0; j < iHeightDst; j++)
     {
       for (Int i = 0; i < iWidthDst; i++)
@@ -2094,10 +3558,10 @@ Void TGeometry::rotFaceChannelGeneral(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSr
   }
   else if (rot == 90 && bFlip)
   {
-    Int  iWidthDst  = iHeightSrc;
-    Int  iHeightDst = iWidthSrc;
-    Pel *pSrcLine   = pSrcBuf + (iHeightSrc - 1) * iStrideSrc + (iWidthSrc - 1) * nSPPSrc;
-    Pel *pDstLine   = pDstBuf;
+    Int      iWidthDst  = iHeightSrc;
+    Int      iHeightDst = iWidthSrc;
+    Pel     *pSrcLine   = pSrcBuf + (iHeightSrc - 1) * iStrideSrc + (iWidthSrc - 1) * nSPPSrc;
+    FacePel *pDstLine   = pDstBuf;
     for (Int j = 0; j < iHeightDst; j++)
     {
       Pel *pSrc = pSrcLine;
@@ -2111,10 +3575,10 @@ Void TGeometry::rotFaceChannelGeneral(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSr
   }
   else if (rot == 180 && bFlip)
   {
-    Int  iWidthDst  = iWidthSrc;
-    Int  iHeightDst = iHeightSrc;
-    Pel *pSrcLine   = pSrcBuf + (iHeightSrc - 1) * iStrideSrc;
-    Pel *pDstLine   = pDstBuf;
+    Int      iWidthDst  = iWidthSrc;
+    Int      iHeightDst = iHeightSrc;
+    Pel     *pSrcLine   = pSrcBuf + (iHeightSrc - 1) * iStrideSrc;
+    FacePel *pDstLine   = pDstBuf;
     for (Int j = 0; j < iHeightDst; j++)
     {
       Pel *pSrc = pSrcLine;
@@ -2128,10 +3592,10 @@ Void TGeometry::rotFaceChannelGeneral(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSr
   }
   else if (rot == 270 && bFlip)
   {
-    Int  iWidthDst  = iHeightSrc;
-    Int  iHeightDst = iWidthSrc;
-    Pel *pSrcLine   = pSrcBuf;
-    Pel *pDstLine   = pDstBuf;
+    Int      iWidthDst  = iHeightSrc;
+    Int      iHeightDst = iWidthSrc;
+    Pel     *pSrcLine   = pSrcBuf;
+    FacePel *pDstLine   = pDstBuf;
     for (Int j = 0; j < iHeightDst; j++)
     {
       Pel *pSrc = pSrcLine;
@@ -2148,6 +3612,124 @@ Void TGeometry::rotFaceChannelGeneral(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSr
     CHECK(true, "Not supported");
 }
 
+#if SVIDEO_BLOCKED_FACE_ROTATION
+/*********************************************
+scan of the source face for the rotations of rotOneFaceChannel(): destination sample (i, j) is
+read at iOffset + i*iStepI + j*iStepJ, with iStepX and iStepY the steps of a source column and row;
+*********************************************/
+Bool TGeometry::xGetRotScan(Int rot, Int iWidthSrc, Int iHeightSrc, Int iStepX, Int iStepY, Int &iOffset, Int &iStepI, Int &iStepJ)
+{
+  //[rot/90]: last column, last row, (dx, dy) along a destination row, (dx, dy) along a destination column;
+  static const Int iScan[8][6] = { { 0, 0,  1,  0,  0,  1 }, { 1, 0,  0,  1, -1,  0 }, { 1, 1, -1,  0,  0, -1 }, { 0, 1,  0, -1,  1,  0 },
+                                   { 1, 0, -1,  0,  0,  1 }, { 0, 0,  0,  1,  1,  0 }, { 0, 1,  1,  0,  0, -1 }, { 1, 1,  0, -1, -1,  0 } };
+#if SVIDEO_HFLIP
+  Int iNumScans = (SVIDEO_HFLIP_DEGREE == 360) ? 8 : 4;
+#else
+  Int iNumScans = 4;
+#endif
+  if (rot < 0 || (rot % 90) || rot / 90 >= iNumScans)
+  {
+    return false;
+  }
+  const Int *pScan = iScan[rot / 90];
+  iOffset = pScan[0] * (iWidthSrc - 1) * iStepX + pScan[1] * (iHeightSrc - 1) * iStepY;
+  iStepI  = pScan[2] * iStepX + pScan[3] * iStepY;
+  iStepJ  = pScan[4] * iStepX + pScan[5] * iStepY;
+  return true;
+}
+
+//the transposes read the source in tiles, so that the lines of a tile stay in the cache;
+template<typename T>
+Void TGeometry::xCopyRotScan(const T *pSrc, Int iStepI, Int iStepJ, FacePel *pDst, Int nSPPDst, Int iStrideDst, Int iWidthDst, Int iHeightDst)
+{
+  Int iTile = (abs(iStepI) > abs(iStepJ)) ? S_ROT_TILE_SIZE : std::max(iWidthDst, iHeightDst);
+  for (Int y0 = 0; y0 < iHeightDst; y0 += iTile)
+  {
+    Int yEnd = std::min(y0 + iTile, iHeightDst);
+    for (Int x0 = 0; x0 < iWidthDst; x0 += iTile)
+    {
+      Int xEnd = std::min(x0 + iTile, iWidthDst);
+      for (Int j = y0; j < yEnd; j++)
+      {
+        const T   *pS = pSrc + j * iStepJ + x0 * iStepI;
+        FacePel   *pD = pDst + j * iStrideDst + x0 * nSPPDst;
+        for (Int i = x0; i < xEnd; i++, pS += iStepI, pD += nSPPDst)
+        {
+          *pD = *pS;
+        }
+      }
+    }
+  }
+}
+template Void TGeometry::xCopyRotScan<Pel>(const Pel *pSrc, Int iStepI, Int iStepJ, FacePel *pDst, Int nSPPDst, Int iStrideDst, Int iWidthDst, Int iHeightDst);
+#if SVIDEO_8BIT_FACE_STORAGE
+template Void TGeometry::xCopyRotScan<FacePel>(const FacePel *pSrc, Int iStepI, Int iStepJ, FacePel *pDst, Int nSPPDst, Int iStrideDst, Int iWidthDst, Int iHeightDst);
+#endif
+
+Void TGeometry::xPackRotScan(const FacePel *pSrc, Int iStepI, Int iStepJ, const UChar *pMask, Int iMaskStepI, Int iMaskStepJ, Pel *pDst, Int iStrideDst,
+                             Int iWidthDst, Int iHeightDst, Int iOffset, Int iBDAdjust, Pel emptyVal)
+{
+  Int iTile = (abs(iStepI) > abs(iStepJ)) ? S_ROT_TILE_SIZE : std::max(iWidthDst, iHeightDst);
+  for (Int y0 = 0; y0 < iHeightDst; y0 += iTile)
+  {
+    Int yEnd = std::min(y0 + iTile, iHeightDst);
+    for (Int x0 = 0; x0 < iWidthDst; x0 += iTile)
+    {
+      Int xEnd = std::min(x0 + iTile, iWidthDst);
+      for (Int j = y0; j < yEnd; j++)
+      {
+        const FacePel *pS = pSrc + j * iStepJ + x0 * iStepI;
+        Pel           *pD = pDst + j * iStrideDst;
+        if (pMask)
+        {
+          const UChar *pM = pMask + j * iMaskStepJ + x0 * iMaskStepI;
+          for (Int i = x0; i < xEnd; i++, pS += iStepI, pM += iMaskStepI)
+          {
+            pD[i] = *pM ? ClipBD(((*pS) + iOffset) >> iBDAdjust, m_nOutputBitDepth) : emptyVal;
+          }
+        }
+        else
+        {
+          for (Int i = x0; i < xEnd; i++, pS += iStepI)
+          {
+            pD[i] = ClipBD(((*pS) + iOffset) >> iBDAdjust, m_nOutputBitDepth);
+          }
+        }
+      }
+    }
+  }
+}
+
+//insideFace() of the samples of a face channel, in source face coordinates; nullptr if all samples are inside;
+const UChar* TGeometry::xGetInsideFaceMask(Int face, ComponentID chId, Int iWidth, Int iHeight, Int iScaleX, Int iScaleY)
+{
+  std::vector<UChar> &mask = m_insideFaceMask[face][chId];
+  Int *pSize = m_iInsideFaceMaskSize[face][chId];
+  if (pSize[0] != iWidth || pSize[1] != iHeight || pSize[2] != iScaleX || pSize[3] != iScaleY)
+  {
+    Bool bAllInside = true;
+    mask.resize(iWidth * iHeight);
+    for (Int j = 0; j < iHeight; j++)
+    {
+      for (Int i = 0; i < iWidth; i++)
+      {
+        mask[j * iWidth + i] = insideFace(face, i << iScaleX, j << iScaleY, COMPONENT_Y, chId) ? 1 : 0;
+        bAllInside = bAllInside && mask[j * iWidth + i];
+      }
+    }
+    if (bAllInside)
+    {
+      std::vector<UChar>().swap(mask);
+    }
+    pSize[0] = iWidth;
+    pSize[1] = iHeight;
+    pSize[2] = iScaleX;
+    pSize[3] = iScaleY;
+  }
+  return mask.empty() ? nullptr : &mask[0];
+}
+#endif
+
 #if SVIDEO_ROT_FIX
 Void TGeometry::invRotate3D(SPos &sPos, Int iRoll, Int iPitch, Int iYaw)
 {
@@ -2355,7 +3937,7 @@ Pel TGeometry::getPelValue(ComponentID chId, SPos inPos)
   Int  iTLPos   = (wList.facePos) >> m_WeightMap_NumOfBits4Faces;
   Int  iWLutIdx = (m_chromaFormatIDC == CHROMA_400 || (m_InterpolationType[0] == m_InterpolationType[1])) ? 0 : chType;
   Int *pWLut    = m_pWeightLut[iWLutIdx][wList.weightIdx];
-  Pel *pPelLine = m_pFacesOrig[face][chId] + iTLPos - ((m_iInterpFilterTaps[chType][1] - 1) >> 1) * iWidthPW
+  FacePel *pPelLine = m_pFacesOrig[face][chId] + iTLPos - ((m_iInterpFilterTaps[chType][1] - 1) >> 1) * iWidthPW
                   - ((m_iInterpFilterTaps[chType][0] - 1) >> 1);
 
   for (Int m = 0; m < m_iInterpFilterTaps[chType][1]; m++)
@@ -2637,23 +4219,29 @@ Void TGeometry::dumpAllFacesToFile(TChar *pPrefixFN, Bool bMarginIncluded, Bool
     fclose(fp);
   }
 }
-Void TGeometry::dumpBufToFile(Pel *pSrc, Int iWidth, Int iHeight, Int iNumSamples, Int iStride, FILE *fp)
+template<typename T>
+Void TGeometry::dumpBufToFile(T *pSrc, Int iWidth, Int iHeight, Int iNumSamples, Int iStride, FILE *fp)
 {
   CHECK(!fp || !pSrc, "");
   // output the 16bit format;
   if (fp)
   {
-    Pel *pSrcLine = pSrc;
+    T *pSrcLine = pSrc;
     for (Int j = 0; j < iHeight; j++)
     {
       for (Int i = 0; i < iWidth; i++)
       {
-        fwrite(pSrcLine + i * iNumSamples, sizeof(Pel), 1, fp);
+        Pel val = pSrcLine[i * iNumSamples];
+        fwrite(&val, sizeof(Pel), 1, fp);
       }
       pSrcLine += iStride;
     }
   }
 }
+template Void TGeometry::dumpBufToFile<Pel>(Pel *pSrc, Int iWidth, Int iHeight, Int iNumSamples, Int iStride, FILE *fp);
+#if SVIDEO_8BIT_FACE_STORAGE
+template Void TGeometry::dumpBufToFile<FacePel>(FacePel *pSrc, Int iWidth, Int iHeight, Int iNumSamples, Int iStride, FILE *fp);
+#endif
 
 // dump the sampling points on the sphere either to the file, or to the memory for analysis, or both;
 Void TGeometry::dumpSpherePoints(TChar *pFileName, Bool bAppended, SpherePoints *pSphPoints)
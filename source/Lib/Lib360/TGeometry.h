@@ -203,6 +203,36 @@
 #endif
 // 360Lib-12.0;
 #define SVIDEO_GCMP_BLENDING                             1      //JVET-T0118
+// 360Lib-13.2 development;
+#define SVIDEO_SHARED_FRAME_CONTEXT                      1      // convert and pad each picture once per geometry, shared by all metrics
+#define SVIDEO_CONCURRENT_METRICS                        1      // run the enabled metrics as independent tasks on a pool of worker threads
+#define SVIDEO_ORIG_FRAME_CACHE                          1      // POC indexed ring cache of the original pictures for the end to end metrics
+#define SVIDEO_INPUT_PREFETCH                            1      // read and convert the input pictures ahead of the encoder on a separate thread
+#define SVIDEO_INPUT_CACHE                               1      // persistent cache of the input pictures converted to the coding geometry, reused across encoder runs
+#define SVIDEO_VIEWPORT_LUT_CACHE                        1      // LRU cache of the viewport mapping tables keyed by the quantised orientation
+#define SVIDEO_VIEWPORT_DIRECT_SAMPLING                  1      // sample the viewports directly from the source geometry without building the mapping tables
+#define SVIDEO_VIEWPORT_BATCH_PSNR                       1      // evaluate all the static viewports in one pass on several threads without frame packing them
+#define SVIDEO_TRACE_VIEWPORT_PSNR                       1      // viewport PSNR along the recorded head motion traces of many users, identical orientations are evaluated once
+#define SVIDEO_VIEWPORT_RENDERER                         1      // render a list of viewports from one frame, only the faces sampled by the viewports are converted and padded
+#define SVIDEO_VIEWPORT_DEPENDENCY_MAP                   1      // regions of the frame packed picture the samples of a viewport depend on, for partial decoding
+#define SVIDEO_DEMAND_SPHERE_PADDING                     1      // the sphere padding only fills the margin samples read by the mapping tables built from the geometry
+#define SVIDEO_POLYHEDRON_FACE_INDEX                     1      // OHP/ISP map3DTo2D only tests the candidate faces of the cell of the sphere the point is in
+#define SVIDEO_TRIANGLE_SPAN_TABLE                       1      // OHP/ISP triangle copies use the spans of the rows inside the faces instead of testing every sample
+#define SVIDEO_FISHEYE_PRECOMPUTATION                    1      // fisheye rotation, field of view and the row spans of the circular region are derived once
+#define SVIDEO_FUSED_PACKED_CONVERSION                   1      // one table from the destination to the source frame packed picture, no face buffers for plain packings
+#define SVIDEO_SEPARABLE_CUBE_MAPPING                    1      // column and row tables instead of the per sample table for the conversions between unrotated cube based geometries
+#define SVIDEO_SEPARABLE_CYLINDER_MAPPING                1      // column and row tables for the conversions between unrotated ERP and EAP (AEP); near-exact, the longitudes may round differently than per sample
+#define SVIDEO_YAW_ROTATION_SHIFT                        1      // yaw rotations of ERP and EAP also use the column and row tables; integer rows are filtered horizontally, or copied for integer shifts
+#define SVIDEO_SEPARABLE_TWO_PASS_FILTER                 1      // faces mapped by the column and row tables are filtered with 1-D kernels, horizontally into a temporary buffer then vertically; rounded once, within 1 of the 2-D kernels
+#define SVIDEO_FAST_TRIGONOMETRY                         0      // polynomial approximations of the trigonometric functions of the mappings, chosen at build time so that they keep POSType; the error is below 1e-10 rad
+#define SVIDEO_FLOAT_POSITION                            0      // single precision POSType for the mappings and the spherical sampling
+#define SVIDEO_MAPPING_ACCURACY_CHECK                    1      // dump of the mapping tables with the source positions, compared with the dump of another build (e.g. with SVIDEO_FLOAT_POSITION or SVIDEO_FAST_TRIGONOMETRY)
+#define SVIDEO_BLOCKED_FACE_ROTATION                     1      // face rotations and flips are one strided copy, transposes in tiles; the insideFace() test of the frame packing is cached per face
+#define SVIDEO_FUSED_CHROMA_RESAMPLING                   1      // chroma resampling filters specialised for the number of taps; the upsampling filters both directions row by row, the 444->420 downsampling in strips of rows
+#define SVIDEO_SSP_POLE_CHROMA_LOCATION                  1      // SSP pole chroma siting fix; the pole padding of a 420 picture maps and fades the chroma samples at their chroma sample location
+#define SVIDEO_SSP_CHROMA_MARGIN_FIX                     1      // SSP 420 chroma margins are initialised: the top and bottom margins of the equatorial faces before the sphere padding, the margins of the chroma upsampling buffer
+#define SVIDEO_RSP_420_OUTPUT_PADDING                    1      // native 420 RSP maps the padded arc region from the source as the 444 path does; the sphere padding read samples outside the faces that were never written
+#define SVIDEO_8BIT_FACE_STORAGE                         0      // 8-bit samples in the face buffers, for builds that only convert 8-bit content (InternalBitDepth 8)
 
 //#define SV_MAX_NUM_SAMPLING          64
 #define SV_MAX_NUM_FACES             20
@@ -210,16 +240,29 @@
 
 #define SVIDEO_DEBUG                 0
 
-#define scos(x)         cos((Double)(x))
-#define ssin(x)         sin((Double)(x))
-#define satan(x)        atan((Double)(x))
-#define satan2(y, x)    atan2((Double)(y), (Double)(x))
-#define sacos(x)        acos((Double)(x))
-#define sasin(x)        asin((Double)(x))
-#define ssqrt(x)        sqrt((Double)(x))
+#if SVIDEO_FAST_TRIGONOMETRY
+#define scos(x)         ((POSType)TFastTrig::fastCos((Double)(x)))
+#define ssin(x)         ((POSType)TFastTrig::fastSin((Double)(x)))
+#define satan(x)        ((POSType)TFastTrig::fastAtan((Double)(x)))
+#define satan2(y, x)    ((POSType)TFastTrig::fastAtan2((Double)(y), (Double)(x)))
+#define sacos(x)        ((POSType)TFastTrig::fastAcos((Double)(x)))
+#define sasin(x)        ((POSType)TFastTrig::fastAsin((Double)(x)))
+#else
+#define scos(x)         cos((POSType)(x))
+#define ssin(x)         sin((POSType)(x))
+#define satan(x)        atan((POSType)(x))
+#define satan2(y, x)    atan2((POSType)(y), (POSType)(x))
+#define sacos(x)        acos((POSType)(x))
+#define sasin(x)        asin((POSType)(x))
+#endif
+#define ssqrt(x)        sqrt((POSType)(x))
 #define sfloor(x)       floor((Double)(x))
 #define sfabs(x)        fabs((Double)(x))
-#define stan(x)         tan((Double)(x))
+#if SVIDEO_FAST_TRIGONOMETRY
+#define stan(x)         ((POSType)TFastTrig::fastTan((Double)(x)))
+#else
+#define stan(x)         tan((POSType)(x))
+#endif
 
 // ====================================================================================================================
 // Basic type redefinition
@@ -238,7 +281,17 @@ typedef       unsigned int        UInt;
 typedef       double              Double;
 typedef       float               Float;
 
+#if SVIDEO_FLOAT_POSITION
+typedef Float           POSType;
+#else
 typedef Double          POSType;
+#endif
+#if SVIDEO_8BIT_FACE_STORAGE
+typedef UChar           FacePel;
+#else
+typedef Pel             FacePel;
+#endif
+#include "TFastTrig.h"
 
 static const Double S_PI = 3.14159265358979323846;
 static const Double S_PI_2 = 1.57079632679489661923;
@@ -254,9 +307,18 @@ static const Int   S_log2NumFaces[SV_MAX_NUM_FACES+1] = { 0,
                                                           4, 4, 4, 4, 4, 4, 4, 4, 
                                                           5, 5, 5, 5 };
 static const Int  S_LANCZOS_LUT_SCALE = 100;
+#if SVIDEO_BLOCKED_FACE_ROTATION
+static const Int  S_ROT_TILE_SIZE = 32;   //tile of the transposed face copies;
+#endif
+#if SVIDEO_FUSED_CHROMA_RESAMPLING
+static const Int  S_CHROMA_DS_STRIP = 8;  //chroma rows of a strip of the 444->420 downsampling;
+#endif
 #if SVIDEO_COHP1_PADDING
 static const Int  S_COHP1_PAD = 16;
 #endif
+#if SVIDEO_VIEWPORT_DEPENDENCY_MAP
+static const Int  S_DEPENDENCY_CACHE_SIZE = 4096;  //viewport orientations kept by TViewPortDependencyMap;
+#endif
 
 enum GeometryType
 {
@@ -527,11 +589,25 @@ struct TriMesh
 };
 
 class TGeometry;
+#if SVIDEO_VIEWPORT_DIRECT_SAMPLING
+class TWorkerPool;
+#endif
 struct PxlFltLut
 {
   Int facePos;          //MSBs for pos; LSBs for faceIdx;
   UShort weightIdx; 
 };
+#if SVIDEO_MAPPING_ACCURACY_CHECK
+struct MappingCheckEntry
+{
+  Int    ch;
+  Int    facePos;
+  Int    weightIdx;
+  Int    faceIdx;      //source face and position, in double whatever POSType is;
+  Double x;
+  Double y;
+};
+#endif
 typedef Void (TGeometry::*interpolateWeightFP)(ComponentID chId, SPos *pSPosIn, PxlFltLut &wlist);
 
 
@@ -560,8 +636,8 @@ class TGeometry
 protected:
   SVideoInfo m_sVideoInfo;
 
-  Pel ***m_pFacesBuf; 
-  Pel ***m_pFacesOrig; //[face][component][raster scan position]
+  FacePel ***m_pFacesBuf; 
+  FacePel ***m_pFacesOrig; //[face][component][raster scan position]
   
   //descriptor for the buffer;
   ChromaFormat m_chromaFormatIDC;   //chroma format of geometry;
@@ -575,20 +651,23 @@ protected:
 
   //temp buffer for chroma downsampling used for framepacking;
   Pel* m_pDS422Buf;
-  Pel* m_pDS420Buf;
+  FacePel* m_pDS420Buf;
   Filter1DInfo m_filterDs[2];  //[0:Hor][1:Ver]
-  Pel* m_pFaceRotBuf;
+  FacePel* m_pFaceRotBuf;
 
   //temp buffer for chroma upsampling;
   Int *m_pUpsTempBuf; //extended buffer for chroma upsampling; [widthC+filtersize]*[heightC*2];
   Int m_iUpsTempBufMarginSize;
   Int m_iStrideUpsTempBuf;
   Filter1DInfo m_filterUps[4];  //[0:Hor phase0; 1:Hor phase1; 2:Ver 3/4 phase; 3: Ver 1/4 phase] The norm for different phases in one direciton must be the same;
+#if SVIDEO_VIEWPORT_DEPENDENCY_MAP
+  std::vector<Int> *m_pUpsProbe; //[face]: the Cb samples chromaUpsample() reads are recorded here instead of being upsampled, if set;
+#endif
 
-  Pel **m_pFacesBufTemp;   //[face][raster scan position]; store the chroma data, and used for chroma upsampling;
+  FacePel **m_pFacesBufTemp;   //[face][raster scan position]; store the chroma data, and used for chroma upsampling;
   Int m_nMarginSizeBufTemp;
   Int m_nStrideBufTemp;
-  Pel **m_pFacesBufTempOrig;
+  FacePel **m_pFacesBufTempOrig;
 
   Bool m_bPadded;
   //interpolation;
@@ -607,6 +686,19 @@ protected:
   Int m_iInterpFilterTaps[MAX_NUM_CHANNEL_TYPE][2];                                        //[channel][hor/ver];
   Int **m_pWeightLut[2];
   PxlFltLut *m_pPixelWeight[SV_MAX_NUM_FACES][2];                   //[SV_MAX_NUM_FACES][2][pxl_idx];
+#if SVIDEO_SEPARABLE_CUBE_MAPPING
+  Bool       m_bSeparableMapping[SV_MAX_NUM_FACES];                 //the weights of a sample are the sum of those of its column and row;
+  PxlFltLut *m_pPixelWeightSep[SV_MAX_NUM_FACES][2][2];             //[SV_MAX_NUM_FACES][2][0: column; 1: row][idx];
+#if SVIDEO_YAW_ROTATION_SHIFT
+  Int        m_iSepColumnShift[SV_MAX_NUM_FACES][2];                //the columns are the source columns circularly shifted by it, -1: not a shift;
+  Bool       m_bHorWeightLut[2];                                    //the kernels of the integer rows only weight their middle row;
+  Bool       m_bIdentityWeight[2];                                  //the kernel of the integer positions is the middle tap;
+#endif
+#if SVIDEO_SEPARABLE_TWO_PASS_FILTER
+  Bool       m_bSepTwoPass[SV_MAX_NUM_FACES][2];                    //all the rows read the same source columns, the face is filtered in two 1-D passes;
+  std::vector<Int> m_weightLut1D[2];                                //[filter][phase*taps]; 1-D kernels, the phases of m_pWeightLut;
+#endif
+#endif
 
   Int m_iChromaSampleLocType;
   Void setChromaResamplingFilter(Int iChromaSampleLocType);
@@ -614,16 +706,70 @@ protected:
   Bool m_bGeometryMapping4SpherePadding;
   PxlFltLut *m_pPixelWeight4SherePadding[SV_MAX_NUM_FACES][2];
   Bool m_bConvOutputPaddingNeeded;
+#if SVIDEO_VIEWPORT_RENDERER
+  UInt m_uiConvertFaceMask;                //faces converted by convertYuv(), if the geometry supports the face masks;
+  UInt m_uiPadFaceMask;                    //faces padded by spherePadding();
+#endif
+#if SVIDEO_DEMAND_SPHERE_PADDING
+  Bool   m_bDemandPadding;
+  Bool   m_bPaddingDemandUpdated;                           //the demand is to be propagated through the padding table;
+  UChar *m_pPaddingDemand[SV_MAX_NUM_FACES][2];             //[face][0: luma; 1: chroma][raster scan position including the margins];
+  UChar *m_pPaddingDemandRow[SV_MAX_NUM_FACES][2];          //[face][0: luma; 1: chroma][row]; rows with at least one demanded sample;
+#endif
+#if SVIDEO_BLOCKED_FACE_ROTATION
+  std::vector<UChar> m_insideFaceMask[SV_MAX_NUM_FACES][MAX_NUM_COMPONENT];    //insideFace() of the samples of a face for the frame packing, empty if all samples are inside;
+  Int                m_iInsideFaceMaskSize[SV_MAX_NUM_FACES][MAX_NUM_COMPONENT][4]; //width, height, scaleX and scaleY the mask is built for;
+#endif
 
   Void geometryMapping4SpherePadding();
   Void getSPLutIdx(Int ch, Int x, Int y, Int& iIdx);
+#if SVIDEO_DEMAND_SPHERE_PADDING
+  Void xAddPaddingDemand(Int iDemandIdx, PxlFltLut &wList);
+  Void xPropagatePaddingDemand();
+  Void xFreePaddingDemand();
+#endif
+#if SVIDEO_SEPARABLE_CUBE_MAPPING || SVIDEO_MAPPING_ACCURACY_CHECK
+  Void xMapSamplePos(TGeometry *pGeoSrc, Int fIdx, ComponentID chId, Int i, Int j, Int *pRot, Bool bInvRot, SPos &pos);
+#endif
+#if SVIDEO_MAPPING_ACCURACY_CHECK
+  Void xGetMappingCheckEntries(TGeometry *pGeoSrc, std::vector<MappingCheckEntry> &entries);
+#endif
+#if SVIDEO_SEPARABLE_CUBE_MAPPING
+  static Bool xIsSeparableCube(SVideoInfo& sVideoInfo);
+#if SVIDEO_SEPARABLE_CYLINDER_MAPPING
+  static Bool xIsSeparableCylinder(SVideoInfo& sVideoInfo);
+#endif
+#if SVIDEO_YAW_ROTATION_SHIFT
+  Void xMapSampleWeight(TGeometry *pGeoSrc, Int fIdx, ComponentID chId, Int i, Int j, Int *pRot, Bool bInvRot, PxlFltLut &wList);
+  Bool xBuildSeparableMapping(TGeometry *pGeoSrc, Int fIdx, Int iNumMaps, Int *pRot, Bool bInvRot);
+#else
+  Void xMapSampleWeight(TGeometry *pGeoSrc, Int fIdx, ComponentID chId, Int i, Int j, PxlFltLut &wList);
+  Bool xBuildSeparableMapping(TGeometry *pGeoSrc, Int fIdx, Int iNumMaps);
+#endif
+  Void xGeoConvertSeparable(TGeometry *pGeoDst, Int fIdx, Int ch);
+#if SVIDEO_SEPARABLE_TWO_PASS_FILTER
+  Void xGeoConvertTwoPass(TGeometry *pGeoDst, Int fIdx, Int ch);
+#endif
+  PxlFltLut getPixelWeight(Int fIdx, Int mapIdx, Int x, Int y);
+#endif
 
   Void initInterpolation(Int *pInterpolateType);
-  Void chromaUpsample(Pel *pSrcBuf, Int nWidthC, Int nHeightC, Int iStrideSrc, Int iFaceId, ComponentID chId);
-  Void rotOneFaceChannel(Pel *pSrc, Int iWidthSrc, Int iHeightSrc, Int iStrideSrc, Int iNumSamplesPerPixel, Int ch, Int rot, PelUnitBuf *pDstYuv, Int offsetX, Int offsetY, Int faceIdx, Int iBDAdjust);
-  Void rotFaceChannelGeneral(Pel *pSrc, Int iWidthSrc, Int iHeightSrc, Int iStrideSrc, Int nSPPSrc, Int rot, Pel *pDst, Int iStrideDst, Int nSPPDst, Bool bInverse=false);
-  Void chromaDonwsampleH(Pel *pSrcBuf, Int iWidth, Int iHeight, Int iStrideSrc, Int iNumPels, Pel *pDstBuf, Int iStrideDst); //horizontal 2:1 downsampling;
-  Void chromaDonwsampleV(Pel *pSrcBuf, Int iWidth, Int iHeight, Int iStrideSrc, Int iNumPels, Pel *pDstBuf, Int iStrideDst); //vertical 2:1 downsampling;
+  template<typename T> Void chromaUpsample(T *pSrcBuf, Int nWidthC, Int nHeightC, Int iStrideSrc, Int iFaceId, ComponentID chId);
+  template<typename TD, typename TS> static Void copySamples(TD *pDst, const TS *pSrc, Int iNum) { for(Int i=0; i<iNum; i++) pDst[i] = (TD)pSrc[i]; } //row copy between the frame and the face buffers;
+  template<typename T> static Void copySamples(T *pDst, const T *pSrc, Int iNum) { memcpy(pDst, pSrc, iNum*sizeof(T)); }                      //same sample type, e.g. without SVIDEO_8BIT_FACE_STORAGE;
+  Void rotOneFaceChannel(FacePel *pSrc, Int iWidthSrc, Int iHeightSrc, Int iStrideSrc, Int iNumSamplesPerPixel, Int ch, Int rot, PelUnitBuf *pDstYuv, Int offsetX, Int offsetY, Int faceIdx, Int iBDAdjust);
+  Void rotFaceChannelGeneral(Pel *pSrc, Int iWidthSrc, Int iHeightSrc, Int iStrideSrc, Int nSPPSrc, Int rot, FacePel *pDst, Int iStrideDst, Int nSPPDst, Bool bInverse=false);
+#if SVIDEO_BLOCKED_FACE_ROTATION
+  static Bool xGetRotScan(Int rot, Int iWidthSrc, Int iHeightSrc, Int iStepX, Int iStepY, Int &iOffset, Int &iStepI, Int &iStepJ);
+  template<typename T> static Void xCopyRotScan(const T *pSrc, Int iStepI, Int iStepJ, FacePel *pDst, Int nSPPDst, Int iStrideDst, Int iWidthDst, Int iHeightDst);
+  Void xPackRotScan(const FacePel *pSrc, Int iStepI, Int iStepJ, const UChar *pMask, Int iMaskStepI, Int iMaskStepJ, Pel *pDst, Int iStrideDst, Int iWidthDst, Int iHeightDst, Int iOffset, Int iBDAdjust, Pel emptyVal);
+  const UChar* xGetInsideFaceMask(Int face, ComponentID chId, Int iWidth, Int iHeight, Int iScaleX, Int iScaleY);
+#endif
+  Void chromaDonwsampleH(FacePel *pSrcBuf, Int iWidth, Int iHeight, Int iStrideSrc, Int iNumPels, Pel *pDstBuf, Int iStrideDst); //horizontal 2:1 downsampling;
+  Void chromaDonwsampleV(Pel *pSrcBuf, Int iWidth, Int iHeight, Int iStrideSrc, Int iNumPels, FacePel *pDstBuf, Int iStrideDst); //vertical 2:1 downsampling;
+#if SVIDEO_FUSED_CHROMA_RESAMPLING
+  Void chromaDonwsampleHV(FacePel *pSrcBuf, Int iWidth, Int iHeight, Int iStrideSrc, Pel *pBuf422, Int iStride422, FacePel *pDstBuf, Int iStrideDst); //444->420 in strips of rows;
+#endif
 #if SVIDEO_ROUND_FIX
   inline Int roundHP(POSType t) { return (Int)(t+ (t>=0? 0.5 :-0.5)); }; 
 #else
@@ -653,15 +799,25 @@ protected:
 
   //debug;
   Void dumpAllFacesToFile(TChar *pPrefixFN, Bool bMarginIncluded, Bool bAppended);
-  Void dumpBufToFile(Pel *pSrc, Int iWidth, Int iHeight, Int iNumSamples, Int iStride, FILE *fp);  
+  template<typename T> Void dumpBufToFile(T *pSrc, Int iWidth, Int iHeight, Int iNumSamples, Int iStride, FILE *fp);  
+#if SVIDEO_VIEWPORT_DIRECT_SAMPLING
+  Void xGeoConvertDirectRows(TGeometry *pGeoDst, Bool bRec, Int iMap, Int iStartRow, Int iEndRow);
+#endif
 #if SVIDEO_HEMI_PROJECTIONS 
   friend class THCMP;
 #endif 
+#if SVIDEO_VIEWPORT_DEPENDENCY_MAP
+  friend class TViewPortDependencyMap;
+#endif
+#if SVIDEO_FUSED_PACKED_CONVERSION
+  friend class TPackedConverter;
+#endif
 public:
 
   TGeometry();
   virtual ~TGeometry();
   Void geoInit(SVideoInfo& sVideoInfo, InputGeoParam *pInGeoParam);
+  Void allocFaceBuffers();
 
 
   GeometryType getType() { return (GeometryType)m_sVideoInfo.geoType; };
@@ -671,7 +827,7 @@ public:
   Int getMarginY(const ComponentID id) const { return (m_iMarginY >> ::getComponentScaleY(id, m_chromaFormatIDC));  }
   Int getComponentScaleX(const ComponentID id) const { return (::getComponentScaleX(id, m_chromaFormatIDC));  }
   Int getComponentScaleY(const ComponentID id) const { return (::getComponentScaleY(id, m_chromaFormatIDC));  }
-  Pel *getAddr(Int fId, Int compId) { return m_pFacesOrig[fId][compId]; }
+  FacePel *getAddr(Int fId, Int compId) { return m_pFacesOrig[fId][compId]; }
   Int getMarginSize(Int bY) { return (bY? m_iMarginY : m_iMarginX); }
   Void setPaddingFlag(Bool bFlag) { m_bPadded = bFlag; }
   TChar* getGeoName() 
@@ -719,6 +875,30 @@ public:
     , Bool bRec=false
 #endif
     );
+#if SVIDEO_VIEWPORT_DIRECT_SAMPLING
+  Void geoConvertDirect(TGeometry *pGeoDst, Bool bRec, TWorkerPool *pPool);
+#endif
+#if SVIDEO_VIEWPORT_BATCH_PSNR
+  Bool isFramePackCopy(ChromaFormat dstChromaFormat);
+  Void calcFramePackSSD(TGeometry *pGeoRec, ChromaFormat dstChromaFormat, Int iBitDepthForPSNRCalc, Double dSSD[MAX_NUM_COMPONENT]);
+#endif
+#if SVIDEO_VIEWPORT_RENDERER
+  virtual Bool isFaceMaskSupported() { return false; }
+  Void setFaceMask(UInt uiConvertFaceMask, UInt uiPadFaceMask);
+  UInt getViewPortFaceMask(TGeometry *pGeoDst, Bool bRec);
+  UInt getPaddingSourceMask(UInt uiFaceMask);
+#endif
+#if SVIDEO_DEMAND_SPHERE_PADDING
+  virtual Bool isDemandPaddingSupported() { return true; }
+  Void setDemandPadding(Bool bEnabled);
+  Bool getDemandPadding() { return m_bDemandPadding; }
+#endif
+#if SVIDEO_VIEWPORT_DEPENDENCY_MAP
+  //the margins are interpolated with m_pPixelWeight4SherePadding, except the samples copied as given by getPaddingCopySource();
+  virtual Bool isPaddingTableUsed() { return true; }
+  //position (samples of chId) of the face sample copied to the margin sample (x, y) of face fIdx by spherePadding();
+  virtual Bool getPaddingCopySource(Int fIdx, Int x, Int y, ComponentID chId, Int &fIdxSrc, Int &xSrc, Int &ySrc) { return false; }
+#endif
   virtual Void framePack(PelUnitBuf *pDstYuv);
 
   virtual Void compactFramePackConvertYuv(PelUnitBuf * pSrcYuv);
@@ -737,6 +917,10 @@ public:
     , Bool bRec=false
 #endif
     );
+#if SVIDEO_MAPPING_ACCURACY_CHECK
+  Void writeMappingCheck(TGeometry *pGeoSrc, const std::string &fileName);
+  Void compareMappingCheck(TGeometry *pGeoSrc, const std::string &refFileName);
+#endif
 
 #if SVIDEO_TSP_IMP
   virtual Bool insideTspFace(Int fId, Int xx, Int yy, ComponentID chId, ComponentID origchId) { return false; }
@@ -745,7 +929,11 @@ public:
   Void rotYuv(PelUnitBuf *pcPicYuvSrc, PelUnitBuf *pDst, Int iRot);
   Void framePadding(PelUnitBuf *pcPicYuv, Int* aiPad);
   
+#if SVIDEO_FUSED_PACKED_CONVERSION
+  static TGeometry* create(SVideoInfo& sVideoInfo, InputGeoParam *pInGeoParam, Bool bFaceBuffers=true);
+#else
   static TGeometry* create(SVideoInfo& sVideoInfo, InputGeoParam *pInGeoParam);
+#endif
 #if SVIDEO_DYNAMIC_VIEWPORT_PSNR
   Void setGeometryMapping(Bool b)   {m_bGeometryMapping = b;};
 #endif
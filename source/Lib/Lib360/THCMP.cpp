@@ -344,17 +344,17 @@ Void THCMP::map3DTo2D(SPos *pSPosIn, SPos *pSPosOut)
   }
 }
 
-Void THCMP::sPad(Pel *pSrc0, Int iHStep0, Int iStrideSrc0, Pel* pSrc1, Int iHStep1, Int iStrideSrc1, Int iNumSamples, Int hCnt, Int vCnt)
+Void THCMP::sPad(FacePel *pSrc0, Int iHStep0, Int iStrideSrc0, FacePel* pSrc1, Int iHStep1, Int iStrideSrc1, Int iNumSamples, Int hCnt, Int vCnt)
 {
-  Pel *pSrc0Start = pSrc0 + iHStep0;
-  Pel *pSrc1Start = pSrc1 - iHStep1;
+  FacePel *pSrc0Start = pSrc0 + iHStep0;
+  FacePel *pSrc1Start = pSrc1 - iHStep1;
 
   for(Int j=0; j<vCnt; j++)
   {
     for(Int i=0; i<hCnt; i++)
     {
-      memcpy(pSrc0Start+i*iHStep0, pSrc1+i*iHStep1, iNumSamples*sizeof(Pel));
-      memcpy(pSrc1Start-i*iHStep1, pSrc0-i*iHStep0, iNumSamples*sizeof(Pel));
+      memcpy(pSrc0Start+i*iHStep0, pSrc1+i*iHStep1, iNumSamples*sizeof(FacePel));
+      memcpy(pSrc1Start-i*iHStep1, pSrc0-i*iHStep0, iNumSamples*sizeof(FacePel));
     }
     pSrc0 += iStrideSrc0;
     pSrc0Start += iStrideSrc0;
@@ -364,15 +364,15 @@ Void THCMP::sPad(Pel *pSrc0, Int iHStep0, Int iStrideSrc0, Pel* pSrc1, Int iHSte
 }
 
 //90 anti clockwise: source -> destination;
-Void THCMP::rot90(Pel *pSrcBuf, Int iStrideSrc, Int iWidth, Int iHeight, Int iNumSamples, Pel *pDst, Int iStrideDst)
+Void THCMP::rot90(FacePel *pSrcBuf, Int iStrideSrc, Int iWidth, Int iHeight, Int iNumSamples, FacePel *pDst, Int iStrideDst)
 {
-    Pel *pSrcCol = pSrcBuf + (iWidth-1)*iNumSamples;
+    FacePel *pSrcCol = pSrcBuf + (iWidth-1)*iNumSamples;
     for(Int j=0; j<iWidth; j++)
     {
-      Pel *pSrc = pSrcCol;
+      FacePel *pSrc = pSrcCol;
       for(Int i=0; i<iHeight; i++, pSrc+= iStrideSrc)
       {
-        memcpy(pDst+i*iNumSamples,  pSrc, iNumSamples*sizeof(Pel));
+        memcpy(pDst+i*iNumSamples,  pSrc, iNumSamples*sizeof(FacePel));
       }
       pDst += iStrideDst;
       pSrcCol -= iNumSamples;
@@ -380,7 +380,7 @@ Void THCMP::rot90(Pel *pSrcBuf, Int iStrideSrc, Int iWidth, Int iHeight, Int iNu
 } 
 
 //corner;
-Void THCMP::cPad(Pel *pSrc, Int iWidth, Int iHeight, Int iStrideSrc, Int iNumSamples, Int hCnt, Int vCnt)
+Void THCMP::cPad(FacePel *pSrc, Int iWidth, Int iHeight, Int iStrideSrc, Int iNumSamples, Int hCnt, Int vCnt)
 {
   //top-left;
   rot90(pSrc-hCnt*iStrideSrc, iStrideSrc, vCnt, hCnt, iNumSamples, pSrc-vCnt*iStrideSrc-hCnt*iNumSamples, iStrideSrc); 
@@ -444,7 +444,7 @@ Void THCMP::convertYuv(PelUnitBuf *pSrcYuv)
             iRot = -1;
           }
 
-          Pel *pDst = m_pFacesOrig[use_idx][ch];
+          FacePel *pDst = m_pFacesOrig[use_idx][ch];
           rotFaceChannelGeneral(pSrc, nWidth, nHeight, pSrcYuv->get((ComponentID)ch).stride, 1, iRot, pDst, getStride((ComponentID)ch), 1, true);
         }
         continue;
@@ -456,14 +456,14 @@ Void THCMP::convertYuv(PelUnitBuf *pSrcYuv)
         CHECK(m_pFacesBufTempOrig,"");
         m_nMarginSizeBufTemp = std::max(m_filterUps[2].nTaps, m_filterUps[3].nTaps)>>1;;  //depends on the vertical upsampling filter;
         m_nStrideBufTemp = nWidth + (m_nMarginSizeBufTemp<<1);
-        m_pFacesBufTemp = new Pel*[nFaces];
-        memset(m_pFacesBufTemp, 0, sizeof(Pel*)*nFaces);
-        m_pFacesBufTempOrig = new Pel*[nFaces];
-        memset(m_pFacesBufTempOrig, 0, sizeof(Pel*)*nFaces);
+        m_pFacesBufTemp = new FacePel*[nFaces];
+        memset(m_pFacesBufTemp, 0, sizeof(FacePel*)*nFaces);
+        m_pFacesBufTempOrig = new FacePel*[nFaces];
+        memset(m_pFacesBufTempOrig, 0, sizeof(FacePel*)*nFaces);
         Int iTotalHeight = (nHeight +(m_nMarginSizeBufTemp<<1));
         for(Int i=0; i<nFaces; i++)
         {
-          m_pFacesBufTemp[i] = (Pel *)xMalloc(Pel,  m_nStrideBufTemp*iTotalHeight);
+          m_pFacesBufTemp[i] = (FacePel *)xMalloc(FacePel,  m_nStrideBufTemp*iTotalHeight);
           m_pFacesBufTempOrig[i] = m_pFacesBufTemp[i] +  m_nStrideBufTemp * m_nMarginSizeBufTemp + m_nMarginSizeBufTemp;
         }
       }
@@ -477,7 +477,7 @@ Void THCMP::convertYuv(PelUnitBuf *pSrcYuv)
 
         Int iStrideSrc = pSrcYuv->get((ComponentID)(ch)).stride;
         Pel *pSrc = pSrcYuv->get((ComponentID)ch).bufAt(0, 0) + faceY*iStrideSrc + faceX;
-        Pel *pDst = m_pFacesBufTempOrig[faceIdx];
+        FacePel *pDst = m_pFacesBufTempOrig[faceIdx];
         rotFaceChannelGeneral(pSrc, nWidth, nHeight, pSrcYuv->get((ComponentID)ch).stride, 1, iRot, pDst, m_nStrideBufTemp, 1, true);
       }
 
@@ -540,7 +540,7 @@ Void THCMP::convertYuv(PelUnitBuf *pSrcYuv)
         {
           Int iStrideSrc = pSrcYuv->get((ComponentID)(ch)).stride;
           Pel *pSrc = pSrcYuv->get((ComponentID)(ch)).bufAt(0, 0) + faceY*iStrideSrc + faceX;
-          Pel *pDst = m_pFacesOrig[faceIdx][ch];
+          FacePel *pDst = m_pFacesOrig[faceIdx][ch];
           rotFaceChannelGeneral(pSrc, nWidth, nHeight, pSrcYuv->get((ComponentID)ch).stride, 1, iRot, pDst, getStride((ComponentID)ch), 1, true);
         }
       }
@@ -773,7 +773,7 @@ Void THCMP::framePack(PelUnitBuf *pDstYuv)
     if (!m_pDS420Buf && ((m_chromaFormatIDC == CHROMA_444) || (m_chromaFormatIDC == CHROMA_420 && m_bResampleChroma)))
 #endif
     {
-      m_pDS420Buf = (Pel*)xMalloc(Pel, nHeightC*iStride420);
+      m_pDS420Buf = (FacePel*)xMalloc(FacePel, nHeightC*iStride420);
     }
     for (Int face = 0; face<iTotalNumOfFaces; face++)
     {
@@ -839,8 +839,12 @@ Void THCMP::framePack(PelUnitBuf *pDstYuv)
             ComponentID chId = (ComponentID)ch;
             Int xc = x >> ::getComponentScaleX(chId, pDstYuv->chromaFormat);
             Int yc = y >> ::getComponentScaleY(chId, pDstYuv->chromaFormat);
+#if SVIDEO_FUSED_CHROMA_RESAMPLING
+            chromaDonwsampleHV(m_pFacesOrig[face][ch], m_sVideoInfo.iFaceWidth, m_sVideoInfo.iFaceHeight, getStride(chId), m_pDS422Buf, iStride422, m_pDS420Buf, iStride420);
+#else
             chromaDonwsampleH(m_pFacesOrig[face][ch] - nMarginSize*getStride((ComponentID)ch), m_sVideoInfo.iFaceWidth, nHeightC422, getStride(chId), 1, m_pDS422Buf, iStride422);
             chromaDonwsampleV(m_pDS422Buf + nMarginSize*iStride422, nWidthC, m_sVideoInfo.iFaceHeight, iStride422, 1, m_pDS420Buf, iStride420);
+#endif
             rotOneFaceChannel(m_pDS420Buf, nWidthC, nHeightC, iStride420, 1, ch, rot, pDstYuv, xc, yc, face, 0);
           }
         }
@@ -933,7 +937,7 @@ Void THCMP::framePack(PelUnitBuf *pDstYuv)
 #endif
 }
 
-Void THCMP::rotOneFaceChannel(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSrc, Int iStrideSrc, Int iNumSamplesPerPixel, Int ch, Int rot, PelUnitBuf *pcPicYuvDst, Int offsetX, Int offsetY, Int face, Int iBDAdjust)
+Void THCMP::rotOneFaceChannel(FacePel *pSrcBuf, Int iWidthSrc, Int iHeightSrc, Int iStrideSrc, Int iNumSamplesPerPixel, Int ch, Int rot, PelUnitBuf *pcPicYuvDst, Int offsetX, Int offsetY, Int face, Int iBDAdjust)
 {
   CHECK(iBDAdjust <0, "");
   ComponentID chId = (ComponentID)ch;
@@ -948,12 +952,12 @@ Void THCMP::rotOneFaceChannel(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSrc, Int i
   {
     Int iWidthDst = iWidthSrc;
     Int iHeightDst = iHeightSrc;
-    Pel *pSrcLine = pSrcBuf;
+    FacePel *pSrcLine = pSrcBuf;
     CHECK(pcPicYuvDst->get(chId).width < offsetX + iWidthDst, "");
     CHECK(pcPicYuvDst->get(chId).height < offsetY + iHeightDst, "");
     for (Int j = 0; j<iHeightDst; j++)
     {
-      Pel *pSrc = pSrcLine;
+      FacePel *pSrc = pSrcLine;
       for (Int i = 0; i<iWidthDst; i++, pSrc += iNumSamplesPerPixel)
       {
 #if SVIDEO_TSP_IMP
@@ -975,8 +979,8 @@ Void THCMP::rotOneFaceChannel(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSrc, Int i
             // m_pFacesOrig[face][ch]
             if (face == 2 && i == iWidthDst / 2 && (m_sVideoInfo.geoType == SVIDEO_HCMP || m_sVideoInfo.geoType == SVIDEO_HEAC) && m_sVideoInfo.bPCMP)
               for (int k = 0; k < HCMP_PADDING; k++) {
-                Pel *pSrcLine = m_pFacesOrig[0][ch];
-                Pel *pSrc = pSrcLine;
+                FacePel *pSrcLine = m_pFacesOrig[0][ch];
+                FacePel *pSrc = pSrcLine;
                 pDstBuf[i - (HCMP_PADDING - k)] = ClipBD(((*(pSrc + iStrideSrc *(HCMP_PADDING - k - 1) + (iWidthDst - j - 1)*iNumSamplesPerPixel)) + iOffset) >> iBDAdjust, m_nOutputBitDepth);
               }
           }
@@ -1005,13 +1009,13 @@ Void THCMP::rotOneFaceChannel(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSrc, Int i
   {
     Int iWidthDst = iHeightSrc;
     Int iHeightDst = iWidthSrc;
-    Pel *pSrcLine = pSrcBuf + (iWidthSrc - 1)*iNumSamplesPerPixel;
+    FacePel *pSrcLine = pSrcBuf + (iWidthSrc - 1)*iNumSamplesPerPixel;
 
     CHECK(pcPicYuvDst->get(chId).width < offsetX + iWidthDst, "");
     CHECK(pcPicYuvDst->get(chId).height < offsetY + iHeightDst, "");
     for (Int j = 0; j<iHeightDst; j++)
     {
-      Pel *pSrc = pSrcLine;
+      FacePel *pSrc = pSrcLine;
       for (Int i = 0; i<iWidthDst; i++, pSrc += iStrideSrc)
       {
         if (insideFace(face, (iHeightDst - 1 - j) << iScaleX, i << iScaleY, COMPONENT_Y, chId))
@@ -1030,13 +1034,13 @@ Void THCMP::rotOneFaceChannel(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSrc, Int i
   {
     Int iWidthDst = iWidthSrc;
     Int iHeightDst = iHeightSrc;
-    Pel *pSrcLine = pSrcBuf + (iHeightSrc - 1)*iStrideSrc + (iWidthSrc - 1)*iNumSamplesPerPixel;
+    FacePel *pSrcLine = pSrcBuf + (iHeightSrc - 1)*iStrideSrc + (iWidthSrc - 1)*iNumSamplesPerPixel;
 
     CHECK(pcPicYuvDst->get(chId).width < offsetX + iWidthDst, "");
     CHECK(pcPicYuvDst->get(chId).height < offsetY + iHeightDst, "");
     for (Int j = 0; j<iHeightDst; j++)
     {
-      Pel *pSrc = pSrcLine;
+      FacePel *pSrc = pSrcLine;
       for (Int i = 0; i<iWidthDst; i++, pSrc -= iNumSamplesPerPixel)
       {
 #if SVIDEO_HEMI_PROJECTIONS
@@ -1050,8 +1054,8 @@ Void THCMP::rotOneFaceChannel(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSrc, Int i
             if (i == iWidthDst / 2)
               for (int k = 0; k < HCMP_PADDING; k++) {
                 // m_pFacesOrig[face][ch]
-                Pel *pSrcLine = m_pFacesOrig[0][ch];
-                Pel *pSrc = pSrcLine;
+                FacePel *pSrcLine = m_pFacesOrig[0][ch];
+                FacePel *pSrc = pSrcLine;
                 pDstBuf[iWidthDst / 2 + k] = ClipBD(((*(pSrc + iStrideSrc * (iHeightDst - k - 1) + (iWidthDst - j - 1)*iNumSamplesPerPixel)) + iOffset) >> iBDAdjust, m_nOutputBitDepth);
               }
           }
@@ -1078,13 +1082,13 @@ Void THCMP::rotOneFaceChannel(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSrc, Int i
   {
     Int iWidthDst = iHeightSrc;
     Int iHeightDst = iWidthSrc;
-    Pel *pSrcLine = pSrcBuf + (iHeightSrc - 1)*iStrideSrc;
+    FacePel *pSrcLine = pSrcBuf + (iHeightSrc - 1)*iStrideSrc;
 
     CHECK(pcPicYuvDst->get(chId).width < offsetX + iWidthDst, "");
     CHECK(pcPicYuvDst->get(chId).height < offsetY + iHeightDst, "");
     for (Int j = 0; j<iHeightDst; j++)
     {
-      Pel *pSrc = pSrcLine;
+      FacePel *pSrc = pSrcLine;
       for (Int i = 0; i<iWidthDst; i++, pSrc -= iStrideSrc)
       {
         if (insideFace(face, j << iScaleX, (iWidthDst - 1 - i) << iScaleY, COMPONENT_Y, chId))
@@ -1103,7 +1107,7 @@ Void THCMP::rotOneFaceChannel(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSrc, Int i
     CHECK(true, "Not supported");
 }
 
-Void THCMP::rotFaceChannelGeneral(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSrc, Int iStrideSrc, Int nSPPSrc, Int rot, Pel *pDstBuf, Int iStrideDst, Int nSPPDst, Bool bInverse)
+Void THCMP::rotFaceChannelGeneral(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSrc, Int iStrideSrc, Int nSPPSrc, Int rot, FacePel *pDstBuf, Int iStrideDst, Int nSPPDst, Bool bInverse)
 {
   int rot2 = rot;
   if (bInverse)
@@ -1115,7 +1119,7 @@ Void THCMP::rotFaceChannelGeneral(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSrc, I
     Int iWidthDst = iWidthSrc;
     Int iHeightDst = iHeightSrc;
     Pel *pSrcLine = pSrcBuf;
-    Pel *pDstLine = pDstBuf;
+    FacePel *pDstLine = pDstBuf;
     for (Int j = 0; j < iHeightDst; j++)
     {
       for (Int i = 0; i < iWidthDst; i++)
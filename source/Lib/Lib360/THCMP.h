@@ -51,16 +51,16 @@ class THCMP : public TGeometry
 
 private:
   bool is_EAC;
-  Void sPad(Pel *pSrc0, Int iHStep0, Int iStrideSrc0, Pel* pSrc1, Int iHStep1, Int iStrideSrc1, Int iNumSamples, Int hCnt, Int vCnt);
-  Void cPad(Pel *pSrc0, Int iWidth, Int iHeight, Int iStrideSrc0, Int iNumSamples, Int hCnt, Int vCnt);
-  Void rot90(Pel *pSrc, Int iStrideSrc, Int iWidth, Int iHeight, Int iNumSamples, Pel *pDst, Int iStrideDst);
+  Void sPad(FacePel *pSrc0, Int iHStep0, Int iStrideSrc0, FacePel* pSrc1, Int iHStep1, Int iStrideSrc1, Int iNumSamples, Int hCnt, Int vCnt);
+  Void cPad(FacePel *pSrc0, Int iWidth, Int iHeight, Int iStrideSrc0, Int iNumSamples, Int hCnt, Int vCnt);
+  Void rot90(FacePel *pSrc, Int iStrideSrc, Int iWidth, Int iHeight, Int iNumSamples, FacePel *pDst, Int iStrideDst);
   double adj(POSType x);
 
 protected:
   
 
-  Void rotOneFaceChannel(Pel *pSrc, Int iWidthSrc, Int iHeightSrc, Int iStrideSrc, Int iNumSamplesPerPixel, Int ch, Int rot, PelUnitBuf *pDstYuv, Int offsetX, Int offsetY, Int faceIdx, Int iBDAdjust);
-  Void rotFaceChannelGeneral(Pel *pSrc, Int iWidthSrc, Int iHeightSrc, Int iStrideSrc, Int nSPPSrc, Int rot, Pel *pDst, Int iStrideDst, Int nSPPDst, Bool bInverse = false);
+  Void rotOneFaceChannel(FacePel *pSrc, Int iWidthSrc, Int iHeightSrc, Int iStrideSrc, Int iNumSamplesPerPixel, Int ch, Int rot, PelUnitBuf *pDstYuv, Int offsetX, Int offsetY, Int faceIdx, Int iBDAdjust);
+  Void rotFaceChannelGeneral(Pel *pSrc, Int iWidthSrc, Int iHeightSrc, Int iStrideSrc, Int nSPPSrc, Int rot, FacePel *pDst, Int iStrideDst, Int nSPPDst, Bool bInverse = false);
 public:
   THCMP(SVideoInfo& sVideoInfo, InputGeoParam *pInGeoParam, bool isEAC = false);
   virtual ~THCMP();
@@ -686,7 +686,7 @@ Void THybridEquiAngularCubeMap::convertYuv(PelUnitBuf *pSrcYuv)
       Int iTLPos = (pPelWeight.facePos)>>m_WeightMap_NumOfBits4Faces;
       Int iWLutIdx = (m_chromaFormatIDC==CHROMA_400 || (m_InterpolationType[0]==m_InterpolationType[1]))? 0 : chType;
       Int *pWLut = m_pWeightLut[iWLutIdx][pPelWeight.weightIdx];
-      Pel *pPelLine = m_pFacesOrig[face][ch] +iTLPos -((m_iInterpFilterTaps[chType][1]-1)>>1)*getStride(chId) -((m_iInterpFilterTaps[chType][0]-1)>>1);
+      FacePel *pPelLine = m_pFacesOrig[face][ch] +iTLPos -((m_iInterpFilterTaps[chType][1]-1)>>1)*getStride(chId) -((m_iInterpFilterTaps[chType][0]-1)>>1);
       for(Int m=0; m<m_iInterpFilterTaps[chType][1]; m++)
       {
         for(Int n=0; n<m_iInterpFilterTaps[chType][0]; n++)
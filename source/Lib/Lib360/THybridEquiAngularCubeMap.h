@@ -76,6 +76,9 @@ protected:
 #if SVIDEO_HEC_PADDING_TYPE == 1
 public:
   virtual Void convertYuv(PelUnitBuf *pSrcYuv);
+#if SVIDEO_VIEWPORT_RENDERER
+  virtual Bool isFaceMaskSupported() { return false; }
+#endif
 private:
   std::vector<BlendingPixel> m_bldPxlInfo[2]; //[ch]
   Bool m_bBlendingMapBuilt;
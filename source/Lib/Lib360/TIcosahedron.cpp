@@ -256,6 +256,9 @@ TIcosahedron::TIcosahedron(SVideoInfo& sVideoInfo, InputGeoParam *pInGeoParam) :
   //init faces;
   for(Int f=0; f<sVideoInfo.iNumFaces; f++)
     initTriMesh(m_meshFaces[f]);
+#if SVIDEO_POLYHEDRON_FACE_INDEX
+  initFaceIndex();
+#endif
 }
 
 #if SVIDEO_SEC_VID_ISP3
@@ -268,10 +271,12 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
 
   if (!m_pFaceRotBuf)
   {
-    m_pFaceRotBuf = (Pel*)xMalloc(Pel, m_sVideoInfo.iFaceWidth*m_sVideoInfo.iFaceHeight);
+    m_pFaceRotBuf = (FacePel*)xMalloc(FacePel, m_sVideoInfo.iFaceWidth*m_sVideoInfo.iFaceHeight);
   }
-  Pel* pcBufSrc, *pcBufDst;
-  Pel* pSrc, *pDst;
+  Pel     *pcBufSrc;
+  FacePel *pcBufDst;
+  FacePel *pSrc;
+  FacePel *pDst;
 
   if (pSrcYuv->chromaFormat == CHROMA_420)
   {
@@ -399,10 +404,10 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
               pcBufSrc = pSrcYuv->get(COMPONENT_Y).bufAt(0, 0) + iVerFPShift*pSrcYuv->get(COMPONENT_Y).stride + iHorFPShift;
               pcBufDst = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 2;
               triangleFaceCopy(nWidth, nHeight, pcBufSrc, (nWidth >> 1) + 2, nWidth - 1, 0, nHeight - 1, iStrideSrc, pcBufDst, getStride(COMPONENT_Y), chId, iRot, FACE_NO_FLIP, faceIdx, 0, m_nBitDepth);
-              pcBufSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 2;
+              pSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 2;
               pcBufDst = m_pFaceRotBuf + (nWidth >> 1) + 2;
               // flip
-              rotFlipFaceChannelGeneral(pcBufSrc, (nWidth >> 1) - 2, nHeight, getStride(COMPONENT_Y), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
+              rotFlipFaceChannelGeneral(pSrc, (nWidth >> 1) - 2, nHeight, getStride(COMPONENT_Y), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
               pSrc = m_pFaceRotBuf;
               pDst = m_pFacesOrig[faceIdx][ch];
               rotFlipFaceChannelGeneral(pSrc, nWidth, nHeight, m_sVideoInfo.iFaceWidth, pDst, getStride((ComponentID)ch), iRot, true, FACE_NO_FLIP);
@@ -423,10 +428,10 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
               pcBufSrc = pSrcYuv->get(chId).bufAt(0, 0) + iVerFPShift*pSrcYuv->get(chId).stride + iHorFPShift;
               pcBufDst = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 1;
               triangleFaceCopy(nWidth, nHeight, pcBufSrc, (nWidth >> 1) + 1, nWidth - 1, 0, nHeight - 1, iStrideSrc, pcBufDst, getStride(chId), chId, iRot, FACE_NO_FLIP, faceIdx, 0, m_nBitDepth);
-              pcBufSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 1;
+              pSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 1;
               pcBufDst = m_pFaceRotBuf + (nWidth >> 1) + 1;
               // flip
-              rotFlipFaceChannelGeneral(pcBufSrc, (nWidth >> 1) - 1, nHeight, getStride(chId), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
+              rotFlipFaceChannelGeneral(pSrc, (nWidth >> 1) - 1, nHeight, getStride(chId), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
               pSrc = m_pFaceRotBuf;
               pDst = m_pFacesOrig[faceIdx][ch];
               rotFlipFaceChannelGeneral(pSrc, nWidth, nHeight, m_sVideoInfo.iFaceWidth, pDst, getStride((ComponentID)ch), iRot, true, FACE_NO_FLIP);
@@ -450,10 +455,10 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
               pcBufSrc = pSrcYuv->get(COMPONENT_Y).bufAt(0, 0) + iVerFPShift*pSrcYuv->get(COMPONENT_Y).stride + iHorFPShift;
               pcBufDst = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 2;
               triangleFaceCopy(nWidth, nHeight, pcBufSrc, (nWidth >> 1) + 2, nWidth - 1, 0, nHeight - 1, iStrideSrc, pcBufDst, getStride(COMPONENT_Y), chId, iRot, FACE_NO_FLIP, faceIdx, 0, m_nBitDepth);
-              pcBufSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 2;
+              pSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 2;
               pcBufDst = m_pFaceRotBuf + (nWidth >> 1) + 2;
               // flip
-              rotFlipFaceChannelGeneral(pcBufSrc, (nWidth >> 1) - 2, nHeight, getStride(COMPONENT_Y), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
+              rotFlipFaceChannelGeneral(pSrc, (nWidth >> 1) - 2, nHeight, getStride(COMPONENT_Y), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
               pSrc = m_pFaceRotBuf;
               pDst = m_pFacesOrig[faceIdx][ch];
               rotFlipFaceChannelGeneral(pSrc, nWidth, nHeight, m_sVideoInfo.iFaceWidth, pDst, getStride((ComponentID)ch), iRot, true, FACE_NO_FLIP);
@@ -474,10 +479,10 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
               pcBufSrc = pSrcYuv->get(chId).bufAt(0, 0) + iVerFPShift*pSrcYuv->get(chId).stride + iHorFPShift;
               pcBufDst = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 1;
               triangleFaceCopy(nWidth, nHeight, pcBufSrc, (nWidth >> 1) + 1, nWidth - 1, 0, nHeight - 1, iStrideSrc, pcBufDst, getStride(chId), chId, iRot, FACE_NO_FLIP, faceIdx, 0, m_nBitDepth);
-              pcBufSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 1;
+              pSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 1;
               pcBufDst = m_pFaceRotBuf + (nWidth >> 1) + 1;
               // flip
-              rotFlipFaceChannelGeneral(pcBufSrc, (nWidth >> 1) - 1, nHeight, getStride(chId), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
+              rotFlipFaceChannelGeneral(pSrc, (nWidth >> 1) - 1, nHeight, getStride(chId), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
               pSrc = m_pFaceRotBuf;
               pDst = m_pFacesOrig[faceIdx][ch];
               rotFlipFaceChannelGeneral(pSrc, nWidth, nHeight, m_sVideoInfo.iFaceWidth, pDst, getStride((ComponentID)ch), iRot, true, FACE_NO_FLIP);
@@ -502,10 +507,10 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
               pcBufSrc = pSrcYuv->get(COMPONENT_Y).bufAt(0, 0) + iVerFPShift*pSrcYuv->get(COMPONENT_Y).stride + iHorFPShift;
               pcBufDst = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 2;
               triangleFaceCopy(nWidth, nHeight, pcBufSrc, (nWidth >> 1) + 2, nWidth - 1, 0, nHeight - 1, iStrideSrc, pcBufDst, getStride(COMPONENT_Y), chId, iRot, FACE_NO_FLIP, faceIdx, 0, m_nBitDepth);
-              pcBufSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 2;
+              pSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 2;
               pcBufDst = m_pFaceRotBuf + (nWidth >> 1) + 2;
               // flip
-              rotFlipFaceChannelGeneral(pcBufSrc, (nWidth >> 1) - 2, nHeight, getStride(COMPONENT_Y), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
+              rotFlipFaceChannelGeneral(pSrc, (nWidth >> 1) - 2, nHeight, getStride(COMPONENT_Y), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
               pSrc = m_pFaceRotBuf;
               pDst = m_pFacesOrig[faceIdx][ch];
               rotFlipFaceChannelGeneral(pSrc, nWidth, nHeight, m_sVideoInfo.iFaceWidth, pDst, getStride((ComponentID)ch), iRot, true, FACE_NO_FLIP);
@@ -527,10 +532,10 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
               pcBufSrc = pSrcYuv->get(chId).bufAt(0, 0) + iVerFPShift*pSrcYuv->get(chId).stride + iHorFPShift;
               pcBufDst = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 1;
               triangleFaceCopy(nWidth, nHeight, pcBufSrc, (nWidth >> 1) + 1, nWidth - 1, 0, nHeight - 1, iStrideSrc, pcBufDst, getStride(chId), chId, iRot, FACE_NO_FLIP, faceIdx, 0, m_nBitDepth);
-              pcBufSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 1;
+              pSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 1;
               pcBufDst = m_pFaceRotBuf + (nWidth >> 1) + 1;
               // flip
-              rotFlipFaceChannelGeneral(pcBufSrc, (nWidth >> 1) - 1, nHeight, getStride(chId), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
+              rotFlipFaceChannelGeneral(pSrc, (nWidth >> 1) - 1, nHeight, getStride(chId), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
               pSrc = m_pFaceRotBuf;
               pDst = m_pFacesOrig[faceIdx][ch];
               rotFlipFaceChannelGeneral(pSrc, nWidth, nHeight, m_sVideoInfo.iFaceWidth, pDst, getStride((ComponentID)ch), iRot, true, FACE_NO_FLIP);
@@ -555,10 +560,10 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
               pcBufSrc = pSrcYuv->get(COMPONENT_Y).bufAt(0, 0) + iVerFPShift*pSrcYuv->get(COMPONENT_Y).stride + iHorFPShift;
               pcBufDst = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 2;
               triangleFaceCopy(nWidth, nHeight, pcBufSrc, (nWidth >> 1) + 2, nWidth - 1, 0, nHeight - 1, iStrideSrc, pcBufDst, getStride(COMPONENT_Y), chId, iRot, FACE_NO_FLIP, faceIdx, 0, m_nBitDepth);
-              pcBufSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 2;
+              pSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 2;
               pcBufDst = m_pFaceRotBuf + (nWidth >> 1) + 2;
               // flip
-              rotFlipFaceChannelGeneral(pcBufSrc, (nWidth >> 1) - 2, nHeight, getStride(COMPONENT_Y), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
+              rotFlipFaceChannelGeneral(pSrc, (nWidth >> 1) - 2, nHeight, getStride(COMPONENT_Y), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
               pSrc = m_pFaceRotBuf;
               pDst = m_pFacesOrig[faceIdx][ch];
               rotFlipFaceChannelGeneral(pSrc, nWidth, nHeight, m_sVideoInfo.iFaceWidth, pDst, getStride((ComponentID)ch), iRot, true, FACE_NO_FLIP);
@@ -580,10 +585,10 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
               pcBufSrc = pSrcYuv->get(chId).bufAt(0, 0) + iVerFPShift*pSrcYuv->get(chId).stride + iHorFPShift;
               pcBufDst = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 1;
               triangleFaceCopy(nWidth, nHeight, pcBufSrc, (nWidth >> 1) + 1, nWidth - 1, 0, nHeight - 1, iStrideSrc, pcBufDst, getStride(chId), chId, iRot, FACE_NO_FLIP, faceIdx, 0, m_nBitDepth);
-              pcBufSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 1;
+              pSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 1;
               pcBufDst = m_pFaceRotBuf + (nWidth >> 1) + 1;
               // flip
-              rotFlipFaceChannelGeneral(pcBufSrc, (nWidth >> 1) - 1, nHeight, getStride(chId), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
+              rotFlipFaceChannelGeneral(pSrc, (nWidth >> 1) - 1, nHeight, getStride(chId), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
               pSrc = m_pFaceRotBuf;
               pDst = m_pFacesOrig[faceIdx][ch];
               rotFlipFaceChannelGeneral(pSrc, nWidth, nHeight, m_sVideoInfo.iFaceWidth, pDst, getStride((ComponentID)ch), iRot, true, FACE_NO_FLIP);
@@ -642,7 +647,7 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
             }
 
             //left
-            Pel* pSrcLine = pSrc + x0;
+            FacePel* pSrcLine = pSrc + x0;
             pDst = pSrcLine - 1;
             for (Int j = 0; j < x0; j++)
               *pDst-- = *pSrcLine;
@@ -664,14 +669,14 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
         CHECK(m_pFacesBufTempOrig,"");
         m_nMarginSizeBufTemp = 2;  //4 tap filter Lena: !!!6taps????
         m_nStrideBufTemp = nWidth + (m_nMarginSizeBufTemp << 1);
-        m_pFacesBufTemp = new Pel*[nFaces];
-        memset(m_pFacesBufTemp, 0, sizeof(Pel*)*nFaces);
-        m_pFacesBufTempOrig = new Pel*[nFaces];
-        memset(m_pFacesBufTempOrig, 0, sizeof(Pel*)*nFaces);
+        m_pFacesBufTemp = new FacePel*[nFaces];
+        memset(m_pFacesBufTemp, 0, sizeof(FacePel*)*nFaces);
+        m_pFacesBufTempOrig = new FacePel*[nFaces];
+        memset(m_pFacesBufTempOrig, 0, sizeof(FacePel*)*nFaces);
         Int iTotalHeight = (nHeight + (m_nMarginSizeBufTemp << 1));
         for (Int i = 0; i < nFaces; i++)
         {
-          m_pFacesBufTemp[i] = (Pel *)xMalloc(Pel, m_nStrideBufTemp*iTotalHeight);
+          m_pFacesBufTemp[i] = (FacePel *)xMalloc(FacePel, m_nStrideBufTemp*iTotalHeight);
           m_pFacesBufTempOrig[i] = m_pFacesBufTemp[i] + m_nStrideBufTemp * m_nMarginSizeBufTemp + m_nMarginSizeBufTemp;
         }
       }
@@ -742,10 +747,10 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
           pcBufSrc = pSrcYuv->get(chId).bufAt(0, 0) + iVerFPShift*pSrcYuv->get(chId).stride + iHorFPShift;
           pcBufDst = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 1;
           triangleFaceCopy(nWidth, nHeight, pcBufSrc, (nWidth >> 1) + 1, nWidth - 1, 0, nHeight - 1, iStrideSrc, pcBufDst, getStride(chId), chId, iRot, FACE_NO_FLIP, faceIdx, 0, m_nBitDepth);
-          pcBufSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 1;
+          pSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 1;
           pcBufDst = m_pFaceRotBuf + (nWidth >> 1) + 1;
           // flip
-          rotFlipFaceChannelGeneral(pcBufSrc, (nWidth >> 1) - 1, nHeight, getStride(chId), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
+          rotFlipFaceChannelGeneral(pSrc, (nWidth >> 1) - 1, nHeight, getStride(chId), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
           pSrc = m_pFaceRotBuf;
           pDst = m_pFacesOrig[faceIdx][ch];
           rotFlipFaceChannelGeneral(pSrc, nWidth, nHeight, m_sVideoInfo.iFaceWidth, pDst, getStride((ComponentID)ch), iRot, true, FACE_NO_FLIP);
@@ -768,10 +773,10 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
           pcBufSrc = pSrcYuv->get(chId).bufAt(0, 0) + iVerFPShift*pSrcYuv->get(chId).stride + iHorFPShift;
           pcBufDst = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 1;
           triangleFaceCopy(nWidth, nHeight, pcBufSrc, (nWidth >> 1) + 1, nWidth - 1, 0, nHeight - 1, iStrideSrc, pcBufDst, getStride(chId), chId, iRot, FACE_NO_FLIP, faceIdx, 0, m_nBitDepth);
-          pcBufSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 1;
+          pSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 1;
           pcBufDst = m_pFaceRotBuf + (nWidth >> 1) + 1;
           // flip
-          rotFlipFaceChannelGeneral(pcBufSrc, (nWidth >> 1) - 1, nHeight,getStride(chId), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
+          rotFlipFaceChannelGeneral(pSrc, (nWidth >> 1) - 1, nHeight,getStride(chId), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
           pSrc = m_pFaceRotBuf;
           pDst = m_pFacesOrig[faceIdx][ch];
           rotFlipFaceChannelGeneral(pSrc, nWidth, nHeight, m_sVideoInfo.iFaceWidth, pDst, getStride((ComponentID)ch), iRot, true, FACE_NO_FLIP);
@@ -795,10 +800,10 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
           pcBufSrc = pSrcYuv->get(chId).bufAt(0, 0) + iVerFPShift*pSrcYuv->get(chId).stride + iHorFPShift;
           pcBufDst = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 1;
           triangleFaceCopy(nWidth, nHeight, pcBufSrc, (nWidth >> 1) + 1, nWidth - 1, 0, nHeight - 1, iStrideSrc, pcBufDst, getStride(chId), chId, iRot, FACE_NO_FLIP, faceIdx, 0, m_nBitDepth);
-          pcBufSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 1;
+          pSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 1;
           pcBufDst = m_pFaceRotBuf + (nWidth >> 1) + 1;
           // flip
-          rotFlipFaceChannelGeneral(pcBufSrc, (nWidth >> 1) - 1, nHeight, getStride(chId), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
+          rotFlipFaceChannelGeneral(pSrc, (nWidth >> 1) - 1, nHeight, getStride(chId), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
           pSrc = m_pFaceRotBuf;
           pDst = m_pFacesOrig[faceIdx][ch];
           rotFlipFaceChannelGeneral(pSrc, nWidth, nHeight, m_sVideoInfo.iFaceWidth, pDst, getStride((ComponentID)ch), iRot, true, FACE_NO_FLIP);
@@ -822,10 +827,10 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
           pcBufSrc = pSrcYuv->get(chId).bufAt(0, 0) + iVerFPShift*pSrcYuv->get(chId).stride + iHorFPShift;
           pcBufDst = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 1;
           triangleFaceCopy(nWidth, nHeight, pcBufSrc, (nWidth >> 1) + 1, nWidth - 1, 0, nHeight - 1, iStrideSrc, pcBufDst, getStride(chId), chId, iRot, FACE_NO_FLIP, faceIdx, 0, m_nBitDepth);
-          pcBufSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 1;
+          pSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 1;
           pcBufDst = m_pFaceRotBuf + (nWidth >> 1) + 1;
           // flip
-          rotFlipFaceChannelGeneral(pcBufSrc, (nWidth >> 1) - 1, nHeight, getStride(chId), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
+          rotFlipFaceChannelGeneral(pSrc, (nWidth >> 1) - 1, nHeight, getStride(chId), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
           pSrc = m_pFaceRotBuf;
           pDst = m_pFacesOrig[faceIdx][ch];
           rotFlipFaceChannelGeneral(pSrc, nWidth, nHeight, m_sVideoInfo.iFaceWidth, pDst, getStride((ComponentID)ch), iRot, true, FACE_NO_FLIP);
@@ -867,7 +872,7 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
             x1 = x1 >> 1;
 
             //left
-            Pel* pSrcLine = pSrc + x0;
+            FacePel* pSrcLine = pSrc + x0;
             pDst = pSrcLine - 1;
             for (Int j = 0; j < m_nMarginSizeBufTemp + x0; j++)
               *pDst-- = *pSrcLine;
@@ -884,7 +889,7 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
           pDst = pSrc - m_nStrideBufTemp;
           for (Int j = 0; j < m_nMarginSizeBufTemp; j++)
           {
-            memcpy(pDst, pSrc, m_nStrideBufTemp*sizeof(Pel));
+            memcpy(pDst, pSrc, m_nStrideBufTemp*sizeof(FacePel));
             pDst -= m_nStrideBufTemp;
           }
           //bottom
@@ -892,7 +897,7 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
           pDst = pSrc + m_nStrideBufTemp;
           for (Int j = 0; j < m_nMarginSizeBufTemp; j++)
           {
-            memcpy(pDst, pSrc, m_nStrideBufTemp*sizeof(Pel));
+            memcpy(pDst, pSrc, m_nStrideBufTemp*sizeof(FacePel));
             pDst += m_nStrideBufTemp;
           }
         }
@@ -990,10 +995,10 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
             pcBufSrc = pSrcYuv->get(chId).bufAt(0, 0) + iVerFPShift*pSrcYuv->get(chId).stride + iHorFPShift;
             pcBufDst = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 2;
             triangleFaceCopy(nWidth, nHeight, pcBufSrc, (nWidth >> 1) + 2, nWidth - 1, 0, nHeight - 1, iStrideSrc, pcBufDst, getStride(chId), chId, iRot, FACE_NO_FLIP, faceIdx, 0, m_nBitDepth);
-            pcBufSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 2;
+            pSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 2;
             pcBufDst = m_pFaceRotBuf + (nWidth >> 1) + 2;
             // flip
-            rotFlipFaceChannelGeneral(pcBufSrc, (nWidth >> 1) - 2, nHeight, getStride(chId), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
+            rotFlipFaceChannelGeneral(pSrc, (nWidth >> 1) - 2, nHeight, getStride(chId), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
             pSrc = m_pFaceRotBuf;
             pDst = m_pFacesOrig[faceIdx][ch];
             rotFlipFaceChannelGeneral(pSrc, nWidth, nHeight, m_sVideoInfo.iFaceWidth, pDst, getStride((ComponentID)ch), iRot, true, FACE_NO_FLIP);
@@ -1015,10 +1020,10 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
             pcBufSrc = pSrcYuv->get(chId).bufAt(0, 0) + iVerFPShift*pSrcYuv->get(chId).stride + iHorFPShift;
             pcBufDst = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 2;
             triangleFaceCopy(nWidth, nHeight, pcBufSrc, (nWidth >> 1) + 2, nWidth - 1, 0, nHeight - 1, iStrideSrc, pcBufDst, getStride(chId), chId, iRot, FACE_NO_FLIP, faceIdx, 0, m_nBitDepth);
-            pcBufSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 2;
+            pSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 2;
             pcBufDst = m_pFaceRotBuf + (nWidth >> 1) + 2;
             // flip
-            rotFlipFaceChannelGeneral(pcBufSrc, (nWidth >> 1) - 2, nHeight, getStride(chId), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
+            rotFlipFaceChannelGeneral(pSrc, (nWidth >> 1) - 2, nHeight, getStride(chId), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
             pSrc = m_pFaceRotBuf;
             pDst = m_pFacesOrig[faceIdx][ch];
             rotFlipFaceChannelGeneral(pSrc, nWidth, nHeight, m_sVideoInfo.iFaceWidth, pDst, getStride((ComponentID)ch), iRot, true, FACE_NO_FLIP);
@@ -1042,10 +1047,10 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
             pcBufSrc = pSrcYuv->get(chId).bufAt(0, 0) + iVerFPShift*pSrcYuv->get(chId).stride + iHorFPShift;
             pcBufDst = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 2;
             triangleFaceCopy(nWidth, nHeight, pcBufSrc, (nWidth >> 1) + 2, nWidth - 1, 0, nHeight - 1, iStrideSrc, pcBufDst, getStride(chId), chId, iRot, FACE_NO_FLIP, faceIdx, 0, m_nBitDepth);
-            pcBufSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 2;
+            pSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 2;
             pcBufDst = m_pFaceRotBuf + (nWidth >> 1) + 2;
             // flip
-            rotFlipFaceChannelGeneral(pcBufSrc, (nWidth >> 1) - 2, nHeight, getStride(chId), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
+            rotFlipFaceChannelGeneral(pSrc, (nWidth >> 1) - 2, nHeight, getStride(chId), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
             pSrc = m_pFaceRotBuf;
             pDst = m_pFacesOrig[faceIdx][ch];
             rotFlipFaceChannelGeneral(pSrc, nWidth, nHeight, m_sVideoInfo.iFaceWidth, pDst, getStride((ComponentID)ch), iRot, true, FACE_NO_FLIP);
@@ -1069,10 +1074,10 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
             pcBufSrc = pSrcYuv->get(chId).bufAt(0, 0) + iVerFPShift*pSrcYuv->get(chId).stride + iHorFPShift;
             pcBufDst = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 2;
             triangleFaceCopy(nWidth, nHeight, pcBufSrc, (nWidth >> 1) + 2, nWidth - 1, 0, nHeight - 1, iStrideSrc, pcBufDst, getStride(chId), chId, iRot, FACE_NO_FLIP, faceIdx, 0, m_nBitDepth);
-            pcBufSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 2;
+            pSrc = m_pFacesOrig[faceIdx][ch] + (nWidth >> 1) + 2;
             pcBufDst = m_pFaceRotBuf + (nWidth >> 1) + 2;
             // flip
-            rotFlipFaceChannelGeneral(pcBufSrc, (nWidth >> 1) - 2, nHeight, getStride(chId), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
+            rotFlipFaceChannelGeneral(pSrc, (nWidth >> 1) - 2, nHeight, getStride(chId), pcBufDst, m_sVideoInfo.iFaceWidth, 0, true, FACE_NO_FLIP);
             pSrc = m_pFaceRotBuf;
             pDst = m_pFacesOrig[faceIdx][ch];
             rotFlipFaceChannelGeneral(pSrc, nWidth, nHeight, m_sVideoInfo.iFaceWidth, pDst, getStride((ComponentID)ch), iRot, true, FACE_NO_FLIP);
@@ -1101,7 +1106,7 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
 
   if( !m_pFaceRotBuf )
   {
-    m_pFaceRotBuf = (Pel*)xMalloc(Pel, m_sVideoInfo.iFaceWidth*m_sVideoInfo.iFaceHeight);
+    m_pFaceRotBuf = (FacePel*)xMalloc(FacePel, m_sVideoInfo.iFaceWidth*m_sVideoInfo.iFaceHeight);
   }
   Pel* pcBufSrc, *pcBufDst;
   Pel* pSrc,     *pDst;
@@ -1551,14 +1556,14 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
         assert(!m_pFacesBufTempOrig);
         m_nMarginSizeBufTemp = 2;  //4 tap filter Lena: !!!6taps????
         m_nStrideBufTemp = nWidth + (m_nMarginSizeBufTemp<<1);
-        m_pFacesBufTemp = new Pel*[nFaces];
-        memset(m_pFacesBufTemp, 0, sizeof(Pel*)*nFaces);
-        m_pFacesBufTempOrig = new Pel*[nFaces];
-        memset(m_pFacesBufTempOrig, 0, sizeof(Pel*)*nFaces);
+        m_pFacesBufTemp = new FacePel*[nFaces];
+        memset(m_pFacesBufTemp, 0, sizeof(FacePel*)*nFaces);
+        m_pFacesBufTempOrig = new FacePel*[nFaces];
+        memset(m_pFacesBufTempOrig, 0, sizeof(FacePel*)*nFaces);
         Int iTotalHeight = (nHeight+(m_nMarginSizeBufTemp<<1));
         for(Int i=0; i<nFaces; i++)
         {
-          m_pFacesBufTemp[i] = (Pel *)xMalloc(Pel,  m_nStrideBufTemp*iTotalHeight);
+          m_pFacesBufTemp[i] = (FacePel *)xMalloc(FacePel,  m_nStrideBufTemp*iTotalHeight);
           m_pFacesBufTempOrig[i] = m_pFacesBufTemp[i] +  m_nStrideBufTemp * m_nMarginSizeBufTemp + m_nMarginSizeBufTemp;
         }
       }
@@ -1789,7 +1794,7 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
           pDst = pSrc - m_nStrideBufTemp;
           for(Int j=0; j<m_nMarginSizeBufTemp; j++)
           {
-            memcpy(pDst, pSrc, m_nStrideBufTemp*sizeof(Pel));
+            memcpy(pDst, pSrc, m_nStrideBufTemp*sizeof(FacePel));
             pDst -= m_nStrideBufTemp;
           }
           //bottom
@@ -1797,7 +1802,7 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
           pDst = pSrc + m_nStrideBufTemp;
           for(Int j=0; j<m_nMarginSizeBufTemp; j++)
           {
-            memcpy(pDst, pSrc, m_nStrideBufTemp*sizeof(Pel));
+            memcpy(pDst, pSrc, m_nStrideBufTemp*sizeof(FacePel));
             pDst += m_nStrideBufTemp;
           }
         }
@@ -2019,7 +2024,7 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
 
   if (!m_pFaceRotBuf)
   {
-    m_pFaceRotBuf = (Pel*)xMalloc(Pel, m_sVideoInfo.iFaceWidth*m_sVideoInfo.iFaceHeight);
+    m_pFaceRotBuf = (FacePel*)xMalloc(FacePel, m_sVideoInfo.iFaceWidth*m_sVideoInfo.iFaceHeight);
   }
   Pel* pcBufSrc, *pcBufDst;
   Pel* pSrc, *pDst;
@@ -2410,14 +2415,14 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
         assert(!m_pFacesBufTempOrig);
         m_nMarginSizeBufTemp = 2;  //4 tap filter
         m_nStrideBufTemp = nWidth + (m_nMarginSizeBufTemp<<1);
-        m_pFacesBufTemp = new Pel*[nFaces];
-        memset(m_pFacesBufTemp, 0, sizeof(Pel*)*nFaces);
-        m_pFacesBufTempOrig = new Pel*[nFaces];
-        memset(m_pFacesBufTempOrig, 0, sizeof(Pel*)*nFaces);
+        m_pFacesBufTemp = new FacePel*[nFaces];
+        memset(m_pFacesBufTemp, 0, sizeof(FacePel*)*nFaces);
+        m_pFacesBufTempOrig = new FacePel*[nFaces];
+        memset(m_pFacesBufTempOrig, 0, sizeof(FacePel*)*nFaces);
         Int iTotalHeight = (nHeight+(m_nMarginSizeBufTemp<<1));
         for(Int i=0; i<nFaces; i++)
         {
-          m_pFacesBufTemp[i] = (Pel *)xMalloc(Pel,  m_nStrideBufTemp*iTotalHeight);
+          m_pFacesBufTemp[i] = (FacePel *)xMalloc(FacePel,  m_nStrideBufTemp*iTotalHeight);
           m_pFacesBufTempOrig[i] = m_pFacesBufTemp[i] +  m_nStrideBufTemp * m_nMarginSizeBufTemp + m_nMarginSizeBufTemp;
         }
       }
@@ -2618,7 +2623,7 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
           pDst = pSrc - m_nStrideBufTemp;
           for(Int j=0; j<m_nMarginSizeBufTemp; j++)
           {
-            memcpy(pDst, pSrc, m_nStrideBufTemp*sizeof(Pel));
+            memcpy(pDst, pSrc, m_nStrideBufTemp*sizeof(FacePel));
             pDst -= m_nStrideBufTemp;
           }
           //bottom
@@ -2626,7 +2631,7 @@ Void TIcosahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
           pDst = pSrc + m_nStrideBufTemp;
           for(Int j=0; j<m_nMarginSizeBufTemp; j++)
           {
-            memcpy(pDst, pSrc, m_nStrideBufTemp*sizeof(Pel));
+            memcpy(pDst, pSrc, m_nStrideBufTemp*sizeof(FacePel));
             pDst += m_nStrideBufTemp;
           }
         }
@@ -2818,9 +2823,10 @@ Void TIcosahedron::compactFramePack(PelUnitBuf *pDstYuv)
   Int iTotalNumOfFaces = m_sVideoInfo.framePackStruct.rows * m_sVideoInfo.framePackStruct.cols;
   if (!m_pFaceRotBuf)
   {
-    m_pFaceRotBuf = (Pel*)xMalloc(Pel, m_sVideoInfo.iFaceWidth*m_sVideoInfo.iFaceHeight);
+    m_pFaceRotBuf = (FacePel*)xMalloc(FacePel, m_sVideoInfo.iFaceWidth*m_sVideoInfo.iFaceHeight);
   }
-  Pel *pcBufSrc, *pcBufDst;
+  FacePel *pcBufSrc;
+  Pel     *pcBufDst;
   for (Int ch = 0; ch < getNumChannels(); ch++)
   {
     ComponentID chId = (ComponentID)ch;
@@ -2864,7 +2870,7 @@ Void TIcosahedron::compactFramePack(PelUnitBuf *pDstYuv)
     if (!m_pDS420Buf && ((m_chromaFormatIDC == CHROMA_444) || (m_chromaFormatIDC == CHROMA_420 && m_bResampleChroma)))
 #endif
     {
-      m_pDS420Buf = (Pel*)xMalloc(Pel, nHeightC*iStride420);
+      m_pDS420Buf = (FacePel*)xMalloc(FacePel, nHeightC*iStride420);
     }
     for (Int face = 0; face < iTotalNumOfFaces; face++)
     {
@@ -2877,8 +2883,12 @@ Void TIcosahedron::compactFramePack(PelUnitBuf *pDstYuv)
           for (Int ch = 1; ch < getNumChannels(); ch++)
           {
             ComponentID chId = (ComponentID)ch;
+#if SVIDEO_FUSED_CHROMA_RESAMPLING
+            chromaDonwsampleHV(m_pFacesOrig[face][ch], m_sVideoInfo.iFaceWidth, m_sVideoInfo.iFaceHeight, getStride(chId), m_pDS422Buf, iStride422, m_pDS420Buf, iStride420);
+#else
             chromaDonwsampleH(m_pFacesOrig[face][ch] - nMarginSize*getStride((ComponentID)ch), m_sVideoInfo.iFaceWidth, nHeightC422, getStride(chId), 1, m_pDS422Buf, iStride422);
             chromaDonwsampleV(m_pDS422Buf + nMarginSize*iStride422, nWidthC, m_sVideoInfo.iFaceHeight, iStride422, 1, m_pDS420Buf, iStride420);
+#endif
             rotFlipFaceChannelGeneral(m_pDS420Buf, nWidthC, nHeightC, iStride420, m_pFaceRotBuf, m_sVideoInfo.iFaceWidth, rot, false, FACE_NO_FLIP);
 
             if ((face >= 0 && face <= 2) || (face >= 15 && face <= 19) || face == 5 || face == 7 || (face >= 8 && face <= 12) || face == 14)  // face copy without flipping
@@ -3680,7 +3690,7 @@ Void TIcosahedron::compactFramePack(PelUnitBuf *pDstYuv)
   Int iTotalNumOfFaces = m_sVideoInfo.framePackStruct.rows * m_sVideoInfo.framePackStruct.cols;
   if( !m_pFaceRotBuf )
   {
-    m_pFaceRotBuf = (Pel*)xMalloc(Pel, m_sVideoInfo.iFaceWidth*m_sVideoInfo.iFaceHeight);
+    m_pFaceRotBuf = (FacePel*)xMalloc(FacePel, m_sVideoInfo.iFaceWidth*m_sVideoInfo.iFaceHeight);
   }
   Pel *pcBufSrc, *pcBufDst;
  for(Int ch=0; ch<getNumChannels(); ch++)
@@ -3718,7 +3728,7 @@ Void TIcosahedron::compactFramePack(PelUnitBuf *pDstYuv)
     }
     if( !m_pDS420Buf && ((m_chromaFormatIDC == CHROMA_444) || (m_chromaFormatIDC == CHROMA_420 && m_bResampleChroma)) )
     {
-      m_pDS420Buf = (Pel*)xMalloc(Pel, nHeightC*iStride420);
+      m_pDS420Buf = (FacePel*)xMalloc(FacePel, nHeightC*iStride420);
     }
     for(Int face=0; face<iTotalNumOfFaces; face++) 
     {
@@ -3731,8 +3741,12 @@ Void TIcosahedron::compactFramePack(PelUnitBuf *pDstYuv)
           for(Int ch=1; ch<getNumChannels(); ch++)
           {
             ComponentID chId = (ComponentID)ch;
+#if SVIDEO_FUSED_CHROMA_RESAMPLING
+            chromaDonwsampleHV(m_pFacesOrig[face][ch], m_sVideoInfo.iFaceWidth, m_sVideoInfo.iFaceHeight, getStride(chId), m_pDS422Buf, iStride422, m_pDS420Buf, iStride420);
+#else
             chromaDonwsampleH(m_pFacesOrig[face][ch]-nMarginSize*getStride((ComponentID)ch), m_sVideoInfo.iFaceWidth, nHeightC422, getStride(chId), 1, m_pDS422Buf, iStride422);
             chromaDonwsampleV(m_pDS422Buf + nMarginSize*iStride422, nWidthC, m_sVideoInfo.iFaceHeight, iStride422, 1, m_pDS420Buf, iStride420);
+#endif
             rotFlipFaceChannelGeneral(m_pDS420Buf, nWidthC, nHeightC, iStride420, m_pFaceRotBuf, m_sVideoInfo.iFaceWidth, rot, false, FACE_NO_FLIP);
 
             if((face >= 0 && face <= 3) || (face >= 16 && face <= 19))  // face copy without flipping
@@ -4554,7 +4568,7 @@ Void TIcosahedron::compactFramePack(PelUnitBuf *pDstYuv)
   Int iTotalNumOfFaces = m_sVideoInfo.framePackStruct.rows * m_sVideoInfo.framePackStruct.cols;
   if (!m_pFaceRotBuf)
   {
-    m_pFaceRotBuf = (Pel*)xMalloc(Pel, m_sVideoInfo.iFaceWidth*m_sVideoInfo.iFaceHeight);
+    m_pFaceRotBuf = (FacePel*)xMalloc(FacePel, m_sVideoInfo.iFaceWidth*m_sVideoInfo.iFaceHeight);
   }
   Pel *pcBufSrc, *pcBufDst;
 
@@ -4579,7 +4593,7 @@ Void TIcosahedron::compactFramePack(PelUnitBuf *pDstYuv)
     }
     if (!m_pDS420Buf && ((m_chromaFormatIDC == CHROMA_444) || (m_chromaFormatIDC == CHROMA_420 && m_bResampleChroma)))
     {
-      m_pDS420Buf = (Pel*)xMalloc(Pel, nHeightC*iStride420);
+      m_pDS420Buf = (FacePel*)xMalloc(FacePel, nHeightC*iStride420);
     }
     for (Int face = 0; face<iTotalNumOfFaces; face++)
     {
@@ -4592,8 +4606,12 @@ Void TIcosahedron::compactFramePack(PelUnitBuf *pDstYuv)
           for (Int ch = 1; ch < getNumChannels(); ch++)
           {
             ComponentID chId = (ComponentID)ch;
+#if SVIDEO_FUSED_CHROMA_RESAMPLING
+            chromaDonwsampleHV(m_pFacesOrig[face][ch], m_sVideoInfo.iFaceWidth, m_sVideoInfo.iFaceHeight, getStride(chId), m_pDS422Buf, iStride422, m_pDS420Buf, iStride420);
+#else
             chromaDonwsampleH(m_pFacesOrig[face][ch] - nMarginSize*getStride((ComponentID)ch), m_sVideoInfo.iFaceWidth, nHeightC422, getStride(chId), 1, m_pDS422Buf, iStride422);
             chromaDonwsampleV(m_pDS422Buf + nMarginSize*iStride422, nWidthC, m_sVideoInfo.iFaceHeight, iStride422, 1, m_pDS420Buf, iStride420);
+#endif
             rotFlipFaceChannelGeneral(m_pDS420Buf, nWidthC, nHeightC, iStride420, m_pFaceRotBuf, m_sVideoInfo.iFaceWidth, rot, false, FACE_NO_FLIP);
                         if((face >= 0 && face <= 3) || (face >= 16 && face <= 19))  // face copy without flipping
             {
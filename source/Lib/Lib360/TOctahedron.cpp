@@ -65,6 +65,9 @@ const POSType TOctahedron::m_octaVerticesNew[6][3] = {
 
 TOctahedron::TOctahedron(SVideoInfo& sVideoInfo, InputGeoParam *pInGeoParam) : TGeometry()
 {
+#if SVIDEO_TRIANGLE_SPAN_TABLE
+  memset(m_pTriangleRowSpan, 0, sizeof(m_pTriangleRowSpan));
+#endif
   geoInit(sVideoInfo, pInGeoParam);
 
   if(sVideoInfo.geoType == SVIDEO_OCTAHEDRON )  //TIcosahedron;
@@ -212,9 +215,139 @@ TOctahedron::TOctahedron(SVideoInfo& sVideoInfo, InputGeoParam *pInGeoParam) : T
     //init faces;
     for(Int f=0; f<sVideoInfo.iNumFaces; f++)
       initTriMesh(m_meshFaces[f]);
+#if SVIDEO_POLYHEDRON_FACE_INDEX
+    initFaceIndex();
+#endif
+  }
+}
+
+#if SVIDEO_POLYHEDRON_FACE_INDEX
+/***************************************************
+//the sphere is divided into cells by a grid on each face of the circumscribed cube; a face is a candidate of a cell
+//unless another face has a larger projection over the whole cell, which is extended by a small margin against the
+//rounding; map3DTo2D() tests the candidates in the same order and with the same comparison as the full search,
+//so the same face is chosen;
+****************************************************/
+Void TOctahedron::initFaceIndex()
+{
+  const Double dDelta  = 1e-3;                                              //extension of the cells;
+  const Double dMargin = 64*std::numeric_limits<POSType>::epsilon();
+  Int iCellsPerFace = S_FACE_INDEX_GRID*S_FACE_INDEX_GRID;
+
+  for(Int iCell=0; iCell<S_FACE_INDEX_CELLS; iCell++)
+  {
+    Int iAxis = iCell/(iCellsPerFace<<1);
+    Int iSign = (iCell/iCellsPerFace)&1;
+    Int iv    = (iCell/S_FACE_INDEX_GRID)%S_FACE_INDEX_GRID;
+    Int iu    = iCell%S_FACE_INDEX_GRID;
+    Double corner[4][3];
+    for(Int k=0; k<4; k++)
+    {
+      corner[k][iAxis]       = iSign? -1.0 : 1.0;
+      corner[k][(iAxis+1)%3] = -1.0 + 2.0*(iu + (k&1))/S_FACE_INDEX_GRID + ((k&1)? dDelta : -dDelta);
+      corner[k][(iAxis+2)%3] = -1.0 + 2.0*(iv + (k>>1))/S_FACE_INDEX_GRID + ((k>>1)? dDelta : -dDelta);
+    }
+
+    m_iNumFaceCandidates[iCell] = 0;
+    for(Int f=0; f<m_sVideoInfo.iNumFaces; f++)
+    {
+      Bool bDominated = false;
+      for(Int g=0; g<m_sVideoInfo.iNumFaces && !bDominated; g++)
+      {
+        if(g == f)
+          continue;
+        //the difference of the projections is linear in the cell, its maximum is at a corner;
+        bDominated = true;
+        for(Int k=0; k<4 && bDominated; k++)
+        {
+          Double d = 0;
+          for(Int i=0; i<3; i++)
+            d += (m_meshFaces[f].normVec[i] - m_meshFaces[g].normVec[i])*corner[k][i];
+          bDominated = (d < -dMargin);
+        }
+      }
+      if(!bDominated)
+        m_faceCandidates[iCell][m_iNumFaceCandidates[iCell]++] = (UChar)f;
+    }
+  }
+}
+
+//cell of the direction (x, y, z); -1 for the zero vector;
+Int TOctahedron::getFaceIndexCell(POSType x, POSType y, POSType z)
+{
+  POSType p[3] = { x, y, z };
+  POSType a[3] = { x<0? -x : x, y<0? -y : y, z<0? -z : z };
+  Int iAxis = (a[0] >= a[1] && a[0] >= a[2])? 0 : (a[1] >= a[2]? 1 : 2);
+  if(!(a[iAxis] > 0))
+    return -1;
+
+  Int iu = (Int)((p[(iAxis+1)%3]/a[iAxis] + 1)*(S_FACE_INDEX_GRID>>1));
+  Int iv = (Int)((p[(iAxis+2)%3]/a[iAxis] + 1)*(S_FACE_INDEX_GRID>>1));
+  iu = Clip3(0, S_FACE_INDEX_GRID-1, iu);
+  iv = Clip3(0, S_FACE_INDEX_GRID-1, iv);
+  return ((((iAxis<<1) + (p[iAxis]<0? 1 : 0))*S_FACE_INDEX_GRID + iv)*S_FACE_INDEX_GRID + iu);
+}
+#endif
+
+#if SVIDEO_TRIANGLE_SPAN_TABLE
+TOctahedron::~TOctahedron()
+{
+  for(Int f=0; f<SV_MAX_NUM_FACES; f++)
+  {
+    for(Int ch=0; ch<MAX_NUM_COMPONENT; ch++)
+    {
+      delete[] m_pTriangleRowSpan[f][ch];
+      m_pTriangleRowSpan[f][ch] = nullptr;
+    }
+  }
+}
+
+/***************************************************
+//the samples inside a triangular face form one run in each row; the runs are derived from insideFace() once,
+//so that the triangle copies do not test every sample; the columns may be broken by the rounding of the edges;
+****************************************************/
+Void TOctahedron::initTriangleSpans(Int face, ComponentID chId)
+{
+  Int iScaleX = getComponentScaleX(chId);
+  Int iScaleY = getComponentScaleY(chId);
+  Int iWidth  = (m_sVideoInfo.iFaceWidth + (1<<iScaleX) - 1) >> iScaleX;
+  Int iHeight = (m_sVideoInfo.iFaceHeight + (1<<iScaleY) - 1) >> iScaleY;
+  Int *pRowSpan = m_pTriangleRowSpan[face][chId] = new Int[iHeight<<1];
+
+  for(Int y=0; y<iHeight; y++)
+  {
+    Int *pRow = pRowSpan + (y<<1);
+    pRow[0] = iWidth;
+    pRow[1] = -2;
+    //the column -1 may be inside the face for some face widths;
+    for(Int x=-1; x<iWidth; x++)
+    {
+      if(!insideFace(face, x*(1<<iScaleX), y<<iScaleY, COMPONENT_Y, chId))
+        continue;
+      CHECK(pRow[0] <= pRow[1] && pRow[1] != x-1, "The samples inside the face are not contiguous");
+      pRow[0] = std::min(pRow[0], x);
+      pRow[1] = x;
+    }
   }
 }
 
+//the run of row y inside the face, in the samples of chId; it is empty if iFirst > iLast;
+Void TOctahedron::getTriangleRowSpan(Int face, ComponentID chId, Int y, Int& iFirst, Int& iLast)
+{
+  if(!m_pTriangleRowSpan[face][chId])
+    initTriangleSpans(face, chId);
+  Int iHeight = (m_sVideoInfo.iFaceHeight + (1<<getComponentScaleY(chId)) - 1) >> getComponentScaleY(chId);
+  if(y < 0 || y >= iHeight)
+  {
+    iFirst = 0;
+    iLast  = -1;
+    return;
+  }
+  iFirst = m_pTriangleRowSpan[face][chId][y<<1];
+  iLast  = m_pTriangleRowSpan[face][chId][(y<<1)+1];
+}
+#endif
+
 Void TOctahedron::map2DTo3D(SPos& IPosIn, SPos *pSPosOut)
 { 
   pSPosOut->faceIdx = IPosIn.faceIdx;
@@ -237,6 +370,23 @@ Void TOctahedron::map3DTo2D(SPos *pSPosIn, SPos *pSPosOut)
   POSType dMax = std::numeric_limits<POSType>::min();
   POSType pu, pv;
   //determine face idx;
+#if SVIDEO_POLYHEDRON_FACE_INDEX
+  Int iCell = getFaceIndexCell(pSPosIn->x, pSPosIn->y, pSPosIn->z);
+  if(iCell >= 0)
+  {
+    for(Int i=0; i<m_iNumFaceCandidates[iCell]; i++)
+    {
+      Int f = m_faceCandidates[iCell][i];
+      POSType d = (pSPosIn->x*m_meshFaces[f].normVec[0] + pSPosIn->y*m_meshFaces[f].normVec[1] + pSPosIn->z*m_meshFaces[f].normVec[2]);
+      if(d >dMax)
+      {
+        iFaceIdx = f;
+        dMax = d;
+      }
+    }
+  }
+  else
+#endif
   for(Int f=0; f<m_sVideoInfo.iNumFaces; f++)
   {
     POSType d = (pSPosIn->x*m_meshFaces[f].normVec[0] + pSPosIn->y*m_meshFaces[f].normVec[1] + pSPosIn->z*m_meshFaces[f].normVec[2]);
@@ -438,12 +588,12 @@ Void TOctahedron::convertYuv(PelUnitBuf *pSrcYuv)
           CHECK(faceIdx != m_sVideoInfo.framePackStruct.faces[m_facePos[faceIdx][0]][m_facePos[faceIdx][1]].id, "");
           Int iRot = m_sVideoInfo.framePackStruct.faces[m_facePos[faceIdx][0]][m_facePos[faceIdx][1]].rot;
           Int iStrideSrc = pSrcYuv->get((ComponentID)(ch)).stride;
-          Pel *pSrc = pSrcYuv->get((ComponentID)ch).bufAt(0, 0) + faceY*iStrideSrc + faceX;
-          Pel *pDst = m_pFacesOrig[faceIdx][ch];
-          rotFaceChannelGeneral(pSrc, nWidth, nHeight, pSrcYuv->get((ComponentID)ch).stride, 1, iRot, pDst, getStride((ComponentID)ch), 1, true);
+          Pel *pSrcFrm = pSrcYuv->get((ComponentID)ch).bufAt(0, 0) + faceY*iStrideSrc + faceX;
+          FacePel *pDst = m_pFacesOrig[faceIdx][ch];
+          rotFaceChannelGeneral(pSrcFrm, nWidth, nHeight, pSrcYuv->get((ComponentID)ch).stride, 1, iRot, pDst, getStride((ComponentID)ch), 1, true);
           
           //fill in a rectangular;
-          pSrc = m_pFacesOrig[faceIdx][ch];
+          FacePel *pSrc = m_pFacesOrig[faceIdx][ch];
           //left/right;
           for(Int row=0; row<nHeight; row++)
           {
@@ -494,7 +644,7 @@ Void TOctahedron::convertYuv(PelUnitBuf *pSrcYuv)
             }
 
             //left;
-            Pel* pSrcLine = pSrc + x0;
+            FacePel* pSrcLine = pSrc + x0;
             pDst = pSrcLine - 1;
             for(Int j=0; j<x0; j++)
                 *pDst-- = *pSrcLine;
@@ -516,14 +666,14 @@ Void TOctahedron::convertYuv(PelUnitBuf *pSrcYuv)
         CHECK(m_pFacesBufTempOrig, "");
         m_nMarginSizeBufTemp = 2;  //4 tap filter;
         m_nStrideBufTemp = nWidth + (m_nMarginSizeBufTemp<<1);
-        m_pFacesBufTemp = new Pel*[nFaces];
-        memset(m_pFacesBufTemp, 0, sizeof(Pel*)*nFaces);
-        m_pFacesBufTempOrig = new Pel*[nFaces];
-        memset(m_pFacesBufTempOrig, 0, sizeof(Pel*)*nFaces);
+        m_pFacesBufTemp = new FacePel*[nFaces];
+        memset(m_pFacesBufTemp, 0, sizeof(FacePel*)*nFaces);
+        m_pFacesBufTempOrig = new FacePel*[nFaces];
+        memset(m_pFacesBufTempOrig, 0, sizeof(FacePel*)*nFaces);
         Int iTotalHeight = (nHeight+(m_nMarginSizeBufTemp<<1));
         for(Int i=0; i<nFaces; i++)
         {
-          m_pFacesBufTemp[i] = (Pel *)xMalloc(Pel,  m_nStrideBufTemp*iTotalHeight);
+          m_pFacesBufTemp[i] = (FacePel *)xMalloc(FacePel,  m_nStrideBufTemp*iTotalHeight);
           m_pFacesBufTempOrig[i] = m_pFacesBufTemp[i] +  m_nStrideBufTemp * m_nMarginSizeBufTemp + m_nMarginSizeBufTemp;
         }
       }
@@ -537,7 +687,7 @@ Void TOctahedron::convertYuv(PelUnitBuf *pSrcYuv)
 
         Int iStrideSrc = pSrcYuv->get((ComponentID)(ch)).stride;
         Pel *pSrc = pSrcYuv->get((ComponentID)ch).bufAt(0, 0) + faceY*iStrideSrc + faceX;
-        Pel *pDst = m_pFacesBufTempOrig[faceIdx];
+        FacePel *pDst = m_pFacesBufTempOrig[faceIdx];
         rotFaceChannelGeneral(pSrc, nWidth, nHeight, pSrcYuv->get((ComponentID)ch).stride, 1, iRot, pDst, m_nStrideBufTemp, 1, true);
       }
 
@@ -546,8 +696,8 @@ Void TOctahedron::convertYuv(PelUnitBuf *pSrcYuv)
         //Int iFaceStride = m_nStrideBufTemp;
         for(Int f=0; f<nFaces; f++)
         {
-          Pel *pDst;
-          Pel *pSrc;
+          FacePel *pDst;
+          FacePel *pSrc;
           
           pSrc = m_pFacesBufTempOrig[f];
           //left/right;
@@ -579,7 +729,7 @@ Void TOctahedron::convertYuv(PelUnitBuf *pSrcYuv)
             x1 = x1>>1;
 
             //left;
-            Pel* pSrcLine = pSrc + x0;
+            FacePel* pSrcLine = pSrc + x0;
             pDst = pSrcLine - 1;
             for(Int j=0; j<m_nMarginSizeBufTemp + x0; j++)
                 *pDst-- = *pSrcLine;
@@ -596,7 +746,7 @@ Void TOctahedron::convertYuv(PelUnitBuf *pSrcYuv)
           pDst = pSrc - m_nStrideBufTemp;
           for(Int j=0; j<m_nMarginSizeBufTemp; j++)
           {
-            memcpy(pDst, pSrc, m_nStrideBufTemp*sizeof(Pel));
+            memcpy(pDst, pSrc, m_nStrideBufTemp*sizeof(FacePel));
             pDst -= m_nStrideBufTemp;
           }
           //bottom;
@@ -604,7 +754,7 @@ Void TOctahedron::convertYuv(PelUnitBuf *pSrcYuv)
           pDst = pSrc + m_nStrideBufTemp;
           for(Int j=0; j<m_nMarginSizeBufTemp; j++)
           {
-            memcpy(pDst, pSrc, m_nStrideBufTemp*sizeof(Pel));
+            memcpy(pDst, pSrc, m_nStrideBufTemp*sizeof(FacePel));
             pDst += m_nStrideBufTemp;
           }
         }
@@ -642,12 +792,12 @@ Void TOctahedron::convertYuv(PelUnitBuf *pSrcYuv)
         {
           ComponentID chId = ComponentID(ch);
           Int iStrideSrc = pSrcYuv->get((ComponentID)(ch)).stride;
-          Pel *pSrc = pSrcYuv->get((ComponentID)ch).bufAt(0, 0) + faceY*iStrideSrc + faceX;
-          Pel *pDst = m_pFacesOrig[faceIdx][ch];
-          rotFaceChannelGeneral(pSrc, nWidth, nHeight, pSrcYuv->get((ComponentID)ch).stride, 1, iRot, pDst, getStride((ComponentID)ch), 1, true);
+          Pel *pSrcFrm = pSrcYuv->get((ComponentID)ch).bufAt(0, 0) + faceY*iStrideSrc + faceX;
+          FacePel *pDst = m_pFacesOrig[faceIdx][ch];
+          rotFaceChannelGeneral(pSrcFrm, nWidth, nHeight, pSrcYuv->get((ComponentID)ch).stride, 1, iRot, pDst, getStride((ComponentID)ch), 1, true);
 
           //fill in a rectangular;
-          pSrc = m_pFacesOrig[faceIdx][ch];
+          FacePel *pSrc = m_pFacesOrig[faceIdx][ch];
           //left/right;
           for(Int row=0; row<nHeight; row++)
           {
@@ -698,7 +848,7 @@ Void TOctahedron::convertYuv(PelUnitBuf *pSrcYuv)
             }
 
             //left;
-            Pel* pSrcLine = pSrc + x0;
+            FacePel* pSrcLine = pSrc + x0;
             pDst = pSrcLine - 1;
             for(Int j=0; j<x0; j++)
                 *pDst-- = *pSrcLine;
@@ -737,7 +887,8 @@ Void TOctahedron::compactFramePackConvertYuv(PelUnitBuf *pSrcYuv)
 #if SVIDEO_MTK_MODIFIED_COHP1
 Void TOctahedron::recoverFaceType1(Int faceIdx, PelUnitBuf *pSrcYuv, ComponentID chId, Int iRot, Int iStrideRot, Int nWidth, Int nHeight)
 {
-  Pel* pcBufSrc, *pcBufDst;
+  Pel     *pcBufSrc;
+  FacePel *pcBufDst;
   Int iStrideSrc = pSrcYuv->get(chId).stride;
   
   if (faceIdx == 2)
@@ -847,7 +998,8 @@ Void TOctahedron::recoverFaceType1(Int faceIdx, PelUnitBuf *pSrcYuv, ComponentID
 
 Void TOctahedron::recoverFaceChromaType1(Int faceIdx, PelUnitBuf *pSrcYuv, ComponentID chId, Int iRot, Int iStrideRot, Int nWidth, Int nHeight)
 {
-  Pel* pcBufSrc, *pcBufDst;
+  Pel     *pcBufSrc;
+  FacePel *pcBufDst;
   Int iStrideSrc = pSrcYuv->get(chId).stride;
 
   if (faceIdx == 2)
@@ -1080,7 +1232,7 @@ Void TOctahedron::compactFramePackConvertYuvType1(PelUnitBuf *pSrcYuv)
 
   if( !m_pFaceRotBuf )
   {
-    m_pFaceRotBuf = (Pel*)xMalloc(Pel, m_sVideoInfo.iFaceWidth*m_sVideoInfo.iFaceHeight);
+    m_pFaceRotBuf = (FacePel*)xMalloc(FacePel, m_sVideoInfo.iFaceWidth*m_sVideoInfo.iFaceHeight);
   }
 
 #if SVIDEO_MTK_MODIFIED_COHP1
@@ -1119,8 +1271,8 @@ Void TOctahedron::compactFramePackConvertYuvType1(PelUnitBuf *pSrcYuv)
           else
             ((*this).*pRecoverFaceChroma)(faceIdx, pSrcYuv, chId, iRot, iStrideRot, nWidth, nHeight);
 
-          Pel *pSrc = m_pFaceRotBuf;
-          Pel *pDst = m_pFacesOrig[faceIdx][ch];
+          FacePel *pSrc = m_pFaceRotBuf;
+          FacePel *pDst = m_pFacesOrig[faceIdx][ch];
 
           if (iRot == 90 || iRot == 270)
             rotFlipFaceChannelGeneral(pSrc, nHeight, nWidth, iStrideRot, pDst, getStride((ComponentID)ch), iRot, true, FACE_NO_FLIP);
@@ -1132,8 +1284,8 @@ Void TOctahedron::compactFramePackConvertYuvType1(PelUnitBuf *pSrcYuv)
           else
             recoverFaceChromaType1(faceIdx, pSrcYuv, chId, iRot, nWidth, nHeight);
 
-          Pel *pSrc = m_pFaceRotBuf;
-          Pel *pDst = m_pFacesOrig[faceIdx][ch];
+          FacePel *pSrc = m_pFaceRotBuf;
+          FacePel *pDst = m_pFacesOrig[faceIdx][ch];
           rotFlipFaceChannelGeneral(pSrc, nWidth, nHeight, m_sVideoInfo.iFaceWidth, pDst, getStride((ComponentID)ch), iRot, true, FACE_NO_FLIP);
 #endif
           //fill in a rectangular
@@ -1188,7 +1340,7 @@ Void TOctahedron::compactFramePackConvertYuvType1(PelUnitBuf *pSrcYuv)
             }
 
             //left
-            Pel* pSrcLine = pSrc + x0;
+            FacePel* pSrcLine = pSrc + x0;
             pDst = pSrcLine - 1;
             for(Int j=0; j<x0; j++)
               *pDst-- = *pSrcLine;
@@ -1210,14 +1362,14 @@ Void TOctahedron::compactFramePackConvertYuvType1(PelUnitBuf *pSrcYuv)
         CHECK(m_pFacesBufTempOrig, "");
         m_nMarginSizeBufTemp = 2;  //4 tap filter
         m_nStrideBufTemp = nWidth + (m_nMarginSizeBufTemp<<1);
-        m_pFacesBufTemp = new Pel*[nFaces];
-        memset(m_pFacesBufTemp, 0, sizeof(Pel*)*nFaces);
-        m_pFacesBufTempOrig = new Pel*[nFaces];
-        memset(m_pFacesBufTempOrig, 0, sizeof(Pel*)*nFaces);
+        m_pFacesBufTemp = new FacePel*[nFaces];
+        memset(m_pFacesBufTemp, 0, sizeof(FacePel*)*nFaces);
+        m_pFacesBufTempOrig = new FacePel*[nFaces];
+        memset(m_pFacesBufTempOrig, 0, sizeof(FacePel*)*nFaces);
         Int iTotalHeight = (nHeight+(m_nMarginSizeBufTemp<<1));
         for(Int i=0; i<nFaces; i++)
         {
-          m_pFacesBufTemp[i] = (Pel *)xMalloc(Pel,  m_nStrideBufTemp*iTotalHeight);
+          m_pFacesBufTemp[i] = (FacePel *)xMalloc(FacePel,  m_nStrideBufTemp*iTotalHeight);
           m_pFacesBufTempOrig[i] = m_pFacesBufTemp[i] +  m_nStrideBufTemp * m_nMarginSizeBufTemp + m_nMarginSizeBufTemp;
         }
       }
@@ -1233,8 +1385,8 @@ Void TOctahedron::compactFramePackConvertYuvType1(PelUnitBuf *pSrcYuv)
 #else
         recoverFaceChromaType1(faceIdx, pSrcYuv, chId, iRot, nWidth, nHeight);
 #endif
-        Pel *pSrc = m_pFaceRotBuf;
-        Pel *pDst = m_pFacesBufTempOrig[faceIdx];
+        FacePel *pSrc = m_pFaceRotBuf;
+        FacePel *pDst = m_pFacesBufTempOrig[faceIdx];
         rotFlipFaceChannelGeneral(pSrc, nWidth, nHeight, m_sVideoInfo.iFaceWidth, pDst, m_nStrideBufTemp, iRot, true, FACE_NO_FLIP);
       }
 
@@ -1242,8 +1394,8 @@ Void TOctahedron::compactFramePackConvertYuvType1(PelUnitBuf *pSrcYuv)
       {
         for(Int f=0; f<nFaces; f++)
         {
-          Pel *pDst;
-          Pel *pSrc;
+          FacePel *pDst;
+          FacePel *pSrc;
 
           pSrc = m_pFacesBufTempOrig[f];
           //left/right
@@ -1275,7 +1427,7 @@ Void TOctahedron::compactFramePackConvertYuvType1(PelUnitBuf *pSrcYuv)
             x1 = x1>>1;
 
             //left
-            Pel* pSrcLine = pSrc + x0;
+            FacePel* pSrcLine = pSrc + x0;
             pDst = pSrcLine - 1;
             for(Int j=0; j<m_nMarginSizeBufTemp + x0; j++)
               *pDst-- = *pSrcLine;
@@ -1292,7 +1444,7 @@ Void TOctahedron::compactFramePackConvertYuvType1(PelUnitBuf *pSrcYuv)
           pDst = pSrc - m_nStrideBufTemp;
           for(Int j=0; j<m_nMarginSizeBufTemp; j++)
           {
-            memcpy(pDst, pSrc, m_nStrideBufTemp*sizeof(Pel));
+            memcpy(pDst, pSrc, m_nStrideBufTemp*sizeof(FacePel));
             pDst -= m_nStrideBufTemp;
           }
           //bottom
@@ -1300,7 +1452,7 @@ Void TOctahedron::compactFramePackConvertYuvType1(PelUnitBuf *pSrcYuv)
           pDst = pSrc + m_nStrideBufTemp;
           for(Int j=0; j<m_nMarginSizeBufTemp; j++)
           {
-            memcpy(pDst, pSrc, m_nStrideBufTemp*sizeof(Pel));
+            memcpy(pDst, pSrc, m_nStrideBufTemp*sizeof(FacePel));
             pDst += m_nStrideBufTemp;
           }
         }
@@ -1343,8 +1495,8 @@ Void TOctahedron::compactFramePackConvertYuvType1(PelUnitBuf *pSrcYuv)
 #else
           recoverFaceType1(faceIdx, pSrcYuv, chId, iRot, nWidth, nHeight);
 #endif
-          Pel *pSrc = m_pFaceRotBuf;
-          Pel *pDst = m_pFacesOrig[faceIdx][ch];
+          FacePel *pSrc = m_pFaceRotBuf;
+          FacePel *pDst = m_pFacesOrig[faceIdx][ch];
           rotFlipFaceChannelGeneral(pSrc, nWidth, nHeight, m_sVideoInfo.iFaceWidth, pDst, getStride((ComponentID)ch), iRot, true, FACE_NO_FLIP);
         }
       }
@@ -1369,9 +1521,10 @@ Void TOctahedron::compactFramePackConvertYuvType2(PelUnitBuf *pSrcYuv)
 
   if( !m_pFaceRotBuf )
   {
-    m_pFaceRotBuf = (Pel*)xMalloc(Pel, m_sVideoInfo.iFaceWidth*m_sVideoInfo.iFaceHeight);
+    m_pFaceRotBuf = (FacePel*)xMalloc(FacePel, m_sVideoInfo.iFaceWidth*m_sVideoInfo.iFaceHeight);
   }
-  Pel* pcBufSrc, *pcBufDst;
+  Pel     *pcBufSrc;
+  FacePel *pcBufDst;
 
   if(pSrcYuv->chromaFormat==CHROMA_420)
   {
@@ -1461,8 +1614,8 @@ Void TOctahedron::compactFramePackConvertYuvType2(PelUnitBuf *pSrcYuv)
             }
             triangleFaceCopy(nWidth, nHeight, pcBufSrc, 0, nWidth - 1, 0, nHeight - 1, iStrideSrc, pcBufDst, m_sVideoInfo.iFaceWidth, chId, iRot, FACE_NO_FLIP, faceIdx, 0, m_nBitDepth);
           }
-          Pel *pSrc = m_pFaceRotBuf;
-          Pel *pDst = m_pFacesOrig[faceIdx][ch];
+          FacePel *pSrc = m_pFaceRotBuf;
+          FacePel *pDst = m_pFacesOrig[faceIdx][ch];
           rotFlipFaceChannelGeneral(pSrc, nWidth, nHeight, m_sVideoInfo.iFaceWidth, pDst, getStride((ComponentID)ch), iRot, true, FACE_NO_FLIP);
 
           //fill in a rectangular
@@ -1517,7 +1670,7 @@ Void TOctahedron::compactFramePackConvertYuvType2(PelUnitBuf *pSrcYuv)
             }
 
             //left
-            Pel* pSrcLine = pSrc + x0;
+            FacePel* pSrcLine = pSrc + x0;
             pDst = pSrcLine - 1;
             for(Int j=0; j<x0; j++)
               *pDst-- = *pSrcLine;
@@ -1539,14 +1692,14 @@ Void TOctahedron::compactFramePackConvertYuvType2(PelUnitBuf *pSrcYuv)
         CHECK(m_pFacesBufTempOrig, "");
         m_nMarginSizeBufTemp = 2;  //4 tap filter
         m_nStrideBufTemp = nWidth + (m_nMarginSizeBufTemp<<1);
-        m_pFacesBufTemp = new Pel*[nFaces];
-        memset(m_pFacesBufTemp, 0, sizeof(Pel*)*nFaces);
-        m_pFacesBufTempOrig = new Pel*[nFaces];
-        memset(m_pFacesBufTempOrig, 0, sizeof(Pel*)*nFaces);
+        m_pFacesBufTemp = new FacePel*[nFaces];
+        memset(m_pFacesBufTemp, 0, sizeof(FacePel*)*nFaces);
+        m_pFacesBufTempOrig = new FacePel*[nFaces];
+        memset(m_pFacesBufTempOrig, 0, sizeof(FacePel*)*nFaces);
         Int iTotalHeight = (nHeight+(m_nMarginSizeBufTemp<<1));
         for(Int i=0; i<nFaces; i++)
         {
-          m_pFacesBufTemp[i] = (Pel *)xMalloc(Pel,  m_nStrideBufTemp*iTotalHeight);
+          m_pFacesBufTemp[i] = (FacePel *)xMalloc(FacePel,  m_nStrideBufTemp*iTotalHeight);
           m_pFacesBufTempOrig[i] = m_pFacesBufTemp[i] +  m_nStrideBufTemp * m_nMarginSizeBufTemp + m_nMarginSizeBufTemp;
         }
       }
@@ -1593,8 +1746,8 @@ Void TOctahedron::compactFramePackConvertYuvType2(PelUnitBuf *pSrcYuv)
           triangleFaceCopy(nWidth, nHeight, pcBufSrc, 0, nWidth - 1, 0, nHeight - 1, iStrideSrc, pcBufDst, m_sVideoInfo.iFaceWidth, chId, iRot, FACE_NO_FLIP, faceIdx, 0, m_nBitDepth);
         }
 
-        Pel *pSrc = m_pFaceRotBuf;
-        Pel *pDst = m_pFacesBufTempOrig[faceIdx];
+        FacePel *pSrc = m_pFaceRotBuf;
+        FacePel *pDst = m_pFacesBufTempOrig[faceIdx];
         rotFlipFaceChannelGeneral(pSrc, nWidth, nHeight, m_sVideoInfo.iFaceWidth, pDst, m_nStrideBufTemp, iRot, true, FACE_NO_FLIP);
       }
 
@@ -1602,8 +1755,8 @@ Void TOctahedron::compactFramePackConvertYuvType2(PelUnitBuf *pSrcYuv)
       {
         for(Int f=0; f<nFaces; f++)
         {
-          Pel *pDst;
-          Pel *pSrc;
+          FacePel *pDst;
+          FacePel *pSrc;
 
           pSrc = m_pFacesBufTempOrig[f];
           //left/right
@@ -1635,7 +1788,7 @@ Void TOctahedron::compactFramePackConvertYuvType2(PelUnitBuf *pSrcYuv)
             x1 = x1>>1;
 
             //left
-            Pel* pSrcLine = pSrc + x0;
+            FacePel* pSrcLine = pSrc + x0;
             pDst = pSrcLine - 1;
             for(Int j=0; j<m_nMarginSizeBufTemp + x0; j++)
               *pDst-- = *pSrcLine;
@@ -1652,7 +1805,7 @@ Void TOctahedron::compactFramePackConvertYuvType2(PelUnitBuf *pSrcYuv)
           pDst = pSrc - m_nStrideBufTemp;
           for(Int j=0; j<m_nMarginSizeBufTemp; j++)
           {
-            memcpy(pDst, pSrc, m_nStrideBufTemp*sizeof(Pel));
+            memcpy(pDst, pSrc, m_nStrideBufTemp*sizeof(FacePel));
             pDst -= m_nStrideBufTemp;
           }
           //bottom
@@ -1660,7 +1813,7 @@ Void TOctahedron::compactFramePackConvertYuvType2(PelUnitBuf *pSrcYuv)
           pDst = pSrc + m_nStrideBufTemp;
           for(Int j=0; j<m_nMarginSizeBufTemp; j++)
           {
-            memcpy(pDst, pSrc, m_nStrideBufTemp*sizeof(Pel));
+            memcpy(pDst, pSrc, m_nStrideBufTemp*sizeof(FacePel));
             pDst += m_nStrideBufTemp;
           }
         }
@@ -1732,8 +1885,8 @@ Void TOctahedron::compactFramePackConvertYuvType2(PelUnitBuf *pSrcYuv)
             triangleFaceCopy(nWidth, nHeight, pcBufSrc, 0, nWidth - 1, 0, nHeight - 1, iStrideSrc, pcBufDst, m_sVideoInfo.iFaceWidth, chId, iRot, FACE_NO_FLIP, faceIdx, 0, m_nBitDepth);
           }
 
-          Pel *pSrc = m_pFaceRotBuf;
-          Pel *pDst = m_pFacesOrig[faceIdx][ch];
+          FacePel *pSrc = m_pFaceRotBuf;
+          FacePel *pDst = m_pFacesOrig[faceIdx][ch];
           rotFlipFaceChannelGeneral(pSrc, nWidth, nHeight, m_sVideoInfo.iFaceWidth, pDst, getStride((ComponentID)ch), iRot, true, FACE_NO_FLIP);
         }
       }
@@ -1761,7 +1914,8 @@ Void TOctahedron::compactFramePack(PelUnitBuf *pDstYuv)
 #if SVIDEO_MTK_MODIFIED_COHP1
 Void TOctahedron::copyFaceChromaType1(Int face, PelUnitBuf *pDstYuv, ComponentID chId, Int rot, Int iStrideRot, Int nWidthC, Int nHeightC)
 {
-  Pel *pcBufSrc, *pcBufDst;
+  FacePel *pcBufSrc;
+  Pel     *pcBufDst;
 
   if(face == 2)
   {
@@ -1845,7 +1999,8 @@ Void TOctahedron::copyFaceChromaType1(Int face, PelUnitBuf *pDstYuv, ComponentID
 
 Void TOctahedron::copyFaceType1(Int face, PelUnitBuf *pDstYuv, ComponentID chId, Int rot, Int iStrideRot)
 {    
-  Pel *pcBufSrc, *pcBufDst;
+  FacePel *pcBufSrc;
+  Pel     *pcBufDst;
   Int iFaceWidth = m_sVideoInfo.iFaceWidth;
   Int iFaceHeight = m_sVideoInfo.iFaceHeight;
 
@@ -2075,7 +2230,7 @@ Void TOctahedron::compactFramePackType1(PelUnitBuf *pDstYuv)
   Int iTotalNumOfFaces = m_sVideoInfo.framePackStruct.rows * m_sVideoInfo.framePackStruct.cols;
   if( !m_pFaceRotBuf )
   {
-    m_pFaceRotBuf = (Pel*)xMalloc(Pel, m_sVideoInfo.iFaceWidth*m_sVideoInfo.iFaceHeight);
+    m_pFaceRotBuf = (FacePel*)xMalloc(FacePel, m_sVideoInfo.iFaceWidth*m_sVideoInfo.iFaceHeight);
   }
 
 #if SVIDEO_MTK_MODIFIED_COHP1
@@ -2114,7 +2269,7 @@ Void TOctahedron::compactFramePackType1(PelUnitBuf *pDstYuv)
     if( !m_pDS420Buf && ((m_chromaFormatIDC == CHROMA_444) || (m_chromaFormatIDC == CHROMA_420 && m_bResampleChroma)) )
 #endif
     {
-      m_pDS420Buf = (Pel*)xMalloc(Pel, nHeightC*iStride420);
+      m_pDS420Buf = (FacePel*)xMalloc(FacePel, nHeightC*iStride420);
     }
     for(Int face=0; face<iTotalNumOfFaces; face++) 
     {
@@ -2130,8 +2285,12 @@ Void TOctahedron::compactFramePackType1(PelUnitBuf *pDstYuv)
           for(Int ch=1; ch<getNumChannels(); ch++)
           {
             ComponentID chId = (ComponentID)ch;
+#if SVIDEO_FUSED_CHROMA_RESAMPLING
+            chromaDonwsampleHV(m_pFacesOrig[face][ch], m_sVideoInfo.iFaceWidth, m_sVideoInfo.iFaceHeight, getStride(chId), m_pDS422Buf, iStride422, m_pDS420Buf, iStride420);
+#else
             chromaDonwsampleH(m_pFacesOrig[face][ch]-nMarginSize*getStride((ComponentID)ch), m_sVideoInfo.iFaceWidth, nHeightC422, getStride(chId), 1, m_pDS422Buf, iStride422);
             chromaDonwsampleV(m_pDS422Buf + nMarginSize*iStride422, nWidthC, m_sVideoInfo.iFaceHeight, iStride422, 1, m_pDS420Buf, iStride420);
+#endif
 #if SVIDEO_MTK_MODIFIED_COHP1
             rotFlipFaceChannelGeneral(m_pDS420Buf, nWidthC, nHeightC, iStride420, m_pFaceRotBuf, iStrideRot, rot, false, FACE_NO_FLIP);
 
@@ -2298,9 +2457,10 @@ Void TOctahedron::compactFramePackType2(PelUnitBuf *pDstYuv)
   Int iTotalNumOfFaces = m_sVideoInfo.framePackStruct.rows * m_sVideoInfo.framePackStruct.cols;
   if( !m_pFaceRotBuf )
   {
-    m_pFaceRotBuf = (Pel*)xMalloc(Pel, m_sVideoInfo.iFaceWidth*m_sVideoInfo.iFaceHeight);
+    m_pFaceRotBuf = (FacePel*)xMalloc(FacePel, m_sVideoInfo.iFaceWidth*m_sVideoInfo.iFaceHeight);
   }
-  Pel *pcBufSrc, *pcBufDst;
+  FacePel *pcBufSrc;
+  Pel     *pcBufDst;
 
   if(pDstYuv->chromaFormat==CHROMA_420)
   {
@@ -2331,7 +2491,7 @@ Void TOctahedron::compactFramePackType2(PelUnitBuf *pDstYuv)
     if( !m_pDS420Buf && ((m_chromaFormatIDC == CHROMA_444) || (m_chromaFormatIDC == CHROMA_420 && m_bResampleChroma)) )
 #endif
     {
-      m_pDS420Buf = (Pel*)xMalloc(Pel, nHeightC*iStride420);
+      m_pDS420Buf = (FacePel*)xMalloc(FacePel, nHeightC*iStride420);
     }
     for(Int face=0; face<iTotalNumOfFaces; face++) 
     {
@@ -2344,8 +2504,12 @@ Void TOctahedron::compactFramePackType2(PelUnitBuf *pDstYuv)
           for(Int ch=1; ch<getNumChannels(); ch++)
           {
             ComponentID chId = (ComponentID)ch;
+#if SVIDEO_FUSED_CHROMA_RESAMPLING
+            chromaDonwsampleHV(m_pFacesOrig[face][ch], m_sVideoInfo.iFaceWidth, m_sVideoInfo.iFaceHeight, getStride(chId), m_pDS422Buf, iStride422, m_pDS420Buf, iStride420);
+#else
             chromaDonwsampleH(m_pFacesOrig[face][ch]-nMarginSize*getStride((ComponentID)ch), m_sVideoInfo.iFaceWidth, nHeightC422, getStride(chId), 1, m_pDS422Buf, iStride422);
             chromaDonwsampleV(m_pDS422Buf + nMarginSize*iStride422, nWidthC, m_sVideoInfo.iFaceHeight, iStride422, 1, m_pDS420Buf, iStride420);
+#endif
             rotFlipFaceChannelGeneral(m_pDS420Buf, nWidthC, nHeightC, iStride420, m_pFaceRotBuf, m_sVideoInfo.iFaceWidth, rot, false, FACE_NO_FLIP);
 
             if(face == 3)
@@ -2578,7 +2742,8 @@ Void TOctahedron::compactFramePackType2(PelUnitBuf *pDstYuv)
 }
 
 // rot is defined in the clock-wise rotation manner
-Void TOctahedron::triangleFaceCopy(Int iFaceWidth, Int iFaceHeight, Pel *pSrcBuf, Int iStartHorPos, Int iEndHorPos, Int iStartVerPos, Int iEndVerPos, Int iStrideSrc, Pel *pDstBuf, Int iStrideDst, ComponentID chId, Int rot, FaceFlipType eFaceFlipType, Int face, Int iBDAdjust, Int iMaxBD)
+template<typename TS, typename TD>
+Void TOctahedron::triangleFaceCopy(Int iFaceWidth, Int iFaceHeight, TS *pSrcBuf, Int iStartHorPos, Int iEndHorPos, Int iStartVerPos, Int iEndVerPos, Int iStrideSrc, TD *pDstBuf, Int iStrideDst, ComponentID chId, Int rot, FaceFlipType eFaceFlipType, Int face, Int iBDAdjust, Int iMaxBD)
 {
   CHECK(iBDAdjust <0, "");
 #if !SVIDEO_MTK_MODIFIED_COHP1
@@ -2590,12 +2755,68 @@ Void TOctahedron::triangleFaceCopy(Int iFaceWidth, Int iFaceHeight, Pel *pSrcBuf
   Int iHeightSrc = iEndVerPos - iStartVerPos   + 1; 
   Int iOffset    = iBDAdjust>0? (1<<(iBDAdjust-1)) : 0; 
 
+#if SVIDEO_TRIANGLE_SPAN_TABLE
+  if(rot == 0 || rot == 180)
+  {
+    //mirroring of the face coordinates; the rotation by 180 degrees mirrors both;
+    Bool bHorMirror = (eFaceFlipType == FACE_HOR_FLIP);
+    Bool bVerMirror = (eFaceFlipType == FACE_VER_FLIP);
+    if(eFaceFlipType >= FACE_FLIP_NUM)
+      return;
+    if(rot == 180)
+    {
+      bHorMirror = !bHorMirror;
+      bVerMirror = !bVerMirror;
+    }
+    Int iBaseX = bHorMirror? (iFaceWidth - 1 - iStartHorPos) : iStartHorPos;
+    TS *pSrcLine = pSrcBuf;
+    for(Int j=0; j<iHeightSrc; j++)
+    {
+      Int iFirst, iLast;
+      getTriangleRowSpan(face, chId, bVerMirror? (iFaceHeight - 1 - (iStartVerPos + j)) : (iStartVerPos + j), iFirst, iLast);
+      Int i0 = std::max(bHorMirror? (iBaseX - iLast) : (iFirst - iBaseX), 0);
+      Int i1 = std::min(bHorMirror? (iBaseX - iFirst) : (iLast - iBaseX), iWidthSrc - 1);
+      for(Int i = i0; i <= i1; i++)
+      {
+        pDstBuf[i] = ClipBD((pSrcLine[i] + iOffset) >> iBDAdjust, iMaxBD);
+      }
+      pDstBuf += iStrideDst;
+      pSrcLine += iStrideSrc;
+    }
+  }
+  else if(rot == 90 || rot == 270)
+  {
+    CHECK(eFaceFlipType != FACE_NO_FLIP, "");
+    //a line of the destination is a column of the face, the sample i is tested against the run of its row;
+    Int *pFirst = new Int[iHeightSrc];
+    Int *pLast  = new Int[iHeightSrc];
+    for(Int i = 0; i < iHeightSrc; i++)
+    {
+      //the rotation by 90 degrees takes the samples of a line from the bottom row upwards;
+      getTriangleRowSpan(face, chId, rot == 90? (iStartVerPos + iHeightSrc - 1 - i) : (iStartVerPos + i), pFirst[i], pLast[i]);
+    }
+    TS *pSrcLine = pSrcBuf;
+    for(Int j = 0; j < iWidthSrc; j++)
+    {
+      Int x = (rot == 90)? (iStartHorPos + j) : (iStartHorPos + iWidthSrc - 1 - j);
+      for(Int i = 0; i < iHeightSrc; i++)
+      {
+        if(x >= pFirst[i] && x <= pLast[i])
+          pDstBuf[i] = ClipBD((pSrcLine[i] + iOffset) >> iBDAdjust, iMaxBD);
+      }
+      pDstBuf += iStrideDst;
+      pSrcLine += iStrideSrc;
+    }
+    delete[] pFirst;
+    delete[] pLast;
+  }
+#else
   if(!rot)
   {
-    Pel *pSrcLine = pSrcBuf;
+    TS *pSrcLine = pSrcBuf;
     for(Int j=0; j<iHeightSrc; j++)
     {
-      Pel *pSrc = pSrcLine;
+      TS *pSrc = pSrcLine;
       for(Int i = 0; i < iWidthSrc; i++, pSrc++)
       {
         if(eFaceFlipType == FACE_NO_FLIP)
@@ -2626,10 +2847,10 @@ Void TOctahedron::triangleFaceCopy(Int iFaceWidth, Int iFaceHeight, Pel *pSrcBuf
   }
   else if(rot == 180)
   {
-    Pel *pSrcLine = pSrcBuf;
+    TS *pSrcLine = pSrcBuf;
     for(Int j=0; j<iHeightSrc; j++)
     {
-      Pel *pSrc = pSrcLine;
+      TS *pSrc = pSrcLine;
       for(Int i = 0; i < iWidthSrc; i++, pSrc++)
       {
         if(eFaceFlipType == FACE_NO_FLIP)
@@ -2661,14 +2882,14 @@ Void TOctahedron::triangleFaceCopy(Int iFaceWidth, Int iFaceHeight, Pel *pSrcBuf
 #if SVIDEO_MTK_MODIFIED_COHP1
   else if(rot == 90)
   {
-    Pel *pSrcLine = pSrcBuf;
+    TS *pSrcLine = pSrcBuf;
 
     switch (eFaceFlipType)
     {
     case FACE_NO_FLIP:
       for(Int j = 0;j < iWidthSrc;j++)
       {
-        Pel *pSrc = pSrcLine;
+        TS *pSrc = pSrcLine;
         for(Int i = iHeightSrc - 1;i >= 0;i--, pSrc++)
         {
           if(insideFace(face, (iStartHorPos + j) << iScaleX, (iStartVerPos + i)<<iScaleY, COMPONENT_Y, chId))
@@ -2688,14 +2909,14 @@ Void TOctahedron::triangleFaceCopy(Int iFaceWidth, Int iFaceHeight, Pel *pSrcBuf
   }
   else if (rot == 270)
   {
-    Pel *pSrcLine = pSrcBuf;
+    TS *pSrcLine = pSrcBuf;
 
     switch (eFaceFlipType)
     {
     case FACE_NO_FLIP:
       for(Int j = iWidthSrc - 1;j >= 0;j--)
       {
-        Pel *pSrc = pSrcLine;
+        TS *pSrc = pSrcLine;
         for(Int i = 0;i < iHeightSrc;i++, pSrc++)
         {
           if(insideFace(face, (iStartHorPos + j) << iScaleX, (iStartVerPos + i)<<iScaleY, COMPONENT_Y, chId))
@@ -2715,9 +2936,15 @@ Void TOctahedron::triangleFaceCopy(Int iFaceWidth, Int iFaceHeight, Pel *pSrcBuf
     }
   }
 #endif
+#endif
 }
+template Void TOctahedron::triangleFaceCopy<Pel, Pel>(Int iFaceWidth, Int iFaceHeight, Pel *pSrcBuf, Int iStartHorPos, Int iEndHorPos, Int iStartVerPos, Int iEndVerPos, Int iStrideSrc, Pel *pDstBuf, Int iStrideDst, ComponentID chId, Int rot, FaceFlipType eFaceFlipType, Int face, Int iBDAdjust, Int iMaxBD);
+#if SVIDEO_8BIT_FACE_STORAGE
+template Void TOctahedron::triangleFaceCopy<Pel, FacePel>(Int iFaceWidth, Int iFaceHeight, Pel *pSrcBuf, Int iStartHorPos, Int iEndHorPos, Int iStartVerPos, Int iEndVerPos, Int iStrideSrc, FacePel *pDstBuf, Int iStrideDst, ComponentID chId, Int rot, FaceFlipType eFaceFlipType, Int face, Int iBDAdjust, Int iMaxBD);
+template Void TOctahedron::triangleFaceCopy<FacePel, Pel>(Int iFaceWidth, Int iFaceHeight, FacePel *pSrcBuf, Int iStartHorPos, Int iEndHorPos, Int iStartVerPos, Int iEndVerPos, Int iStrideSrc, Pel *pDstBuf, Int iStrideDst, ComponentID chId, Int rot, FaceFlipType eFaceFlipType, Int face, Int iBDAdjust, Int iMaxBD);
+#endif
 
-Void TOctahedron::rotFlipFaceChannelGeneral(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSrc, Int iStrideSrc, Pel *pDstBuf, Int iStrideDst, Int rot, Bool bInverse, FaceFlipType eFaceFlipType)
+Void TOctahedron::rotFlipFaceChannelGeneral(FacePel *pSrcBuf, Int iWidthSrc, Int iHeightSrc, Int iStrideSrc, FacePel *pDstBuf, Int iStrideDst, Int rot, Bool bInverse, FaceFlipType eFaceFlipType)
 {
   Int iWidthDst = iWidthSrc;
   Int iHeightDst = iHeightSrc;
@@ -2726,12 +2953,41 @@ Void TOctahedron::rotFlipFaceChannelGeneral(Pel *pSrcBuf, Int iWidthSrc, Int iHe
   {
     rot = (360-rot)%360;
   }
+#if SVIDEO_BLOCKED_FACE_ROTATION
+  {
+#if SVIDEO_MTK_MODIFIED_COHP1
+    Int iScanRot = (rot == 90 || rot == 270) ? 360 - rot : rot;
+#else
+    Int iScanRot = rot;
+#endif
+    Int iSrcOffset, iStepI, iStepJ;
+    if(iScanRot < 360 && xGetRotScan(iScanRot, iWidthSrc, iHeightSrc, 1, iStrideSrc, iSrcOffset, iStepI, iStepJ))
+    {
+      Bool bTranspose = ((rot / 90) & 1);
+      iWidthDst  = bTranspose ? iHeightSrc : iWidthSrc;
+      iHeightDst = bTranspose ? iWidthSrc : iHeightSrc;
+      //the flip of the destination is folded into the scan;
+      if(eFaceFlipType == FACE_HOR_FLIP)
+      {
+        iSrcOffset += (iWidthDst - 1) * iStepI;
+        iStepI      = -iStepI;
+      }
+      else if(eFaceFlipType == FACE_VER_FLIP)
+      {
+        iSrcOffset += (iHeightDst - 1) * iStepJ;
+        iStepJ      = -iStepJ;
+      }
+      xCopyRotScan(pSrcBuf + iSrcOffset, iStepI, iStepJ, pDstBuf, 1, iStrideDst, iWidthDst, iHeightDst);
+      return;
+    }
+  }
+#endif
   if(!rot)
   {
     iWidthDst     = iWidthSrc;
     iHeightDst    = iHeightSrc;
-    Pel *pSrcLine = pSrcBuf;
-    Pel *pDstLine = pDstBuf;
+    FacePel *pSrcLine = pSrcBuf;
+    FacePel *pDstLine = pDstBuf;
 
     for(Int j=0; j<iHeightDst; j++)
     {
@@ -2748,11 +3004,11 @@ Void TOctahedron::rotFlipFaceChannelGeneral(Pel *pSrcBuf, Int iWidthSrc, Int iHe
     iWidthDst  = iHeightSrc;
     iHeightDst = iWidthSrc;
 #if SVIDEO_MTK_MODIFIED_COHP1
-    Pel *pSrcLine  = pSrcBuf + (iHeightSrc - 1) * iStrideSrc;
-    Pel *pDstLine = pDstBuf;
+    FacePel *pSrcLine = pSrcBuf + (iHeightSrc - 1) * iStrideSrc;
+    FacePel *pDstLine = pDstBuf;
     for(Int j=0; j<iHeightDst; j++)
     {
-      Pel *pSrc = pSrcLine;
+      FacePel *pSrc = pSrcLine;
       for(Int i=0; i<iWidthDst; i++, pSrc -= iStrideSrc)
       {
         pDstLine[i] = *pSrc;
@@ -2761,11 +3017,11 @@ Void TOctahedron::rotFlipFaceChannelGeneral(Pel *pSrcBuf, Int iWidthSrc, Int iHe
       pSrcLine ++;
     }
 #else
-    Pel *pSrcLine  = pSrcBuf + iWidthSrc - 1;
-    Pel *pDstLine = pDstBuf;
+    FacePel *pSrcLine = pSrcBuf + iWidthSrc - 1;
+    FacePel *pDstLine = pDstBuf;
     for(Int j=0; j<iHeightDst; j++)
     {
-      Pel *pSrc = pSrcLine;
+      FacePel *pSrc = pSrcLine;
       for(Int i=0; i<iWidthDst; i++, pSrc += iStrideSrc)
       {
         pDstLine[i] = *pSrc;
@@ -2779,11 +3035,11 @@ Void TOctahedron::rotFlipFaceChannelGeneral(Pel *pSrcBuf, Int iWidthSrc, Int iHe
   {
     iWidthDst     = iWidthSrc;
     iHeightDst    = iHeightSrc;
-    Pel *pSrcLine = pSrcBuf + (iHeightSrc-1)*iStrideSrc + iWidthSrc - 1;
-    Pel *pDstLine = pDstBuf;
+    FacePel *pSrcLine = pSrcBuf + (iHeightSrc-1)*iStrideSrc + iWidthSrc - 1;
+    FacePel *pDstLine = pDstBuf;
     for(Int j=0; j<iHeightDst; j++)
     {
-      Pel *pSrc = pSrcLine;
+      FacePel *pSrc = pSrcLine;
       for(Int i=0; i<iWidthDst; i++, pSrc-- )
       {
         pDstLine[i] = *pSrc;
@@ -2797,11 +3053,11 @@ Void TOctahedron::rotFlipFaceChannelGeneral(Pel *pSrcBuf, Int iWidthSrc, Int iHe
     iWidthDst  = iHeightSrc;
     iHeightDst = iWidthSrc;
 #if SVIDEO_MTK_MODIFIED_COHP1
-    Pel *pSrcLine = pSrcBuf + iWidthSrc - 1;
-    Pel *pDstLine = pDstBuf;
+    FacePel *pSrcLine = pSrcBuf + iWidthSrc - 1;
+    FacePel *pDstLine = pDstBuf;
     for(Int j=0; j<iHeightDst; j++)
     {
-      Pel *pSrc = pSrcLine;
+      FacePel *pSrc = pSrcLine;
       for(Int i=0; i<iWidthDst; i++, pSrc += iStrideSrc)
       {
         pDstLine[i] = *pSrc;
@@ -2810,11 +3066,11 @@ Void TOctahedron::rotFlipFaceChannelGeneral(Pel *pSrcBuf, Int iWidthSrc, Int iHe
       pSrcLine --;
     }
 #else
-    Pel *pSrcLine = pSrcBuf + (iHeightSrc-1)*iStrideSrc;
-    Pel *pDstLine = pDstBuf;
+    FacePel *pSrcLine = pSrcBuf + (iHeightSrc-1)*iStrideSrc;
+    FacePel *pDstLine = pDstBuf;
     for(Int j=0; j<iHeightDst; j++)
     {
-      Pel *pSrc = pSrcLine;
+      FacePel *pSrc = pSrcLine;
       for(Int i=0; i<iWidthDst; i++, pSrc -= iStrideSrc)
       {
         pDstLine[i] = *pSrc;
@@ -2829,12 +3085,12 @@ Void TOctahedron::rotFlipFaceChannelGeneral(Pel *pSrcBuf, Int iWidthSrc, Int iHe
 
   if(eFaceFlipType == FACE_HOR_FLIP)
   {
-    Pel *pDstLine = pDstBuf;
+    FacePel *pDstLine = pDstBuf;
     for(Int j = 0; j < iHeightDst; j++)
     {
       for(Int i = 0; i <= (iWidthDst>>1)-1; i++)
       {
-        Pel tmp = pDstLine[i];
+        FacePel tmp = pDstLine[i];
         pDstLine[i] = pDstLine[iWidthDst-1-i];
         pDstLine[iWidthDst-1-i] = tmp;
       }
@@ -2843,12 +3099,12 @@ Void TOctahedron::rotFlipFaceChannelGeneral(Pel *pSrcBuf, Int iWidthSrc, Int iHe
   }
   else if(eFaceFlipType == FACE_VER_FLIP)
   {
-    Pel *pDstLine = pDstBuf;
+    FacePel *pDstLine = pDstBuf;
     for(Int i = 0; i < iWidthDst; i++)
     {
       for(Int j = 0; j <= (iHeightDst>>1)-1; j++)
       {
-        Pel tmp = pDstLine[j*iStrideDst];
+        FacePel tmp = pDstLine[j*iStrideDst];
         pDstLine[j*iStrideDst] = pDstLine[(iHeightDst-1-j)*iStrideDst];
         pDstLine[(iHeightDst-1-j)*iStrideDst] = tmp;
       }  
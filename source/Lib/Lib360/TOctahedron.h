@@ -46,6 +46,11 @@
 
 #if EXTENSION_360_VIDEO
 
+#if SVIDEO_POLYHEDRON_FACE_INDEX
+#define S_FACE_INDEX_GRID                                8      // cells per edge of each face of the cube the sphere is divided into
+#define S_FACE_INDEX_CELLS                               (6*S_FACE_INDEX_GRID*S_FACE_INDEX_GRID)
+#endif
+
 class TOctahedron : public TGeometry
 {
 private:
@@ -56,6 +61,19 @@ private:
 
 protected:
   TriMesh m_meshFaces[SV_MAX_NUM_FACES];
+#if SVIDEO_POLYHEDRON_FACE_INDEX
+  Int     m_iNumFaceCandidates[S_FACE_INDEX_CELLS];
+  UChar   m_faceCandidates[S_FACE_INDEX_CELLS][SV_MAX_NUM_FACES];    //[cell][i]: faces which may have the largest projection in the cell, in increasing order;
+
+  Void initFaceIndex();
+  Int  getFaceIndexCell(POSType x, POSType y, POSType z);
+#endif
+#if SVIDEO_TRIANGLE_SPAN_TABLE
+  Int    *m_pTriangleRowSpan[SV_MAX_NUM_FACES][MAX_NUM_COMPONENT];  //[face][ch][2*y]: first and last column inside the face;
+
+  Void initTriangleSpans(Int face, ComponentID chId);
+  Void getTriangleRowSpan(Int face, ComponentID chId, Int y, Int& iFirst, Int& iLast);
+#endif
   
   Void compactFramePackConvertYuvType1(PelUnitBuf *pSrcYuv);  //JVET-D0142;
   Void compactFramePackType1(PelUnitBuf *pDstYuv);            //JVET-D0142;
@@ -77,7 +95,11 @@ protected:
 #endif
 public:
   TOctahedron(SVideoInfo& sVideoInfo, InputGeoParam *pInGeoParam);
+#if SVIDEO_TRIANGLE_SPAN_TABLE
+  virtual ~TOctahedron();
+#else
   virtual ~TOctahedron() {};
+#endif
 
   virtual Void clamp(IPos *pIPos);
   virtual Void map2DTo3D(SPos& IPosIn, SPos *pSPosOut); 
@@ -88,8 +110,9 @@ public:
 
   virtual Void compactFramePackConvertYuv(PelUnitBuf *pSrcYuv);
   virtual Void compactFramePack(PelUnitBuf *pDstYuv);
-  Void         rotFlipFaceChannelGeneral(Pel *pSrc, Int iWidthSrc, Int iHeightSrc, Int iStrideSrc, Pel *pDst, Int iStrideDst, Int rot, Bool bInverse, FaceFlipType eFaceFlipType);
-  Void         triangleFaceCopy(Int iFaceWidth, Int iFaceHeight, Pel *pSrcBuf, Int iStartHorPos, Int iEndHorPos, Int iStartVerPos, Int iEndVerPos, Int iStrideSrc, Pel *pDstBuf, Int iStrideDst, ComponentID chId, Int rot, FaceFlipType eFaceFlipType, Int face, Int iBDAdjust, Int iMaxBD);
+  Void         rotFlipFaceChannelGeneral(FacePel *pSrc, Int iWidthSrc, Int iHeightSrc, Int iStrideSrc, FacePel *pDst, Int iStrideDst, Int rot, Bool bInverse, FaceFlipType eFaceFlipType);
+  template<typename TS, typename TD>
+  Void         triangleFaceCopy(Int iFaceWidth, Int iFaceHeight, TS *pSrcBuf, Int iStartHorPos, Int iEndHorPos, Int iStartVerPos, Int iEndVerPos, Int iStrideSrc, TD *pDstBuf, Int iStrideDst, ComponentID chId, Int rot, FaceFlipType eFaceFlipType, Int face, Int iBDAdjust, Int iMaxBD);
   virtual Void geoToFramePack(IPos* posIn, IPos2D* posOut);
 };
 
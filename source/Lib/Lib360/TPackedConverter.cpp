@@ -0,0 +1,489 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TPackedConverter.cpp
+    \brief    Conversion from a frame packed picture to another in one pass over the destination samples
+*/
+
+#include "TPackedConverter.h"
+#include <algorithm>
+
+#if SVIDEO_FUSED_PACKED_CONVERSION
+TPackedConverter::TPackedConverter()
+: m_pcGeoSrc(nullptr)
+, m_pcGeoDst(nullptr)
+, m_bRec(false)
+, m_iNumMaps(0)
+, m_iPadFaceSize(0)
+{
+  memset(m_iSrcStride, 0, sizeof(m_iSrcStride));
+  memset(m_iDstStride, 0, sizeof(m_iDstStride));
+}
+
+TPackedConverter::~TPackedConverter()
+{
+  destroy();
+}
+
+Void TPackedConverter::destroy()
+{
+  for(Int i=0; i<2; i++)
+  {
+    std::vector<FusedPxlLut>().swap(m_lut[i]);
+    std::vector<FusedPxlLut>().swap(m_padLut[i]);
+    std::vector<Int>().swap(m_taps[i]);
+    std::vector<Int>().swap(m_emptyPos[i]);
+    m_iSrcStride[i] = m_iDstStride[i] = 0;
+  }
+  for(Int ch=0; ch<MAX_NUM_COMPONENT; ch++)
+  {
+    std::vector<Pel>().swap(m_padded[ch]);
+  }
+  m_pcGeoSrc = m_pcGeoDst = nullptr;
+  m_iNumMaps = 0;
+}
+
+//the faces are rectangles copied to the frame packed picture without resampling, and the margins are padded
+//either by TEquiRect::spherePadding() or by TGeometry::spherePadding();
+Bool TPackedConverter::xIsPlainGeometry(TGeometry *pcGeo)
+{
+  SVideoInfo *pVideoInfo = pcGeo->getSVideoInfo();
+  if(pcGeo->m_chromaFormatIDC != pVideoInfo->framePackStruct.chromaFormatIDC)
+    return false;
+#if !SVIDEO_CHROMA_TYPES_SUPPORT
+  if(pcGeo->m_chromaFormatIDC == CHROMA_420 && pcGeo->m_bResampleChroma)
+    return false;
+#endif
+  switch(pVideoInfo->geoType)
+  {
+  case SVIDEO_EQUIRECT:
+#if SVIDEO_ERP_PADDING
+    return !pVideoInfo->bPERP;
+#else
+    return true;
+#endif
+  case SVIDEO_CUBEMAP:
+#if SVIDEO_ADJUSTED_CUBEMAP
+  case SVIDEO_ADJUSTEDCUBEMAP:
+#endif
+#if SVIDEO_EQUIANGULAR_CUBEMAP
+  case SVIDEO_EQUIANGULARCUBEMAP:
+#endif
+    return true;
+  default:
+    return false;
+  }
+}
+
+Bool TPackedConverter::isSupported(TGeometry *pcGeoSrc, TGeometry *pcGeoDst)
+{
+  if(!xIsPlainGeometry(pcGeoSrc) || !xIsPlainGeometry(pcGeoDst))
+    return false;
+  //the tables of both geometries are shared by the same channels;
+  if(pcGeoSrc->m_chromaFormatIDC != pcGeoDst->m_chromaFormatIDC
+     || pcGeoSrc->m_InterpolationType[0] != pcGeoDst->m_InterpolationType[0]
+     || pcGeoSrc->m_InterpolationType[1] != pcGeoDst->m_InterpolationType[1])
+    return false;
+  //the rotation of the source ERP picture is undone before convertYuv();
+  if(pcGeoSrc->getSVideoInfo()->geoType == SVIDEO_EQUIRECT && pcGeoSrc->getSVideoInfo()->framePackStruct.faces[0][0].rot)
+    return false;
+  return !pcGeoDst->m_bConvOutputPaddingNeeded;
+}
+
+Void TPackedConverter::init(TGeometry *pcGeoSrc, TGeometry *pcGeoDst, Bool bRec)
+{
+  CHECK(!isSupported(pcGeoSrc, pcGeoDst), "The geometries are not supported by the fused conversion");
+  destroy();
+  m_pcGeoSrc = pcGeoSrc;
+  m_pcGeoDst = pcGeoDst;
+  m_bRec     = bRec;
+  m_iNumMaps = (pcGeoDst->m_chromaFormatIDC == CHROMA_400
+                || (pcGeoDst->m_chromaFormatIDC == CHROMA_444 && pcGeoDst->m_InterpolationType[0] == pcGeoDst->m_InterpolationType[1]))
+                 ? 1
+                 : 2;
+  //the tables depend on the strides of the pictures and are built by the first convert();
+}
+
+//the frame packing of a face is a rotation and/or a flip, the offset in the picture is linear in the face position;
+Void TPackedConverter::xInitFaceLayout(TGeometry *pcGeo, Int iMap, Int iStride, Int *pOrigin, Int *pStepX, Int *pStepY)
+{
+  ComponentID chId    = (ComponentID)iMap;
+  Int         iScaleX = pcGeo->getComponentScaleX(chId);
+  Int         iScaleY = pcGeo->getComponentScaleY(chId);
+
+  for(Int face=0; face<pcGeo->getSVideoInfo()->iNumFaces; face++)
+  {
+    IPos   pos(face, 0, 0);
+    IPos2D pos00, pos10, pos01;
+    pcGeo->geoToFramePack(&pos, &pos00);
+    pos.u = (1 << iScaleX);
+    pcGeo->geoToFramePack(&pos, &pos10);
+    pos.u = 0;
+    pos.v = (1 << iScaleY);
+    pcGeo->geoToFramePack(&pos, &pos01);
+    pOrigin[face] = (pos00.y >> iScaleY)*iStride + (pos00.x >> iScaleX);
+    pStepX[face]  = ((pos10.y >> iScaleY) - (pos00.y >> iScaleY))*iStride + (pos10.x >> iScaleX) - (pos00.x >> iScaleX);
+    pStepY[face]  = ((pos01.y >> iScaleY) - (pos00.y >> iScaleY))*iStride + (pos01.x >> iScaleX) - (pos00.x >> iScaleX);
+  }
+}
+
+//returns the offset of the sample in the source picture, or -1-(index of the padded sample) for a margin sample;
+Int TPackedConverter::xResolveTap(Int iMap, Int iFace, Int u, Int v)
+{
+  ComponentID chId    = (ComponentID)iMap;
+  Int         iWidth  = m_pcGeoSrc->getSVideoInfo()->iFaceWidth >> m_pcGeoSrc->getComponentScaleX(chId);
+  Int         iHeight = m_pcGeoSrc->getSVideoInfo()->iFaceHeight >> m_pcGeoSrc->getComponentScaleY(chId);
+
+  if(m_pcGeoSrc->getSVideoInfo()->geoType == SVIDEO_EQUIRECT)
+  {
+    //same as TEquiRect::spherePadding(): the top and bottom margins are the rows mirrored at the poles shifted by half
+    //of the width, and the left and right margins wrap around;
+    if(v < 0)
+    {
+      v = -1 - v;
+      u += (iWidth >> 1);
+    }
+    else if(v >= iHeight)
+    {
+      v = (iHeight << 1) - 1 - v;
+      u += (iWidth >> 1);
+    }
+    u = ((u % iWidth) + iWidth) % iWidth;
+  }
+  if(u >= 0 && u < iWidth && v >= 0 && v < iHeight)
+  {
+    return m_iSrcOrigin[iMap][iFace] + u*m_iSrcStepX[iMap][iFace] + v*m_iSrcStepY[iMap][iFace];
+  }
+
+  Int  iStride = m_pcGeoSrc->getStride(chId);
+  Int  iPadPos = (v + m_pcGeoSrc->getMarginY(chId))*iStride + u + m_pcGeoSrc->getMarginX(chId);
+  Int &iPadIdx = m_padIdx[iFace][iPadPos];
+  if(iPadIdx < 0)
+  {
+    //the taps of the padded sample are resolved by xResolvePadding();
+    FusedPxlLut entry;
+    entry.iDstPos   = iFace*m_iPadFaceSize + iPadPos;
+    entry.iSrcPos   = -1;
+    entry.weightIdx = 0;
+    entry.iSrcFace  = -1;
+    iPadIdx = (Int)m_padLut[iMap].size();
+    m_padLut[iMap].push_back(entry);
+  }
+  return -1 - iPadIdx;
+}
+
+Void TPackedConverter::xResolveWindow(Int iMap, PxlFltLut &wList, std::vector<Int> &taps)
+{
+  ComponentID chId     = (ComponentID)iMap;
+  ChannelType chType   = toChannelType(chId);
+  Int         iTapsH   = m_pcGeoSrc->m_iInterpFilterTaps[chType][0];
+  Int         iTapsV   = m_pcGeoSrc->m_iInterpFilterTaps[chType][1];
+  Int         iStride  = m_pcGeoSrc->getStride(chId);
+  Int         nMarginX = m_pcGeoSrc->getMarginX(chId);
+  Int         nMarginY = m_pcGeoSrc->getMarginY(chId);
+  Int         face     = wList.facePos & ((1 << m_pcGeoSrc->m_WeightMap_NumOfBits4Faces) - 1);
+  Int         iPos     = (wList.facePos >> m_pcGeoSrc->m_WeightMap_NumOfBits4Faces) + nMarginY*iStride + nMarginX;
+  Int         u0       = iPos % iStride - nMarginX - ((iTapsH - 1) >> 1);
+  Int         v0       = iPos / iStride - nMarginY - ((iTapsV - 1) >> 1);
+  Int         iWLutIdx = (m_pcGeoSrc->m_chromaFormatIDC == CHROMA_400 || (m_pcGeoSrc->m_InterpolationType[0] == m_pcGeoSrc->m_InterpolationType[1])) ? 0 : chType;
+  Int        *pWLut    = m_pcGeoSrc->m_pWeightLut[iWLutIdx][wList.weightIdx];
+
+  for(Int m=0; m<iTapsV; m++)
+  {
+    for(Int n=0; n<iTapsH; n++)
+    {
+      //a tap of zero weight is not resolved, any sample will do;
+      taps.push_back(pWLut[m*iTapsH + n] ? xResolveTap(iMap, face, u0 + n, v0 + m) : 0);
+    }
+  }
+}
+
+//spherePadding() pads the margins in place, face by face in raster scan order, and a tap on a margin sample which is
+//not padded yet reads it as padded for the previous picture; the padded samples are sorted in that order, so that
+//convert() reads the same values from its buffer of the padded samples;
+Void TPackedConverter::xResolvePadding(Int iMap)
+{
+  ComponentID chId     = (ComponentID)iMap;
+  Int         iStride  = m_pcGeoSrc->getStride(chId);
+  Int         nMarginX = m_pcGeoSrc->getMarginX(chId);
+  Int         nMarginY = m_pcGeoSrc->getMarginY(chId);
+  std::vector<FusedPxlLut> &padLut = m_padLut[iMap];
+  std::vector<Int>          taps;
+
+  //the padded samples the taps read are appended to the table while it is resolved;
+  for(Int k=0; k<(Int)padLut.size(); k++)
+  {
+    Int iFace   = padLut[k].iDstPos / m_iPadFaceSize;
+    Int iPadPos = padLut[k].iDstPos % m_iPadFaceSize;
+    Int iLutIdx;
+    m_pcGeoSrc->getSPLutIdx(iMap, iPadPos % iStride - nMarginX, iPadPos / iStride - nMarginY, iLutIdx);
+    PxlFltLut &wList = m_pcGeoSrc->m_pPixelWeight4SherePadding[iFace][iMap][iLutIdx];
+    taps.clear();
+    xResolveWindow(iMap, wList, taps);
+    padLut[k].iSrcPos   = (Int)m_taps[iMap].size();
+    padLut[k].weightIdx = wList.weightIdx;
+    m_taps[iMap].insert(m_taps[iMap].end(), taps.begin(), taps.end());
+  }
+
+  std::vector<std::pair<Int, Int> > order(padLut.size());
+  for(Int k=0; k<(Int)padLut.size(); k++)
+  {
+    order[k] = std::make_pair(padLut[k].iDstPos, k);
+  }
+  std::sort(order.begin(), order.end());
+  std::vector<Int>         newIdx(padLut.size());
+  std::vector<FusedPxlLut> sorted(padLut.size());
+  for(Int k=0; k<(Int)order.size(); k++)
+  {
+    newIdx[order[k].second] = k;
+    sorted[k]               = padLut[order[k].second];
+    sorted[k].iDstPos       = k;
+  }
+  padLut.swap(sorted);
+  for(Int k=0; k<(Int)m_taps[iMap].size(); k++)
+  {
+    if(m_taps[iMap][k] < 0)
+      m_taps[iMap][k] = -1 - newIdx[-1 - m_taps[iMap][k]];
+  }
+}
+
+Void TPackedConverter::xBuildLut(Int iMap)
+{
+  ComponentID chId  = (ComponentID)iMap;
+  ChannelType chType = toChannelType(chId);
+  TGeometry  *pcSrc = m_pcGeoSrc;
+  TGeometry  *pcDst = m_pcGeoDst;
+
+  m_lut[iMap].clear();
+  m_padLut[iMap].clear();
+  m_taps[iMap].clear();
+  m_emptyPos[iMap].clear();
+
+  if(!pcDst->m_bGeometryMapping)
+#if SVIDEO_ROT_FIX
+    pcDst->geometryMapping(pcSrc, m_bRec);
+#else
+    pcDst->geometryMapping(pcSrc);
+#endif
+  if(pcSrc->getSVideoInfo()->geoType != SVIDEO_EQUIRECT)
+  {
+    if(!pcSrc->m_bGeometryMapping4SpherePadding)
+      pcSrc->geometryMapping4SpherePadding();
+    Int iHeightPW = (pcSrc->getSVideoInfo()->iFaceHeight + (pcSrc->m_iMarginY << 1)) >> pcSrc->getComponentScaleY(chId);
+    m_iPadFaceSize = pcSrc->getStride(chId)*iHeightPW;
+    for(Int face=0; face<pcSrc->getSVideoInfo()->iNumFaces; face++)
+    {
+      m_padIdx[face].assign(m_iPadFaceSize, -1);
+    }
+  }
+
+  Int iDstOrigin[SV_MAX_NUM_FACES], iDstStepX[SV_MAX_NUM_FACES], iDstStepY[SV_MAX_NUM_FACES];
+  xInitFaceLayout(pcSrc, iMap, m_iSrcStride[iMap], m_iSrcOrigin[iMap], m_iSrcStepX[iMap], m_iSrcStepY[iMap]);
+  xInitFaceLayout(pcDst, iMap, m_iDstStride[iMap], iDstOrigin, iDstStepX, iDstStepY);
+
+  Int iTapsH        = pcSrc->m_iInterpFilterTaps[chType][0];
+  Int iTapsV        = pcSrc->m_iInterpFilterTaps[chType][1];
+  Int iSrcWidth     = pcSrc->getSVideoInfo()->iFaceWidth >> pcSrc->getComponentScaleX(chId);
+  Int iSrcHeight    = pcSrc->getSVideoInfo()->iFaceHeight >> pcSrc->getComponentScaleY(chId);
+  Int iSrcStride    = pcSrc->getStride(chId);
+  Int nSrcMarginX   = pcSrc->getMarginX(chId);
+  Int nSrcMarginY   = pcSrc->getMarginY(chId);
+  Int iFaceMask     = (1 << pcSrc->m_WeightMap_NumOfBits4Faces) - 1;
+  Int nWidth        = pcDst->getSVideoInfo()->iFaceWidth >> pcDst->getComponentScaleX(chId);
+  Int nHeight       = pcDst->getSVideoInfo()->iFaceHeight >> pcDst->getComponentScaleY(chId);
+  Int nMarginX      = pcDst->getMarginX(chId);
+  Int nMarginY      = pcDst->getMarginY(chId);
+#if !SVIDEO_SEPARABLE_CUBE_MAPPING
+  Int iWidthPW      = pcDst->getStride(chId);
+#endif
+  std::vector<Int> taps;
+
+  m_lut[iMap].reserve(pcDst->getSVideoInfo()->iNumFaces*nWidth*nHeight);
+  for(Int fIdx=0; fIdx<pcDst->getSVideoInfo()->iNumFaces; fIdx++)
+  {
+    for(Int j=0; j<nHeight; j++)
+      for(Int i=0; i<nWidth; i++)
+      {
+        Int iDstPos = iDstOrigin[fIdx] + i*iDstStepX[fIdx] + j*iDstStepY[fIdx];
+        if(!pcDst->insideFace(fIdx, (i << pcDst->getComponentScaleX(chId)), (j << pcDst->getComponentScaleY(chId)), COMPONENT_Y, chId))
+        {
+          m_emptyPos[iMap].push_back(iDstPos);
+          continue;
+        }
+
+#if SVIDEO_SEPARABLE_CUBE_MAPPING
+        PxlFltLut   wList = pcDst->getPixelWeight(fIdx, iMap, i + nMarginX, j + nMarginY);
+#else
+        PxlFltLut  &wList = pcDst->m_pPixelWeight[fIdx][iMap][(j + nMarginY)*iWidthPW + i + nMarginX];
+#endif
+        Int         face  = wList.facePos & iFaceMask;
+        Int         iPos  = (wList.facePos >> pcSrc->m_WeightMap_NumOfBits4Faces) + nSrcMarginY*iSrcStride + nSrcMarginX;
+        Int         u0    = iPos % iSrcStride - nSrcMarginX - ((iTapsH - 1) >> 1);
+        Int         v0    = iPos / iSrcStride - nSrcMarginY - ((iTapsV - 1) >> 1);
+        FusedPxlLut entry;
+        entry.iDstPos   = iDstPos;
+        entry.weightIdx = wList.weightIdx;
+        if(u0 >= 0 && u0 + iTapsH <= iSrcWidth && v0 >= 0 && v0 + iTapsV <= iSrcHeight)
+        {
+          entry.iSrcFace = face;
+          entry.iSrcPos  = m_iSrcOrigin[iMap][face] + u0*m_iSrcStepX[iMap][face] + v0*m_iSrcStepY[iMap][face];
+        }
+        else
+        {
+          taps.clear();
+          xResolveWindow(iMap, wList, taps);
+          entry.iSrcFace = -1;
+          entry.iSrcPos  = (Int)m_taps[iMap].size();
+          m_taps[iMap].insert(m_taps[iMap].end(), taps.begin(), taps.end());
+        }
+        m_lut[iMap].push_back(entry);
+      }
+  }
+
+  //the regions of the frame packing without a face are filled as fillRegion() does;
+  SVideoInfo *pDstInfo = pcDst->getSVideoInfo();
+  for(Int face=pDstInfo->iNumFaces; face<pDstInfo->framePackStruct.rows*pDstInfo->framePackStruct.cols; face++)
+  {
+    Int rot     = pDstInfo->framePackStruct.faces[pcDst->m_facePos[face][0]][pcDst->m_facePos[face][1]].rot;
+    Int iWidth  = (rot == 90 || rot == 270) ? pDstInfo->iFaceHeight : pDstInfo->iFaceWidth;
+    Int iHeight = (rot == 90 || rot == 270) ? pDstInfo->iFaceWidth : pDstInfo->iFaceHeight;
+    Int iXC     = (pcDst->m_facePos[face][1]*pDstInfo->iFaceWidth) >> pcDst->getComponentScaleX(chId);
+    Int iYC     = (pcDst->m_facePos[face][0]*pDstInfo->iFaceHeight) >> pcDst->getComponentScaleY(chId);
+    for(Int j=0; j<(iHeight >> pcDst->getComponentScaleY(chId)); j++)
+      for(Int i=0; i<(iWidth >> pcDst->getComponentScaleX(chId)); i++)
+        m_emptyPos[iMap].push_back((iYC + j)*m_iDstStride[iMap] + iXC + i);
+  }
+
+  xResolvePadding(iMap);
+  for(Int face=0; face<SV_MAX_NUM_FACES; face++)
+  {
+    std::vector<Int>().swap(m_padIdx[face]);
+  }
+}
+
+Int TPackedConverter::xFilter(const Pel *pSrc, const Pel *pPadded, const FusedPxlLut &entry, Int iMap, Int *pWLut, Int iTapsH, Int iTapsV)
+{
+  Int sum = 0;
+  if(entry.iSrcFace >= 0)
+  {
+    Int        iStepX   = m_iSrcStepX[iMap][entry.iSrcFace];
+    Int        iStepY   = m_iSrcStepY[iMap][entry.iSrcFace];
+    const Pel *pPelLine = pSrc + entry.iSrcPos;
+    for(Int m=0; m<iTapsV; m++)
+    {
+      const Pel *pPel = pPelLine;
+      for(Int n=0; n<iTapsH; n++, pPel += iStepX)
+        sum += (*pPel) * pWLut[n];
+      pPelLine += iStepY;
+      pWLut += iTapsH;
+    }
+  }
+  else
+  {
+    const Int *pTap = &m_taps[iMap][entry.iSrcPos];
+    for(Int k=0; k<iTapsH*iTapsV; k++)
+      sum += (pTap[k] >= 0 ? pSrc[pTap[k]] : pPadded[-1 - pTap[k]]) * pWLut[k];
+  }
+  return sum;
+}
+
+Void TPackedConverter::convert(PelUnitBuf *pSrcYuv, PelUnitBuf *pDstYuv)
+{
+  CHECK(!m_pcGeoSrc, "The fused conversion is not initialized");
+  CHECK(pSrcYuv->chromaFormat != m_pcGeoSrc->m_chromaFormatIDC || pDstYuv->chromaFormat != m_pcGeoDst->m_chromaFormatIDC, "");
+  SVideoInfo *pSrcInfo = m_pcGeoSrc->getSVideoInfo();
+  CHECK(pSrcYuv->get(COMPONENT_Y).width != pSrcInfo->iFaceWidth*pSrcInfo->framePackStruct.cols
+        || pSrcYuv->get(COMPONENT_Y).height != pSrcInfo->iFaceHeight*pSrcInfo->framePackStruct.rows, "");
+
+  for(Int iMap=0; iMap<m_iNumMaps; iMap++)
+  {
+    ComponentID chId = (ComponentID)iMap;
+    if(pSrcYuv->get(chId).stride != m_iSrcStride[iMap] || pDstYuv->get(chId).stride != m_iDstStride[iMap])
+    {
+      m_iSrcStride[iMap] = pSrcYuv->get(chId).stride;
+      m_iDstStride[iMap] = pDstYuv->get(chId).stride;
+      xBuildLut(iMap);
+    }
+  }
+
+  Int iBDPrecision = S_INTERPOLATE_PrecisionBD;
+  Int iOffset      = 1 << (iBDPrecision - 1);
+  Int iBDAdjust    = m_pcGeoDst->m_nBitDepth - m_pcGeoDst->m_nOutputBitDepth;
+  CHECK(iBDAdjust < 0, "");
+  Int iOffsetBD    = iBDAdjust > 0 ? (1 << (iBDAdjust - 1)) : 0;
+  Pel emptyVal     = 1 << (m_pcGeoDst->m_nOutputBitDepth - 1);
+
+  for(Int ch=0; ch<m_pcGeoDst->getNumChannels(); ch++)
+  {
+    ComponentID chId   = (ComponentID)ch;
+    ChannelType chType = toChannelType(chId);
+    Int         iMap   = xGetMapIdx(ch);
+    CHECK(pSrcYuv->get(chId).stride != m_iSrcStride[iMap] || pDstYuv->get(chId).stride != m_iDstStride[iMap], "");
+    Int  iWLutIdx = (m_pcGeoSrc->m_chromaFormatIDC == CHROMA_400 || (m_pcGeoSrc->m_InterpolationType[0] == m_pcGeoSrc->m_InterpolationType[1])) ? 0 : chType;
+    Int **pWLut   = m_pcGeoSrc->m_pWeightLut[iWLutIdx];
+    Int  iTapsH   = m_pcGeoSrc->m_iInterpFilterTaps[chType][0];
+    Int  iTapsV   = m_pcGeoSrc->m_iInterpFilterTaps[chType][1];
+    const Pel *pSrc = pSrcYuv->get(chId).bufAt(0, 0);
+    Pel       *pDst = pDstYuv->get(chId).bufAt(0, 0);
+
+    //the padded samples are kept for the taps of the next picture on the samples padded after them;
+    m_padded[ch].resize(m_padLut[iMap].size());
+    Pel *pPadded = m_padded[ch].data();
+    for(Int k=0; k<(Int)m_padLut[iMap].size(); k++)
+    {
+      const FusedPxlLut &entry = m_padLut[iMap][k];
+      Int sum = xFilter(pSrc, pPadded, entry, iMap, pWLut[entry.weightIdx], iTapsH, iTapsV);
+      pPadded[entry.iDstPos] = ClipBD((sum + iOffset) >> iBDPrecision, m_pcGeoSrc->m_nBitDepth);
+    }
+
+    //geoConvert() and framePack() in one step, including their rounding;
+    for(Int k=0; k<(Int)m_lut[iMap].size(); k++)
+    {
+      const FusedPxlLut &entry = m_lut[iMap][k];
+      Int sum = xFilter(pSrc, pPadded, entry, iMap, pWLut[entry.weightIdx], iTapsH, iTapsV);
+#if SVIDEO_GEOCONVERT_CLIP
+      Pel val = ClipBD((sum + iOffset) >> iBDPrecision, m_pcGeoSrc->m_nBitDepth);
+#else
+      Pel val = (sum + iOffset) >> iBDPrecision;
+#endif
+      pDst[entry.iDstPos] = ClipBD((val + iOffsetBD) >> iBDAdjust, m_pcGeoDst->m_nOutputBitDepth);
+    }
+
+    for(Int k=0; k<(Int)m_emptyPos[iMap].size(); k++)
+    {
+      pDst[m_emptyPos[iMap][k]] = emptyVal;
+    }
+  }
+}
+#endif
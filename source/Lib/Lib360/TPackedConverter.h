@@ -0,0 +1,106 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TPackedConverter.h
+    \brief    Conversion from a frame packed picture to another in one pass over the destination samples (header)
+*/
+
+#ifndef __TPACKEDCONVERTER__
+#define __TPACKEDCONVERTER__
+#include "TGeometry.h"
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+#if SVIDEO_FUSED_PACKED_CONVERSION
+
+struct FusedPxlLut
+{
+  Int    iDstPos;          //offset in the destination frame packed picture, or index of the padded sample;
+  Int    iSrcPos;          //offset of the top-left tap in the source frame packed picture, or first tap in the tap list;
+  UShort weightIdx;
+  Short  iSrcFace;         //source face the taps are read from; -1: the taps are given by the tap list;
+};
+
+/* The mapping of the destination geometry and the frame packing of both geometries are folded into one table,
+   the samples of the destination frame packed picture are interpolated directly from the source frame packed picture;
+   a tap in a face margin of the source is replaced by the sample it is padded from (ERP) or by a padded sample which
+   is interpolated from the source picture first (cubemap family); the padded samples are interpolated in the order
+   spherePadding() pads the margins in place, so the results are identical to convertYuv(), geoConvert() and
+   framePack(), except for the margin samples read by the padding of the first picture before they are padded, which
+   are 0 here and as allocated there;
+   only the geometries whose internal chroma format is the one of the frame packed picture are supported;
+*/
+class TPackedConverter
+{
+private:
+  TGeometry               *m_pcGeoSrc;
+  TGeometry               *m_pcGeoDst;
+  Bool                     m_bRec;
+  Int                      m_iNumMaps;
+  Int                      m_iSrcStride[2];
+  Int                      m_iDstStride[2];
+  Int                      m_iSrcOrigin[2][SV_MAX_NUM_FACES];  //offset of sample (0, 0) of each face;
+  Int                      m_iSrcStepX[2][SV_MAX_NUM_FACES];   //offset between horizontally neighbouring samples of each face;
+  Int                      m_iSrcStepY[2][SV_MAX_NUM_FACES];
+  std::vector<FusedPxlLut> m_lut[2];                           //[map][destination sample];
+  std::vector<FusedPxlLut> m_padLut[2];                        //[map][padded sample], in the padding order of spherePadding();
+  std::vector<Int>         m_taps[2];                          //>=0: offset in the source picture; <0: -1-(index of the padded sample);
+  std::vector<Int>         m_emptyPos[2];                      //destination samples not covered by any face;
+  std::vector<Pel>         m_padded[MAX_NUM_COMPONENT];
+  std::vector<Int>         m_padIdx[SV_MAX_NUM_FACES];         //index of the padded sample of each margin sample, temporary;
+  Int                      m_iPadFaceSize;                     //margin samples are numbered in the padding order, face by face;
+
+  static Bool xIsPlainGeometry(TGeometry *pcGeo);
+  Int  xGetMapIdx(Int ch) { return (m_iNumMaps == 1 || !ch) ? 0 : 1; }
+  Void xInitFaceLayout(TGeometry *pcGeo, Int iMap, Int iStride, Int *pOrigin, Int *pStepX, Int *pStepY);
+  Int  xResolveTap(Int iMap, Int iFace, Int u, Int v);
+  Void xResolveWindow(Int iMap, PxlFltLut &wList, std::vector<Int> &taps);
+  Void xResolvePadding(Int iMap);
+  Void xBuildLut(Int iMap);
+  Int  xFilter(const Pel *pSrc, const Pel *pPadded, const FusedPxlLut &entry, Int iMap, Int *pWLut, Int iTapsH, Int iTapsV);
+
+public:
+  TPackedConverter();
+  virtual ~TPackedConverter();
+
+  static Bool isSupported(TGeometry *pcGeoSrc, TGeometry *pcGeoDst);
+  Void init(TGeometry *pcGeoSrc, TGeometry *pcGeoDst, Bool bRec=false);
+  Void destroy();
+  Void convert(PelUnitBuf *pSrcYuv, PelUnitBuf *pDstYuv);
+};
+
+#endif
+#endif // __TPACKEDCONVERTER__
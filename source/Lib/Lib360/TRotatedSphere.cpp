@@ -59,32 +59,32 @@ enum
  General purpose padding functions that should be somewhere else
  **************************************************************/
 
-static Void rot90(Pel *pSrcBuf, Int iStrideSrc, Int iWidth, Int iHeight, Int iNumSamples, Pel *pDst, Int iStrideDst)
+static Void rot90(FacePel *pSrcBuf, Int iStrideSrc, Int iWidth, Int iHeight, Int iNumSamples, FacePel *pDst, Int iStrideDst)
 {
-    Pel *pSrcCol = pSrcBuf + (iWidth-1)*iNumSamples;
+    FacePel *pSrcCol = pSrcBuf + (iWidth-1)*iNumSamples;
     for(Int j=0; j<iWidth; j++)
     {
-        Pel *pSrc = pSrcCol;
+        FacePel *pSrc = pSrcCol;
         for(Int i=0; i<iHeight; i++, pSrc+= iStrideSrc)
         {
-            memcpy(pDst+i*iNumSamples,  pSrc, iNumSamples*sizeof(Pel));
+            memcpy(pDst+i*iNumSamples,  pSrc, iNumSamples*sizeof(FacePel));
         }
         pDst += iStrideDst;
         pSrcCol -= iNumSamples;
     }
 }
 
-static Void sPad(Pel *pSrc0, Int iHStep0, Int iStrideSrc0, Pel* pSrc1, Int iHStep1, Int iStrideSrc1, Int iNumSamples, Int hCnt, Int vCnt)
+static Void sPad(FacePel *pSrc0, Int iHStep0, Int iStrideSrc0, FacePel* pSrc1, Int iHStep1, Int iStrideSrc1, Int iNumSamples, Int hCnt, Int vCnt)
 {
-    Pel *pSrc0Start = pSrc0 + iHStep0;
-    Pel *pSrc1Start = pSrc1 - iHStep1;
+    FacePel *pSrc0Start = pSrc0 + iHStep0;
+    FacePel *pSrc1Start = pSrc1 - iHStep1;
     
     for(Int j=0; j<vCnt; j++)
     {
         for(Int i=0; i<hCnt; i++)
         {
-            memcpy(pSrc0Start+i*iHStep0, pSrc1+i*iHStep1, iNumSamples*sizeof(Pel));
-            memcpy(pSrc1Start-i*iHStep1, pSrc0-i*iHStep0, iNumSamples*sizeof(Pel));
+            memcpy(pSrc0Start+i*iHStep0, pSrc1+i*iHStep1, iNumSamples*sizeof(FacePel));
+            memcpy(pSrc1Start-i*iHStep1, pSrc0-i*iHStep0, iNumSamples*sizeof(FacePel));
         }
         pSrc0 += iStrideSrc0;
         pSrc0Start += iStrideSrc0;
@@ -93,7 +93,7 @@ static Void sPad(Pel *pSrc0, Int iHStep0, Int iStrideSrc0, Pel* pSrc1, Int iHSte
     }
 }
 
-static Void cPad(Pel *pSrc, Int iWidth, Int iHeight, Int iStrideSrc, Int iNumSamples, Int hCnt, Int vCnt)
+static Void cPad(FacePel *pSrc, Int iWidth, Int iHeight, Int iStrideSrc, Int iNumSamples, Int hCnt, Int vCnt)
 {
     //top-left;
     rot90(pSrc-hCnt*iStrideSrc, iStrideSrc, vCnt, hCnt, iNumSamples, pSrc-vCnt*iStrideSrc-hCnt*iNumSamples, iStrideSrc);
@@ -105,7 +105,7 @@ static Void cPad(Pel *pSrc, Int iWidth, Int iHeight, Int iStrideSrc, Int iNumSam
     rot90(pSrc+iWidth*iNumSamples, iStrideSrc, vCnt, hCnt, iNumSamples, pSrc-vCnt*iStrideSrc+iWidth*iNumSamples, iStrideSrc);
 }
 
-static Void sPadH(Pel *pSrc, Pel *pDst, Int iCount, Int iVCnt, Int iStride)
+static Void sPadH(FacePel *pSrc, FacePel *pDst, Int iCount, Int iVCnt, Int iStride)
 {
     for (Int j = 0; j < iVCnt; j++)
     {
@@ -347,7 +347,7 @@ Void TRotatedSphere::convertYuv(PelUnitBuf *pSrcYuv)
                     Int iRot = m_sVideoInfo.framePackStruct.faces[m_facePos[faceIdx][0]][m_facePos[faceIdx][1]].rot;
                     Int iStrideSrc = pSrcYuv->get((ComponentID)(ch)).stride;
                     Pel *pSrc = pSrcYuv->get((ComponentID)ch).bufAt(0, 0) + faceY*iStrideSrc + faceX;
-                    Pel *pDst = m_pFacesOrig[faceIdx][ch];
+                    FacePel *pDst = m_pFacesOrig[faceIdx][ch];
                     rotFaceChannelGeneral(pSrc, nWidth, nHeight, pSrcYuv->get((ComponentID)ch).stride, 1, iRot, pDst, getStride((ComponentID)ch), 1, true);
                 }
                 continue;
@@ -359,14 +359,14 @@ Void TRotatedSphere::convertYuv(PelUnitBuf *pSrcYuv)
                 CHECK(m_pFacesBufTempOrig, "");
                 m_nMarginSizeBufTemp = std::max(m_filterUps[2].nTaps, m_filterUps[3].nTaps)>>1;;  //depends on the vertical upsampling filter;
                 m_nStrideBufTemp = nWidth + (m_nMarginSizeBufTemp<<1);
-                m_pFacesBufTemp = new Pel*[nFaces];
-                memset(m_pFacesBufTemp, 0, sizeof(Pel*)*nFaces);
-                m_pFacesBufTempOrig = new Pel*[nFaces];
-                memset(m_pFacesBufTempOrig, 0, sizeof(Pel*)*nFaces);
+                m_pFacesBufTemp = new FacePel*[nFaces];
+                memset(m_pFacesBufTemp, 0, sizeof(FacePel*)*nFaces);
+                m_pFacesBufTempOrig = new FacePel*[nFaces];
+                memset(m_pFacesBufTempOrig, 0, sizeof(FacePel*)*nFaces);
                 Int iTotalHeight = (nHeight +(m_nMarginSizeBufTemp<<1));
                 for(Int i=0; i<nFaces; i++)
                 {
-                    m_pFacesBufTemp[i] = (Pel *)xMalloc(Pel,  m_nStrideBufTemp*iTotalHeight);
+                    m_pFacesBufTemp[i] = (FacePel *)xMalloc(FacePel,  m_nStrideBufTemp*iTotalHeight);
                     m_pFacesBufTempOrig[i] = m_pFacesBufTemp[i] +  m_nStrideBufTemp * m_nMarginSizeBufTemp + m_nMarginSizeBufTemp;
                 }
             }
@@ -380,7 +380,7 @@ Void TRotatedSphere::convertYuv(PelUnitBuf *pSrcYuv)
                 
                 Int iStrideSrc = pSrcYuv->get((ComponentID)(ch)).stride;
                 Pel *pSrc = pSrcYuv->get((ComponentID)ch).bufAt(0, 0) + faceY*iStrideSrc + faceX;
-                Pel *pDst = m_pFacesBufTempOrig[faceIdx];
+                FacePel *pDst = m_pFacesBufTempOrig[faceIdx];
                 rotFaceChannelGeneral(pSrc, nWidth, nHeight, pSrcYuv->get((ComponentID)ch).stride, 1, iRot, pDst, m_nStrideBufTemp, 1, true);
             }
             
@@ -443,7 +443,7 @@ Void TRotatedSphere::convertYuv(PelUnitBuf *pSrcYuv)
                 {
                     Int iStrideSrc = pSrcYuv->get((ComponentID)(ch)).stride;
                     Pel *pSrc = pSrcYuv->get((ComponentID)ch).bufAt(0, 0) + faceY*iStrideSrc + faceX;
-                    Pel *pDst = m_pFacesOrig[faceIdx][ch];
+                    FacePel *pDst = m_pFacesOrig[faceIdx][ch];
                     rotFaceChannelGeneral(pSrc, nWidth, nHeight, pSrcYuv->get((ComponentID)ch).stride, 1, iRot, pDst, getStride((ComponentID)ch), 1, true);
                 }
             }
@@ -480,8 +480,8 @@ Void TRotatedSphere::spherePadding(Bool bEnforced)
         Int iStride = getStride(ComponentID(ch));
         
         //Equatorial area, face 2,3,4,5
-        Pel **pSrc = new Pel*[nFaces];
-        Pel **pDst = new Pel*[nFaces];
+        FacePel **pSrc = new FacePel*[nFaces];
+        FacePel **pDst = new FacePel*[nFaces];
         for (Int faceIdx = 0; faceIdx<nFaces; faceIdx++)
         {
             pSrc[faceIdx] = m_pFacesOrig[faceIdx][ch];
@@ -501,6 +501,45 @@ Void TRotatedSphere::spherePadding(Bool bEnforced)
     m_bPadded = true;
 }
 
+#if SVIDEO_VIEWPORT_DEPENDENCY_MAP
+//the left and right margins of the faces in a row copied by spherePadding();
+Bool TRotatedSphere::getPaddingCopySource(Int fIdx, Int x, Int y, ComponentID chId, Int &fIdxSrc, Int &xSrc, Int &ySrc)
+{
+  Int nWidth  = m_sVideoInfo.iFaceWidth >> getComponentScaleX(chId);
+  Int nHeight = m_sVideoInfo.iFaceHeight >> getComponentScaleY(chId);
+  if(y < 0 || y >= nHeight || (x >= 0 && x < nWidth))
+  {
+    return false;
+  }
+  if(x >= nWidth)
+  {
+    switch(fIdx)
+    {
+    case RSP_RIGHT_FACE:  fIdxSrc = RSP_FRONT_FACE; break;
+    case RSP_FRONT_FACE:  fIdxSrc = RSP_LEFT_FACE;  break;
+    case RSP_BOTTOM_FACE: fIdxSrc = RSP_BACK_FACE;  break;
+    case RSP_BACK_FACE:   fIdxSrc = RSP_TOP_FACE;   break;
+    default: return false;
+    }
+    xSrc = x - nWidth;
+  }
+  else
+  {
+    switch(fIdx)
+    {
+    case RSP_FRONT_FACE:  fIdxSrc = RSP_RIGHT_FACE;  break;
+    case RSP_LEFT_FACE:   fIdxSrc = RSP_FRONT_FACE;  break;
+    case RSP_BACK_FACE:   fIdxSrc = RSP_BOTTOM_FACE; break;
+    case RSP_TOP_FACE:    fIdxSrc = RSP_BACK_FACE;   break;
+    default: return false;
+    }
+    xSrc = x + nWidth;
+  }
+  ySrc = y;
+  return true;
+}
+#endif
+
 Void TRotatedSphere::framePack(PelUnitBuf *pDstYuv)
 {
     spherePadding();
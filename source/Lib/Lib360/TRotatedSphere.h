@@ -97,6 +97,12 @@ public:
   virtual Void framePack(PelUnitBuf *pDstYuv);
     
   virtual Void spherePadding(Bool bEnforced = false);
+#if SVIDEO_DEMAND_SPHERE_PADDING
+  virtual Bool isDemandPaddingSupported() { return false; }
+#endif
+#if SVIDEO_VIEWPORT_DEPENDENCY_MAP
+  virtual Bool getPaddingCopySource(Int fIdx, Int x, Int y, ComponentID chId, Int &fIdxSrc, Int &xSrc, Int &ySrc);
+#endif
     
   virtual Bool insideFace(Int fId, Int x, Int y, ComponentID chId, ComponentID origchId);
 };
@@ -44,6 +44,9 @@ TSPSNRIMetric::TSPSNRIMetric()
 , m_pCart2D(nullptr)
 , m_fpDTable(nullptr)
 , m_fpTable(nullptr)
+#if SVIDEO_SHARED_FRAME_CONTEXT
+, m_pcFrameContext(nullptr)
+#endif
 {
   m_dSPSNRI[0] = m_dSPSNRI[1] = m_dSPSNRI[2] = 0;
 }
@@ -203,6 +206,15 @@ Void TSPSNRIMetric::xCalculateSPSNRI( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcPic
 
   memset(m_dSPSNRI, 0, sizeof(Double)*3);
 
+#if SVIDEO_SHARED_FRAME_CONTEXT
+  if(m_pcFrameContext)
+  {
+    pcCodingGeometry  = m_pcFrameContext->getGeometry(m_OutputVideoInfo, &m_GeoParam, pcPicD);
+    pcRefGeometry     = m_pcFrameContext->getGeometry(m_RefVideoInfo, &m_GeoParam, pcOrgPicYuv);
+  }
+  else
+  {
+#endif
   pcCodingGeometry    = TGeometry::create(m_OutputVideoInfo, &m_GeoParam);
   pcRefGeometry       = TGeometry::create(m_RefVideoInfo, &m_GeoParam);
 
@@ -225,6 +237,9 @@ Void TSPSNRIMetric::xCalculateSPSNRI( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcPic
     pcRefGeometry->convertYuv(pcOrgPicYuv);
   }
   pcRefGeometry->spherePadding(true);
+#if SVIDEO_SHARED_FRAME_CONTEXT
+  }
+#endif
 
   for(Int chan=0; chan<getNumberValidComponents(pcPicD->chromaFormat); chan++)
   {
@@ -288,6 +303,10 @@ Void TSPSNRIMetric::xCalculateSPSNRI( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcPic
     m_dSPSNRI[ch_indx] = ( SSDspsnrI[ch_indx] ? 10.0 * log10( fReflpsnr / (Double)SSDspsnrI[ch_indx] ) : 999.99 );
   }
 
+#if SVIDEO_SHARED_FRAME_CONTEXT
+  if(m_pcFrameContext)
+    return;
+#endif
   if(pcCodingGeometry)
     delete pcCodingGeometry;
   if(pcRefGeometry)
@@ -38,6 +38,9 @@
 #ifndef __TSPSNRICALC__
 #define __TSPSNRICALC__
 #include "TGeometry.h"
+#if SVIDEO_SHARED_FRAME_CONTEXT
+#include "TSphereFrameContext.h"
+#endif
 
 // ====================================================================================================================
 // Class definition
@@ -68,6 +71,9 @@ private:
   Int        m_iRefWidth;
   Int        m_iRefHeight;
   //ChromaFormat  m_chromaFormatIDC;
+#if SVIDEO_SHARED_FRAME_CONTEXT
+  TSphereFrameContext *m_pcFrameContext;   //note: reference;
+#endif
 
 
 public:
@@ -85,6 +91,9 @@ public:
   Void    sphToCart(CPos2D*, CPos3D*);
   Void    createTable(PelUnitBuf* pcPicD, TGeometry *pcCodingGeomtry);
   Void    xCalculateSPSNRI( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcPicD );
+#if SVIDEO_SHARED_FRAME_CONTEXT
+  Void    setFrameContext(TSphereFrameContext *pcFrameContext) { m_pcFrameContext = pcFrameContext; }
+#endif
 
   Int     interpolate(POSType t) { return (Int)(t+ (t>=0? 0.5 :-0.5)); };
 };
@@ -314,6 +314,30 @@ Void TSegmentedSphere::spherePadding(Bool bEnforced)
     bFirstDumpBeforePading = false;
 #endif
 
+#if SVIDEO_SSP_CHROMA_MARGIN_FIX
+    //420 chroma: the padding of the top and bottom margins of the equatorial faces and the padding of the samples around
+    //the pole discs read each other; these are first filled with the nearest samples, so that none is read unwritten;
+    if (m_chromaFormatIDC == CHROMA_420)
+    {
+        for (Int ch = 1; ch < getNumChannels(); ch++)
+        {
+            ComponentID chId = (ComponentID)ch;
+            for (Int faceIdx = 0; faceIdx < m_sVideoInfo.iNumFaces; faceIdx++)
+            {
+                if (faceIdx < 2)
+                {
+                    sPadDisc(faceIdx, chId);
+                }
+                else
+                {
+                    sPadEdge(m_pFacesOrig[faceIdx][ch], m_sVideoInfo.iFaceWidth >> getComponentScaleX(chId), m_sVideoInfo.iFaceHeight >> getComponentScaleY(chId),
+                             getStride(chId), m_iMarginX >> getComponentScaleX(chId), m_iMarginY >> getComponentScaleY(chId), true);
+                }
+            }
+        }
+    }
+#endif
+
     TGeometry::spherePadding(bEnforced);
 
     Int nFaces = m_sVideoInfo.iNumFaces;
@@ -327,8 +351,8 @@ Void TSegmentedSphere::spherePadding(Bool bEnforced)
         Int iStride = getStride(ComponentID(ch));
 
         //Equatorial area, face 2,3,4,5
-        Pel **pSrc = new Pel*[nFaces];
-        Pel **pDst = new Pel*[nFaces];
+        FacePel **pSrc = new FacePel*[nFaces];
+        FacePel **pDst = new FacePel*[nFaces];
         for (Int faceIdx = 0; faceIdx<nFaces; faceIdx++)
         {
             pSrc[faceIdx] = m_pFacesOrig[faceIdx][ch];
@@ -353,7 +377,7 @@ Void TSegmentedSphere::spherePadding(Bool bEnforced)
 #endif
 }
 
-Void TSegmentedSphere::sPadH(Pel *pSrc, Pel *pDst, Int iCount, Int iVCnt, Int iStride)
+Void TSegmentedSphere::sPadH(FacePel *pSrc, FacePel *pDst, Int iCount, Int iVCnt, Int iStride)
 {
     for (Int j = 0; j < iVCnt; j++)
     {
@@ -366,6 +390,92 @@ Void TSegmentedSphere::sPadH(Pel *pSrc, Pel *pDst, Int iCount, Int iVCnt, Int iS
         pDst += iStride;
     }
 }
+
+#if SVIDEO_VIEWPORT_DEPENDENCY_MAP
+//the left and right margins of the equatorial faces 2..5 copied by spherePadding();
+Bool TSegmentedSphere::getPaddingCopySource(Int fIdx, Int x, Int y, ComponentID chId, Int &fIdxSrc, Int &xSrc, Int &ySrc)
+{
+    Int nWidth = m_sVideoInfo.iFaceWidth >> getComponentScaleX(chId);
+    Int nHeight = m_sVideoInfo.iFaceHeight >> getComponentScaleY(chId);
+    if (fIdx < 2 || fIdx > 5 || y < 0 || y >= nHeight || (x >= 0 && x < nWidth))
+    {
+        return false;
+    }
+    if (x >= nWidth)
+    {
+        fIdxSrc = (fIdx == 5) ? 2 : fIdx + 1;
+        xSrc = x - nWidth;
+    }
+    else
+    {
+        fIdxSrc = (fIdx == 2) ? 5 : fIdx - 1;
+        xSrc = x + nWidth;
+    }
+    ySrc = y;
+    return true;
+}
+#endif
+#endif
+
+#if SVIDEO_SSP_CHROMA_MARGIN_FIX
+//repeats the edge samples in the margins; the left and right margins are kept if bPadH is false;
+Void TSegmentedSphere::sPadEdge(FacePel *pSrc, Int iWidth, Int iHeight, Int iStride, Int iMarginX, Int iMarginY, Bool bPadH)
+{
+    if (bPadH)
+    {
+        for (Int j = 0; j < iHeight; j++)
+        {
+            FacePel *pRow = pSrc + j*iStride;
+            for (Int i = 1; i <= iMarginX; i++)
+            {
+                pRow[-i] = pRow[0];
+                pRow[iWidth - 1 + i] = pRow[iWidth - 1];
+            }
+        }
+    }
+    for (Int j = 1; j <= iMarginY; j++)
+    {
+        memcpy(pSrc - j*iStride - iMarginX, pSrc - iMarginX, (iWidth + (iMarginX << 1))*sizeof(FacePel));
+        memcpy(pSrc + (iHeight - 1 + j)*iStride - iMarginX, pSrc + (iHeight - 1)*iStride - iMarginX, (iWidth + (iMarginX << 1))*sizeof(FacePel));
+    }
+}
+
+//the samples of a pole face outside its disc repeat the nearest sample of the disc in their row, the rows without any
+//sample of the disc repeat the nearest row;
+Void TSegmentedSphere::sPadDisc(Int faceIdx, ComponentID chId)
+{
+    Int nWidth = m_sVideoInfo.iFaceWidth >> getComponentScaleX(chId);
+    Int nHeight = m_sVideoInfo.iFaceHeight >> getComponentScaleY(chId);
+    Int nMarginX = m_iMarginX >> getComponentScaleX(chId);
+    Int nMarginY = m_iMarginY >> getComponentScaleY(chId);
+    Int iStride = getStride(chId);
+    FacePel *pSrc = m_pFacesOrig[faceIdx][chId];
+    Int iFirstRow = -1, iLastRow = -1;
+
+    for (Int j = 0; j < nHeight; j++)
+    {
+        Int i0 = 0, i1 = nWidth - 1;
+        while (i0 <= i1 && !insideFace(faceIdx, i0 << getComponentScaleX(chId), j << getComponentScaleY(chId), COMPONENT_Y, chId))
+            i0++;
+        while (i1 >= i0 && !insideFace(faceIdx, i1 << getComponentScaleX(chId), j << getComponentScaleY(chId), COMPONENT_Y, chId))
+            i1--;
+        if (i0 > i1)
+            continue;
+        FacePel *pRow = pSrc + j*iStride;
+        for (Int i = -nMarginX; i < i0; i++)
+            pRow[i] = pRow[i0];
+        for (Int i = i1 + 1; i < nWidth + nMarginX; i++)
+            pRow[i] = pRow[i1];
+        iFirstRow = (iFirstRow < 0) ? j : iFirstRow;
+        iLastRow = j;
+    }
+    CHECK(iFirstRow < 0, "");
+    for (Int j = -nMarginY; j < nHeight + nMarginY; j++)
+    {
+        if (j < iFirstRow || j > iLastRow)
+            memcpy(pSrc + j*iStride - nMarginX, pSrc + ((j < iFirstRow) ? iFirstRow : iLastRow)*iStride - nMarginX, (nWidth + (nMarginX << 1))*sizeof(FacePel));
+    }
+}
 #endif
 
 #if SVIDEO_EAP_SSP_PADDING
@@ -461,6 +571,11 @@ Void TSegmentedSphere::geometryMapping4PolePadding()
       {
         pixelWeight4PolePadding[faceIdx][ch] = new PxlFltLut[nWidth*nHeight];
       }
+#if SVIDEO_SSP_POLE_CHROMA_LOCATION
+      Double chromaOffsetSrc[2] = { 0.0, 0.0 }; //[0: X; 1: Y];
+      Double chromaOffsetDst[2] = { 0.0, 0.0 }; //[0: X; 1: Y];
+      getFaceChromaOffset(chromaOffsetDst, faceIdx, chId);
+#endif
       
       for(Int j = 0; j < nHeight; j++)
       {
@@ -469,8 +584,13 @@ Void TSegmentedSphere::geometryMapping4PolePadding()
           if(!insidePadding(faceIdx, i<<getComponentScaleX(chId), j<<getComponentScaleY(chId), COMPONENT_Y, chId))
             continue;
 
+#if SVIDEO_SSP_POLE_CHROMA_LOCATION
+          POSType x = i * (1<<getComponentScaleX(chId)) + (POSType)(0.5 + chromaOffsetDst[0]);
+          POSType y = j * (1<<getComponentScaleY(chId)) + (POSType)(0.5 + chromaOffsetDst[1]);
+#else
           POSType x = i * (1<<getComponentScaleX(chId)) + (POSType)(0.5);
           POSType y = j * (1<<getComponentScaleY(chId)) + (POSType)(0.5);
+#endif
 
           POSType yaw, pitch;
           POSType pole_x = x - m_sVideoInfo.iFaceWidth / 2;
@@ -497,8 +617,14 @@ Void TSegmentedSphere::geometryMapping4PolePadding()
 
           map3DTo2D(&in, &pos3D);
           
+#if SVIDEO_SSP_POLE_CHROMA_LOCATION
+          getFaceChromaOffset(chromaOffsetSrc, pos3D.faceIdx, chId);
+          pos3D.x = (pos3D.x - chromaOffsetSrc[0]) / POSType(1<<getComponentScaleX(chId));
+          pos3D.y = (pos3D.y - chromaOffsetSrc[1]) / POSType(1<<getComponentScaleY(chId));
+#else
           pos3D.x /= (1<<getComponentScaleX(chId));
           pos3D.y /= (1<<getComponentScaleY(chId));
+#endif
           
           (this->*m_interpolateWeight[toChannelType(chId)])(chId, &pos3D, pixelWeight4PolePadding[faceIdx][ch][i+j*nWidth]);
         }
@@ -533,6 +659,10 @@ Void TSegmentedSphere::polePadding(PelUnitBuf *pDstYuv)
 
       Int mapIdx = (m_chromaFormatIDC==CHROMA_444 && m_InterpolationType[CHANNEL_TYPE_LUMA] == m_InterpolationType[CHANNEL_TYPE_CHROMA])? 0: (ch>0? 1: 0);
       ChannelType chType = toChannelType(chId);
+#if SVIDEO_SSP_POLE_CHROMA_LOCATION
+      Double chromaOffset[2] = { 0.0, 0.0 }; //[0: X; 1: Y];
+      getFaceChromaOffset(chromaOffset, faceIdx, chId);
+#endif
 
       Int offsetDstX = (m_facePos[faceIdx][1]*m_sVideoInfo.iFaceWidth) >> getComponentScaleX(chId);
       Int offsetDstY = (m_facePos[faceIdx][0]*m_sVideoInfo.iFaceHeight) >> getComponentScaleY(chId);
@@ -557,7 +687,7 @@ Void TSegmentedSphere::polePadding(PelUnitBuf *pDstYuv)
           Int iTLPos = (pPelWeight->facePos)>>m_WeightMap_NumOfBits4Faces;
           Int iWLutIdx = (m_chromaFormatIDC==CHROMA_400 || (m_InterpolationType[0]==m_InterpolationType[1]))? 0 : chType;
           Int *pWLut = m_pWeightLut[iWLutIdx][pPelWeight->weightIdx];
-          Pel *pPelLine = m_pFacesOrig[face][ch] +iTLPos -((m_iInterpFilterTaps[chType][1]-1)>>1)*getStride(chId) -((m_iInterpFilterTaps[chType][0]-1)>>1);
+          FacePel *pPelLine = m_pFacesOrig[face][ch] +iTLPos -((m_iInterpFilterTaps[chType][1]-1)>>1)*getStride(chId) -((m_iInterpFilterTaps[chType][0]-1)>>1);
           for(Int m=0; m<m_iInterpFilterTaps[chType][1]; m++)
           {
             for(Int n=0; n<m_iInterpFilterTaps[chType][0]; n++)
@@ -568,8 +698,13 @@ Void TSegmentedSphere::polePadding(PelUnitBuf *pDstYuv)
           
           pDstBuf[i+j*iStrideDst] = ClipBD((sum + iOffset)>>iBDPrecision, m_nBitDepth);
           
+#if SVIDEO_SSP_POLE_CHROMA_LOCATION
+          Double x_L = (i << getComponentScaleX(chId)) + 0.5 + chromaOffset[0] - radius;
+          Double y_L = (j << getComponentScaleY(chId)) + 0.5 + chromaOffset[1] - radius;
+#else
           Double x_L = (i << getComponentScaleX(chId)) + 0.5 - radius;
           Double y_L = (j << getComponentScaleY(chId)) + 0.5 - radius;
+#endif
 
           if(faceIdx == 1)
             y_L -= SVIDEO_SSP_GUARD_BAND;
@@ -649,7 +784,7 @@ Void TSegmentedSphere::framePack(PelUnitBuf *pDstYuv)
     if( !m_pDS420Buf && ((m_chromaFormatIDC == CHROMA_444) || (m_chromaFormatIDC == CHROMA_420 && m_bResampleChroma)) )
 #endif
     {
-      m_pDS420Buf = (Pel*)xMalloc(Pel, nHeightC*iStride420);
+      m_pDS420Buf = (FacePel*)xMalloc(FacePel, nHeightC*iStride420);
     }
     for(Int face=0; face<iTotalNumOfFaces; face++)
     {
@@ -672,8 +807,12 @@ Void TSegmentedSphere::framePack(PelUnitBuf *pDstYuv)
             ComponentID chId = (ComponentID)ch;
             Int xc = x >> ::getComponentScaleX(chId, pDstYuv->chromaFormat);
             Int yc = y >> ::getComponentScaleY(chId, pDstYuv->chromaFormat);
+#if SVIDEO_FUSED_CHROMA_RESAMPLING
+            chromaDonwsampleHV(m_pFacesOrig[face][ch], m_sVideoInfo.iFaceWidth, m_sVideoInfo.iFaceHeight, getStride(chId), m_pDS422Buf, iStride422, m_pDS420Buf, iStride420);
+#else
             chromaDonwsampleH(m_pFacesOrig[face][ch]-nMarginSize*getStride((ComponentID)ch), m_sVideoInfo.iFaceWidth, nHeightC422, getStride(chId), 1, m_pDS422Buf, iStride422);
             chromaDonwsampleV(m_pDS422Buf + nMarginSize*iStride422, nWidthC, m_sVideoInfo.iFaceHeight, iStride422, 1, m_pDS420Buf, iStride420);
+#endif
             rotOneFaceChannel(m_pDS420Buf, nWidthC, nHeightC, iStride420, 1, ch, rot, pDstYuv, xc, yc, face, 0);
           }
         }
@@ -804,7 +943,7 @@ Void TSegmentedSphere::convertYuv(PelUnitBuf *pSrcYuv)
           Int iRot = m_sVideoInfo.framePackStruct.faces[m_facePos[faceIdx][0]][m_facePos[faceIdx][1]].rot;
           Int iStrideSrc = pSrcYuv->get((ComponentID)(ch)).stride;
           Pel *pSrc = pSrcYuv->get((ComponentID)ch).bufAt(0, 0) + faceY*iStrideSrc + faceX;
-          Pel *pDst = m_pFacesOrig[faceIdx][ch];
+          FacePel *pDst = m_pFacesOrig[faceIdx][ch];
           rotFaceChannelGeneral(pSrc, nWidth, nHeight, pSrcYuv->get((ComponentID)ch).stride, 1, iRot, pDst, getStride((ComponentID)ch), 1, true);
         }
         continue;
@@ -816,14 +955,14 @@ Void TSegmentedSphere::convertYuv(PelUnitBuf *pSrcYuv)
         CHECK(m_pFacesBufTempOrig, "");
         m_nMarginSizeBufTemp = std::max(m_filterUps[2].nTaps, m_filterUps[3].nTaps)>>1;;  //depends on the vertical upsampling filter;
         m_nStrideBufTemp = nWidth + (m_nMarginSizeBufTemp<<1);
-        m_pFacesBufTemp = new Pel*[nFaces];
-        memset(m_pFacesBufTemp, 0, sizeof(Pel*)*nFaces);
-        m_pFacesBufTempOrig = new Pel*[nFaces];
-        memset(m_pFacesBufTempOrig, 0, sizeof(Pel*)*nFaces);
+        m_pFacesBufTemp = new FacePel*[nFaces];
+        memset(m_pFacesBufTemp, 0, sizeof(FacePel*)*nFaces);
+        m_pFacesBufTempOrig = new FacePel*[nFaces];
+        memset(m_pFacesBufTempOrig, 0, sizeof(FacePel*)*nFaces);
         Int iTotalHeight = (nHeight +(m_nMarginSizeBufTemp<<1));
         for(Int i=0; i<nFaces; i++)
         {
-          m_pFacesBufTemp[i] = (Pel *)xMalloc(Pel,  m_nStrideBufTemp*iTotalHeight);
+          m_pFacesBufTemp[i] = (FacePel *)xMalloc(FacePel,  m_nStrideBufTemp*iTotalHeight);
           m_pFacesBufTempOrig[i] = m_pFacesBufTemp[i] +  m_nStrideBufTemp * m_nMarginSizeBufTemp + m_nMarginSizeBufTemp;
         }
       }
@@ -843,9 +982,19 @@ Void TSegmentedSphere::convertYuv(PelUnitBuf *pSrcYuv)
 
         Int iStrideSrc = pSrcYuv->get((ComponentID)(ch)).stride;
         Pel *pSrc = pSrcYuv->get((ComponentID)ch).bufAt(0, 0) + faceY*iStrideSrc + faceX;
-        Pel *pDst = m_pFacesBufTempOrig[faceIdx];
+        FacePel *pDst = m_pFacesBufTempOrig[faceIdx];
         rotFaceChannelGeneral(pSrc, nWidth, nHeight, pSrcYuv->get((ComponentID)ch).stride, 1, iRot, pDst, m_nStrideBufTemp, 1, true);
       }
+#if SVIDEO_SSP_CHROMA_MARGIN_FIX
+
+      //padding; the equatorial faces are continuous horizontally, the other margins repeat the edge samples;
+      sPadH(m_pFacesBufTempOrig[3], m_pFacesBufTempOrig[2]+nWidth, m_nMarginSizeBufTemp, nHeight, m_nStrideBufTemp);
+      sPadH(m_pFacesBufTempOrig[4], m_pFacesBufTempOrig[3]+nWidth, m_nMarginSizeBufTemp, nHeight, m_nStrideBufTemp);
+      sPadH(m_pFacesBufTempOrig[5], m_pFacesBufTempOrig[4]+nWidth, m_nMarginSizeBufTemp, nHeight, m_nStrideBufTemp);
+      sPadH(m_pFacesBufTempOrig[2], m_pFacesBufTempOrig[5]+nWidth, m_nMarginSizeBufTemp, nHeight, m_nStrideBufTemp);
+      for(Int f=0; f<nFaces; f++)
+        sPadEdge(m_pFacesBufTempOrig[f], nWidth, nHeight, m_nStrideBufTemp, m_nMarginSizeBufTemp, m_nMarginSizeBufTemp, f < 2);
+#endif
 
 #if SVIDEO_CHROMA_TYPES_SUPPORT
       if(m_chromaFormatIDC == CHROMA_444)
@@ -886,7 +1035,7 @@ Void TSegmentedSphere::convertYuv(PelUnitBuf *pSrcYuv)
         {
           Int iStrideSrc = pSrcYuv->get((ComponentID)(ch)).stride;
           Pel *pSrc = pSrcYuv->get((ComponentID)ch).bufAt(0, 0) + faceY*iStrideSrc + faceX;
-          Pel *pDst = m_pFacesOrig[faceIdx][ch];
+          FacePel *pDst = m_pFacesOrig[faceIdx][ch];
           rotFaceChannelGeneral(pSrc, nWidth, nHeight, pSrcYuv->get((ComponentID)ch).stride, 1, iRot, pDst, getStride((ComponentID)ch), 1, true);
         }
       }
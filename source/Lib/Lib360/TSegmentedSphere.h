@@ -57,9 +57,22 @@ public:
     //virtual Void rot90(Pel *pSrcBuf, Int iStrideSrc, Int iWidth, Int iHeight, Int iNumSamples, Pel *pDst, Int iStrideDst);
     Int getRot(Int faceIdx);
 #endif
+#if SVIDEO_VIEWPORT_RENDERER
+    virtual Bool isFaceMaskSupported() { return false; }
+#endif
 #if SVIDEO_SSP_PADDING_FIX
     virtual Void spherePadding(Bool bEnforced=false);
-    Void sPadH(Pel *pSrc, Pel *pDst, Int iCount, Int iVCnt, Int iStride);
+#if SVIDEO_DEMAND_SPHERE_PADDING
+    virtual Bool isDemandPaddingSupported() { return false; }
+#endif
+#if SVIDEO_VIEWPORT_DEPENDENCY_MAP
+    virtual Bool getPaddingCopySource(Int fIdx, Int x, Int y, ComponentID chId, Int &fIdxSrc, Int &xSrc, Int &ySrc);
+#endif
+    Void sPadH(FacePel *pSrc, FacePel *pDst, Int iCount, Int iVCnt, Int iStride);
+#endif
+#if SVIDEO_SSP_CHROMA_MARGIN_FIX
+    Void sPadEdge(FacePel *pSrc, Int iWidth, Int iHeight, Int iStride, Int iMarginX, Int iMarginY, Bool bPadH);
+    Void sPadDisc(Int faceIdx, ComponentID chId);
 #endif
 #if SVIDEO_EAP_SSP_PADDING
     virtual Void framePack(PelUnitBuf *pDstYuv);
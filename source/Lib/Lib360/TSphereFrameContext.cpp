@@ -0,0 +1,158 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TSphereFrameContext.cpp
+    \brief    Per-picture cache of unpacked and padded geometries shared by the metric calculators
+*/
+
+#include "TSphereFrameContext.h"
+
+#if SVIDEO_SHARED_FRAME_CONTEXT
+
+TSphereFrameContext::TSphereFrameContext()
+: m_uiFrameIdx(0)
+{
+}
+
+TSphereFrameContext::~TSphereFrameContext()
+{
+  destroy();
+}
+
+Void TSphereFrameContext::destroy()
+{
+  for(Int i=0; i<(Int)m_entries.size(); i++)
+  {
+    if(m_entries[i].pcGeometry)
+    {
+      delete m_entries[i].pcGeometry;
+      m_entries[i].pcGeometry = nullptr;
+    }
+  }
+  m_entries.clear();
+}
+
+Bool TSphereFrameContext::xIsSameVideoInfo(const SVideoInfo& a, const SVideoInfo& b)
+{
+  Bool bSame = (a.geoType == b.geoType)
+            && (a.iFaceWidth == b.iFaceWidth) && (a.iFaceHeight == b.iFaceHeight)
+            && (a.iNumFaces == b.iNumFaces) && (a.iCompactFPStructure == b.iCompactFPStructure)
+            && (!memcmp(&a.framePackStruct, &b.framePackStruct, sizeof(SVideoFPStruct)))
+            && (!memcmp(&a.sVideoRotation, &b.sVideoRotation, sizeof(GeometryRotation)));
+#if SVIDEO_HEMI_PROJECTIONS
+  bSame = bSame && (a.hemiFlag == b.hemiFlag) && (a.bPCMP == b.bPCMP);
+#endif
+#if SVIDEO_ERP_PADDING
+  bSame = bSame && (a.bPERP == b.bPERP);
+#endif
+#if SVIDEO_SUB_SPHERE
+  bSame = bSame && (!memcmp(&a.subSphere, &b.subSphere, sizeof(SubSphereSettings)));
+#endif
+#if SVIDEO_FISHEYE
+  bSame = bSame && (!memcmp(&a.sFisheyeInfo, &b.sFisheyeInfo, sizeof(FisheyeInfo)));
+#endif
+#if SVIDEO_GENERALIZED_CUBEMAP
+  bSame = bSame && (a.iGCMPPackingType == b.iGCMPPackingType) && (a.iGCMPMappingType == b.iGCMPMappingType)
+                && (!memcmp(&a.GCMPSettings, &b.GCMPSettings, sizeof(GeneralizedCMPSettings)))
+                && (a.bPGCMP == b.bPGCMP) && (a.bPGCMPBoundary == b.bPGCMPBoundary) && (a.iPGCMPSize == b.iPGCMPSize);
+#if SVIDEO_GCMP_PADDING_TYPE
+  bSame = bSame && (a.iPGCMPPaddingType == b.iPGCMPPaddingType);
+#endif
+#endif
+  return bSame;
+}
+
+Bool TSphereFrameContext::xIsSameGeoParam(const InputGeoParam& a, const InputGeoParam& b)
+{
+  Bool bSame = (a.chromaFormat == b.chromaFormat)
+            && (a.nBitDepth == b.nBitDepth) && (a.nOutputBitDepth == b.nOutputBitDepth)
+            && (a.iInterp[CHANNEL_TYPE_LUMA] == b.iInterp[CHANNEL_TYPE_LUMA]) && (a.iInterp[CHANNEL_TYPE_CHROMA] == b.iInterp[CHANNEL_TYPE_CHROMA]);
+#if !SVIDEO_CHROMA_TYPES_SUPPORT
+  bSame = bSame && (a.bResampleChroma == b.bResampleChroma) && (a.iChromaSampleLocType == b.iChromaSampleLocType);
+#endif
+  return bSame;
+}
+
+/*********************************************************
+//return the geometry holding the unpacked and padded faces of pcPicYuv;
+//the conversion is done only once per picture for each distinct geometry;
+**********************************************************/
+TGeometry* TSphereFrameContext::getGeometry(SVideoInfo& sVideoInfo, InputGeoParam *pInGeoParam, PelUnitBuf *pcPicYuv)
+{
+#if SVIDEO_CONCURRENT_METRICS
+  std::unique_lock<std::mutex> lock(m_mutex);
+#endif
+  const Pel *pSrcAddr = pcPicYuv->get(COMPONENT_Y).buf;
+  FrameEntry *pEntry = nullptr;
+  for(Int i=0; i<(Int)m_entries.size(); i++)
+  {
+    if(m_entries[i].pSrcAddr == pSrcAddr && xIsSameVideoInfo(m_entries[i].sVideoInfo, sVideoInfo) && xIsSameGeoParam(m_entries[i].geoParam, *pInGeoParam))
+    {
+      pEntry = &m_entries[i];
+      break;
+    }
+  }
+  //reuse a geometry not yet used by the current picture (e.g. reconstructed pictures are held in different buffers);
+  for(Int i=0; !pEntry && i<(Int)m_entries.size(); i++)
+  {
+    if(m_entries[i].uiFrameIdx != m_uiFrameIdx && xIsSameVideoInfo(m_entries[i].sVideoInfo, sVideoInfo) && xIsSameGeoParam(m_entries[i].geoParam, *pInGeoParam))
+    {
+      pEntry = &m_entries[i];
+      pEntry->pSrcAddr = pSrcAddr;
+    }
+  }
+  if(!pEntry)
+  {
+    FrameEntry entry;
+    entry.sVideoInfo = sVideoInfo;
+    entry.geoParam   = *pInGeoParam;
+    entry.pSrcAddr   = pSrcAddr;
+    entry.uiFrameIdx = m_uiFrameIdx-1;
+    entry.pcGeometry = TGeometry::create(sVideoInfo, pInGeoParam);
+    m_entries.push_back(entry);
+    pEntry = &m_entries.back();
+  }
+
+  if(pEntry->uiFrameIdx != m_uiFrameIdx)
+  {
+    TGeometry *pcGeometry = pEntry->pcGeometry;
+    if((pcGeometry->getType() == SVIDEO_OCTAHEDRON || pcGeometry->getType() == SVIDEO_ICOSAHEDRON) && pcGeometry->getSVideoInfo()->iCompactFPStructure)
+      pcGeometry->compactFramePackConvertYuv(pcPicYuv);
+    else
+      pcGeometry->convertYuv(pcPicYuv);
+    pcGeometry->spherePadding(true);
+    pEntry->uiFrameIdx = m_uiFrameIdx;
+  }
+  return pEntry->pcGeometry;
+}
+#endif
@@ -0,0 +1,82 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TSphereFrameContext.h
+    \brief    Per-picture cache of unpacked and padded geometries shared by the metric calculators (header)
+*/
+
+#ifndef __TSPHEREFRAMECONTEXT__
+#define __TSPHEREFRAMECONTEXT__
+#include "TGeometry.h"
+#if SVIDEO_CONCURRENT_METRICS
+#include <mutex>
+#endif
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+#if SVIDEO_SHARED_FRAME_CONTEXT
+
+class TSphereFrameContext
+{
+private:
+  struct FrameEntry
+  {
+    SVideoInfo    sVideoInfo;
+    InputGeoParam geoParam;
+    const Pel    *pSrcAddr;        //identity of the frame packed picture;
+    UInt          uiFrameIdx;      //picture the faces were converted from;
+    TGeometry    *pcGeometry;
+  };
+  std::vector<FrameEntry> m_entries;
+  UInt                    m_uiFrameIdx;
+#if SVIDEO_CONCURRENT_METRICS
+  std::mutex              m_mutex;               //getGeometry() may be called by the metric tasks concurrently;
+#endif
+
+  Bool xIsSameVideoInfo(const SVideoInfo& a, const SVideoInfo& b);
+  Bool xIsSameGeoParam(const InputGeoParam& a, const InputGeoParam& b);
+
+public:
+  TSphereFrameContext();
+  virtual ~TSphereFrameContext();
+
+  Void       newFrame() { m_uiFrameIdx++; }       //invalidate all faces; must be called once the source pictures are changed;
+  Void       destroy();
+  TGeometry* getGeometry(SVideoInfo& sVideoInfo, InputGeoParam *pInGeoParam, PelUnitBuf *pcPicYuv);
+  Int        getNumGeometries() { return (Int)m_entries.size(); }
+};
+
+#endif
+#endif // __TSPHEREFRAMECONTEXT__
@@ -0,0 +1,484 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TTraceViewPortPSNR.cpp
+    \brief    Viewport PSNR along the recorded head motion traces of many users
+*/
+
+#include <math.h>
+#include <map>
+#include <thread>
+#include "TTraceViewPortPSNR.h"
+
+#if SVIDEO_TRACE_VIEWPORT_PSNR
+TTraceViewPortPSNR::TTraceViewPortPSNR()
+: m_bEnabled(false)
+, m_iNumUsers(0)
+, m_iNumTraceFrames(0)
+, m_fHFOV(0)
+, m_fVFOV(0)
+, m_fStep(0)
+, m_iViewPortWidth(0)
+, m_iViewPortHeight(0)
+, m_iNumThreads(1)
+, m_iNumFrameSkipped(0)
+, m_temporalSubsampleRatio(1)
+, m_iViewPortBitDepth(0)
+, m_iRefBitDepth(0)
+, m_pRefGeometry(nullptr)
+, m_pRecGeometry(nullptr)
+, m_iNumDistinct(0)
+, m_uiNumPics(0)
+, m_dNumDistinctSum(0)
+#if SVIDEO_SHARED_FRAME_CONTEXT
+, m_pcFrameContext(nullptr)
+#endif
+{
+  memset(m_dPSNR, 0, sizeof(m_dPSNR));
+  memset(m_dWorstPSNR, 0, sizeof(m_dWorstPSNR));
+}
+
+TTraceViewPortPSNR::~TTraceViewPortPSNR()
+{
+  destroy();
+}
+
+Void TTraceViewPortPSNR::destroy()
+{
+  if(m_cTraceFile.is_open())
+  {
+    m_cTraceFile.close();
+  }
+  if(m_pRefGeometry)
+  {
+    delete m_pRefGeometry;
+    m_pRefGeometry = nullptr;
+  }
+  if(m_pRecGeometry)
+  {
+    delete m_pRecGeometry;
+    m_pRecGeometry = nullptr;
+  }
+  for(Int i=0; i<(Int)m_refViewPorts.size(); i++)
+  {
+    delete m_refViewPorts[i];
+    delete m_recViewPorts[i];
+  }
+  m_refViewPorts.clear();
+  m_recViewPorts.clear();
+  for(Int i=0; i<(Int)m_viewPortYuv.size(); i++)
+  {
+    m_viewPortYuv[i]->destroy();
+    delete m_viewPortYuv[i];
+  }
+  m_viewPortYuv.clear();
+  m_orientations.clear();
+  m_userViewPort.clear();
+  m_distinctViewPorts.clear();
+  m_userPSNRSum.clear();
+  m_userMSESum.clear();
+  m_bEnabled = false;
+}
+
+Void TTraceViewPortPSNR::init(SVideoInfo& sRefVideoInfo, SVideoInfo& sRecVideoInfo, InputGeoParam *pInGeoParam, const std::string& traceFileName, Int iViewPortWidth, Int iViewPortHeight, Float fStep, Int iNumThreads, UInt numFrameSkipped, UInt tempSubsampleRatio)
+{
+  destroy();
+  if(traceFileName.empty())
+  {
+    return;
+  }
+  m_cTraceFile.open(traceFileName.c_str(), std::ios::binary | std::ios::in);
+  if(!m_cTraceFile.is_open())
+  {
+    printf("Trace viewport PSNR is disabled because the trace file (%s) cannot be opened!\n", traceFileName.c_str());
+    return;
+  }
+  Int iHeader[2];
+  Float fFOV[2];
+  m_cTraceFile.read((TChar *)iHeader, 2*sizeof(Int));
+  m_cTraceFile.read((TChar *)fFOV, 2*sizeof(Float));
+  if(!m_cTraceFile || iHeader[0] <= 0 || iHeader[1] <= 0)
+  {
+    printf("Trace viewport PSNR is disabled because the trace file (%s) has no valid header!\n", traceFileName.c_str());
+    m_cTraceFile.close();
+    return;
+  }
+  m_iNumUsers       = iHeader[0];
+  m_iNumTraceFrames = iHeader[1];
+  m_fHFOV           = fFOV[0];
+  m_fVFOV           = fFOV[1];
+  m_fStep           = fStep;
+  m_iViewPortWidth  = iViewPortWidth;
+  m_iViewPortHeight = iViewPortHeight;
+  m_iNumThreads     = std::max(1, iNumThreads);
+  m_iNumFrameSkipped = numFrameSkipped;
+  m_temporalSubsampleRatio = tempSubsampleRatio;
+
+#if SVIDEO_VIEWPORT_BILINEAR_FILTER_FIX
+  Int orgSInterp[MAX_NUM_CHANNEL_TYPE];
+  for(Int ch = CHANNEL_TYPE_LUMA; ch < MAX_NUM_CHANNEL_TYPE; ch++)
+  {
+    orgSInterp[ch] = pInGeoParam->iInterp[ch];
+    pInGeoParam->iInterp[ch] = SI_BILINEAR;
+  }
+#endif
+  m_pRefGeometry = TGeometry::create(sRefVideoInfo, pInGeoParam);
+  m_pRecGeometry = TGeometry::create(sRecVideoInfo, pInGeoParam);
+#if SVIDEO_SHARED_FRAME_CONTEXT
+  m_refVideoInfo = sRefVideoInfo;
+  m_recVideoInfo = sRecVideoInfo;
+  m_viewPortGeoParam = *pInGeoParam;
+#endif
+  SVideoInfo sViewPortInfo;
+  memset(&sViewPortInfo, 0, sizeof(sViewPortInfo));
+  sViewPortInfo.geoType = SVIDEO_VIEWPORT;
+  sViewPortInfo.framePackStruct.chromaFormatIDC = sRecVideoInfo.framePackStruct.chromaFormatIDC;
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+  sViewPortInfo.framePackStruct.chromaSampleLocType = 0;
+#endif
+  sViewPortInfo.framePackStruct.rows = sViewPortInfo.framePackStruct.cols = 1;
+  sViewPortInfo.iNumFaces = 1;
+  sViewPortInfo.iFaceWidth = m_iViewPortWidth;
+  sViewPortInfo.iFaceHeight = m_iViewPortHeight;
+  sViewPortInfo.viewPort.hFOV = m_fHFOV;
+  sViewPortInfo.viewPort.vFOV = m_fVFOV;
+  //the viewports are only sampled by the threads, so the memory depends on the number of threads instead of the number of users;
+  for(Int t=0; t<m_iNumThreads; t++)
+  {
+    m_refViewPorts.push_back(TGeometry::create(sViewPortInfo, pInGeoParam));
+    m_recViewPorts.push_back(TGeometry::create(sViewPortInfo, pInGeoParam));
+  }
+#if SVIDEO_VIEWPORT_BILINEAR_FILTER_FIX
+  for(Int ch = CHANNEL_TYPE_LUMA; ch < MAX_NUM_CHANNEL_TYPE; ch++)
+  {
+    pInGeoParam->iInterp[ch] = orgSInterp[ch];
+  }
+#endif
+  ChromaFormat chFmt = sViewPortInfo.framePackStruct.chromaFormatIDC;
+  if(!m_refViewPorts[0]->isFramePackCopy(chFmt) || !m_recViewPorts[0]->isFramePackCopy(chFmt))
+  {
+    for(Int i=0; i<m_iNumThreads*2; i++)
+    {
+      PelStorage *pcYuv = new PelStorage;
+      pcYuv->create(chFmt, Area(Position(), Size(m_iViewPortWidth, m_iViewPortHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+      m_viewPortYuv.push_back(pcYuv);
+    }
+  }
+
+  m_orientations.resize(m_iNumUsers*2);
+  m_userViewPort.resize(m_iNumUsers);
+  m_distinctViewPorts.reserve(m_iNumUsers);
+  m_userPSNRSum.assign(m_iNumUsers*MAX_NUM_COMPONENT, 0.0);
+  m_userMSESum.assign(m_iNumUsers*MAX_NUM_COMPONENT, 0.0);
+  m_iViewPortBitDepth = pInGeoParam->nOutputBitDepth;
+  m_iRefBitDepth = pInGeoParam->nOutputBitDepth;
+  m_uiNumPics = 0;
+  m_dNumDistinctSum = 0;
+  m_bEnabled = true;
+}
+
+Bool TTraceViewPortPSNR::xReadFrame(Int iFrame)
+{
+  //the pictures beyond the end of the traces keep the last recorded orientations;
+  iFrame = std::min(std::max(iFrame, 0), m_iNumTraceFrames-1);
+  //64-bit offset, long is 32 bits on LLP64 platforms;
+  std::streamoff iOffset = (std::streamoff)(2*sizeof(Int) + 2*sizeof(Float)) + (std::streamoff)iFrame*m_iNumUsers*2*(std::streamoff)sizeof(Float);
+  m_cTraceFile.clear();
+  m_cTraceFile.seekg(iOffset, std::ios::beg);
+  m_cTraceFile.read((TChar *)&m_orientations[0], m_iNumUsers*2*sizeof(Float));
+  return !m_cTraceFile.fail();
+}
+
+/*********************************************************
+//the orientations of the users are mapped to the distinct viewports of the frame; with a positive step the
+//orientations are quantised and each cell is evaluated at its centre, otherwise only identical orientations are merged;
+**********************************************************/
+Void TTraceViewPortPSNR::xCoalesceViewPorts()
+{
+  std::map<std::pair<Int, Int>, Int> distinctIdx;
+  m_distinctViewPorts.clear();
+  Int iNumYawSteps = m_fStep > 0 ? std::max(1, (Int)floor(360.0/m_fStep + 0.5)) : 0;
+  for(Int u=0; u<m_iNumUsers; u++)
+  {
+    Float fYaw   = m_orientations[u*2];
+    Float fPitch = Clip3(-90.0f, 90.0f, m_orientations[u*2+1]);
+    fYaw = (Float)(fYaw - 360.0*floor((fYaw + 180.0)/360.0));
+    std::pair<Int, Int> key;
+    if(m_fStep > 0)
+    {
+      Int iYaw   = (Int)floor(fYaw/m_fStep + 0.5);
+      Int iPitch = (Int)floor(fPitch/m_fStep + 0.5);
+      iYaw = ((iYaw % iNumYawSteps) + iNumYawSteps) % iNumYawSteps;
+      key = std::make_pair(iYaw, iPitch);
+      fYaw   = iYaw*m_fStep;
+      fYaw   = fYaw >= 180.0f ? fYaw - 360.0f : fYaw;
+      fPitch = Clip3(-90.0f, 90.0f, iPitch*m_fStep);
+    }
+    else
+    {
+      memcpy(&key.first, &fYaw, sizeof(Float));
+      memcpy(&key.second, &fPitch, sizeof(Float));
+    }
+    std::map<std::pair<Int, Int>, Int>::iterator it = distinctIdx.find(key);
+    if(it == distinctIdx.end())
+    {
+      TraceViewPort viewPort;
+      viewPort.fYaw   = fYaw;
+      viewPort.fPitch = fPitch;
+      it = distinctIdx.insert(std::make_pair(key, (Int)m_distinctViewPorts.size())).first;
+      m_distinctViewPorts.push_back(viewPort);
+    }
+    m_userViewPort[u] = it->second;
+  }
+  m_iNumDistinct = (Int)m_distinctViewPorts.size();
+}
+
+Void TTraceViewPortPSNR::xCalculatePSNR(Picture* pcPic, PelUnitBuf *pcOrgPicYuv)
+{
+  if(!m_bEnabled)
+    return;
+
+  Int iFrame = m_iNumFrameSkipped + pcPic->getPOC()*m_temporalSubsampleRatio;
+  CHECK(!xReadFrame(iFrame), "Cannot read the head motion trace file");
+  xCoalesceViewPorts();
+
+  TGeometry *pRefGeometry = m_pRefGeometry;
+  TGeometry *pRecGeometry = m_pRecGeometry;
+  PelUnitBuf pRecPicYuv = pcPic->getRecoBuf();
+#if SVIDEO_SHARED_FRAME_CONTEXT
+  if(m_pcFrameContext)
+  {
+    pRefGeometry = m_pcFrameContext->getGeometry(m_refVideoInfo, &m_viewPortGeoParam, pcOrgPicYuv);
+    pRecGeometry = m_pcFrameContext->getGeometry(m_recVideoInfo, &m_viewPortGeoParam, &pRecPicYuv);
+  }
+  else
+  {
+#endif
+  if((m_pRefGeometry->getType() == SVIDEO_OCTAHEDRON || m_pRefGeometry->getType() == SVIDEO_ICOSAHEDRON) && m_pRefGeometry->getSVideoInfo()->iCompactFPStructure) 
+    m_pRefGeometry->compactFramePackConvertYuv(pcOrgPicYuv);
+  else
+    m_pRefGeometry->convertYuv(pcOrgPicYuv);
+
+  if((m_pRecGeometry->getType() == SVIDEO_OCTAHEDRON || m_pRecGeometry->getType() == SVIDEO_ICOSAHEDRON) && m_pRecGeometry->getSVideoInfo()->iCompactFPStructure) 
+    m_pRecGeometry->compactFramePackConvertYuv(&pRecPicYuv);
+  else
+    m_pRecGeometry->convertYuv(&pRecPicYuv);
+#if SVIDEO_SHARED_FRAME_CONTEXT
+  }
+#endif
+  //the source faces are padded here, the threads only read them;
+  pRefGeometry->spherePadding();
+  pRecGeometry->spherePadding();
+
+  ChromaFormat chFmt          = m_refViewPorts[0]->getSVideoInfo()->framePackStruct.chromaFormatIDC;
+  Bool         bFramePackCopy = m_viewPortYuv.empty();
+  Int          iNumThreads    = std::min(m_iNumThreads, m_iNumDistinct);
+  if(iNumThreads <= 1)
+  {
+    xCalculateViewPorts(pRefGeometry, pRecGeometry, 0, 1, bFramePackCopy);
+  }
+  else
+  {
+    std::vector<std::thread> threads;
+    for(Int t=0; t<iNumThreads; t++)
+    {
+      threads.push_back(std::thread(&TTraceViewPortPSNR::xCalculateViewPorts, this, pRefGeometry, pRecGeometry, t, iNumThreads, bFramePackCopy));
+    }
+    for(Int t=0; t<iNumThreads; t++)
+    {
+      threads[t].join();
+    }
+  }
+
+  //the users share the results of their distinct viewports;
+  Int iNumComps = (Int)getNumberValidComponents(chFmt);
+  for(Int ch=0; ch<MAX_NUM_COMPONENT; ch++)
+  {
+    m_dPSNR[ch] = 0.0;
+    m_dWorstPSNR[ch] = ch<iNumComps ? 999.99 : 0.0;
+  }
+  for(Int u=0; u<m_iNumUsers; u++)
+  {
+    TraceViewPort& viewPort = m_distinctViewPorts[m_userViewPort[u]];
+    for(Int ch=0; ch<iNumComps; ch++)
+    {
+      m_userPSNRSum[u*MAX_NUM_COMPONENT+ch] += viewPort.dPSNR[ch];
+      m_userMSESum[u*MAX_NUM_COMPONENT+ch]  += viewPort.dMSE[ch];
+      m_dPSNR[ch] += viewPort.dPSNR[ch];
+      m_dWorstPSNR[ch] = std::min(m_dWorstPSNR[ch], viewPort.dPSNR[ch]);
+    }
+  }
+  for(Int ch=0; ch<iNumComps; ch++)
+  {
+    m_dPSNR[ch] /= m_iNumUsers;
+  }
+  m_uiNumPics++;
+  m_dNumDistinctSum += m_iNumDistinct;
+}
+
+Void TTraceViewPortPSNR::xCalculateViewPorts(TGeometry *pRefGeometry, TGeometry *pRecGeometry, Int iThreadIdx, Int iNumThreads, Bool bFramePackCopy)
+{
+  TGeometry   *pRefViewPort         = m_refViewPorts[iThreadIdx];
+  TGeometry   *pRecViewPort         = m_recViewPorts[iThreadIdx];
+  ChromaFormat chFmt                = pRefViewPort->getSVideoInfo()->framePackStruct.chromaFormatIDC;
+  Int          iBitDepthForPSNRCalc = std::max(m_iViewPortBitDepth, m_iRefBitDepth);
+  const Int    maxval               = 255<<(iBitDepthForPSNRCalc - 8);
+
+  for(Int i=iThreadIdx; i<m_iNumDistinct; i+=iNumThreads)
+  {
+    TraceViewPort& viewPort = m_distinctViewPorts[i];
+    pRefViewPort->getSVideoInfo()->viewPort.fYaw   = viewPort.fYaw;
+    pRefViewPort->getSVideoInfo()->viewPort.fPitch = viewPort.fPitch;
+    pRecViewPort->getSVideoInfo()->viewPort.fYaw   = viewPort.fYaw;
+    pRecViewPort->getSVideoInfo()->viewPort.fPitch = viewPort.fPitch;
+    pRefGeometry->geoConvertDirect(pRefViewPort, false, nullptr);
+    pRecGeometry->geoConvertDirect(pRecViewPort, true, nullptr);
+
+    if(bFramePackCopy)
+    {
+      Double dSSD[MAX_NUM_COMPONENT];
+      pRefViewPort->calcFramePackSSD(pRecViewPort, chFmt, iBitDepthForPSNRCalc, dSSD);
+      for(Int ch=0; ch<MAX_NUM_COMPONENT; ch++)
+      {
+        viewPort.dPSNR[ch] = viewPort.dMSE[ch] = 0.0;
+      }
+      for(Int ch=0; ch<(Int)getNumberValidComponents(chFmt); ch++)
+      {
+        Int iSize = (m_iViewPortWidth >> ::getComponentScaleX(ComponentID(ch), chFmt)) * (m_iViewPortHeight >> ::getComponentScaleY(ComponentID(ch), chFmt));
+        const Double fRefValue = (Double) maxval * maxval * iSize;
+        viewPort.dPSNR[ch] = ( dSSD[ch] ? 10.0 * log10( fRefValue / dSSD[ch] ) : 999.99 );
+        viewPort.dMSE[ch] = dSSD[ch]/(iSize);
+      }
+    }
+    else
+    {
+      PelStorage *pcRefYuv = m_viewPortYuv[iThreadIdx*2];
+      PelStorage *pcRecYuv = m_viewPortYuv[iThreadIdx*2+1];
+      pRefViewPort->framePack(pcRefYuv);
+      pRecViewPort->framePack(pcRecYuv);
+      xCalculatePSNRInternal(pcRefYuv, pcRecYuv, viewPort.dPSNR, viewPort.dMSE);
+    }
+  }
+}
+
+Void TTraceViewPortPSNR::xCalculatePSNRInternal(PelUnitBuf *pcOrgPicYuv, PelUnitBuf *pcPicD, Double *pdPSNR, Double *pdMSE)
+{
+  for(Int i=0; i<MAX_NUM_COMPONENT; i++)
+  {
+    pdPSNR[i] = pdMSE[i] = 0.0;
+  }
+  Int iBitDepthForPSNRCalc = std::max(m_iViewPortBitDepth, m_iRefBitDepth);
+  Int iReferenceBitShift = iBitDepthForPSNRCalc - m_iRefBitDepth;
+  Int iOutputBitShift = iBitDepthForPSNRCalc - m_iViewPortBitDepth;
+
+  for(Int chan=0; chan< getNumberValidComponents(pcPicD->chromaFormat); chan++)
+  {
+    const ComponentID ch=ComponentID(chan);
+    const Pel*  pOrg       = pcOrgPicYuv->get(ch).bufAt(0, 0);
+    const Int   iOrgStride = pcOrgPicYuv->get(ch).stride;
+    Pel*  pRec             = pcPicD->get(ch).bufAt(0, 0);
+    const Int   iRecStride = pcPicD->get(ch).stride;
+    const Int   iWidth  = pcPicD->get(ch).width ;
+    const Int   iHeight = pcPicD->get(ch).height ;
+    Int   iSize   = iWidth*iHeight;
+
+    Double SSDpsnr=0;
+    for(Int y = 0; y < iHeight; y++ )
+    {
+      for(Int x = 0; x < iWidth; x++ )
+      {
+        Intermediate_Int iDiff = (Intermediate_Int)( (pOrg[x]<<iReferenceBitShift) - (pRec[x]<<iOutputBitShift) );
+        SSDpsnr += iDiff * iDiff;
+      }
+      pOrg += iOrgStride;
+      pRec += iRecStride;
+    }
+    const Int maxval = 255<<(iBitDepthForPSNRCalc - 8) ;
+    const Double fRefValue = (Double) maxval * maxval * iSize;
+    pdPSNR[ch] = ( SSDpsnr ? 10.0 * log10( fRefValue / (Double)SSDpsnr ) : 999.99 );
+    pdMSE[ch] = (Double)SSDpsnr/(iSize);
+  }
+}
+
+Void TTraceViewPortPSNR::printSummary()
+{
+  if(!m_bEnabled || !m_uiNumPics)
+    return;
+
+  ChromaFormat chFmt = m_refViewPorts[0]->getSVideoInfo()->framePackStruct.chromaFormatIDC;
+  Int iNumComps = (Int)getNumberValidComponents(chFmt);
+  Double dMean[MAX_NUM_COMPONENT] = { 0 };
+  Double dWorst[MAX_NUM_COMPONENT] = { 0 };
+  Int    iWorstUser = 0;
+  for(Int u=0; u<m_iNumUsers; u++)
+  {
+    for(Int ch=0; ch<iNumComps; ch++)
+    {
+      dMean[ch] += m_userPSNRSum[u*MAX_NUM_COMPONENT+ch]/m_uiNumPics;
+    }
+    if(!u || m_userPSNRSum[u*MAX_NUM_COMPONENT] < m_userPSNRSum[iWorstUser*MAX_NUM_COMPONENT])
+    {
+      iWorstUser = u;
+    }
+  }
+  for(Int ch=0; ch<iNumComps; ch++)
+  {
+    dMean[ch] /= m_iNumUsers;
+    dWorst[ch] = m_userPSNRSum[iWorstUser*MAX_NUM_COMPONENT+ch]/m_uiNumPics;
+  }
+
+  printf( "\n\nTRACE VIEWPORT SUMMARY --------------------------------------------------\n" );
+  printf( "\tTotal Frames |   Users   Viewports/Frame   Y-PSNR    U-PSNR    V-PSNR\n" );
+  printf( "\t %8d    %c   %6d   %10.2lf     %8.4lf  %8.4lf  %8.4lf (average over users)\n", m_uiNumPics, 'a', m_iNumUsers, m_dNumDistinctSum/m_uiNumPics, dMean[0], dMean[1], dMean[2] );
+  printf( "\t %8d    %c   %6d                   %8.4lf  %8.4lf  %8.4lf (worst user)\n", m_uiNumPics, 'w', iWorstUser, dWorst[0], dWorst[1], dWorst[2] );
+
+  if(!m_userSummaryFileName.empty())
+  {
+    FILE *fp = fopen(m_userSummaryFileName.c_str(), "w");
+    if(!fp)
+    {
+      printf("The trace viewport summary file (%s) cannot be opened!\n", m_userSummaryFileName.c_str());
+      return;
+    }
+    fprintf(fp, "User,Y-PSNR,U-PSNR,V-PSNR,Y-MSE,U-MSE,V-MSE\n");
+    for(Int u=0; u<m_iNumUsers; u++)
+    {
+      const Double *pdPSNRSum = &m_userPSNRSum[u*MAX_NUM_COMPONENT];
+      const Double *pdMSESum  = &m_userMSESum[u*MAX_NUM_COMPONENT];
+      fprintf(fp, "%d,%.4lf,%.4lf,%.4lf,%.4lf,%.4lf,%.4lf\n", u, pdPSNRSum[0]/m_uiNumPics, pdPSNRSum[1]/m_uiNumPics, pdPSNRSum[2]/m_uiNumPics, pdMSESum[0]/m_uiNumPics, pdMSESum[1]/m_uiNumPics, pdMSESum[2]/m_uiNumPics);
+    }
+    fclose(fp);
+  }
+}
+#endif
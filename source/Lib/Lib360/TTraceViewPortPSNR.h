@@ -0,0 +1,133 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TTraceViewPortPSNR.h
+    \brief    Viewport PSNR along the recorded head motion traces of many users (header)
+*/
+
+#ifndef __TTRACEVIEWPORTPSNR__
+#define __TTRACEVIEWPORTPSNR__
+#include "TGeometry.h"
+#if SVIDEO_SHARED_FRAME_CONTEXT
+#include "TSphereFrameContext.h"
+#endif
+#include "../CommonLib/Picture.h"
+#include <cstdio>
+#include <fstream>
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+#if SVIDEO_TRACE_VIEWPORT_PSNR
+
+/* Trace file format (binary, little endian):
+   Int32   number of users;
+   Int32   number of frames;
+   Float32 horizontal and vertical field of view in degrees, shared by all users;
+   then for each frame and for each user of the frame: Float32 yaw, Float32 pitch in degrees;
+   the records of one frame are read when the frame is evaluated, so the memory does not depend on the trace length;
+*/
+class TTraceViewPortPSNR
+{
+private:
+  struct TraceViewPort
+  {
+    Float  fYaw;
+    Float  fPitch;
+    Double dPSNR[MAX_NUM_COMPONENT];
+    Double dMSE[MAX_NUM_COMPONENT];
+  };
+
+  Bool         m_bEnabled;
+  std::ifstream m_cTraceFile;
+  Int          m_iNumUsers;
+  Int          m_iNumTraceFrames;
+  Float        m_fHFOV;
+  Float        m_fVFOV;
+  Float        m_fStep;                    //orientations within the same step (degrees) are evaluated once, 0: only identical orientations;
+  Int          m_iViewPortWidth;
+  Int          m_iViewPortHeight;
+  Int          m_iNumThreads;
+  UInt         m_iNumFrameSkipped;
+  UInt         m_temporalSubsampleRatio;
+  Int          m_iViewPortBitDepth;
+  Int          m_iRefBitDepth;
+  TGeometry   *m_pRefGeometry;
+  TGeometry   *m_pRecGeometry;
+  std::vector<TGeometry*>  m_refViewPorts;     //one pair of viewports per thread;
+  std::vector<TGeometry*>  m_recViewPorts;
+  std::vector<PelStorage*> m_viewPortYuv;      //[thread*2+0: ref, thread*2+1: rec], only used when the frame packing resamples the chroma;
+  std::vector<Float>       m_orientations;     //records of the current frame;
+  std::vector<Int>         m_userViewPort;     //index of the distinct viewport of each user;
+  std::vector<TraceViewPort> m_distinctViewPorts;
+  std::vector<Double>      m_userPSNRSum;      //[user*MAX_NUM_COMPONENT+ch];
+  std::vector<Double>      m_userMSESum;
+  Double       m_dPSNR[MAX_NUM_COMPONENT];     //average over the users of the current picture;
+  Double       m_dWorstPSNR[MAX_NUM_COMPONENT];
+  Int          m_iNumDistinct;
+  UInt         m_uiNumPics;
+  Double       m_dNumDistinctSum;
+  std::string  m_userSummaryFileName;       //per-user averages are written to the file if it is set;
+#if SVIDEO_SHARED_FRAME_CONTEXT
+  TSphereFrameContext *m_pcFrameContext;
+  SVideoInfo           m_refVideoInfo;
+  SVideoInfo           m_recVideoInfo;
+  InputGeoParam        m_viewPortGeoParam;
+#endif
+
+  Bool xReadFrame(Int iFrame);
+  Void xCoalesceViewPorts();
+  Void xCalculateViewPorts(TGeometry *pRefGeometry, TGeometry *pRecGeometry, Int iThreadIdx, Int iNumThreads, Bool bFramePackCopy);
+  Void xCalculatePSNRInternal(PelUnitBuf *pcOrgPicYuv, PelUnitBuf *pcPicD, Double *pdPSNR, Double *pdMSE);
+public:
+  TTraceViewPortPSNR();
+  virtual ~TTraceViewPortPSNR();
+
+  Void init(SVideoInfo& sRefVideoInfo, SVideoInfo& sRecVideoInfo, InputGeoParam *pInGeoParam, const std::string& traceFileName, Int iViewPortWidth, Int iViewPortHeight, Float fStep, Int iNumThreads, UInt numFrameSkipped, UInt tempSubsampleRatio);
+  Void destroy();
+  Void xCalculatePSNR(Picture* pcPic, PelUnitBuf *pcOrgPicYuv);
+  Bool isEnabled() { return m_bEnabled; }
+  Double* getPSNR() { return m_dPSNR; }
+  Double* getWorstPSNR() { return m_dWorstPSNR; }
+  Int getNumDistinctViewPorts() { return m_iNumDistinct; }
+  Void setUserSummaryFile(const std::string& fileName) { m_userSummaryFileName = fileName; }
+  Void printSummary();
+#if SVIDEO_SHARED_FRAME_CONTEXT
+  Void setFrameContext(TSphereFrameContext *pcFrameContext) { m_pcFrameContext = pcFrameContext; }
+#endif
+};
+
+#endif
+#endif // __TTRACEVIEWPORTPSNR__
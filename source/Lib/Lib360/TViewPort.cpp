@@ -40,7 +40,15 @@
 
 #if EXTENSION_360_VIDEO
 
+#if SVIDEO_VIEWPORT_LUT_CACHE
+static const Double s_dLutCacheAngleScale = 1000.0;   //orientations are quantised to 1/1000 degree;
+#endif
+
 TViewPort::TViewPort(SVideoInfo& sVideoInfo, InputGeoParam *pInGeoParam) : TGeometry()
+#if SVIDEO_VIEWPORT_LUT_CACHE
+  , m_iLutCacheBudget(0)
+  , m_iLutCacheSize(0)
+#endif
 {
    //assert(sVideoInfo.iNumFaces == 1);
    geoInit(sVideoInfo, pInGeoParam);   
@@ -48,6 +56,9 @@ TViewPort::TViewPort(SVideoInfo& sVideoInfo, InputGeoParam *pInGeoParam) : TGeom
 
 TViewPort::~TViewPort()  
 {
+#if SVIDEO_VIEWPORT_LUT_CACHE
+  xClearLutCache();
+#endif
 }
 
 
@@ -123,4 +134,118 @@ Void TViewPort::map3DTo2D(SPos *,SPos *)
     CHECK(true, "Viewport 3D to 2D is not supported ");
 }
 
+#if SVIDEO_VIEWPORT_LUT_CACHE
+//the cached tables are owned by the cache; the current one is referenced by m_pPixelWeight[0];
+Void TViewPort::xClearLutCache()
+{
+  for(std::list<LutCacheEntry>::iterator it = m_lutCache.begin(); it != m_lutCache.end(); it++)
+  {
+    for(Int ch=0; ch<2; ch++)
+    {
+      delete[] it->pPixelWeight[ch];
+    }
+  }
+  if(!m_lutCache.empty())
+  {
+    m_pPixelWeight[0][0] = m_pPixelWeight[0][1] = nullptr;
+    m_bGeometryMapping = false;
+  }
+  m_lutCache.clear();
+  m_iLutCacheSize = 0;
+}
+
+Void TViewPort::setLutCacheSize(Int iMBytes)
+{
+  xClearLutCache();
+  for(Int ch=0; ch<2; ch++)
+  {
+    if(m_pPixelWeight[0][ch])
+    {
+      delete[] m_pPixelWeight[0][ch];
+      m_pPixelWeight[0][ch] = nullptr;
+      m_bGeometryMapping = false;
+    }
+  }
+  m_iLutCacheBudget = (size_t)std::max(iMBytes, 0)<<20;
+}
+
+/*********************************************************
+//the mapping tables are reused when the viewport returns to an orientation already used with the same source geometry;
+//the least recently used tables are dropped once the cache exceeds its budget, the current table is always kept;
+**********************************************************/
+#if SVIDEO_ROT_FIX
+Void TViewPort::geometryMapping(TGeometry *pGeoSrc, Bool bRec)
+#else
+Void TViewPort::geometryMapping(TGeometry *pGeoSrc)
+#endif
+{
+#if !SVIDEO_ROT_FIX
+  Bool bRec = false;
+#endif
+  if(!m_iLutCacheBudget)
+  {
+#if SVIDEO_ROT_FIX
+    TGeometry::geometryMapping(pGeoSrc, bRec);
+#else
+    TGeometry::geometryMapping(pGeoSrc);
+#endif
+    return;
+  }
+  CHECK(m_sVideoInfo.iNumFaces != 1, "Viewport must have one face");
+
+  Int iOrientation[4];
+  iOrientation[0] = (Int)round(m_sVideoInfo.viewPort.hFOV*s_dLutCacheAngleScale);
+  iOrientation[1] = (Int)round(m_sVideoInfo.viewPort.vFOV*s_dLutCacheAngleScale);
+  iOrientation[2] = (Int)round(m_sVideoInfo.viewPort.fYaw*s_dLutCacheAngleScale);
+  iOrientation[3] = (Int)round(m_sVideoInfo.viewPort.fPitch*s_dLutCacheAngleScale);
+  for(std::list<LutCacheEntry>::iterator it = m_lutCache.begin(); it != m_lutCache.end(); it++)
+  {
+    if(   !memcmp(it->iOrientation, iOrientation, sizeof(iOrientation)) && it->pcGeoSrc == pGeoSrc && it->bRec == bRec
+       && !memcmp(&it->srcVideoInfo, pGeoSrc->getSVideoInfo(), sizeof(SVideoInfo)))
+    {
+      m_lutCache.splice(m_lutCache.begin(), m_lutCache, it);
+      m_pPixelWeight[0][0] = it->pPixelWeight[0];
+      m_pPixelWeight[0][1] = it->pPixelWeight[1];
+      setRotMat();
+      setInvK();
+      m_bGeometryMapping = true;
+      return;
+    }
+  }
+
+  //build a new table; the current one stays in the cache;
+  m_pPixelWeight[0][0] = m_pPixelWeight[0][1] = nullptr;
+#if SVIDEO_ROT_FIX
+  TGeometry::geometryMapping(pGeoSrc, bRec);
+#else
+  TGeometry::geometryMapping(pGeoSrc);
+#endif
+  LutCacheEntry entry;
+  memcpy(entry.iOrientation, iOrientation, sizeof(iOrientation));
+  entry.pcGeoSrc = pGeoSrc;
+  entry.srcVideoInfo = *pGeoSrc->getSVideoInfo();
+  entry.bRec = bRec;
+  entry.iSize = 0;
+  for(Int ch=0; ch<2; ch++)
+  {
+    entry.pPixelWeight[ch] = m_pPixelWeight[0][ch];
+    if(entry.pPixelWeight[ch])
+    {
+      Int iHeightPW = (m_sVideoInfo.iFaceHeight + (m_iMarginY << 1)) >> getComponentScaleY((ComponentID)ch);
+      entry.iSize += sizeof(PxlFltLut)*getStride((ComponentID)ch)*iHeightPW;
+    }
+  }
+  m_lutCache.push_front(entry);
+  m_iLutCacheSize += entry.iSize;
+  while(m_iLutCacheSize > m_iLutCacheBudget && m_lutCache.size() > 1)
+  {
+    LutCacheEntry &last = m_lutCache.back();
+    delete[] last.pPixelWeight[0];
+    delete[] last.pPixelWeight[1];
+    m_iLutCacheSize -= last.iSize;
+    m_lutCache.pop_back();
+  }
+}
+#endif
+
 #endif
@@ -38,6 +38,9 @@
 #ifndef __TVIEWPORT__
 #define __TVIEWPORT__
 #include "TGeometry.h"
+#if SVIDEO_VIEWPORT_LUT_CACHE
+#include <list>
+#endif
 
 // ====================================================================================================================
 // Class definition
@@ -50,6 +53,22 @@ class TViewPort : public TGeometry
 private:
   POSType m_matRotMatx[3][3];
   POSType m_matInvK[3][3];
+#if SVIDEO_VIEWPORT_LUT_CACHE
+  struct LutCacheEntry
+  {
+    Int         iOrientation[4];    //quantised fovx, fovy, yaw, pitch;
+    TGeometry  *pcGeoSrc;
+    SVideoInfo  srcVideoInfo;
+    Bool        bRec;
+    PxlFltLut  *pPixelWeight[2];
+    size_t      iSize;              //bytes;
+  };
+  std::list<LutCacheEntry> m_lutCache;          //most recently used first;
+  size_t                   m_iLutCacheBudget;   //bytes; 0: disabled;
+  size_t                   m_iLutCacheSize;
+
+  Void xClearLutCache();
+#endif
 
 public:
   TViewPort(SVideoInfo& sVideoInfo, InputGeoParam *pInGeoParam);
@@ -64,6 +83,14 @@ public:
   Void setRotMat();
   Void setInvK();
   Void matInv(POSType[3][3]);
+#if SVIDEO_VIEWPORT_LUT_CACHE
+  Void setLutCacheSize(Int iMBytes);
+  virtual Void geometryMapping(TGeometry *pGeoSrc
+#if SVIDEO_ROT_FIX
+    , Bool bRec=false
+#endif
+    );
+#endif
 };
 
 #endif
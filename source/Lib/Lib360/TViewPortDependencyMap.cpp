@@ -0,0 +1,567 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TViewPortDependencyMap.cpp
+    \brief    Regions of the frame packed picture the samples of viewports depend on
+*/
+
+#include <math.h>
+#include "TViewPortDependencyMap.h"
+
+#if SVIDEO_VIEWPORT_DEPENDENCY_MAP
+TViewPortDependencyMap::TViewPortDependencyMap()
+: m_pcCodingGeometry(nullptr)
+, m_pcViewPort(nullptr)
+, m_iFrameWidth(0)
+, m_iFrameHeight(0)
+, m_bUpsampled(false)
+, m_bMarkUpsampled(false)
+, m_iUpsMarginX(0)
+, m_iUpsMarginY(0)
+{
+}
+
+TViewPortDependencyMap::~TViewPortDependencyMap()
+{
+  destroy();
+}
+
+Void TViewPortDependencyMap::destroy()
+{
+  if(m_pcCodingGeometry)
+  {
+    delete m_pcCodingGeometry;
+    m_pcCodingGeometry = nullptr;
+  }
+  if(m_pcViewPort)
+  {
+    delete m_pcViewPort;
+    m_pcViewPort = nullptr;
+  }
+  m_colPos.clear();
+  m_rowPos.clear();
+  m_colIdx.clear();
+  m_rowIdx.clear();
+  m_cache.clear();
+  m_cacheIdx.clear();
+  m_visited.clear();
+  for(Int face=0; face<SV_MAX_NUM_FACES; face++)
+  {
+    std::vector<Int>().swap(m_upsProbe[face]);
+  }
+  m_bUpsampled = m_bMarkUpsampled = false;
+}
+
+Void TViewPortDependencyMap::init(SVideoInfo& sCodingVideoInfo, InputGeoParam *pInGeoParam, Int iFrameWidth, Int iFrameHeight, Int iViewPortWidth, Int iViewPortHeight)
+{
+  destroy();
+  //the faces of the compact packings are split, geoToFramePack() does not give their rectangles;
+  CHECK((sCodingVideoInfo.geoType == SVIDEO_OCTAHEDRON || sCodingVideoInfo.geoType == SVIDEO_ICOSAHEDRON) && sCodingVideoInfo.iCompactFPStructure,
+        "The viewport dependency map does not support the compact OHP and ISP packings");
+  m_iFrameWidth  = iFrameWidth;
+  m_iFrameHeight = iFrameHeight;
+  m_pcCodingGeometry = TGeometry::create(sCodingVideoInfo, pInGeoParam);
+
+  SVideoInfo sViewPortInfo;
+  memset(&sViewPortInfo, 0, sizeof(sViewPortInfo));
+  sViewPortInfo.geoType = SVIDEO_VIEWPORT;
+  sViewPortInfo.framePackStruct.chromaFormatIDC = sCodingVideoInfo.framePackStruct.chromaFormatIDC;
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+  sViewPortInfo.framePackStruct.chromaSampleLocType = 0;
+#endif
+  sViewPortInfo.framePackStruct.rows = sViewPortInfo.framePackStruct.cols = 1;
+  sViewPortInfo.iNumFaces = 1;
+  sViewPortInfo.iFaceWidth = iViewPortWidth;
+  sViewPortInfo.iFaceHeight = iViewPortHeight;
+  m_pcViewPort = TGeometry::create(sViewPortInfo, pInGeoParam);
+  setUniformGrid(iFrameWidth, iFrameHeight);
+
+  m_bUpsampled = sCodingVideoInfo.framePackStruct.chromaFormatIDC == CHROMA_420 && m_pcCodingGeometry->m_chromaFormatIDC == CHROMA_444;
+  if(m_bUpsampled)
+  {
+    m_iUpsMarginX = std::max(m_pcCodingGeometry->m_filterUps[0].nTaps, m_pcCodingGeometry->m_filterUps[1].nTaps) >> 1;
+    m_iUpsMarginY = std::max(m_pcCodingGeometry->m_filterUps[2].nTaps, m_pcCodingGeometry->m_filterUps[3].nTaps) >> 1;
+    xInitUpsamplingProbe();
+  }
+}
+
+//the grid is given by the widths of the columns and the heights of the rows in luma samples;
+Void TViewPortDependencyMap::setGrid(const std::vector<Int>& colWidths, const std::vector<Int>& rowHeights)
+{
+  m_colPos.assign(1, 0);
+  m_colIdx.resize(m_iFrameWidth);
+  for(Int c=0; c<(Int)colWidths.size(); c++)
+  {
+    CHECK(colWidths[c] <= 0, "Invalid grid column width");
+    for(Int x=m_colPos[c]; x<std::min(m_colPos[c]+colWidths[c], m_iFrameWidth); x++)
+      m_colIdx[x] = c;
+    m_colPos.push_back(m_colPos[c]+colWidths[c]);
+  }
+  CHECK(m_colPos.back() != m_iFrameWidth, "The grid columns do not cover the frame width");
+  m_rowPos.assign(1, 0);
+  m_rowIdx.resize(m_iFrameHeight);
+  for(Int r=0; r<(Int)rowHeights.size(); r++)
+  {
+    CHECK(rowHeights[r] <= 0, "Invalid grid row height");
+    for(Int y=m_rowPos[r]; y<std::min(m_rowPos[r]+rowHeights[r], m_iFrameHeight); y++)
+      m_rowIdx[y] = r;
+    m_rowPos.push_back(m_rowPos[r]+rowHeights[r]);
+  }
+  CHECK(m_rowPos.back() != m_iFrameHeight, "The grid rows do not cover the frame height");
+  m_cache.clear();
+  m_cacheIdx.clear();
+}
+
+//CTUs: the CTU size; CTU rows: the frame width and the CTU size;
+Void TViewPortDependencyMap::setUniformGrid(Int iBlockWidth, Int iBlockHeight)
+{
+  std::vector<Int> colWidths, rowHeights;
+  for(Int x=0; x<m_iFrameWidth; x+=iBlockWidth)
+    colWidths.push_back(std::min(iBlockWidth, m_iFrameWidth-x));
+  for(Int y=0; y<m_iFrameHeight; y+=iBlockHeight)
+    rowHeights.push_back(std::min(iBlockHeight, m_iFrameHeight-y));
+  setGrid(colWidths, rowHeights);
+}
+
+Void TViewPortDependencyMap::xMarkFrameRect(Int x0, Int y0, Int x1, Int y1, std::vector<Bool>& cells)
+{
+  x0 = std::max(x0, 0);
+  y0 = std::max(y0, 0);
+  x1 = std::min(x1, m_iFrameWidth-1);
+  y1 = std::min(y1, m_iFrameHeight-1);
+  if(x0 > x1 || y0 > y1)
+    return;
+  Int iNumCols = getNumCols();
+  for(Int r=m_rowIdx[y0]; r<=m_rowIdx[y1]; r++)
+    for(Int c=m_colIdx[x0]; c<=m_colIdx[x1]; c++)
+      cells[r*iNumCols+c] = true;
+}
+
+//the rectangle is given in luma samples of the face;
+Void TViewPortDependencyMap::xMarkFaceRect(Int iFace, Int u0, Int v0, Int u1, Int v1, std::vector<Bool>& cells)
+{
+  if(m_bMarkUpsampled)
+    xMarkUpsampledRect(iFace, u0, v0, u1, v1, cells);
+  else
+    xMarkCodedRect(iFace, u0, v0, u1, v1, cells);
+}
+
+//the rotations of the frame packing keep the rectangle a rectangle;
+Void TViewPortDependencyMap::xMarkCodedRect(Int iFace, Int u0, Int v0, Int u1, Int v1, std::vector<Bool>& cells)
+{
+  SVideoInfo *pInfo = m_pcCodingGeometry->getSVideoInfo();
+  u0 = std::max(u0, 0);
+  v0 = std::max(v0, 0);
+  u1 = std::min(u1, pInfo->iFaceWidth-1);
+  v1 = std::min(v1, pInfo->iFaceHeight-1);
+  if(u0 > u1 || v0 > v1)
+    return;
+  IPos pos0(iFace, u0, v0), pos1(iFace, u1, v1);
+  IPos2D fp0, fp1;
+  m_pcCodingGeometry->geoToFramePack(&pos0, &fp0);
+  m_pcCodingGeometry->geoToFramePack(&pos1, &fp1);
+  xMarkFrameRect(std::min(fp0.x, fp1.x), std::min(fp0.y, fp1.y), std::max(fp0.x, fp1.x), std::max(fp0.y, fp1.y), cells);
+}
+
+//a sample of the 4:4:4 faces reads the 4:2:0 samples within the half length of the upsampling filters around it; the
+//samples outside the face are read from its margins, which are padded from the neighboring faces before the upsampling;
+Void TViewPortDependencyMap::xMarkUpsampledRect(Int iFace, Int u0, Int v0, Int u1, Int v1, std::vector<Bool>& cells)
+{
+  TGeometry        *pGeo     = m_pcCodingGeometry;
+  Int               iWidthC  = pGeo->m_sVideoInfo.iFaceWidth >> 1;
+  Int               iHeightC = pGeo->m_sVideoInfo.iFaceHeight >> 1;
+  std::vector<Int> &probe    = m_upsProbe[iFace];
+  //4:2:0 samples;
+  Int x0 = (u0 >> 1) - m_iUpsMarginX;
+  Int y0 = (v0 >> 1) - m_iUpsMarginY;
+  Int x1 = (u1 >> 1) + m_iUpsMarginX;
+  Int y1 = (v1 >> 1) + m_iUpsMarginY;
+  if(probe.empty()
+     || (x0 >= 0 && y0 >= 0 && x1 < iWidthC && y1 < iHeightC
+         && pGeo->insideFace(iFace, x0 << 1, y0 << 1, COMPONENT_Y, COMPONENT_Y)
+         && pGeo->insideFace(iFace, x1 << 1, y0 << 1, COMPONENT_Y, COMPONENT_Y)
+         && pGeo->insideFace(iFace, x0 << 1, y1 << 1, COMPONENT_Y, COMPONENT_Y)
+         && pGeo->insideFace(iFace, x1 << 1, y1 << 1, COMPONENT_Y, COMPONENT_Y)))
+  {
+    xMarkCodedRect(iFace, x0 << 1, y0 << 1, (x1 << 1) + 1, (y1 << 1) + 1, cells);
+    return;
+  }
+  Int iWidthP      = iWidthC + (m_iUpsMarginX << 1);
+  Int iFrameWidthC = m_iFrameWidth >> 1;
+  for(Int y = std::max(y0, -m_iUpsMarginY); y <= std::min(y1, iHeightC + m_iUpsMarginY - 1); y++)
+    for(Int x = std::max(x0, -m_iUpsMarginX); x <= std::min(x1, iWidthC + m_iUpsMarginX - 1); x++)
+    {
+      Int iPos = probe[(y + m_iUpsMarginY) * iWidthP + x + m_iUpsMarginX];
+      if(iPos >= 0)
+        xMarkFrameRect((iPos % iFrameWidthC) << 1, (iPos / iFrameWidthC) << 1, ((iPos % iFrameWidthC) << 1) + 1, ((iPos / iFrameWidthC) << 1) + 1, cells);
+    }
+}
+
+//the samples chromaUpsample() reads for each face, including the padded margins, are located by converting two
+//pictures of the columns and of the rows of the chroma samples;
+Void TViewPortDependencyMap::xInitUpsamplingProbe()
+{
+  TGeometry       *pGeo     = m_pcCodingGeometry;
+  Int              iWidthC  = m_iFrameWidth >> 1;
+  Int              iHeightC = m_iFrameHeight >> 1;
+  std::vector<Int> cols[SV_MAX_NUM_FACES];
+  PelStorage       cPicYuv;
+  cPicYuv.create(CHROMA_420, Area(Position(), Size(m_iFrameWidth, m_iFrameHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+  for(Int iPass = 0; iPass < 2; iPass++)
+  {
+    for(Int ch = 0; ch < ::getNumberValidComponents(CHROMA_420); ch++)
+    {
+      PelBuf &buf = cPicYuv.get(ComponentID(ch));
+      for(Int y = 0; y < (Int)buf.height; y++)
+        for(Int x = 0; x < (Int)buf.width; x++)
+          buf.at(x, y) = ch ? Pel(iPass ? y : x) : 0;
+    }
+    pGeo->m_pUpsProbe = iPass ? m_upsProbe : cols;
+    pGeo->convertYuv(&cPicYuv);
+  }
+  pGeo->m_pUpsProbe = nullptr;
+  cPicYuv.destroy();
+
+  //the margins not padded are not read from the picture;
+  for(Int face = 0; face < pGeo->m_sVideoInfo.iNumFaces; face++)
+  {
+    for(Int k = 0; k < (Int)m_upsProbe[face].size(); k++)
+    {
+      Int x = cols[face][k];
+      Int y = m_upsProbe[face][k];
+      m_upsProbe[face][k] = (x >= 0 && x < iWidthC && y >= 0 && y < iHeightC) ? y * iWidthC + x : -1;
+    }
+  }
+}
+
+//top-left tap (samples of chId) of the interpolation window at iTLPos; the margin columns make the row offset non-negative;
+Void TViewPortDependencyMap::xGetTapWindow(ComponentID chId, Int iTLPos, Int& x0, Int& y0)
+{
+  TGeometry  *pGeo    = m_pcCodingGeometry;
+  ChannelType chType  = toChannelType(chId);
+  Int         iStride = pGeo->getStride(chId);
+  Int         iOffset = iTLPos + (pGeo->m_iMarginX >> pGeo->getComponentScaleX(chId));
+  Int         iTLY    = iOffset >= 0 ? iOffset / iStride : -((iStride - 1 - iOffset) / iStride);
+  x0 = iTLPos - iTLY * iStride - ((pGeo->m_iInterpFilterTaps[chType][0] - 1) >> 1);
+  y0 = iTLY - ((pGeo->m_iInterpFilterTaps[chType][1] - 1) >> 1);
+}
+
+/*********************************************************
+//a margin sample (samples of chId) is followed as spherePadding() fills it: to the face sample it is copied from,
+//or to the taps of its entry in the padding table, which may lie in margins padded before it; the samples the
+//padding does not fill are read from the frame packed picture as they are;
+**********************************************************/
+Void TViewPortDependencyMap::xMarkMarginSample(ComponentID chId, Int iFace, Int x, Int y, std::vector<Bool>& cells)
+{
+  TGeometry  *pGeo     = m_pcCodingGeometry;
+  ChannelType chType   = toChannelType(chId);
+  Int         iScaleX  = pGeo->getComponentScaleX(chId);
+  Int         iScaleY  = pGeo->getComponentScaleY(chId);
+  Int         iWidth   = pGeo->m_sVideoInfo.iFaceWidth >> iScaleX;
+  Int         iHeight  = pGeo->m_sVideoInfo.iFaceHeight >> iScaleY;
+  Int         nMarginX = pGeo->m_iMarginX >> iScaleX;
+  Int         nMarginY = pGeo->m_iMarginY >> iScaleY;
+  Int         iStride  = pGeo->getStride(chId);
+  Int         iFaceSize = iStride * (iHeight + (nMarginY << 1));
+  Int         iTapsX   = pGeo->m_iInterpFilterTaps[chType][0];
+  Int         iTapsY   = pGeo->m_iInterpFilterTaps[chType][1];
+  Int         mapIdx   = (pGeo->m_chromaFormatIDC == CHROMA_444
+                          && pGeo->m_InterpolationType[CHANNEL_TYPE_LUMA] == pGeo->m_InterpolationType[CHANNEL_TYPE_CHROMA])
+                           ? 0
+                           : (chId > 0 ? 1 : 0);
+  Int         iWeightMapFaceMask = (1 << pGeo->m_WeightMap_NumOfBits4Faces) - 1;
+
+  //each sample is read either after the padding, or by the padding of the sample of the given padding order;
+  Int iPadded = pGeo->m_sVideoInfo.iNumFaces * iFaceSize;
+  std::vector<std::pair<IPos, Int> > samples(1, std::make_pair(IPos(iFace, x, y), iPadded));
+  while(!samples.empty())
+  {
+    IPos p     = samples.back().first;
+    Int  iRead = samples.back().second;
+    samples.pop_back();
+    if(p.faceIdx < 0 || p.faceIdx >= pGeo->m_sVideoInfo.iNumFaces
+       || p.u < -nMarginX || p.u >= iWidth + nMarginX || p.v < -nMarginY || p.v >= iHeight + nMarginY)
+      continue;
+    Bool bInRect = p.u >= 0 && p.u < iWidth && p.v >= 0 && p.v < iHeight;
+    if(pGeo->insideFace(p.faceIdx, p.u << iScaleX, p.v << iScaleY, COMPONENT_Y, chId))
+    {
+      xMarkFaceRect(p.faceIdx, p.u << iScaleX, p.v << iScaleY, ((p.u + 1) << iScaleX) - 1, ((p.v + 1) << iScaleY) - 1, cells);
+      continue;
+    }
+    //the copies run after the interpolation with the padding table, only the reads after the padding see them;
+    Int fIdxSrc, xSrc, ySrc;
+    if(iRead == iPadded && pGeo->getPaddingCopySource(p.faceIdx, p.u, p.v, chId, fIdxSrc, xSrc, ySrc))
+    {
+      samples.push_back(std::make_pair(IPos(fIdxSrc, xSrc, ySrc), iPadded));
+      continue;
+    }
+    Bool bPadded = pGeo->isPaddingTableUsed();
+#if SVIDEO_HEMI_PROJECTIONS
+    //as in spherePadding(), only the samples outside the face rectangle are padded;
+    if(pGeo->m_sVideoInfo.geoType == SVIDEO_HCMP || pGeo->m_sVideoInfo.geoType == SVIDEO_HEAC)
+      bPadded = bPadded && !bInRect;
+#endif
+    if(bPadded && !pGeo->m_bGeometryMapping4SpherePadding)
+      pGeo->geometryMapping4SpherePadding();
+    //the padding runs in place in the padding order; a sample not padded yet is read as coded;
+    Int iIdx = p.faceIdx * iFaceSize + (p.v + nMarginY) * iStride + (p.u + nMarginX);
+    if(!bPadded || iIdx >= iRead || !pGeo->m_pPixelWeight4SherePadding[p.faceIdx][mapIdx])
+    {
+      if(bInRect)
+        xMarkFaceRect(p.faceIdx, p.u << iScaleX, p.v << iScaleY, ((p.u + 1) << iScaleX) - 1, ((p.v + 1) << iScaleY) - 1, cells);
+      continue;
+    }
+    if(m_visited[iIdx])
+      continue;
+    m_visited[iIdx] = true;
+    Int iLutIdx;
+    pGeo->getSPLutIdx(chId, p.u, p.v, iLutIdx);
+    PxlFltLut *pPelWeight = pGeo->m_pPixelWeight4SherePadding[p.faceIdx][mapIdx] + iLutIdx;
+    Int x0, y0;
+    xGetTapWindow(chId, (pPelWeight->facePos) >> pGeo->m_WeightMap_NumOfBits4Faces, x0, y0);
+    for(Int ty = y0; ty < y0 + iTapsY; ty++)
+      for(Int tx = x0; tx < x0 + iTapsX; tx++)
+        samples.push_back(std::make_pair(IPos((pPelWeight->facePos) & iWeightMapFaceMask, tx, ty), iIdx));
+  }
+}
+
+/*********************************************************
+//the viewport samples are mapped as by geoConvert(), and the interpolation footprint of each sample is taken
+//from its PxlFltLut; consecutive samples with the same top-left position are only marked once;
+**********************************************************/
+Void TViewPortDependencyMap::xCalcDependency(const ViewPortSettings& viewPort, std::vector<Bool>& cells)
+{
+  TGeometry *pGeoSrc = m_pcCodingGeometry;
+  TGeometry *pGeoDst = m_pcViewPort;
+  pGeoDst->m_sVideoInfo.viewPort = viewPort;
+  ((TViewPort *) pGeoDst)->setRotMat();
+  ((TViewPort *) pGeoDst)->setInvK();
+
+  //the rotation of the coded picture is undone as for the reconstructed pictures;
+  Int pRot[3];
+  pRot[0] = -pGeoSrc->m_sVideoInfo.sVideoRotation.degree[0];
+  pRot[1] = -pGeoSrc->m_sVideoInfo.sVideoRotation.degree[1];
+  pRot[2] = -pGeoSrc->m_sVideoInfo.sVideoRotation.degree[2];
+
+  Bool bOutputPadding = pGeoDst->m_bConvOutputPaddingNeeded;
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+  if ((pGeoDst->m_sVideoInfo.framePackStruct.chromaFormatIDC == CHROMA_420) && (pGeoDst->m_chromaFormatIDC == CHROMA_444))
+#else
+  if ((pGeoDst->m_sVideoInfo.framePackStruct.chromaFormatIDC == CHROMA_420)
+      && ((pGeoDst->m_chromaFormatIDC == CHROMA_444) || (pGeoDst->m_chromaFormatIDC == CHROMA_420 && pGeoDst->m_bResampleChroma)))
+#endif
+    bOutputPadding = true;
+
+  Int iWeightMapFaceMask = (1 << pGeoSrc->m_WeightMap_NumOfBits4Faces) - 1;
+  Int iNumMaps = (pGeoDst->m_chromaFormatIDC == CHROMA_400
+                  || (pGeoDst->m_chromaFormatIDC == CHROMA_444 && pGeoDst->m_InterpolationType[0] == pGeoDst->m_InterpolationType[1]))
+                   ? 1
+                   : 2;
+  //the chroma of the faces is upsampled from the coded picture, a map shared by luma and chroma is followed twice;
+  Int iNumPasses = (m_bUpsampled && iNumMaps == 1) ? 2 : iNumMaps;
+  for (Int iPass = 0; iPass < iNumPasses; iPass++)
+  {
+    Int         iMap     = std::min(iPass, iNumMaps - 1);
+    ComponentID chId     = (ComponentID) iMap;
+    m_bMarkUpsampled     = m_bUpsampled && iPass > 0;
+    ChannelType chType   = toChannelType(chId);
+    Int         iWidth   = pGeoDst->m_sVideoInfo.iFaceWidth >> pGeoDst->getComponentScaleX(chId);
+    Int         iHeight  = pGeoDst->m_sVideoInfo.iFaceHeight >> pGeoDst->getComponentScaleY(chId);
+    Int         nMarginX = pGeoDst->m_iMarginX >> pGeoDst->getComponentScaleX(chId);
+    Int         nMarginY = pGeoDst->m_iMarginY >> pGeoDst->getComponentScaleY(chId);
+    Int         iScaleX  = pGeoSrc->getComponentScaleX(chId);
+    Int         iScaleY  = pGeoSrc->getComponentScaleY(chId);
+    Int         iTapsX   = pGeoSrc->m_iInterpFilterTaps[chType][0];
+    Int         iTapsY   = pGeoSrc->m_iInterpFilterTaps[chType][1];
+    Int         iLastFace  = -1;
+    Int         iLastTLPos = 0;
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+    Double chromaOffsetSrc[2] = { 0.0, 0.0 };   //[0: X; 1: Y];
+    Double chromaOffsetDst[2] = { 0.0, 0.0 };   //[0: X; 1: Y];
+    pGeoDst->getFaceChromaOffset(chromaOffsetDst, 0, chId);
+#endif
+    m_visited.assign(pGeoSrc->m_sVideoInfo.iNumFaces * pGeoSrc->getStride(chId)
+                       * ((pGeoSrc->m_sVideoInfo.iFaceHeight + (pGeoSrc->m_iMarginY << 1)) >> iScaleY),
+                     false);
+    for (Int j = -nMarginY; j < iHeight + nMarginY; j++)
+      for (Int i = -nMarginX; i < iWidth + nMarginX; i++)
+      {
+        if (!bOutputPadding
+            && !pGeoDst->insideFace(0, (i << pGeoDst->getComponentScaleX(chId)), (j << pGeoDst->getComponentScaleY(chId)), COMPONENT_Y, chId))
+          continue;
+        PxlFltLut wList;
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+        POSType x = (i) * (1 << pGeoDst->getComponentScaleX(chId)) + chromaOffsetDst[0];
+        POSType y = (j) * (1 << pGeoDst->getComponentScaleY(chId)) + chromaOffsetDst[1];
+#else
+        POSType x = (i) * (1 << pGeoDst->getComponentScaleX(chId));
+        POSType y = (j) * (1 << pGeoDst->getComponentScaleY(chId));
+#endif
+        SPos in(0, x, y, 0), pos3D;
+        pGeoDst->map2DTo3D(in, &pos3D);
+        pGeoDst->invRotate3D(pos3D, pRot[0], pRot[1], pRot[2]);
+        pGeoSrc->map3DTo2D(&pos3D, &pos3D);
+#if SVIDEO_HEMI_PROJECTIONS
+        if (((Int)pGeoSrc->getType() == SVIDEO_HCMP || (Int)pGeoSrc->getType() == SVIDEO_HEAC) && pos3D.faceIdx == 7)
+        {
+          pos3D.faceIdx = 0;
+          pos3D.x       = 0;
+          pos3D.y       = 0;
+        }
+#endif
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+        pGeoSrc->getFaceChromaOffset(chromaOffsetSrc, pos3D.faceIdx, chId);
+        pos3D.x = (pos3D.x - chromaOffsetSrc[0]) / POSType(1 << iScaleX);
+        pos3D.y = (pos3D.y - chromaOffsetSrc[1]) / POSType(1 << iScaleY);
+#else
+        pos3D.x = pos3D.x / POSType(1 << iScaleX);
+        pos3D.y = pos3D.y / POSType(1 << iScaleY);
+#endif
+        (pGeoSrc->*(pGeoSrc->m_interpolateWeight[chType]))(chId, &pos3D, wList);
+
+        Int iFace  = (wList.facePos) & iWeightMapFaceMask;
+        Int iTLPos = (wList.facePos) >> pGeoSrc->m_WeightMap_NumOfBits4Faces;
+        if (iFace == iLastFace && iTLPos == iLastTLPos)
+          continue;
+        iLastFace  = iFace;
+        iLastTLPos = iTLPos;
+
+        Int x0, y0;
+        xGetTapWindow(chId, iTLPos, x0, y0);
+        Int x1      = x0 + iTapsX - 1;
+        Int y1      = y0 + iTapsY - 1;
+        if (pGeoSrc->insideFace(iFace, x0 << iScaleX, y0 << iScaleY, COMPONENT_Y, chId)
+            && pGeoSrc->insideFace(iFace, x1 << iScaleX, y0 << iScaleY, COMPONENT_Y, chId)
+            && pGeoSrc->insideFace(iFace, x0 << iScaleX, y1 << iScaleY, COMPONENT_Y, chId)
+            && pGeoSrc->insideFace(iFace, x1 << iScaleX, y1 << iScaleY, COMPONENT_Y, chId))
+        {
+          xMarkFaceRect(iFace, x0 << iScaleX, y0 << iScaleY, ((x1 + 1) << iScaleX) - 1, ((y1 + 1) << iScaleY) - 1, cells);
+          continue;
+        }
+        for (Int py = y0; py <= y1; py++)
+          for (Int px = x0; px <= x1; px++)
+          {
+            if (pGeoSrc->insideFace(iFace, px << iScaleX, py << iScaleY, COMPONENT_Y, chId))
+              xMarkFaceRect(iFace, px << iScaleX, py << iScaleY, ((px + 1) << iScaleX) - 1, ((py + 1) << iScaleY) - 1, cells);
+            else
+              xMarkMarginSample(chId, iFace, px, py, cells);
+          }
+      }
+  }
+  m_bMarkUpsampled = false;
+}
+
+Void TViewPortDependencyMap::getDependency(const std::vector<ViewPortSettings>& viewPorts, std::vector<Bool>& cells)
+{
+  Int iNumCells = getNumCols()*getNumRows();
+  cells.assign(iNumCells, false);
+  for(Int v=0; v<(Int)viewPorts.size(); v++)
+  {
+    //orientations are kept to 1/1000 degree;
+    std::vector<Int> key(4);
+    key[0] = (Int)floor(viewPorts[v].fYaw*1000.0 + 0.5);
+    key[1] = (Int)floor(viewPorts[v].fPitch*1000.0 + 0.5);
+    key[2] = (Int)floor(viewPorts[v].hFOV*1000.0 + 0.5);
+    key[3] = (Int)floor(viewPorts[v].vFOV*1000.0 + 0.5);
+    std::map<std::vector<Int>, DependencyCache::iterator>::iterator itIdx = m_cacheIdx.find(key);
+    DependencyCache::iterator it;
+    if(itIdx != m_cacheIdx.end())
+    {
+      it = itIdx->second;
+      m_cache.splice(m_cache.begin(), m_cache, it);
+    }
+    else
+    {
+      ViewPortSettings sViewPort = viewPorts[v];
+      sViewPort.fYaw   = key[0]/1000.0f;
+      sViewPort.fPitch = key[1]/1000.0f;
+      sViewPort.hFOV   = key[2]/1000.0f;
+      sViewPort.vFOV   = key[3]/1000.0f;
+      //the least recently used orientation is dropped;
+      if((Int)m_cache.size() >= S_DEPENDENCY_CACHE_SIZE)
+      {
+        m_cacheIdx.erase(m_cache.back().first);
+        m_cache.pop_back();
+      }
+      m_cache.push_front(std::make_pair(key, std::vector<Bool>(iNumCells, false)));
+      it = m_cache.begin();
+      m_cacheIdx[key] = it;
+      xCalcDependency(sViewPort, it->second);
+    }
+    for(Int c=0; c<iNumCells; c++)
+    {
+      if(it->second[c])
+        cells[c] = true;
+    }
+  }
+}
+
+//the marked cells of each grid row are merged into runs, and equal runs of consecutive rows into one rectangle;
+Void TViewPortDependencyMap::getRectangles(const std::vector<Bool>& cells, std::vector<DependencyRect>& rects)
+{
+  Int iNumCols = getNumCols();
+  std::map<std::pair<Int, Int>, Int> prevRuns, currRuns;
+  rects.clear();
+  for(Int r=0; r<getNumRows(); r++)
+  {
+    currRuns.clear();
+    for(Int c=0; c<iNumCols; c++)
+    {
+      if(!cells[r*iNumCols+c])
+        continue;
+      Int c0 = c;
+      while(c+1<iNumCols && cells[r*iNumCols+c+1])
+        c++;
+      std::pair<Int, Int> run(c0, c);
+      std::map<std::pair<Int, Int>, Int>::iterator it = prevRuns.find(run);
+      if(it != prevRuns.end())
+      {
+        rects[it->second].iHeight += m_rowPos[r+1] - m_rowPos[r];
+        currRuns[run] = it->second;
+      }
+      else
+      {
+        DependencyRect rect;
+        rect.x       = m_colPos[c0];
+        rect.y       = m_rowPos[r];
+        rect.iWidth  = m_colPos[c+1] - m_colPos[c0];
+        rect.iHeight = m_rowPos[r+1] - m_rowPos[r];
+        currRuns[run] = (Int)rects.size();
+        rects.push_back(rect);
+      }
+    }
+    prevRuns.swap(currRuns);
+  }
+}
+#endif
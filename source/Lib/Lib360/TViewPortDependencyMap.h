@@ -0,0 +1,110 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TViewPortDependencyMap.h
+    \brief    Regions of the frame packed picture the samples of viewports depend on (header)
+*/
+
+#ifndef __TVIEWPORTDEPENDENCYMAP__
+#define __TVIEWPORTDEPENDENCYMAP__
+#include "TGeometry.h"
+#include "TViewPort.h"
+#include <map>
+#include <list>
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+#if SVIDEO_VIEWPORT_DEPENDENCY_MAP
+
+struct DependencyRect
+{
+  Int x;                   //luma samples of the frame packed picture;
+  Int y;
+  Int iWidth;
+  Int iHeight;
+};
+
+/* The frame packed picture is split into a grid of regions (CTUs, CTU rows, tiles or subpictures);
+   a region is marked if any sample read by the interpolation of the viewport lies in it, either directly
+   or through the sphere padding of a face margin, or through the chroma upsampling of a 4:2:0 picture to the 4:4:4
+   faces; the results of the last S_DEPENDENCY_CACHE_SIZE viewport
+   orientations are cached; the compact OHP and ISP packings are not supported;
+*/
+class TViewPortDependencyMap
+{
+private:
+  TGeometry       *m_pcCodingGeometry;
+  TGeometry       *m_pcViewPort;
+  Int              m_iFrameWidth;
+  Int              m_iFrameHeight;
+  std::vector<Int> m_colPos;               //left boundary of each grid column, and the frame width;
+  std::vector<Int> m_rowPos;
+  std::vector<Int> m_colIdx;               //grid column of each luma column;
+  std::vector<Int> m_rowIdx;
+  typedef std::list<std::pair<std::vector<Int>, std::vector<Bool> > > DependencyCache;
+  DependencyCache  m_cache;                //most recently used orientation first;
+  std::map<std::vector<Int>, DependencyCache::iterator> m_cacheIdx;
+  std::vector<Bool> m_visited;             //padded samples already followed, per face and sample of the padded face buffer;
+  Bool             m_bUpsampled;           //the chroma of a 4:2:0 picture is upsampled to 4:4:4 faces by convertYuv();
+  Bool             m_bMarkUpsampled;       //the samples marked are upsampled chroma samples;
+  Int              m_iUpsMarginX;          //half lengths of the upsampling filters;
+  Int              m_iUpsMarginY;
+  std::vector<Int> m_upsProbe[SV_MAX_NUM_FACES]; //4:2:0 sample read by chromaUpsample() at each sample of the extended face, -1: none;
+
+  Void xMarkFrameRect(Int x0, Int y0, Int x1, Int y1, std::vector<Bool>& cells);
+  Void xMarkFaceRect(Int iFace, Int u0, Int v0, Int u1, Int v1, std::vector<Bool>& cells);
+  Void xMarkCodedRect(Int iFace, Int u0, Int v0, Int u1, Int v1, std::vector<Bool>& cells);
+  Void xMarkUpsampledRect(Int iFace, Int u0, Int v0, Int u1, Int v1, std::vector<Bool>& cells);
+  Void xInitUpsamplingProbe();
+  Void xGetTapWindow(ComponentID chId, Int iTLPos, Int& x0, Int& y0);
+  Void xMarkMarginSample(ComponentID chId, Int iFace, Int x, Int y, std::vector<Bool>& cells);
+  Void xCalcDependency(const ViewPortSettings& viewPort, std::vector<Bool>& cells);
+public:
+  TViewPortDependencyMap();
+  virtual ~TViewPortDependencyMap();
+
+  Void init(SVideoInfo& sCodingVideoInfo, InputGeoParam *pInGeoParam, Int iFrameWidth, Int iFrameHeight, Int iViewPortWidth, Int iViewPortHeight);
+  Void destroy();
+  Void setGrid(const std::vector<Int>& colWidths, const std::vector<Int>& rowHeights);
+  Void setUniformGrid(Int iBlockWidth, Int iBlockHeight);
+  Int  getNumCols() { return (Int)m_colPos.size()-1; }
+  Int  getNumRows() { return (Int)m_rowPos.size()-1; }
+  Void getDependency(const std::vector<ViewPortSettings>& viewPorts, std::vector<Bool>& cells);
+  Void getRectangles(const std::vector<Bool>& cells, std::vector<DependencyRect>& rects);
+};
+
+#endif
+#endif // __TVIEWPORTDEPENDENCYMAP__
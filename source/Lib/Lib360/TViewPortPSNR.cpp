@@ -37,6 +37,9 @@
 
 #include <math.h>
 #include "TViewPortPSNR.h"
+#if SVIDEO_VIEWPORT_BATCH_PSNR || SVIDEO_VIEWPORT_DIRECT_SAMPLING
+#include <thread>
+#endif
 
 #if SVIDEO_VIEWPORT_PSNR
 TViewPortPSNR::TViewPortPSNR() 
@@ -64,6 +67,15 @@ TViewPortPSNR::TViewPortPSNR()
 , m_iNumFrameSkipped(0)
 , m_bViewPortPSNREnabled(false)
 #endif
+#if SVIDEO_SHARED_FRAME_CONTEXT
+, m_pcFrameContext(nullptr)
+#endif
+#if SVIDEO_VIEWPORT_DIRECT_SAMPLING
+, m_bDirectSampling(false)
+#endif
+#if SVIDEO_VIEWPORT_BATCH_PSNR
+, m_iBatchThreads(0)
+#endif
 {
   m_viewPortPSNRParam.bViewPortPSNREnabled = false;
   m_viewPortPSNRParam.viewPortSettingsList.clear();
@@ -132,6 +144,14 @@ TViewPortPSNR::~TViewPortPSNR()
     delete m_pRecViewPortYuv;
     m_pRecViewPortYuv = nullptr;
   }
+#if SVIDEO_VIEWPORT_BATCH_PSNR
+  for(Int i=0; i<(Int)m_batchViewPortYuv.size(); i++)
+  {
+    m_batchViewPortYuv[i]->destroy();
+    delete m_batchViewPortYuv[i];
+  }
+  m_batchViewPortYuv.clear();
+#endif
 
   if(m_pdPSNRSum)
   {
@@ -179,6 +199,11 @@ Void TViewPortPSNR::init(SVideoInfo& sRefVideoInfo, SVideoInfo& sRecVideoInfo, I
 #endif
     m_pRefGeometry = TGeometry::create(sRefVideoInfo, pInGeoParam);
     m_pRecGeometry = TGeometry::create(sRecVideoInfo, pInGeoParam);
+#if SVIDEO_SHARED_FRAME_CONTEXT
+    m_refVideoInfo = sRefVideoInfo;
+    m_recVideoInfo = sRecVideoInfo;
+    m_viewPortGeoParam = *pInGeoParam;
+#endif
     m_pRefViewPortList = new TGeometry*[iNumViewPorts];
     m_pRecViewPortList = new TGeometry*[iNumViewPorts];
     SVideoInfo sViewPortInfo;
@@ -252,6 +277,11 @@ Void TViewPortPSNR::initDynamicViewPort(SVideoInfo& sRefVideoInfo, SVideoInfo& s
 #endif
     m_pRefGeometry = TGeometry::create(sRefVideoInfo, pInGeoParam);
     m_pRecGeometry = TGeometry::create(sRecVideoInfo, pInGeoParam);
+#if SVIDEO_SHARED_FRAME_CONTEXT
+    m_refVideoInfo = sRefVideoInfo;
+    m_recVideoInfo = sRecVideoInfo;
+    m_viewPortGeoParam = *pInGeoParam;
+#endif
     m_pRefViewPortList = new TGeometry*[iNumViewPorts];
     m_pRecViewPortList = new TGeometry*[iNumViewPorts];
     SVideoInfo sViewPortInfo;
@@ -303,6 +333,39 @@ Void TViewPortPSNR::initDynamicViewPort(SVideoInfo& sRefVideoInfo, SVideoInfo& s
 }
 #endif
 
+#if SVIDEO_VIEWPORT_LUT_CACHE
+//budget of the mapping table cache of each viewport; it only pays off when the viewports are changed;
+Void TViewPortPSNR::setLutCacheSize(Int iMBytes)
+{
+  for(Int i=0; i<m_iNumViewPorts; i++)
+  {
+    if(m_pRefViewPortList && m_pRefViewPortList[i])
+    {
+      ((TViewPort *)m_pRefViewPortList[i])->setLutCacheSize(iMBytes);
+    }
+    if(m_pRecViewPortList && m_pRecViewPortList[i])
+    {
+      ((TViewPort *)m_pRecViewPortList[i])->setLutCacheSize(iMBytes);
+    }
+  }
+}
+#endif
+
+#if SVIDEO_VIEWPORT_DIRECT_SAMPLING
+//the worker threads are created once and reused by every dynamic viewport of every picture;
+Void TViewPortPSNR::setDirectSampling(Bool bDirect, Int iNumThreads)
+{
+  m_bDirectSampling = bDirect;
+  m_cDirectSamplingPool.destroy();
+  Int iMaxThreads = std::max(1, (Int)std::thread::hardware_concurrency());
+  iNumThreads = std::min(iNumThreads, iMaxThreads);
+  if(bDirect && iNumThreads > 1)
+  {
+    m_cDirectSamplingPool.create(iNumThreads);
+  }
+}
+#endif
+
 Void TViewPortPSNR::xCalculatePSNRInternal(PelUnitBuf *pcOrgPicYuv, PelUnitBuf *pcPicD, Double *pdPSNR, Double *pdMSE)
 {
   for(Int i=0; i<MAX_NUM_COMPONENT; i++)
@@ -386,6 +449,18 @@ Void TViewPortPSNR::xCalculatePSNR( Picture* pcPic)
   m_iLastFrmPOC = pcPic->getPOC()*m_temporalSubsampleRatio+1;
 #endif
   Int iNumOfViewPorts = (Int)m_viewPortPSNRParam.viewPortSettingsList.size(); 
+  TGeometry *pRefGeometry = m_pRefGeometry;
+  TGeometry *pRecGeometry = m_pRecGeometry;
+  PelUnitBuf pRecPicYuv = pcPic->getRecoBuf();
+#if SVIDEO_SHARED_FRAME_CONTEXT && SVIDEO_E2E_METRICS
+  if(m_pcFrameContext)
+  {
+    pRefGeometry = m_pcFrameContext->getGeometry(m_refVideoInfo, &m_viewPortGeoParam, pcOrgPicYuv);
+    pRecGeometry = m_pcFrameContext->getGeometry(m_recVideoInfo, &m_viewPortGeoParam, &pRecPicYuv);
+  }
+  else
+  {
+#endif
 #if SVIDEO_E2E_METRICS
   if((m_pRefGeometry->getType() == SVIDEO_OCTAHEDRON || m_pRefGeometry->getType() == SVIDEO_ICOSAHEDRON) && m_pRefGeometry->getSVideoInfo()->iCompactFPStructure) 
     m_pRefGeometry->compactFramePackConvertYuv(pcOrgPicYuv);
@@ -397,11 +472,20 @@ Void TViewPortPSNR::xCalculatePSNR( Picture* pcPic)
   else
     m_pRefGeometry->convertYuv(m_pcOrgPicYuv);
 #endif
-  PelUnitBuf pRecPicYuv = pcPic->getRecoBuf();
   if((m_pRecGeometry->getType() == SVIDEO_OCTAHEDRON || m_pRecGeometry->getType() == SVIDEO_ICOSAHEDRON) && m_pRecGeometry->getSVideoInfo()->iCompactFPStructure) 
     m_pRecGeometry->compactFramePackConvertYuv(&pRecPicYuv);
   else
     m_pRecGeometry->convertYuv(&pRecPicYuv);
+#if SVIDEO_SHARED_FRAME_CONTEXT && SVIDEO_E2E_METRICS
+  }
+#endif
+#if SVIDEO_VIEWPORT_BATCH_PSNR
+  if(m_iBatchThreads)
+  {
+    xCalculatePSNRBatch(pRefGeometry, pRecGeometry);
+    return;
+  }
+#endif
 
   for(Int i=0; i<iNumOfViewPorts; i++)
   {
@@ -409,7 +493,7 @@ Void TViewPortPSNR::xCalculatePSNR( Picture* pcPic)
     Double dMSE[MAX_NUM_COMPONENT];
 
     //generate reference viewport;
-    m_pRefGeometry->geoConvert(m_pRefViewPortList[i]);
+    pRefGeometry->geoConvert(m_pRefViewPortList[i]);
     if((m_pRefViewPortList[i]->getType() == SVIDEO_OCTAHEDRON || m_pRefViewPortList[i]->getType() == SVIDEO_ICOSAHEDRON) && m_pRefViewPortList[i]->getSVideoInfo()->iCompactFPStructure)
       m_pRefViewPortList[i]->compactFramePack(m_pRefViewPortYuv);
     else
@@ -417,9 +501,9 @@ Void TViewPortPSNR::xCalculatePSNR( Picture* pcPic)
     
     //generate reconstructed viewport;
 #if SVIDEO_ROT_FIX
-    m_pRecGeometry->geoConvert(m_pRecViewPortList[i], true);
+    pRecGeometry->geoConvert(m_pRecViewPortList[i], true);
 #else
-    m_pRecGeometry->geoConvert(m_pRecViewPortList[i]);
+    pRecGeometry->geoConvert(m_pRecViewPortList[i]);
 #endif
     if((m_pRecViewPortList[i]->getType() == SVIDEO_OCTAHEDRON || m_pRecViewPortList[i]->getType() == SVIDEO_ICOSAHEDRON) && m_pRecViewPortList[i]->getSVideoInfo()->iCompactFPStructure)
       m_pRecViewPortList[i]->compactFramePack(m_pRecViewPortYuv);
@@ -448,22 +532,130 @@ Void TViewPortPSNR::xCalculatePSNR( Picture* pcPic)
   }
 }
 
+#if SVIDEO_VIEWPORT_BATCH_PSNR
+/*********************************************************
+//all the static viewports are evaluated in one pass; the viewports are distributed over the threads,
+//which share the padded source faces, and the PSNR is accumulated from the viewport faces
+//unless the frame packing resamples the chroma;
+**********************************************************/
+Void TViewPortPSNR::xCalculatePSNRBatch(TGeometry *pRefGeometry, TGeometry *pRecGeometry)
+{
+  Int          iNumOfViewPorts = (Int)m_viewPortPSNRParam.viewPortSettingsList.size();
+  Int          iNumThreads     = std::max(1, std::min(m_iBatchThreads, iNumOfViewPorts));
+  ChromaFormat chFmt           = m_pRefViewPortYuv->chromaFormat;
+  Bool         bFramePackCopy  = m_pRefViewPortList[0]->isFramePackCopy(chFmt) && m_pRecViewPortList[0]->isFramePackCopy(chFmt);
+
+  if(!bFramePackCopy && (Int)m_batchViewPortYuv.size() < iNumThreads*2)
+  {
+    for(Int i=(Int)m_batchViewPortYuv.size(); i<iNumThreads*2; i++)
+    {
+      PelStorage *pcYuv = new PelStorage;
+      pcYuv->create(chFmt, Area(Position(), Size(m_viewPortPSNRParam.iViewPortWidth, m_viewPortPSNRParam.iViewPortHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+      m_batchViewPortYuv.push_back(pcYuv);
+    }
+  }
+  //the source faces are padded here, the threads only read them;
+  pRefGeometry->spherePadding();
+  pRecGeometry->spherePadding();
+
+  if(iNumThreads == 1)
+  {
+    xCalculatePSNRBatchThread(pRefGeometry, pRecGeometry, 0, 1, bFramePackCopy);
+    return;
+  }
+  std::vector<std::thread> threads;
+  for(Int t=0; t<iNumThreads; t++)
+  {
+    threads.push_back(std::thread(&TViewPortPSNR::xCalculatePSNRBatchThread, this, pRefGeometry, pRecGeometry, t, iNumThreads, bFramePackCopy));
+  }
+  for(Int t=0; t<iNumThreads; t++)
+  {
+    threads[t].join();
+  }
+}
+
+Void TViewPortPSNR::xCalculatePSNRBatchThread(TGeometry *pRefGeometry, TGeometry *pRecGeometry, Int iThreadIdx, Int iNumThreads, Bool bFramePackCopy)
+{
+  Int          iNumOfViewPorts      = (Int)m_viewPortPSNRParam.viewPortSettingsList.size();
+  ChromaFormat chFmt                = m_pRefViewPortYuv->chromaFormat;
+  Int          iBitDepthForPSNRCalc = std::max(m_iViewPortBitDepth, m_iRefBitDepth);
+  const Int    maxval               = 255<<(iBitDepthForPSNRCalc - 8);
+
+  for(Int i=iThreadIdx; i<iNumOfViewPorts; i+=iNumThreads)
+  {
+    Double *dPSNR = m_pdPSNR[i];
+    Double dMSE[MAX_NUM_COMPONENT];
+
+    pRefGeometry->geoConvert(m_pRefViewPortList[i]);
+#if SVIDEO_ROT_FIX
+    pRecGeometry->geoConvert(m_pRecViewPortList[i], true);
+#else
+    pRecGeometry->geoConvert(m_pRecViewPortList[i]);
+#endif
+    if(bFramePackCopy)
+    {
+      Double dSSD[MAX_NUM_COMPONENT];
+      m_pRefViewPortList[i]->calcFramePackSSD(m_pRecViewPortList[i], chFmt, iBitDepthForPSNRCalc, dSSD);
+      for(Int ch=0; ch<MAX_NUM_COMPONENT; ch++)
+      {
+        dPSNR[ch] = dMSE[ch] = 0.0;
+      }
+      for(Int ch=0; ch<(Int)getNumberValidComponents(chFmt); ch++)
+      {
+        Int iSize = (m_viewPortPSNRParam.iViewPortWidth >> ::getComponentScaleX(ComponentID(ch), chFmt)) * (m_viewPortPSNRParam.iViewPortHeight >> ::getComponentScaleY(ComponentID(ch), chFmt));
+        const Double fRefValue = (Double) maxval * maxval * iSize;
+        dPSNR[ch] = ( dSSD[ch] ? 10.0 * log10( fRefValue / dSSD[ch] ) : 999.99 );
+        dMSE[ch] = dSSD[ch]/(iSize);
+      }
+    }
+    else
+    {
+      PelStorage *pcRefYuv = m_batchViewPortYuv[iThreadIdx*2];
+      PelStorage *pcRecYuv = m_batchViewPortYuv[iThreadIdx*2+1];
+      m_pRefViewPortList[i]->framePack(pcRefYuv);
+      m_pRecViewPortList[i]->framePack(pcRecYuv);
+      xCalculatePSNRInternal(pcRefYuv, pcRecYuv, dPSNR, dMSE);
+    }
+    //added frame based metrics;
+    for(Int j=0; j<MAX_NUM_COMPONENT; j++)
+    {
+      m_pdPSNRSum[i][j] += dPSNR[j];
+      m_pdMSESum[i][j] += dMSE[j];
+    }
+  }
+}
+#endif
+
 #if SVIDEO_DYNAMIC_VIEWPORT_PSNR
 Void TViewPortPSNR::xCalculateDynamicViewPSNR( Picture* pcPic, PelUnitBuf *pcOrgPicYuv)
 {
   if(!m_dynamicViewPortPSNRParam.bViewPortPSNREnabled)
     return;
 
+  TGeometry *pRefGeometry = m_pRefGeometry;
+  TGeometry *pRecGeometry = m_pRecGeometry;
+  PelUnitBuf pRecPicYuv = pcPic->getRecoBuf();
+#if SVIDEO_SHARED_FRAME_CONTEXT
+  if(m_pcFrameContext)
+  {
+    pRefGeometry = m_pcFrameContext->getGeometry(m_refVideoInfo, &m_viewPortGeoParam, pcOrgPicYuv);
+    pRecGeometry = m_pcFrameContext->getGeometry(m_recVideoInfo, &m_viewPortGeoParam, &pRecPicYuv);
+  }
+  else
+  {
+#endif
   if((m_pRefGeometry->getType() == SVIDEO_OCTAHEDRON || m_pRefGeometry->getType() == SVIDEO_ICOSAHEDRON) && m_pRefGeometry->getSVideoInfo()->iCompactFPStructure) 
     m_pRefGeometry->compactFramePackConvertYuv(pcOrgPicYuv);
   else
     m_pRefGeometry->convertYuv(pcOrgPicYuv);
 
-  PelUnitBuf pRecPicYuv = pcPic->getRecoBuf();
   if((m_pRecGeometry->getType() == SVIDEO_OCTAHEDRON || m_pRecGeometry->getType() == SVIDEO_ICOSAHEDRON) && m_pRecGeometry->getSVideoInfo()->iCompactFPStructure) 
     m_pRecGeometry->compactFramePackConvertYuv(&pRecPicYuv);
   else
     m_pRecGeometry->convertYuv(&pRecPicYuv);
+#if SVIDEO_SHARED_FRAME_CONTEXT
+  }
+#endif
 
   for(Int i=0; i<m_iNumViewPorts; i++)
   {
@@ -487,19 +679,41 @@ Void TViewPortPSNR::xCalculateDynamicViewPSNR( Picture* pcPic, PelUnitBuf *pcOrg
     Double dMSE[MAX_NUM_COMPONENT];
 
     //generate reference viewport;
+#if SVIDEO_VIEWPORT_DIRECT_SAMPLING
+    if(m_bDirectSampling)
+    {
+      pRefGeometry->geoConvertDirect(m_pRefViewPortList[i], false, &m_cDirectSamplingPool);
+    }
+    else
+    {
+#endif
     m_pRefViewPortList[i]->setGeometryMapping(false);
-    m_pRefGeometry->geoConvert(m_pRefViewPortList[i]);
+    pRefGeometry->geoConvert(m_pRefViewPortList[i]);
+#if SVIDEO_VIEWPORT_DIRECT_SAMPLING
+    }
+#endif
     if((m_pRefViewPortList[i]->getType() == SVIDEO_OCTAHEDRON || m_pRefViewPortList[i]->getType() == SVIDEO_ICOSAHEDRON) && m_pRefViewPortList[i]->getSVideoInfo()->iCompactFPStructure)
       m_pRefViewPortList[i]->compactFramePack(m_pRefViewPortYuv);
     else
       m_pRefViewPortList[i]->framePack(m_pRefViewPortYuv);
 
     //generate reconstructed viewport;
+#if SVIDEO_VIEWPORT_DIRECT_SAMPLING
+    if(m_bDirectSampling)
+    {
+      pRecGeometry->geoConvertDirect(m_pRecViewPortList[i], true, &m_cDirectSamplingPool);
+    }
+    else
+    {
+#endif
     m_pRecViewPortList[i]->setGeometryMapping(false);
 #if SVIDEO_ROT_FIX
-    m_pRecGeometry->geoConvert(m_pRecViewPortList[i], true);
+    pRecGeometry->geoConvert(m_pRecViewPortList[i], true);
 #else
-    m_pRecGeometry->geoConvert(m_pRecViewPortList[i]);
+    pRecGeometry->geoConvert(m_pRecViewPortList[i]);
+#endif
+#if SVIDEO_VIEWPORT_DIRECT_SAMPLING
+    }
 #endif
     if((m_pRecViewPortList[i]->getType() == SVIDEO_OCTAHEDRON || m_pRecViewPortList[i]->getType() == SVIDEO_ICOSAHEDRON) && m_pRecViewPortList[i]->getSVideoInfo()->iCompactFPStructure)
       m_pRecViewPortList[i]->compactFramePack(m_pRecViewPortYuv);
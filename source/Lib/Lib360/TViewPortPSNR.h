@@ -39,6 +39,12 @@
 #define __TVIEWPORTPSNR__
 #include "TGeometry.h"
 #include "TViewPort.h"
+#if SVIDEO_VIEWPORT_DIRECT_SAMPLING
+#include "TWorkerPool.h"
+#endif
+#if SVIDEO_SHARED_FRAME_CONTEXT
+#include "TSphereFrameContext.h"
+#endif
 #include "../Utilities/VideoIOYuv.h"
 #include "../CommonLib/Picture.h"
 #include "../Utilities/VideoIOYuv.h"
@@ -84,6 +90,23 @@ private:
   UInt         m_iNumFrameSkipped;
   Bool         m_bViewPortPSNREnabled;
 #endif
+#if SVIDEO_SHARED_FRAME_CONTEXT
+  TSphereFrameContext *m_pcFrameContext;
+  SVideoInfo           m_refVideoInfo;
+  SVideoInfo           m_recVideoInfo;
+  InputGeoParam        m_viewPortGeoParam;
+#endif
+#if SVIDEO_VIEWPORT_DIRECT_SAMPLING
+  Bool         m_bDirectSampling;          //dynamic viewports are sampled without the mapping tables;
+  TWorkerPool  m_cDirectSamplingPool;     //bands of the dynamic viewports, kept across the pictures;
+#endif
+#if SVIDEO_VIEWPORT_BATCH_PSNR
+  Int          m_iBatchThreads;            //0: the static viewports are evaluated one by one;
+  std::vector<PelStorage*> m_batchViewPortYuv;   //[thread*2+0: ref, thread*2+1: rec], only used when the frame packing resamples the chroma;
+
+  Void xCalculatePSNRBatch(TGeometry *pRefGeometry, TGeometry *pRecGeometry);
+  Void xCalculatePSNRBatchThread(TGeometry *pRefGeometry, TGeometry *pRecGeometry, Int iThreadIdx, Int iNumThreads, Bool bFramePackCopy);
+#endif
 
   Void xCalculatePSNRInternal(PelUnitBuf *pcOrgPicYuv, PelUnitBuf *pcPicD, Double *pdPSNR, Double *pdMSE);
   Void calculateCombinedValues(Int vpIdx, UInt uiNumPics, Double &PSNRyuv, Double &MSEyuv);
@@ -112,10 +135,22 @@ public:
   Bool isEnabled() { return m_viewPortPSNRParam.bViewPortPSNREnabled; }
 #endif
   Void printSummary(UInt uiNumPics);
+#if SVIDEO_SHARED_FRAME_CONTEXT
+  Void setFrameContext(TSphereFrameContext *pcFrameContext) { m_pcFrameContext = pcFrameContext; }
+#endif
 #if SVIDEO_DYNAMIC_VIEWPORT_PSNR
   Void initDynamicViewPort(SVideoInfo& sRefVideoInfo, SVideoInfo& sRecVideoInfo, InputGeoParam *pInGeoParam, DynamicViewPortPSNRParam& param, UInt numFrameSkipped, UInt tempSubsampleRatio);
   Void xCalculateDynamicViewPSNR( Picture* pcPic, PelUnitBuf *pcOrgPicYuv);
 #endif
+#if SVIDEO_VIEWPORT_LUT_CACHE
+  Void setLutCacheSize(Int iMBytes);
+#endif
+#if SVIDEO_VIEWPORT_DIRECT_SAMPLING
+  Void setDirectSampling(Bool bDirect, Int iNumThreads);
+#endif
+#if SVIDEO_VIEWPORT_BATCH_PSNR
+  Void setBatchThreads(Int iNumThreads) { m_iBatchThreads = iNumThreads; }
+#endif
 };
 
 #endif
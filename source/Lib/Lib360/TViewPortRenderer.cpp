@@ -0,0 +1,201 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TViewPortRenderer.cpp
+    \brief    Renders a list of viewports from one frame packed 360 picture
+*/
+
+#include <thread>
+#include "TViewPortRenderer.h"
+
+#if SVIDEO_VIEWPORT_RENDERER
+TViewPortRenderer::TViewPortRenderer()
+: m_pcSrcGeometry(nullptr)
+, m_iNumThreads(1)
+, m_bFaceMask(false)
+, m_uiPadFaceMask(0)
+, m_uiConvertFaceMask(0)
+, m_iNumViewPorts(0)
+{
+}
+
+TViewPortRenderer::~TViewPortRenderer()
+{
+  destroy();
+}
+
+Void TViewPortRenderer::destroy()
+{
+  for(Int i=0; i<(Int)m_slots.size(); i++)
+  {
+    delete m_slots[i].pcViewPort;
+    m_slots[i].pcViewPortYuv->destroy();
+    delete m_slots[i].pcViewPortYuv;
+  }
+  m_slots.clear();
+  m_iNumViewPorts = 0;
+  if(m_pcSrcGeometry)
+  {
+    delete m_pcSrcGeometry;
+    m_pcSrcGeometry = nullptr;
+  }
+}
+
+Void TViewPortRenderer::init(SVideoInfo& sSrcVideoInfo, InputGeoParam *pInGeoParam, Int iNumThreads)
+{
+  destroy();
+  m_geoParam      = *pInGeoParam;
+  m_iNumThreads   = std::max(1, iNumThreads);
+  m_pcSrcGeometry = TGeometry::create(sSrcVideoInfo, &m_geoParam);
+  m_bFaceMask     = m_pcSrcGeometry->isFaceMaskSupported();
+  m_uiPadFaceMask = m_uiConvertFaceMask = 0;
+
+  memset(&m_viewPortVideoInfo, 0, sizeof(m_viewPortVideoInfo));
+  m_viewPortVideoInfo.geoType = SVIDEO_VIEWPORT;
+  m_viewPortVideoInfo.framePackStruct.chromaFormatIDC = sSrcVideoInfo.framePackStruct.chromaFormatIDC;
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+  m_viewPortVideoInfo.framePackStruct.chromaSampleLocType = 0;
+#endif
+  m_viewPortVideoInfo.framePackStruct.rows = m_viewPortVideoInfo.framePackStruct.cols = 1;
+  m_viewPortVideoInfo.iNumFaces = 1;
+}
+
+//the viewport of a slot is only created again if its size is changed;
+Void TViewPortRenderer::xPrepareSlot(Int iIdx, const ViewPortRenderSettings& settings)
+{
+  if(iIdx == (Int)m_slots.size())
+  {
+    RenderSlot slot;
+    slot.pcViewPort     = nullptr;
+    slot.pcViewPortYuv  = nullptr;
+    slot.uiFaceMask     = 0;
+    slot.bFaceMaskValid = false;
+    m_slots.push_back(slot);
+  }
+  RenderSlot& slot = m_slots[iIdx];
+  if(!slot.pcViewPort || slot.settings.iWidth != settings.iWidth || slot.settings.iHeight != settings.iHeight)
+  {
+    CHECK(settings.iWidth <= 0 || settings.iHeight <= 0, "Invalid viewport size");
+    if(slot.pcViewPort)
+    {
+      delete slot.pcViewPort;
+      slot.pcViewPortYuv->destroy();
+      delete slot.pcViewPortYuv;
+    }
+    m_viewPortVideoInfo.iFaceWidth  = settings.iWidth;
+    m_viewPortVideoInfo.iFaceHeight = settings.iHeight;
+    m_viewPortVideoInfo.viewPort    = settings.viewPort;
+    slot.pcViewPort = TGeometry::create(m_viewPortVideoInfo, &m_geoParam);
+    slot.pcViewPortYuv = new PelStorage;
+    slot.pcViewPortYuv->create(m_viewPortVideoInfo.framePackStruct.chromaFormatIDC, Area(Position(), Size(settings.iWidth, settings.iHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+    slot.bFaceMaskValid = false;
+  }
+  else if(slot.settings.viewPort.hFOV != settings.viewPort.hFOV || slot.settings.viewPort.vFOV != settings.viewPort.vFOV
+       || slot.settings.viewPort.fYaw != settings.viewPort.fYaw || slot.settings.viewPort.fPitch != settings.viewPort.fPitch)
+  {
+    slot.pcViewPort->getSVideoInfo()->viewPort = settings.viewPort;
+    slot.bFaceMaskValid = false;
+  }
+  slot.settings = settings;
+}
+
+/*********************************************************
+//the picture is converted and padded once for all the viewports; for the cube map family only the faces sampled
+//by the viewports are padded, and only these faces and their padding sources are converted;
+//the viewports are sampled directly from the faces, so no mapping table is built when the viewports move;
+**********************************************************/
+Void TViewPortRenderer::render(PelUnitBuf *pcSrcYuv, const std::vector<ViewPortRenderSettings>& viewPorts)
+{
+  m_iNumViewPorts = (Int)viewPorts.size();
+  if(!m_iNumViewPorts)
+    return;
+  for(Int i=0; i<m_iNumViewPorts; i++)
+  {
+    xPrepareSlot(i, viewPorts[i]);
+  }
+  if(m_bFaceMask)
+  {
+    UInt uiPadFaceMask = 0;
+    for(Int i=0; i<m_iNumViewPorts; i++)
+    {
+      RenderSlot& slot = m_slots[i];
+      if(!slot.bFaceMaskValid)
+      {
+        slot.uiFaceMask = m_pcSrcGeometry->getViewPortFaceMask(slot.pcViewPort, true);
+        slot.bFaceMaskValid = true;
+      }
+      uiPadFaceMask |= slot.uiFaceMask;
+    }
+    if(uiPadFaceMask != m_uiPadFaceMask)
+    {
+      m_uiPadFaceMask = uiPadFaceMask;
+      m_uiConvertFaceMask = uiPadFaceMask | m_pcSrcGeometry->getPaddingSourceMask(uiPadFaceMask);
+    }
+    m_pcSrcGeometry->setFaceMask(m_uiConvertFaceMask, m_uiPadFaceMask);
+  }
+
+  if((m_pcSrcGeometry->getType() == SVIDEO_OCTAHEDRON || m_pcSrcGeometry->getType() == SVIDEO_ICOSAHEDRON) && m_pcSrcGeometry->getSVideoInfo()->iCompactFPStructure)
+    m_pcSrcGeometry->compactFramePackConvertYuv(pcSrcYuv);
+  else
+    m_pcSrcGeometry->convertYuv(pcSrcYuv);
+  //the source faces are padded here, the threads only read them;
+  m_pcSrcGeometry->spherePadding();
+
+  Int iNumThreads = std::min(m_iNumThreads, m_iNumViewPorts);
+  if(iNumThreads == 1)
+  {
+    xRenderViewPorts(0, 1);
+    return;
+  }
+  std::vector<std::thread> threads;
+  for(Int t=0; t<iNumThreads; t++)
+  {
+    threads.push_back(std::thread(&TViewPortRenderer::xRenderViewPorts, this, t, iNumThreads));
+  }
+  for(Int t=0; t<iNumThreads; t++)
+  {
+    threads[t].join();
+  }
+}
+
+Void TViewPortRenderer::xRenderViewPorts(Int iThreadIdx, Int iNumThreads)
+{
+  for(Int i=iThreadIdx; i<m_iNumViewPorts; i+=iNumThreads)
+  {
+    //the rotation of the source picture is undone as for the reconstructed pictures;
+    m_pcSrcGeometry->geoConvertDirect(m_slots[i].pcViewPort, true, nullptr);
+    m_slots[i].pcViewPort->framePack(m_slots[i].pcViewPortYuv);
+  }
+}
+#endif
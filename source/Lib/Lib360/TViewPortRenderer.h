@@ -0,0 +1,100 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TViewPortRenderer.h
+    \brief    Renders a list of viewports from one frame packed 360 picture (header)
+*/
+
+#ifndef __TVIEWPORTRENDERER__
+#define __TVIEWPORTRENDERER__
+#include "TGeometry.h"
+#include "TViewPort.h"
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+#if SVIDEO_VIEWPORT_RENDERER
+
+struct ViewPortRenderSettings
+{
+  ViewPortSettings viewPort;         //field of view and orientation in degrees;
+  Int              iWidth;
+  Int              iHeight;
+  ViewPortRenderSettings() : iWidth(0), iHeight(0) {};
+};
+
+/* Typical use:
+     TViewPortRenderer cRenderer;
+     cRenderer.init(sVideoInfo, &geoParam, iNumThreads);
+     for each picture: cRenderer.render(&picYuv, viewPorts); then read cRenderer.getViewPortYuv(i);
+   the geometries, the viewports and the output pictures are kept between the calls;
+*/
+class TViewPortRenderer
+{
+private:
+  struct RenderSlot
+  {
+    ViewPortRenderSettings settings;
+    TGeometry             *pcViewPort;
+    PelStorage            *pcViewPortYuv;
+    UInt                   uiFaceMask;         //faces of the source sampled by the viewport;
+    Bool                   bFaceMaskValid;
+  };
+
+  TGeometry     *m_pcSrcGeometry;
+  SVideoInfo     m_viewPortVideoInfo;
+  InputGeoParam  m_geoParam;
+  Int            m_iNumThreads;
+  Bool           m_bFaceMask;                  //only the faces sampled by the viewports are converted and padded;
+  UInt           m_uiPadFaceMask;
+  UInt           m_uiConvertFaceMask;          //faces read by the padding of m_uiPadFaceMask;
+  std::vector<RenderSlot> m_slots;
+  Int            m_iNumViewPorts;
+
+  Void xPrepareSlot(Int iIdx, const ViewPortRenderSettings& settings);
+  Void xRenderViewPorts(Int iThreadIdx, Int iNumThreads);
+public:
+  TViewPortRenderer();
+  virtual ~TViewPortRenderer();
+
+  Void init(SVideoInfo& sSrcVideoInfo, InputGeoParam *pInGeoParam, Int iNumThreads);
+  Void destroy();
+  Void render(PelUnitBuf *pcSrcYuv, const std::vector<ViewPortRenderSettings>& viewPorts);
+  Int  getNumViewPorts() { return m_iNumViewPorts; }
+  PelStorage* getViewPortYuv(Int iIdx) { return m_slots[iIdx].pcViewPortYuv; }
+};
+
+#endif
+#endif // __TVIEWPORTRENDERER__
@@ -0,0 +1,123 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TWorkerPool.cpp
+    \brief    Simple pool of worker threads used to run independent 360 video tasks
+*/
+
+#include "TWorkerPool.h"
+
+#if SVIDEO_CONCURRENT_METRICS || SVIDEO_VIEWPORT_DIRECT_SAMPLING
+
+TWorkerPool::TWorkerPool()
+: m_iNumPending(0)
+, m_bStop(false)
+{
+}
+
+TWorkerPool::~TWorkerPool()
+{
+  destroy();
+}
+
+Void TWorkerPool::create(Int iNumThreads)
+{
+  destroy();
+  m_bStop = false;
+  for(Int i=0; i<iNumThreads; i++)
+  {
+    m_workers.push_back(std::thread(&TWorkerPool::xWorkerLoop, this));
+  }
+}
+
+Void TWorkerPool::destroy()
+{
+  if(m_workers.empty())
+    return;
+  wait();
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_bStop = true;
+  }
+  m_taskCond.notify_all();
+  for(Int i=0; i<(Int)m_workers.size(); i++)
+  {
+    m_workers[i].join();
+  }
+  m_workers.clear();
+}
+
+Void TWorkerPool::addTask(std::function<Void()> task)
+{
+  if(m_workers.empty())
+  {
+    task();
+    return;
+  }
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_tasks.push_back(task);
+    m_iNumPending++;
+  }
+  m_taskCond.notify_one();
+}
+
+Void TWorkerPool::wait()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_doneCond.wait(lock, [this]{ return m_iNumPending == 0; });
+}
+
+Void TWorkerPool::xWorkerLoop()
+{
+  for(;;)
+  {
+    std::function<Void()> task;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_taskCond.wait(lock, [this]{ return m_bStop || !m_tasks.empty(); });
+      if(m_tasks.empty())
+        return;
+      task = m_tasks.front();
+      m_tasks.pop_front();
+    }
+    task();
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_iNumPending--;
+      if(!m_iNumPending)
+        m_doneCond.notify_all();
+    }
+  }
+}
+#endif
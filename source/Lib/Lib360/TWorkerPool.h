@@ -0,0 +1,79 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TWorkerPool.h
+    \brief    Simple pool of worker threads used to run independent 360 video tasks (header)
+*/
+
+#ifndef __TWORKERPOOL__
+#define __TWORKERPOOL__
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "TGeometry.h"
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+#if SVIDEO_CONCURRENT_METRICS || SVIDEO_VIEWPORT_DIRECT_SAMPLING
+
+class TWorkerPool
+{
+private:
+  std::vector<std::thread>           m_workers;
+  std::deque<std::function<Void()> > m_tasks;
+  std::mutex                         m_mutex;
+  std::condition_variable            m_taskCond;
+  std::condition_variable            m_doneCond;
+  Int                                m_iNumPending;       //queued and running tasks;
+  Bool                               m_bStop;
+
+  Void xWorkerLoop();
+
+public:
+  TWorkerPool();
+  virtual ~TWorkerPool();
+
+  Void create(Int iNumThreads);
+  Void destroy();
+  Void addTask(std::function<Void()> task);        //runs the task immediately if no worker threads are created;
+  Void wait();                                     //returns once all the added tasks are finished;
+  Int  getNumThreads() { return (Int)m_workers.size(); }
+};
+
+#endif
+#endif // __TWORKERPOOL__